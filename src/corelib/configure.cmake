@@ -227,6 +227,51 @@ char buf[32];
 }
 ")
 
+# epoll
+qt_config_compile_test(epoll
+    LABEL "epoll()"
+    CODE
+"#include <sys/epoll.h>
+
+int main(void)
+{
+    /* BEGIN TEST: */
+struct epoll_event ev = {};
+ev.events = EPOLLIN | EPOLLPRI | EPOLLET;
+int fd = epoll_create1(EPOLL_CLOEXEC);
+epoll_ctl(fd, EPOLL_CTL_ADD, 0, &ev);
+epoll_wait(fd, &ev, 1, 0);
+    /* END TEST: */
+    return 0;
+}
+")
+
+# io_uring
+qt_config_compile_test(io_uring
+    LABEL "io_uring"
+    CODE
+"#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+int main(void)
+{
+    /* BEGIN TEST: */
+struct io_uring_params params = {};
+params.flags = IORING_SETUP_CLAMP;
+int fd = syscall(__NR_io_uring_setup, 8, &params);
+syscall(__NR_io_uring_enter, fd, 0, 1, IORING_ENTER_GETEVENTS, 0, 0);
+syscall(__NR_io_uring_register, fd, IORING_REGISTER_EVENTFD, &fd, 1);
+syscall(__NR_io_uring_register, fd, IORING_REGISTER_PROBE, 0, 0);
+unsigned supported = IO_URING_OP_SUPPORTED;
+(void)supported;
+struct io_uring_sqe sqe = {};
+sqe.opcode = IORING_OP_READ;
+    /* END TEST: */
+    return 0;
+}
+")
+
 # inotify
 qt_config_compile_test(inotify
     LABEL "inotify"
@@ -555,6 +600,11 @@ qt_feature("dladdr" PRIVATE
     LABEL "dladdr"
     CONDITION QT_FEATURE_dlopen AND TEST_dladdr
 )
+qt_feature("epoll" PRIVATE
+    LABEL "epoll() based event dispatcher"
+    CONDITION TEST_epoll
+    EMIT_IF UNIX
+)
 qt_feature("futimens" PRIVATE
     LABEL "futimens()"
     CONDITION NOT WIN32 AND TEST_futimens
@@ -583,6 +633,10 @@ qt_feature("inotify" PUBLIC PRIVATE
     CONDITION TEST_inotify
 )
 qt_feature_definition("inotify" "QT_NO_INOTIFY" NEGATE VALUE "1")
+qt_feature("io_uring" PRIVATE
+    LABEL "io_uring based asynchronous file I/O"
+    CONDITION LINUX AND QT_FEATURE_thread AND TEST_io_uring
+)
 qt_feature("ipc_posix"
     LABEL "Defaulting legacy IPC to POSIX"
     CONDITION TEST_posix_shm AND TEST_posix_sem AND (
@@ -1005,9 +1059,11 @@ qt_configure_add_summary_entry(ARGS "backtrace")
 qt_configure_add_summary_entry(ARGS "cxx23_stacktrace")
 qt_configure_add_summary_entry(ARGS "doubleconversion")
 qt_configure_add_summary_entry(ARGS "system-doubleconversion")
+qt_configure_add_summary_entry(ARGS "epoll" CONDITION LINUX)
 qt_configure_add_summary_entry(ARGS "forkfd_pidfd" CONDITION LINUX)
 qt_configure_add_summary_entry(ARGS "glib")
 qt_configure_add_summary_entry(ARGS "icu")
+qt_configure_add_summary_entry(ARGS "io_uring" CONDITION LINUX)
 qt_configure_add_summary_entry(ARGS "timezone_tzdb")
 qt_configure_add_summary_entry(ARGS "system-libb2")
 qt_configure_add_summary_entry(ARGS "mimetype-database")
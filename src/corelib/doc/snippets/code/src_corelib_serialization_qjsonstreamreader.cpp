@@ -0,0 +1,23 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR BSD-3-Clause
+
+//! [0]
+    QFile file("requests.ndjson");
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    QJsonStreamReader reader(&file);
+    while (reader.readNext() == QJsonStreamReader::StartObject) {
+        // one log record per line: pick out the fields we need
+        while (reader.readNext() != QJsonStreamReader::EndObject && !reader.hasError()) {
+            if (reader.nameEquals("status"))
+                countStatus(reader.toInteger());
+            else if (reader.nameEquals("path"))
+                countPath(reader.text());
+            else
+                reader.skipCurrentElement();
+        }
+    }
+    if (reader.hasError())
+        qWarning() << reader.errorString() << "at offset" << reader.offset();
+//! [0]
@@ -0,0 +1,20 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR BSD-3-Clause
+
+//! [0]
+QReadCopyUpdate<QHash<QString, QUrl>> mirrors;
+
+QUrl mirrorFor(const QString &country)
+{
+    // no lock is taken, and writers do not block us
+    return mirrors.read()->value(country, defaultMirror);
+}
+
+void addMirror(const QString &country, const QUrl &url)
+{
+    // copies the current hash, inserts into the copy and publishes it
+    mirrors.update([&](QHash<QString, QUrl> &hash) {
+        hash.insert(country, url);
+    });
+}
+//! [0]
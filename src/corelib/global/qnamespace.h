@@ -1288,6 +1288,8 @@ namespace Qt {
         BlockingQueuedConnection,
         UniqueConnection =  0x80,
         SingleShotConnection = 0x100,
+        BatchedQueuedConnection = 0x200,
+        CoalescedQueuedConnection = 0x400,
     };
 
     enum ShortcutContext {
@@ -0,0 +1,772 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qrandomaccessasyncfile_p.h"
+
+#include "qcoreapplication.h"
+#include "qfile.h"
+#include "qhash.h"
+#include "qmutex.h"
+#include "qpointer.h"
+#include "qthreadpool.h"
+#include "qwaitcondition.h"
+
+#include <private/qcore_unix_p.h>
+#include <private/qobject_p.h>
+
+#if QT_CONFIG(io_uring)
+#  include "qsocketnotifier.h"
+#  include <linux/io_uring.h>
+#  include <sys/eventfd.h>
+#  include <sys/mman.h>
+#  include <sys/syscall.h>
+#  ifndef IORING_SQ_CQ_OVERFLOW
+#    define IORING_SQ_CQ_OVERFLOW (1U << 1) // Linux 5.8
+#  endif
+#endif
+
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \internal
+    \class QRandomAccessAsyncFile
+    \inmodule QtCore
+
+    \brief The QRandomAccessAsyncFile class reads and writes files without
+    blocking the calling thread.
+
+    Each read() or write() call queues a positional operation and returns an
+    identifier for it. When the operation completes, readyRead() or
+    bytesWritten() is emitted from the event loop of the thread the object
+    lives in, carrying that identifier. Operations are independent of each
+    other and may complete in any order.
+
+    On Linux, operations are submitted to an io_uring instance shared by all
+    objects of the thread, whose completions are signalled through an eventfd
+    watched by the thread's event dispatcher, so a deep queue of reads costs
+    no extra threads. Where io_uring is unavailable or does not support plain
+    reads and writes, or when the \c QT_NO_IO_URING environment variable is
+    set, operations run as pread()/pwrite() calls on a thread pool instead.
+*/
+
+// Linux never transfers more than this in one read() or write() call
+static constexpr qint64 MaxTransferSize = 0x7ffff000;
+
+// The jobs run on a pool of their own, so that close() can wait for them
+// even when it is called from a thread of the global pool.
+Q_GLOBAL_STATIC(QThreadPool, asyncFileThreadPool)
+
+namespace {
+struct Operation
+{
+    enum Type : quint8 { Read, Write };
+
+    quint64 id;
+    qint64 offset;
+    QByteArray buffer;
+    Type type;
+};
+
+// Shared with the thread pool jobs, so that the last job can signal
+// completion without touching the QRandomAccessAsyncFilePrivate that may be
+// destroyed as soon as the waiter wakes up.
+struct ThreadPoolState
+{
+    QMutex mutex;
+    QWaitCondition finished;
+    int inFlight = 0;
+};
+
+#if QT_CONFIG(io_uring)
+static unsigned loadAcquire(const unsigned *ptr)
+{
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+
+static void storeRelease(unsigned *ptr, unsigned value)
+{
+    __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+}
+
+class QIoUring
+{
+public:
+    struct Completion
+    {
+        quint64 id;
+        int result;
+    };
+
+    QIoUring() = default;
+    ~QIoUring();
+    Q_DISABLE_COPY_MOVE(QIoUring)
+
+    bool init(unsigned entries);
+    bool push(quint64 userData, const Operation &op, int fd);
+    int submit(unsigned minComplete);
+    void retract(QList<quint64> *userData);
+    bool reap(Completion *completion);
+
+    // entries pushed to the submission queue that the kernel has not taken yet
+    unsigned unsubmitted() const { return *sqTail - loadAcquire(sqHead); }
+    // completions are waiting for room in the completion queue
+    bool cqOverflowed() const { return loadAcquire(sqFlags) & IORING_SQ_CQ_OVERFLOW; }
+
+    int eventFd = -1;
+
+private:
+    int ringFd = -1;
+    void *sqRing = MAP_FAILED;
+    void *cqRing = MAP_FAILED;
+    size_t sqRingSize = 0;
+    size_t cqRingSize = 0;
+    io_uring_sqe *sqes = static_cast<io_uring_sqe *>(MAP_FAILED);
+    size_t sqesSize = 0;
+
+    unsigned *sqHead = nullptr;
+    unsigned *sqTail = nullptr;
+    unsigned *sqArray = nullptr;
+    unsigned *sqFlags = nullptr;
+    unsigned sqMask = 0;
+    unsigned sqEntries = 0;
+
+    unsigned *cqHead = nullptr;
+    unsigned *cqTail = nullptr;
+    io_uring_cqe *cqes = nullptr;
+    unsigned cqMask = 0;
+
+    bool supportsReadWrite() const;
+};
+
+QIoUring::~QIoUring()
+{
+    if (sqes != MAP_FAILED)
+        munmap(sqes, sqesSize);
+    if (cqRing != MAP_FAILED && cqRing != sqRing)
+        munmap(cqRing, cqRingSize);
+    if (sqRing != MAP_FAILED)
+        munmap(sqRing, sqRingSize);
+    if (eventFd >= 0)
+        qt_safe_close(eventFd);
+    if (ringFd >= 0)
+        qt_safe_close(ringFd);
+}
+
+bool QIoUring::init(unsigned entries)
+{
+    io_uring_params params = {};
+    params.flags = IORING_SETUP_CLAMP;
+    ringFd = int(syscall(__NR_io_uring_setup, entries, &params));
+    if (ringFd < 0)
+        return false;
+
+    sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (singleMmap)
+        sqRingSize = cqRingSize = qMax(sqRingSize, cqRingSize);
+
+    sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                  ringFd, IORING_OFF_SQ_RING);
+    if (sqRing == MAP_FAILED)
+        return false;
+    if (singleMmap) {
+        cqRing = sqRing;
+    } else {
+        cqRing = mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ringFd, IORING_OFF_CQ_RING);
+        if (cqRing == MAP_FAILED)
+            return false;
+    }
+
+    if (!supportsReadWrite())
+        return false;
+
+    sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    sqes = static_cast<io_uring_sqe *>(mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE,
+                                            MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES));
+    if (sqes == MAP_FAILED)
+        return false;
+
+    char *sq = static_cast<char *>(sqRing);
+    sqHead = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+    sqTail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    sqArray = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    sqFlags = reinterpret_cast<unsigned *>(sq + params.sq_off.flags);
+    sqMask = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    sqEntries = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_entries);
+
+    char *cq = static_cast<char *>(cqRing);
+    cqHead = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    cqTail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+    cqMask = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+
+    eventFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (eventFd < 0)
+        return false;
+    return syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_EVENTFD, &eventFd, 1) == 0;
+}
+
+// IORING_OP_READ and IORING_OP_WRITE exist since Linux 5.6, but seccomp
+// filters and kernels built with a restricted io_uring may still reject
+// them, so ask the kernel rather than relying on its version.
+bool QIoUring::supportsReadWrite() const
+{
+    constexpr unsigned ProbeOps = IORING_OP_WRITE + 1;
+    alignas(io_uring_probe) unsigned char buffer[sizeof(io_uring_probe)
+                                                 + ProbeOps * sizeof(io_uring_probe_op)] = {};
+    auto *probe = reinterpret_cast<io_uring_probe *>(buffer);
+    if (syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_PROBE, probe, ProbeOps) != 0)
+        return false;
+    if (probe->last_op < IORING_OP_WRITE)
+        return false;
+    return (probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED)
+            && (probe->ops[IORING_OP_WRITE].flags & IO_URING_OP_SUPPORTED);
+}
+
+// Returns false if the submission queue is full.
+bool QIoUring::push(quint64 userData, const Operation &op, int fd)
+{
+    const unsigned tail = *sqTail;
+    if (tail - loadAcquire(sqHead) >= sqEntries)
+        return false;
+
+    const unsigned index = tail & sqMask;
+    io_uring_sqe *sqe = &sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = op.type == Operation::Read ? IORING_OP_READ : IORING_OP_WRITE;
+    sqe->fd = fd;
+    sqe->off = quint64(op.offset);
+    sqe->addr = quintptr(op.buffer.constData());
+    sqe->len = unsigned(op.buffer.size());
+    sqe->user_data = userData;
+    sqArray[index] = index;
+    storeRelease(sqTail, tail + 1);
+    return true;
+}
+
+// Hands all unsubmitted entries to the kernel and waits for minComplete
+// completions. The kernel may take fewer entries than offered; the rest stay
+// in the submission queue for the next call.
+int QIoUring::submit(unsigned minComplete)
+{
+    // Completions that did not fit into the completion queue are only moved
+    // there when events are asked for; with minComplete == 0 that does not
+    // block.
+    const unsigned flags = minComplete || cqOverflowed() ? IORING_ENTER_GETEVENTS : 0;
+    int ret;
+    QT_EINTR_LOOP(ret, int(syscall(__NR_io_uring_enter, ringFd, unsubmitted(), minComplete,
+                                   flags, nullptr, 0)));
+    return ret;
+}
+
+// Takes back the entries the kernel has not taken yet and stores their
+// user data in userData. Without SQPOLL the kernel only reads the submission
+// queue from within io_uring_enter(), so this is safe between calls.
+void QIoUring::retract(QList<quint64> *userData)
+{
+    const unsigned head = loadAcquire(sqHead);
+    for (unsigned pos = head; pos != *sqTail; ++pos)
+        userData->append(sqes[sqArray[pos & sqMask]].user_data);
+    storeRelease(sqTail, head);
+}
+
+// Takes one completion off the completion queue, if there is one.
+bool QIoUring::reap(Completion *completion)
+{
+    const unsigned head = *cqHead;
+    if (head == loadAcquire(cqTail))
+        return false;
+    const io_uring_cqe &cqe = cqes[head & cqMask];
+    *completion = { cqe.user_data, cqe.res };
+    storeRelease(cqHead, head + 1);
+    return true;
+}
+
+class QIoUringContext;
+#endif // QT_CONFIG(io_uring)
+} // unnamed namespace
+
+class QRandomAccessAsyncFilePrivate : public QObjectPrivate
+{
+    Q_DECLARE_PUBLIC(QRandomAccessAsyncFile)
+
+public:
+    quint64 enqueue(Operation::Type type, qint64 offset, QByteArray buffer);
+    void complete(Operation &op, qint64 result, int errnum);
+    void drain();
+
+    void startOnThreadPool(Operation &&op);
+
+    QFile file;
+    QString errorString;
+    int fd = -1;
+    int pending = 0;
+    quint64 nextId = 0;
+    QRandomAccessAsyncFile::Backend backend = QRandomAccessAsyncFile::Backend::ThreadPool;
+
+    std::shared_ptr<ThreadPoolState> threadPoolState = std::make_shared<ThreadPoolState>();
+    // results of thread pool jobs from before the last close() are dropped
+    quint64 generation = 0;
+
+#if QT_CONFIG(io_uring)
+    // the ring of the thread the object lives in
+    std::shared_ptr<QIoUringContext> ring;
+#endif
+};
+
+#if QT_CONFIG(io_uring)
+namespace {
+// The io_uring instance of a thread, shared by the QRandomAccessAsyncFile
+// objects living in it. It holds on to the operations until the kernel has
+// completed them, also for objects that closed their file in the meantime,
+// and is destroyed when neither remain.
+class QIoUringContext : public QObject, public std::enable_shared_from_this<QIoUringContext>
+{
+public:
+    static std::shared_ptr<QIoUringContext> forCurrentThread();
+    ~QIoUringContext() override;
+
+    void enqueue(QRandomAccessAsyncFilePrivate *owner, Operation &&op);
+    bool waitForCompletion();
+    void cancel(QRandomAccessAsyncFilePrivate *owner);
+
+private:
+    struct Entry
+    {
+        quint64 key = 0;
+        // nullptr once the owner no longer wants the result
+        QRandomAccessAsyncFilePrivate *owner = nullptr;
+        int fd = -1;
+        Operation op;
+    };
+
+    void submitQueued();
+    bool enterRing(unsigned minComplete);
+    void deliverFailed();
+    void processCompletions();
+
+    QIoUring ring;
+    QSocketNotifier *completionNotifier = nullptr;
+    QHash<quint64, Entry> submitted;
+    QList<Entry> queued;
+    QList<Entry> failed;
+    int failedErrno = 0;
+    quint64 nextKey = 0;
+};
+
+std::shared_ptr<QIoUringContext> QIoUringContext::forCurrentThread()
+{
+    if (!qEnvironmentVariableIsEmpty("QT_NO_IO_URING"))
+        return nullptr;
+    static thread_local std::weak_ptr<QIoUringContext> current;
+    if (auto context = current.lock())
+        return context;
+
+    auto context = std::make_shared<QIoUringContext>();
+    if (!context->ring.init(256))
+        return nullptr;
+
+    QIoUringContext *c = context.get();
+    c->completionNotifier = new QSocketNotifier(c->ring.eventFd, QSocketNotifier::Read, c);
+    QObject::connect(c->completionNotifier, &QSocketNotifier::activated, c, [c] {
+        // the receivers may destroy the last object using the ring
+        const auto self = c->shared_from_this();
+        eventfd_t value;
+        eventfd_read(c->ring.eventFd, &value);
+        c->processCompletions();
+        c->submitQueued();
+    });
+    current = context;
+    return context;
+}
+
+QIoUringContext::~QIoUringContext()
+{
+    // The kernel writes into the buffers of the operations still in flight
+    // until their completions have been reaped.
+    queued.clear();
+    while (!submitted.isEmpty() && enterRing(1))
+        processCompletions();
+}
+
+void QIoUringContext::enqueue(QRandomAccessAsyncFilePrivate *owner, Operation &&op)
+{
+    queued.append({ ++nextKey, owner, owner->fd, std::move(op) });
+    submitQueued();
+}
+
+void QIoUringContext::submitQueued()
+{
+    while (!queued.isEmpty()) {
+        const Entry &first = queued.constFirst();
+        if (!ring.push(first.key, first.op, first.fd))
+            break;
+        Entry entry = queued.takeFirst();
+        const quint64 key = entry.key;
+        submitted.emplace(key, std::move(entry));
+    }
+
+    if (ring.unsubmitted())
+        enterRing(0);
+}
+
+// Submits the entries in the ring and waits for minComplete completions.
+// Operations stay in submitted until their completion has been reaped, as
+// the kernel owns their buffers until then. Returns false if the ring failed
+// for good; the entries the kernel had not taken are then retracted and
+// reported as failed, and those still in flight are left alone.
+bool QIoUringContext::enterRing(unsigned minComplete)
+{
+    if (ring.submit(minComplete) >= 0)
+        return true;
+
+    const int errnum = errno;
+    const bool inFlight = submitted.size() > qsizetype(ring.unsubmitted());
+    if ((errnum == EAGAIN || errnum == EBUSY) && inFlight) {
+        // the kernel is short on resources or completions need reaping;
+        // try again once the operations in flight complete
+        return true;
+    }
+
+    QList<quint64> keys;
+    ring.retract(&keys);
+    for (quint64 key : std::as_const(keys))
+        failed.append(submitted.take(key));
+    failedErrno = errnum;
+    deliverFailed();
+    return errnum == EAGAIN || errnum == EBUSY;
+}
+
+// Entries are taken off the member lists one at a time, so that receivers
+// can start, wait for or cancel operations of any object.
+void QIoUringContext::deliverFailed()
+{
+    while (!failed.isEmpty()) {
+        Entry entry = failed.takeFirst();
+        if (entry.owner)
+            entry.owner->complete(entry.op, -1, failedErrno);
+    }
+}
+
+void QIoUringContext::processCompletions()
+{
+    QIoUring::Completion c;
+    // The kernel moves completions that overflowed the queue over when the
+    // ring is entered, without signalling the eventfd again.
+    while (ring.reap(&c) || (ring.cqOverflowed() && ring.submit(0) >= 0 && ring.reap(&c))) {
+        Entry entry = submitted.take(c.id);
+        if (entry.owner)
+            entry.owner->complete(entry.op, c.result, -c.result);
+    }
+}
+
+// Waits for at least one operation to complete and delivers the results.
+// Returns false if the ring failed for good.
+bool QIoUringContext::waitForCompletion()
+{
+    submitQueued();
+    const bool inFlight = submitted.size() > qsizetype(ring.unsubmitted());
+    const bool ok = enterRing(inFlight ? 1 : 0);
+    processCompletions();
+    return ok;
+}
+
+// Drops the operations of owner that have not started yet and waits for
+// those the kernel works on, discarding their results. If the ring fails,
+// they are left to complete after owner is gone.
+void QIoUringContext::cancel(QRandomAccessAsyncFilePrivate *owner)
+{
+    const auto isOwned = [owner](const Entry &entry) { return entry.owner == owner; };
+    queued.removeIf(isOwned);
+    failed.removeIf(isOwned);
+
+    QList<quint64> keys;
+    for (Entry &entry : submitted) {
+        if (isOwned(entry)) {
+            entry.owner = nullptr;
+            keys.append(entry.key);
+        }
+    }
+
+    for (quint64 key : std::as_const(keys)) {
+        while (submitted.contains(key)) {
+            if (!enterRing(1))
+                return;
+            processCompletions();
+        }
+    }
+}
+} // unnamed namespace
+#endif // QT_CONFIG(io_uring)
+
+quint64 QRandomAccessAsyncFilePrivate::enqueue(Operation::Type type, qint64 offset,
+                                               QByteArray buffer)
+{
+    const quint64 id = ++nextId;
+    Operation op{ id, offset, std::move(buffer), type };
+    ++pending;
+
+#if QT_CONFIG(io_uring)
+    if (backend == QRandomAccessAsyncFile::Backend::IoUring && !ring) {
+        // the object moved to another thread
+        ring = QIoUringContext::forCurrentThread();
+        if (!ring)
+            backend = QRandomAccessAsyncFile::Backend::ThreadPool;
+    }
+    if (ring) {
+        // receivers of failures reported right away may destroy us
+        const auto context = ring;
+        context->enqueue(this, std::move(op));
+        return id;
+    }
+#endif
+
+    startOnThreadPool(std::move(op));
+    return id;
+}
+
+void QRandomAccessAsyncFilePrivate::complete(Operation &op, qint64 result, int errnum)
+{
+    Q_Q(QRandomAccessAsyncFile);
+    --pending;
+
+    if (result < 0) {
+        errorString = qt_error_string(errnum);
+        emit q->errorOccurred(op.id, op.type == Operation::Read ? QFileDevice::ReadError
+                                                                : QFileDevice::WriteError);
+    } else if (op.type == Operation::Read) {
+        op.buffer.truncate(result);
+        emit q->readyRead(op.id, op.buffer);
+    } else {
+        emit q->bytesWritten(op.id, result);
+    }
+}
+
+void QRandomAccessAsyncFilePrivate::startOnThreadPool(Operation &&op)
+{
+    Q_Q(QRandomAccessAsyncFile);
+    {
+        QMutexLocker locker(&threadPoolState->mutex);
+        ++threadPoolState->inFlight;
+    }
+
+    asyncFileThreadPool()->start(
+            [q, fd = fd, gen = generation, state = threadPoolState, op = std::move(op)]() mutable {
+        qint64 result;
+        if (op.type == Operation::Read)
+            QT_EINTR_LOOP(result, ::pread(fd, op.buffer.data(), op.buffer.size(), op.offset));
+        else
+            QT_EINTR_LOOP(result, ::pwrite(fd, op.buffer.constData(), op.buffer.size(), op.offset));
+        const int errnum = errno;
+
+        // q is alive: its destructor waits for inFlight to drop to zero
+        QMetaObject::invokeMethod(q, [q, gen, result, errnum, op = std::move(op)]() mutable {
+            QRandomAccessAsyncFilePrivate *d = q->d_func();
+            if (d->generation == gen)
+                d->complete(op, result, errnum);
+        }, Qt::QueuedConnection);
+
+        QMutexLocker locker(&state->mutex);
+        if (--state->inFlight == 0)
+            state->finished.wakeAll();
+    });
+}
+
+// Waits for all operations the kernel or the thread pool still work on.
+// Their results are discarded.
+void QRandomAccessAsyncFilePrivate::drain()
+{
+#if QT_CONFIG(io_uring)
+    if (ring) {
+        const auto context = ring;
+        context->cancel(this);
+    }
+#endif
+
+    {
+        QMutexLocker locker(&threadPoolState->mutex);
+        while (threadPoolState->inFlight)
+            threadPoolState->finished.wait(&threadPoolState->mutex);
+    }
+    ++generation;
+    pending = 0;
+}
+
+QRandomAccessAsyncFile::QRandomAccessAsyncFile(QObject *parent)
+    : QObject(*new QRandomAccessAsyncFilePrivate, parent)
+{
+}
+
+/*!
+    Destroys the object. Operations that are still pending are waited for,
+    but no signals are emitted for them.
+*/
+QRandomAccessAsyncFile::~QRandomAccessAsyncFile()
+{
+    close();
+}
+
+/*!
+    Opens the file \a fileName with \a mode, which is interpreted as by
+    QFile::open(). Returns \c true on success.
+*/
+bool QRandomAccessAsyncFile::open(const QString &fileName, QIODeviceBase::OpenMode mode)
+{
+    Q_D(QRandomAccessAsyncFile);
+    close();
+
+    d->file.setFileName(fileName);
+    if (!d->file.open(mode | QIODeviceBase::Unbuffered)) {
+        d->errorString = d->file.errorString();
+        return false;
+    }
+    d->errorString.clear();
+    d->fd = d->file.handle();
+
+#if QT_CONFIG(io_uring)
+    if (!d->ring)
+        d->ring = QIoUringContext::forCurrentThread();
+    d->backend = d->ring ? Backend::IoUring : Backend::ThreadPool;
+#endif
+    return true;
+}
+
+bool QRandomAccessAsyncFile::isOpen() const
+{
+    Q_D(const QRandomAccessAsyncFile);
+    return d->fd >= 0;
+}
+
+/*!
+    Closes the file. Operations that are still pending are waited for, but no
+    signals are emitted for them.
+*/
+void QRandomAccessAsyncFile::close()
+{
+    Q_D(QRandomAccessAsyncFile);
+    if (d->fd < 0)
+        return;
+
+    d->drain();
+    d->file.close();
+    d->fd = -1;
+}
+
+QString QRandomAccessAsyncFile::errorString() const
+{
+    Q_D(const QRandomAccessAsyncFile);
+    return d->errorString;
+}
+
+qint64 QRandomAccessAsyncFile::size() const
+{
+    Q_D(const QRandomAccessAsyncFile);
+    return d->file.size();
+}
+
+QRandomAccessAsyncFile::Backend QRandomAccessAsyncFile::backend() const
+{
+    Q_D(const QRandomAccessAsyncFile);
+    return d->backend;
+}
+
+/*!
+    Returns the number of operations whose completion signal has not been
+    emitted yet.
+*/
+int QRandomAccessAsyncFile::pendingOperations() const
+{
+    Q_D(const QRandomAccessAsyncFile);
+    return d->pending;
+}
+
+/*!
+    Queues a read of up to \a maxSize bytes starting at \a offset and returns
+    the identifier that readyRead() or errorOccurred() will report. Fewer
+    bytes than requested are delivered at the end of the file.
+
+    Returns 0 if the file is not open for reading.
+*/
+quint64 QRandomAccessAsyncFile::read(qint64 offset, qint64 maxSize)
+{
+    Q_D(QRandomAccessAsyncFile);
+    if (d->fd < 0 || !d->file.isReadable() || offset < 0 || maxSize < 0)
+        return 0;
+
+    maxSize = qMin(maxSize, MaxTransferSize);
+    return d->enqueue(Operation::Read, offset, QByteArray(maxSize, Qt::Uninitialized));
+}
+
+/*!
+    Queues a write of \a data at \a offset and returns the identifier that
+    bytesWritten() or errorOccurred() will report. As with pwrite(), fewer
+    bytes than requested may be written.
+
+    Returns 0 if the file is not open for writing.
+*/
+quint64 QRandomAccessAsyncFile::write(qint64 offset, const QByteArray &data)
+{
+    Q_D(QRandomAccessAsyncFile);
+    if (d->fd < 0 || !d->file.isWritable() || offset < 0)
+        return 0;
+
+    return d->enqueue(Operation::Write, offset,
+                      data.size() > MaxTransferSize ? data.first(MaxTransferSize) : data);
+}
+
+/*!
+    Blocks until all pending operations have completed, emitting their
+    completion signals before returning.
+*/
+void QRandomAccessAsyncFile::waitForFinished()
+{
+    Q_D(QRandomAccessAsyncFile);
+
+#if QT_CONFIG(io_uring)
+    if (d->ring) {
+        const auto context = d->ring;
+        // receivers may destroy us
+        const QPointer<QRandomAccessAsyncFile> self = this;
+        while (self && d->pending) {
+            if (!context->waitForCompletion())
+                break;
+        }
+        return;
+    }
+#endif
+
+    {
+        QMutexLocker locker(&d->threadPoolState->mutex);
+        while (d->threadPoolState->inFlight)
+            d->threadPoolState->finished.wait(&d->threadPoolState->mutex);
+    }
+    QCoreApplication::sendPostedEvents(this, QEvent::MetaCall);
+}
+
+/*!
+    \reimp
+
+    Operations that are pending when the object moves to another thread
+    complete before it moves, and their signals are emitted in the old
+    thread; the io_uring instance they were submitted to belongs to that
+    thread.
+*/
+bool QRandomAccessAsyncFile::event(QEvent *event)
+{
+    if (event->type() == QEvent::ThreadChange) {
+        waitForFinished();
+#if QT_CONFIG(io_uring)
+        Q_D(QRandomAccessAsyncFile);
+        d->ring.reset();
+#endif
+    }
+    return QObject::event(event);
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qrandomaccessasyncfile_p.cpp"
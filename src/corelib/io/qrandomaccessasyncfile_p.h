@@ -0,0 +1,70 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QRANDOMACCESSASYNCFILE_P_H
+#define QRANDOMACCESSASYNCFILE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API. It exists purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qbytearray.h>
+#include <QtCore/qfiledevice.h>
+#include <QtCore/qobject.h>
+
+QT_REQUIRE_CONFIG(thread);
+
+QT_BEGIN_NAMESPACE
+
+class QRandomAccessAsyncFilePrivate;
+
+class Q_CORE_EXPORT QRandomAccessAsyncFile : public QObject
+{
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(QRandomAccessAsyncFile)
+
+public:
+    enum class Backend {
+        ThreadPool,
+        IoUring,
+    };
+
+    explicit QRandomAccessAsyncFile(QObject *parent = nullptr);
+    ~QRandomAccessAsyncFile() override;
+
+    bool open(const QString &fileName, QIODeviceBase::OpenMode mode);
+    bool isOpen() const;
+    void close();
+
+    QString errorString() const;
+    qint64 size() const;
+    Backend backend() const;
+    int pendingOperations() const;
+
+    quint64 read(qint64 offset, qint64 maxSize);
+    quint64 write(qint64 offset, const QByteArray &data);
+    void waitForFinished();
+
+Q_SIGNALS:
+    void readyRead(quint64 id, const QByteArray &data);
+    void bytesWritten(quint64 id, qint64 bytes);
+    void errorOccurred(quint64 id, QFileDevice::FileError error);
+
+protected:
+    bool event(QEvent *event) override;
+
+private:
+    Q_DISABLE_COPY_MOVE(QRandomAccessAsyncFile)
+};
+
+QT_END_NAMESPACE
+
+#endif // QRANDOMACCESSASYNCFILE_P_H
@@ -10,8 +10,16 @@
 #include <private/qabstractitemmodel_p.h>
 #include <private/qabstractproxymodel_p.h>
 #include <private/qproperty_p.h>
+#if QT_CONFIG(thread)
+#include <qrunnable.h>
+#include <qsemaphore.h>
+#include <qthreadpool.h>
+#include <qvarlengtharray.h>
+#endif
 
 #include <algorithm>
+#include <memory>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
@@ -76,6 +84,95 @@ private:
     const QSortFilterProxyModel *proxy_model;
 };
 
+#if QT_CONFIG(thread)
+namespace {
+// the number of rows from which filtering and sorting run in parallel
+constexpr int ParallelRowThreshold = 10000;
+
+/*
+    Calls \a function for each of the chunks 0 to \a chunkCount - 1, from
+    the threads of the global thread pool and the current thread, and
+    returns once all calls have returned. The current thread processes the
+    chunks that no thread of the pool has picked up, so that this works
+    even if the pool is busy.
+*/
+template <typename Function>
+void forEachChunkInParallel(int chunkCount, Function function)
+{
+    QThreadPool *pool = QThreadPool::globalInstance();
+    QAtomicInt next = 0;
+    const auto processChunks = [&] {
+        for (int chunk = next.fetchAndAddRelaxed(1); chunk < chunkCount;
+             chunk = next.fetchAndAddRelaxed(1)) {
+            function(chunk);
+        }
+    };
+
+    QSemaphore done;
+    std::vector<std::unique_ptr<QRunnable>> helpers;
+    const int helperCount = qMin(pool->maxThreadCount(), chunkCount) - 1;
+    helpers.reserve(helperCount);
+    for (int i = 0; i < helperCount; ++i) {
+        helpers.emplace_back(QRunnable::create([&] {
+            processChunks();
+            done.release();
+        }));
+        helpers.back()->setAutoDelete(false);
+        pool->start(helpers.back().get());
+    }
+
+    processChunks();
+
+    int running = 0;
+    for (const auto &helper : helpers) {
+        if (!pool->tryTake(helper.get()))
+            ++running;
+    }
+    done.acquire(running);
+}
+
+int parallelChunkCount(qsizetype count)
+{
+    const int threads = QThreadPool::globalInstance()->maxThreadCount();
+    return int(qBound(qsizetype(1), count / (ParallelRowThreshold / 2), qsizetype(4) * threads));
+}
+
+/*
+    Sorts \a rows like std::stable_sort() does, by sorting chunks of the
+    list in parallel and merging them pairwise.
+*/
+template <typename Compare>
+void parallelStableSort(QList<int> &rows, Compare compare)
+{
+    const int chunkCount = parallelChunkCount(rows.size());
+    QVarLengthArray<qsizetype, 64> bounds(chunkCount + 1);
+    for (int i = 0; i <= chunkCount; ++i)
+        bounds[i] = rows.size() * i / chunkCount;
+
+    int *data = rows.data();
+    forEachChunkInParallel(chunkCount, [&](int chunk) {
+        std::stable_sort(data + bounds[chunk], data + bounds[chunk + 1], compare);
+    });
+
+    QList<int> buffer(rows.size(), Qt::Uninitialized);
+    int *out = buffer.data();
+    for (int width = 1; width < chunkCount; width *= 2) {
+        const int mergeCount = (chunkCount + 2 * width - 1) / (2 * width);
+        forEachChunkInParallel(mergeCount, [&](int merge) {
+            const qsizetype begin = bounds[merge * 2 * width];
+            const qsizetype middle = bounds[qMin(merge * 2 * width + width, chunkCount)];
+            const qsizetype end = bounds[qMin(merge * 2 * width + 2 * width, chunkCount)];
+            // taking from the left range first on ties keeps the sort stable
+            std::merge(data + begin, data + middle, data + middle, data + end, out + begin,
+                       compare);
+        });
+        std::swap(data, out);
+    }
+    if (data != rows.data())
+        rows.swap(buffer);
+}
+} // unnamed namespace
+#endif // QT_CONFIG(thread)
 
 //this struct is used to store what are the rows that are removed
 //between a call to rowsAboutToBeRemoved and rowsRemoved
@@ -165,6 +262,15 @@ public:
 
     void setDynamicSortFilterForwarder(bool enable) { q_func()->setDynamicSortFilter(enable); }
 
+    void setParallelSortFilterEnabledForwarder(bool enable)
+    {
+        q_func()->setParallelSortFilterEnabled(enable);
+    }
+    void parallelSortFilterEnabledChangedForwarder(bool enable)
+    {
+        emit q_func()->parallelSortFilterEnabledChanged(enable);
+    }
+
     void setFilterCaseSensitivityForwarder(Qt::CaseSensitivity cs)
     {
         q_func()->setFilterCaseSensitivity(cs);
@@ -222,6 +328,11 @@ public:
                                        &QSortFilterProxyModelPrivate::setDynamicSortFilterForwarder,
                                        true)
 
+    Q_OBJECT_COMPAT_PROPERTY_WITH_ARGS(
+            QSortFilterProxyModelPrivate, bool, parallel_sortfilter,
+            &QSortFilterProxyModelPrivate::setParallelSortFilterEnabledForwarder,
+            &QSortFilterProxyModelPrivate::parallelSortFilterEnabledChangedForwarder, false)
+
     Q_OBJECT_COMPAT_PROPERTY_WITH_ARGS(
             QSortFilterProxyModelPrivate, Qt::CaseSensitivity, filter_casesensitive,
             &QSortFilterProxyModelPrivate::setFilterCaseSensitivityForwarder,
@@ -379,6 +490,10 @@ public:
 
     bool filterAcceptsRowInternal(int source_row, const QModelIndex &source_parent) const;
     bool recursiveChildAcceptsRow(int source_row, const QModelIndex &source_parent) const;
+    bool processInParallel(qsizetype count) const;
+#if QT_CONFIG(thread)
+    QList<bool> filterAcceptsRowsInParallel(int count, const QModelIndex &source_parent) const;
+#endif
     bool recursiveParentAcceptsRow(const QModelIndex &source_parent) const;
 };
 
@@ -414,6 +529,44 @@ bool QSortFilterProxyModelPrivate::filterAcceptsRowInternal(int source_row, cons
     return false;
 }
 
+/*!
+  \internal
+
+  Returns true if \a count rows are to be filtered or sorted in parallel.
+*/
+bool QSortFilterProxyModelPrivate::processInParallel(qsizetype count) const
+{
+#if QT_CONFIG(thread)
+    return count >= ParallelRowThreshold && parallel_sortfilter
+            && QThreadPool::globalInstance()->maxThreadCount() > 1;
+#else
+    Q_UNUSED(count);
+    return false;
+#endif
+}
+
+#if QT_CONFIG(thread)
+/*!
+  \internal
+
+  Returns whether filterAcceptsRowInternal() accepts each of the first
+  \a count rows of \a source_parent, evaluating the rows in parallel.
+*/
+QList<bool> QSortFilterProxyModelPrivate::filterAcceptsRowsInParallel(
+    int count, const QModelIndex &source_parent) const
+{
+    QList<bool> accepted(count);
+    bool *results = accepted.data();
+    const int chunkCount = parallelChunkCount(count);
+    forEachChunkInParallel(chunkCount, [&](int chunk) {
+        const int end = int(qint64(count) * (chunk + 1) / chunkCount);
+        for (int row = int(qint64(count) * chunk / chunkCount); row < end; ++row)
+            results[row] = filterAcceptsRowInternal(row, source_parent);
+    });
+    return accepted;
+}
+#endif
+
 bool QSortFilterProxyModelPrivate::recursiveParentAcceptsRow(const QModelIndex &source_parent) const
 {
     Q_Q(const QSortFilterProxyModel);
@@ -484,9 +637,20 @@ IndexMap::const_iterator QSortFilterProxyModelPrivate::create_mapping(
 
     int source_rows = model->rowCount(source_parent);
     m->source_rows.reserve(source_rows);
-    for (int i = 0; i < source_rows; ++i) {
-        if (filterAcceptsRowInternal(i, source_parent))
-            m->source_rows.append(i);
+#if QT_CONFIG(thread)
+    if (processInParallel(source_rows)) {
+        const QList<bool> accepted = filterAcceptsRowsInParallel(source_rows, source_parent);
+        for (int i = 0; i < source_rows; ++i) {
+            if (accepted.at(i))
+                m->source_rows.append(i);
+        }
+    } else
+#endif
+    {
+        for (int i = 0; i < source_rows; ++i) {
+            if (filterAcceptsRowInternal(i, source_parent))
+                m->source_rows.append(i);
+        }
     }
     int source_cols = model->columnCount(source_parent);
     m->source_columns.reserve(source_cols);
@@ -681,6 +845,18 @@ void QSortFilterProxyModelPrivate::sort_source_rows(
 {
     Q_Q(const QSortFilterProxyModel);
     if (source_sort_column >= 0) {
+#if QT_CONFIG(thread)
+        if (processInParallel(source_rows.size())) {
+            if (sort_order == Qt::AscendingOrder) {
+                QSortFilterProxyModelLessThan lt(source_sort_column, source_parent, model, q);
+                parallelStableSort(source_rows, lt);
+            } else {
+                QSortFilterProxyModelGreaterThan gt(source_sort_column, source_parent, model, q);
+                parallelStableSort(source_rows, gt);
+            }
+            return;
+        }
+#endif
         if (sort_order == Qt::AscendingOrder) {
             QSortFilterProxyModelLessThan lt(source_sort_column, source_parent, model, q);
             std::stable_sort(source_rows.begin(), source_rows.end(), lt);
@@ -1327,25 +1503,33 @@ QSet<int> QSortFilterProxyModelPrivate::handle_filter_changed(
     const QModelIndex &source_parent, Qt::Orientation orient)
 {
     Q_Q(QSortFilterProxyModel);
+    int source_count = source_to_proxy.size();
+    QList<bool> accepted;
+#if QT_CONFIG(thread)
+    if (orient == Qt::Vertical && processInParallel(source_count))
+        accepted = filterAcceptsRowsInParallel(source_count, source_parent);
+#endif
+    const auto acceptsItem = [&](int source_item) {
+        if (!accepted.isEmpty())
+            return accepted.at(source_item);
+        return (orient == Qt::Vertical)
+            ? filterAcceptsRowInternal(source_item, source_parent)
+            : q->filterAcceptsColumn(source_item, source_parent);
+    };
     // Figure out which mapped items to remove
     QList<int> source_items_remove;
     for (int i = 0; i < proxy_to_source.size(); ++i) {
         const int source_item = proxy_to_source.at(i);
-        if ((orient == Qt::Vertical)
-            ? !filterAcceptsRowInternal(source_item, source_parent)
-            : !q->filterAcceptsColumn(source_item, source_parent)) {
+        if (!acceptsItem(source_item)) {
             // This source item does not satisfy the filter, so it must be removed
             source_items_remove.append(source_item);
         }
     }
     // Figure out which non-mapped items to insert
     QList<int> source_items_insert;
-    int source_count = source_to_proxy.size();
     for (int source_item = 0; source_item < source_count; ++source_item) {
         if (source_to_proxy.at(source_item) == -1) {
-            if ((orient == Qt::Vertical)
-                ? filterAcceptsRowInternal(source_item, source_parent)
-                : q->filterAcceptsColumn(source_item, source_parent)) {
+            if (acceptsItem(source_item)) {
                 // This source item satisfies the filter, so it must be added
                 source_items_insert.append(source_item);
             }
@@ -3064,6 +3248,64 @@ QBindable<bool> QSortFilterProxyModel::bindableAutoAcceptChildRows()
     return QBindable<bool>(&d->accept_children);
 }
 
+/*!
+    \since 6.10
+    \property QSortFilterProxyModel::parallelSortFilterEnabled
+    \brief whether the proxy model filters and sorts large models in parallel.
+
+    When this property is \c true, the proxy model distributes the filtering
+    and sorting of the rows of a parent that has at least 10000 rows over
+    the threads of the global QThreadPool. This makes setting a new filter
+    or sorting a large model take a fraction of the time it otherwise takes,
+    on systems with several processor cores. The proxy model waits for the
+    threads to finish, and then updates itself and emits its signals as it
+    does when this property is \c false, for instance layoutChanged() after
+    sorting.
+
+    While the threads run, filterAcceptsRow() and lessThan() are called
+    concurrently from several threads, and with them the index(), data()
+    and rowCount() functions of the source model. Only enable this property
+    if these functions are safe to call concurrently as long as the models
+    are not modified, as the implementations of QSortFilterProxyModel,
+    QStringListModel and QStandardItemModel are. Sorting in parallel keeps
+    the order of the rows that compare equal, like sorting sequentially.
+
+    The default value is false.
+
+    \sa filterAcceptsRow(), lessThan(), QThreadPool::globalInstance()
+*/
+
+/*!
+    \since 6.10
+    \fn void QSortFilterProxyModel::parallelSortFilterEnabledChanged(bool parallelSortFilterEnabled)
+
+    \brief This signal is emitted when the value of the
+    \a parallelSortFilterEnabled property is changed.
+
+    \sa parallelSortFilterEnabled
+*/
+bool QSortFilterProxyModel::isParallelSortFilterEnabled() const
+{
+    Q_D(const QSortFilterProxyModel);
+    return d->parallel_sortfilter;
+}
+
+void QSortFilterProxyModel::setParallelSortFilterEnabled(bool enable)
+{
+    Q_D(QSortFilterProxyModel);
+    d->parallel_sortfilter.removeBindingUnlessInWrapper();
+    if (d->parallel_sortfilter == enable)
+        return;
+    d->parallel_sortfilter.setValueBypassingBindings(enable);
+    d->parallel_sortfilter.notify(); // also emits a signal
+}
+
+QBindable<bool> QSortFilterProxyModel::bindableParallelSortFilterEnabled()
+{
+    Q_D(QSortFilterProxyModel);
+    return QBindable<bool>(&d->parallel_sortfilter);
+}
+
 /*!
    \since 4.3
 
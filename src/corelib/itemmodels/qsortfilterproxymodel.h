@@ -46,6 +46,9 @@ class Q_CORE_EXPORT QSortFilterProxyModel : public QAbstractProxyModel
                BINDABLE bindableRecursiveFilteringEnabled)
     Q_PROPERTY(bool autoAcceptChildRows READ autoAcceptChildRows WRITE setAutoAcceptChildRows
                NOTIFY autoAcceptChildRowsChanged BINDABLE bindableAutoAcceptChildRows)
+    Q_PROPERTY(bool parallelSortFilterEnabled READ isParallelSortFilterEnabled
+               WRITE setParallelSortFilterEnabled NOTIFY parallelSortFilterEnabledChanged
+               BINDABLE bindableParallelSortFilterEnabled)
 
 public:
     explicit QSortFilterProxyModel(QObject *parent = nullptr);
@@ -101,6 +104,10 @@ public:
     void setAutoAcceptChildRows(bool accept);
     QBindable<bool> bindableAutoAcceptChildRows();
 
+    bool isParallelSortFilterEnabled() const;
+    void setParallelSortFilterEnabled(bool enable);
+    QBindable<bool> bindableParallelSortFilterEnabled();
+
 public Q_SLOTS:
     void setFilterRegularExpression(const QString &pattern);
     void setFilterRegularExpression(const QRegularExpression &regularExpression);
@@ -169,6 +176,7 @@ Q_SIGNALS:
     void filterRoleChanged(int filterRole);
     void recursiveFilteringEnabledChanged(bool recursiveFilteringEnabled);
     void autoAcceptChildRowsChanged(bool autoAcceptChildRows);
+    void parallelSortFilterEnabledChanged(bool parallelSortFilterEnabled);
 
 private:
     Q_DECLARE_PRIVATE(QSortFilterProxyModel)
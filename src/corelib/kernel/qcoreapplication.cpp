@@ -351,7 +351,10 @@ Q_CONSTINIT bool QCoreApplicationPrivate::is_app_closing = false;
 
 qsizetype qGlobalPostedEventsCount()
 {
-    const QPostEventList &l = QThreadData::current()->postEventList;
+    QPostEventList &l = QThreadData::current()->postEventList;
+    const auto locker = qt_scoped_lock(l.mutex);
+    // count the events that were posted without the mutex, too
+    l.takePendingEvents();
     return l.size() - l.startOffset;
 }
 
@@ -500,6 +503,7 @@ void QCoreApplicationPrivate::cleanupThreadData()
 
         // need to clear the state of the mainData, just in case a new QCoreApplication comes along.
         const auto locker = qt_scoped_lock(thisThreadData->postEventList.mutex);
+        thisThreadData->postEventList.takePendingEvents();
         for (const QPostEvent &pe : std::as_const(thisThreadData->postEventList)) {
             if (pe.event) {
                 --pe.receiver->d_func()->postedEvents;
@@ -1654,6 +1658,52 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
         return;
     }
 
+    if (event->type() == QEvent::MetaCall) {
+        // Queued slot invocations are never compressed, so they don't need
+        // to look at the list: push them onto the receiver thread's pending
+        // stack without taking the mutex, which the receiving thread would
+        // otherwise hold for most of sendPostedEvents().
+        // Allocate before registering as a producer, so that nothing between
+        // registering and deregistering can block.
+        std::unique_ptr<QEvent> eventDeleter(event);
+        std::unique_ptr<QPostEventList::PendingEvent> pe(
+                new QPostEventList::PendingEvent{QPostEvent(receiver, event, priority), nullptr});
+        // only used by the trace point
+        [[maybe_unused]] const QEvent::Type type = event->type();
+
+        auto &threadData = QObjectPrivate::get(receiver)->threadData;
+        QThreadData *data;
+        for (;;) {
+            // synchronizes with the storeRelease in QObject::moveToThread
+            data = threadData.loadAcquire();
+            if (!data) {
+                // posting during destruction? just delete the event to prevent a leak
+                return;
+            }
+            // moveToThread() and removePostedEvents() wait for this count to
+            // drop before looking at the list; pairs with the fence in
+            // QPostEventList::waitForPendingEvents()
+            data->postEventList.producers.ref();
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (data == threadData.loadRelaxed())
+                break;
+            data->postEventList.releaseProducer();
+        }
+
+        Q_UNUSED(eventDeleter.release());
+        event->m_posted = true;
+        ++receiver->d_func()->postedEvents;
+        data->postEventList.pushPendingEvent(pe.release());
+
+        QAbstractEventDispatcher *dispatcher = data->eventDispatcher.loadAcquire();
+        data->postEventList.releaseProducer();
+        // the receiver's thread may already have deleted the event
+        Q_TRACE(QCoreApplication_postEvent_event_posted, receiver, event, type);
+        if (dispatcher)
+            dispatcher->wakeUp();
+        return;
+    }
+
     auto locker = QCoreApplicationPrivate::lockThreadPostEventList(receiver);
     if (!locker.threadData) {
         // posting during destruction? just delete the event to prevent a leak
@@ -1662,6 +1712,8 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
     }
 
     QThreadData *data = locker.threadData;
+    // keep the order relative to queued calls posted without the mutex
+    data->postEventList.takePendingEvents();
 
     // if this is one of the compressible events, do compression
     if (receiver->d_func()->postedEvents
@@ -1686,6 +1738,62 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
         dispatcher->wakeUp();
 }
 
+/*!
+    \internal
+
+    Posts the QEvent::MetaCall events in \a events, in order, as
+    postEvent() would. All receivers must live in the current thread, which
+    lets the events be pushed onto its posted event list at once, with a
+    single wake-up of its event dispatcher.
+
+    Receivers in other threads are not supported: their events must be
+    posted while the signal slot lock of the receiver is held, or the
+    receiver could be destroyed before the event arrives.
+*/
+void QCoreApplicationPrivate::postMetaCallEvents(QSpan<const QPostEvent> events)
+{
+    if (events.empty())
+        return;
+
+    QThreadData *data = QThreadData::current();
+    using PendingEvent = QPostEventList::PendingEvent;
+    PendingEvent *top = nullptr;
+    PendingEvent *bottom = nullptr;
+    QT_TRY {
+        for (const QPostEvent &pe : events) {
+            Q_ASSERT(pe.event->type() == QEvent::MetaCall);
+            Q_ASSERT(QObjectPrivate::get(pe.receiver)->threadData.loadRelaxed() == data);
+            top = new PendingEvent{pe, top};
+            if (!bottom)
+                bottom = top;
+        }
+    } QT_CATCH (...) {
+        while (top) {
+            std::unique_ptr<PendingEvent> current(top);
+            top = top->next;
+        }
+        for (const QPostEvent &pe : events)
+            delete pe.event;
+        QT_RETHROW;
+    }
+
+    for (const QPostEvent &pe : events) {
+        Q_TRACE(QCoreApplication_postEvent_event_posted, pe.receiver, pe.event, pe.event->type());
+        pe.event->m_posted = true;
+        ++pe.receiver->d_func()->postedEvents;
+    }
+
+    // the receivers cannot move to another thread while we are posting, but
+    // removePostedEvents() may be looking at the list from another thread
+    data->postEventList.producers.ref();
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    data->postEventList.pushPendingEvents(top, bottom);
+    QAbstractEventDispatcher *dispatcher = data->eventDispatcher.loadAcquire();
+    data->postEventList.releaseProducer();
+    if (dispatcher)
+        dispatcher->wakeUp();
+}
+
 /*!
   \internal
   Returns \c true if \a event was compressed away (possibly deleted) and should not be added to the list.
@@ -1772,6 +1880,7 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
     ++data->postEventList.recursion;
 
     auto locker = qt_unique_lock(data->postEventList.mutex);
+    data->postEventList.takePendingEvents();
 
     // by default, we assume that the event dispatcher can go to sleep after
     // processing all events. if any new events are posted while we send
@@ -1953,6 +2062,8 @@ void QCoreApplication::removePostedEvents(QObject *receiver, int eventType)
 {
     auto locker = QCoreApplicationPrivate::lockThreadPostEventList(receiver);
     QThreadData *data = locker.threadData;
+    if (data)
+        data->postEventList.waitForPendingEvents();
 
     // the QObject destructor calls this function directly.  this can
     // happen while the event loop is in the middle of posting events,
@@ -2016,6 +2127,7 @@ void QCoreApplicationPrivate::removePostedEvent(QEvent * event)
     QThreadData *data = QThreadData::current();
 
     const auto locker = qt_scoped_lock(data->postEventList.mutex);
+    data->postEventList.takePendingEvents();
 
     if (data->postEventList.size() == 0) {
 #if defined(QT_DEBUG)
@@ -20,6 +20,7 @@
 #include "QtCore/qcommandlineoption.h"
 #endif
 #include "QtCore/qreadwritelock.h"
+#include "QtCore/qspan.h"
 #include "QtCore/qtranslator.h"
 #if QT_CONFIG(settings)
 #include "QtCore/qsettings.h"
@@ -46,6 +47,7 @@ class QAbstractEventDispatcher;
 
 #ifndef QT_NO_QOBJECT
 class QEvent;
+class QPostEvent;
 #endif
 
 class Q_CORE_EXPORT QCoreApplicationPrivate
@@ -128,6 +130,7 @@ public:
         void unlock() { locker.unlock(); }
     };
     static QPostEventListLocker lockThreadPostEventList(QObject *object);
+    static void postMetaCallEvents(QSpan<const QPostEvent> events);
 #endif // QT_NO_QOBJECT
 
     int &argc;
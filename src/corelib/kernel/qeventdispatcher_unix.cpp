@@ -31,6 +31,10 @@ static constexpr bool UsingEventfd = false;
 #  include <pipeDrv.h>
 #endif
 
+#if QT_CONFIG(epoll)
+#  include <sys/epoll.h>
+#endif
+
 using namespace std::chrono;
 using namespace std::chrono_literals;
 
@@ -176,10 +180,24 @@ QEventDispatcherUNIXPrivate::QEventDispatcherUNIXPrivate()
 {
     if (Q_UNLIKELY(threadPipe.init() == false))
         qFatal("QEventDispatcherUNIXPrivate(): Cannot continue without a thread pipe");
+
+#if QT_CONFIG(epoll)
+    if (qEnvironmentVariableIsEmpty("QT_NO_EPOLL")) {
+        // on failure, epollFd stays -1 and we fall back to rebuilding the
+        // pollfd list on every loop turn
+        epollFd = epoll_create1(EPOLL_CLOEXEC);
+        epollPid = getpid();
+    }
+#endif
 }
 
 QEventDispatcherUNIXPrivate::~QEventDispatcherUNIXPrivate()
 {
+#if QT_CONFIG(epoll)
+    if (epollFd >= 0)
+        qt_safe_close(epollFd);
+#endif
+
     // cleanup timers
     timerList.clearTimers();
 }
@@ -239,6 +257,137 @@ void QEventDispatcherUNIXPrivate::markPendingSocketNotifiers()
     pollfds.clear();
 }
 
+#if QT_CONFIG(epoll)
+// Notifiers are level-triggered: they keep firing until the condition is
+// dealt with, so edge-triggered epoll is not an option. Registrations are
+// one-shot instead and re-armed for each event they report, which keeps them
+// level-triggered while we hear of their descriptor, and quiets those that
+// outlived their descriptor after their first event.
+static epoll_event makeEpollEvent(int fd, quint32 generation, short events)
+{
+    epoll_event ev = {};
+    ev.events = EPOLLONESHOT;
+    ev.data.u64 = quint64(quint32(fd)) | quint64(generation) << 32;
+    if (events & POLLIN)
+        ev.events |= EPOLLIN;
+    if (events & POLLOUT)
+        ev.events |= EPOLLOUT;
+    if (events & POLLPRI)
+        ev.events |= EPOLLPRI;
+    return ev;
+}
+
+void QEventDispatcherUNIXPrivate::updateEpollInterest(int fd, short oldEvents, short newEvents)
+{
+    checkEpollOwner();
+    if (epollFd < 0 || oldEvents == newEvents)
+        return;
+
+    if (epollFallbackFds.contains(fd)) {
+        if (!newEvents)
+            epollFallbackFds.removeOne(fd);
+        return;
+    }
+
+    if (!newEvents) {
+        // This fails if the descriptor was closed before the notifier was
+        // disabled. Usually the kernel has then already forgotten about it;
+        // if not, the registration reports at most one more event, which
+        // collectEpollEvents() drops.
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        epollGenerations.remove(fd);
+        return;
+    }
+
+    const quint32 generation = ++nextEpollGeneration;
+    epoll_event ev = makeEpollEvent(fd, generation, newEvents);
+    int ret = epoll_ctl(epollFd, oldEvents ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, fd, &ev);
+    if (ret == -1 && errno == ENOENT) {
+        // the descriptor was closed and reused behind our back
+        ret = epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev);
+    } else if (ret == -1 && errno == EEXIST) {
+        // the registration of a descriptor that was closed without
+        // disabling its notifiers survived in a duplicate of it
+        ret = epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &ev);
+    }
+
+    // epoll refuses regular files (EPERM) and invalid descriptors (EBADF);
+    // poll() these so that we keep reporting the same conditions as before,
+    // including POLLNVAL
+    if (ret == -1) {
+        epollGenerations.remove(fd);
+        epollFallbackFds.append(fd);
+    } else {
+        epollGenerations.insert(fd, generation);
+    }
+}
+
+// After fork(), the child shares the epoll instance with its parent, so each
+// would change the interest set of the other. The child starts over with an
+// instance of its own.
+void QEventDispatcherUNIXPrivate::checkEpollOwner()
+{
+    if (epollFd < 0 || epollPid == getpid())
+        return;
+
+    qt_safe_close(epollFd);
+    epollFallbackFds.clear();
+    epollGenerations.clear();
+
+    // on failure, we fall back to rebuilding the pollfd list on every turn
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    epollPid = getpid();
+    for (auto it = socketNotifiers.cbegin(); it != socketNotifiers.cend(); ++it)
+        updateEpollInterest(it.key(), 0, it.value().events());
+}
+
+void QEventDispatcherUNIXPrivate::collectEpollEvents(const pollfd &pfd)
+{
+    Q_ASSERT(pfd.fd == epollFd);
+    if (!(pfd.revents & POLLIN))
+        return;
+
+    // anything left over stays in the kernel's ready list for the next turn
+    epoll_event events[256];
+    const int n = epoll_wait(epollFd, events, int(std::size(events)), 0);
+    for (int i = 0; i < n; ++i) {
+        const int fd = int(quint32(events[i].data.u64));
+        const quint32 generation = quint32(events[i].data.u64 >> 32);
+        const auto registration = epollGenerations.constFind(fd);
+        if (registration == epollGenerations.cend() || *registration != generation) {
+            // the registration outlived its descriptor and stays quiet now
+            continue;
+        }
+
+        const short interest = socketNotifiers.value(fd).events();
+        pollfd ready = qt_make_pollfd(fd, interest);
+        epoll_event ev = makeEpollEvent(fd, generation, interest);
+        if (epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &ev) == 0) {
+            ready.revents = short(events[i].events
+                                  & (EPOLLIN | EPOLLOUT | EPOLLPRI | EPOLLERR | EPOLLHUP));
+        } else if (errno == ENOENT) {
+            // The descriptor was closed and reused for another file; the
+            // event was for the old one.
+            epollGenerations.remove(fd);
+            updateEpollInterest(fd, 0, interest);
+            continue;
+        } else if (errno == EBADF) {
+            // The descriptor was closed before its notifiers were disabled,
+            // and a duplicate keeps the file open. Report it like poll() does.
+            epollGenerations.remove(fd);
+            ready.revents = POLLNVAL;
+        } else {
+            // poll() what we cannot re-arm
+            epollGenerations.remove(fd);
+            epollFallbackFds.append(fd);
+            ready.revents = short(events[i].events
+                                  & (EPOLLIN | EPOLLOUT | EPOLLPRI | EPOLLERR | EPOLLHUP));
+        }
+        pollfds.append(ready);
+    }
+}
+#endif // QT_CONFIG(epoll)
+
 int QEventDispatcherUNIXPrivate::activateSocketNotifiers()
 {
     markPendingSocketNotifiers();
@@ -361,7 +510,13 @@ void QEventDispatcherUNIX::registerSocketNotifier(QSocketNotifier *notifier)
         qWarning("%s: Multiple socket notifiers for same socket %d and type %s",
                  Q_FUNC_INFO, sockfd, socketType(type));
 
+#if QT_CONFIG(epoll)
+    const short oldEvents = sn_set.events();
+    sn_set.notifiers[type] = notifier;
+    d->updateEpollInterest(sockfd, oldEvents, sn_set.events());
+#else
     sn_set.notifiers[type] = notifier;
+#endif
 }
 
 void QEventDispatcherUNIX::unregisterSocketNotifier(QSocketNotifier *notifier)
@@ -400,7 +555,13 @@ void QEventDispatcherUNIX::unregisterSocketNotifier(QSocketNotifier *notifier)
         return;
     }
 
+#if QT_CONFIG(epoll)
+    const short oldEvents = sn_set.events();
+    sn_set.notifiers[type] = nullptr;
+    d->updateEpollInterest(sockfd, oldEvents, sn_set.events());
+#else
     sn_set.notifiers[type] = nullptr;
+#endif
 
     if (sn_set.isEmpty())
         d->socketNotifiers.erase(i);
@@ -446,11 +607,26 @@ bool QEventDispatcherUNIX::processEvents(QEventLoop::ProcessEventsFlags flags)
     }
 
     d->pollfds.clear();
-    d->pollfds.reserve(1 + (include_notifiers ? d->socketNotifiers.size() : 0));
-
+#if QT_CONFIG(epoll)
     if (include_notifiers)
-        for (auto it = d->socketNotifiers.cbegin(); it != d->socketNotifiers.cend(); ++it)
-            d->pollfds.append(qt_make_pollfd(it.key(), it.value().events()));
+        d->checkEpollOwner();
+    const bool use_epoll = include_notifiers && d->epollFd >= 0;
+    if (use_epoll) {
+        d->pollfds.reserve(2 + d->epollFallbackFds.size());
+        for (int fd : std::as_const(d->epollFallbackFds))
+            d->pollfds.append(qt_make_pollfd(fd, d->socketNotifiers.value(fd).events()));
+
+        // This must be second to last, as it's popped off the end below
+        d->pollfds.append(qt_make_pollfd(d->epollFd, POLLIN));
+    } else
+#endif
+    {
+        d->pollfds.reserve(1 + (include_notifiers ? d->socketNotifiers.size() : 0));
+
+        if (include_notifiers)
+            for (auto it = d->socketNotifiers.cbegin(); it != d->socketNotifiers.cend(); ++it)
+                d->pollfds.append(qt_make_pollfd(it.key(), it.value().events()));
+    }
 
     // This must be last, as it's popped off the end below
     d->pollfds.append(d->threadPipe.prepare());
@@ -466,6 +642,10 @@ bool QEventDispatcherUNIX::processEvents(QEventLoop::ProcessEventsFlags flags)
         break;
     default:
         nevents += d->threadPipe.check(d->pollfds.takeLast());
+#if QT_CONFIG(epoll)
+        if (use_epoll)
+            d->collectEpollEvents(d->pollfds.takeLast());
+#endif
         if (include_notifiers)
             nevents += d->activateSocketNotifiers();
         break;
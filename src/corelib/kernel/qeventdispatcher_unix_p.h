@@ -103,9 +103,29 @@ public:
     int activateSocketNotifiers();
     void setSocketNotifierPending(QSocketNotifier *notifier);
 
+#if QT_CONFIG(epoll)
+    void updateEpollInterest(int fd, short oldEvents, short newEvents);
+    void collectEpollEvents(const pollfd &pfd);
+    void checkEpollOwner();
+#endif
+
     QThreadPipe threadPipe;
     QList<pollfd> pollfds;
 
+#if QT_CONFIG(epoll)
+    // The kernel keeps the interest set, so a loop turn only polls the epoll
+    // descriptor itself plus the (usually empty) list of descriptors that
+    // epoll refused, e.g. regular files.
+    int epollFd = -1;
+    pid_t epollPid = 0;
+    QList<int> epollFallbackFds;
+    // The registration of each descriptor carries a generation, so that
+    // events from registrations that outlived their descriptor (because it
+    // was closed while a duplicate kept the file open) can be told apart.
+    QHash<int, quint32> epollGenerations;
+    quint32 nextEpollGeneration = 0;
+#endif
+
     QHash<int, QSocketNotifierSetUNIX> socketNotifiers;
     QList<QSocketNotifier *> pendingNotifiers;
 
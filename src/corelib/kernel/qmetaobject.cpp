@@ -1661,7 +1661,7 @@ bool QMetaObject::invokeMethodImpl(QObject *object, QtPrivate::QSlotObjectBase *
 
         for (int i = 1; i < parameterCount; ++i) {
             types[i] = QMetaType(metaTypes[i]);
-            args[i] = types[i].create(argv[i]);
+            args[i] = event->copyArgument(types[i], argv[i]);
         }
 
         QCoreApplication::postEvent(object, event.release());
@@ -2819,7 +2819,7 @@ auto QMetaMethodInvoker::invokeImpl(QMetaMethod self, void *target,
 
         // now create copies of our parameters using those meta types
         for (int i = 1; i < paramCount; ++i)
-            args[i] = types[i].create(parameters[i]);
+            args[i] = event->copyArgument(types[i], parameters[i]);
 
         QCoreApplication::postEvent(object, event.release());
     } else { // blocking queued connection
@@ -161,6 +161,12 @@ inline bool isDestructible(const QtPrivate::QMetaTypeInterface *iface) noexcept
            checkMetaTypeFlagOrPointer(iface, iface->dtor, QMetaType::NeedsDestruction);
 }
 
+inline bool isTriviallyCopyable(const QtPrivate::QMetaTypeInterface *iface) noexcept
+{
+    // such types can be copied with memcpy() and need not be destroyed
+    return !iface->copyCtr && !iface->dtor && isCopyConstructible(iface) && isDestructible(iface);
+}
+
 inline void defaultConstruct(const QtPrivate::QMetaTypeInterface *iface, void *where)
 {
     Q_ASSERT(isDefaultConstructible(iface));
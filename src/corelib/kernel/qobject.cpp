@@ -7,6 +7,7 @@
 #include "qobject_p.h"
 #include "qobject_p_p.h"
 #include "qmetaobject_p.h"
+#include "qmetatype_p.h"
 
 #include "qabstracteventdispatcher.h"
 #include "qabstracteventdispatcher_p.h"
@@ -22,6 +23,7 @@
 #include <qthread.h>
 #include <private/qthread_p.h>
 #include <qdebug.h>
+#include <qpointer.h>
 #include <qvarlengtharray.h>
 #include <qscopeguard.h>
 #include <qset.h>
@@ -73,6 +75,11 @@ QAbstractDynamicMetaObject::~QAbstractDynamicMetaObject()
 {
 }
 
+static bool isBatchedConnection(int type)
+{
+    return type & (Qt::BatchedQueuedConnection | Qt::CoalescedQueuedConnection);
+}
+
 static int *queuedConnectionTypes(const QMetaMethod &method)
 {
     const auto parameterCount = method.parameterCount();
@@ -497,6 +504,12 @@ inline void QMetaCallEvent::allocArgs()
     d.args_ = static_cast<void **>(memory);
 }
 
+inline bool QMetaCallEvent::isStoredInEvent(const void *argument) const
+{
+    const auto p = quintptr(argument);
+    return p - quintptr(argumentStorage_) < sizeof(argumentStorage_);
+}
+
 /*!
     \internal
 
@@ -604,7 +617,7 @@ QMetaCallEvent::~QMetaCallEvent()
     if (d.nargs_) {
         QMetaType *t = types();
         for (int i = 0; i < d.nargs_; ++i) {
-            if (t[i].isValid() && d.args_[i])
+            if (t[i].isValid() && d.args_[i] && !isStoredInEvent(d.args_[i]))
                 t[i].destroy(d.args_[i]);
         }
         if (reinterpret_cast<void *>(d.args_) != reinterpret_cast<void *>(prealloc_))
@@ -612,6 +625,31 @@ QMetaCallEvent::~QMetaCallEvent()
     }
 }
 
+/*!
+    \internal
+
+    Returns a copy of \a copy, which is a value of type \a type, or a
+    default-constructed value if \a copy is null, for use as an argument of
+    the call. The event owns the value. Small trivially copyable values are
+    stored in the event itself, so that no memory is allocated for them.
+ */
+void *QMetaCallEvent::copyArgument(QMetaType type, const void *copy)
+{
+    const QtPrivate::QMetaTypeInterface *iface = type.iface();
+    if (copy && iface && iface->size && size_t(iface->alignment) <= alignof(double)
+            && QtMetaTypePrivate::isTriviallyCopyable(iface)) {
+        const size_t offset = (argumentStorageUsed_ + iface->alignment - 1)
+                & ~size_t(iface->alignment - 1);
+        if (offset + iface->size <= sizeof(argumentStorage_)) {
+            void *where = argumentStorage_ + offset;
+            memcpy(where, copy, iface->size);
+            argumentStorageUsed_ = ushort(offset + iface->size);
+            return where;
+        }
+    }
+    return type.create(copy);
+}
+
 /*!
     \internal
  */
@@ -639,7 +677,7 @@ QMetaCallEvent* QMetaCallEvent::create_impl(QtPrivate::SlotObjUniquePtr slotObj,
     QMetaType *types = metaCallEvent->types();
     for (size_t i = 0; i < argc; ++i) {
         types[i] = metaTypes[i];
-        args[i] = types[i].create(argp[i]);
+        args[i] = metaCallEvent->copyArgument(types[i], argp[i]);
         Q_CHECK_PTR(!i || args[i]);
     }
 
@@ -1738,6 +1776,17 @@ void QObjectPrivate::setThreadData_helper(QThreadData *currentData, QThreadData
         this->bindingStorage.bindingStatus = status;
     }
 
+    // set new thread data
+    targetData->ref();
+    threadData.loadRelaxed()->deref();
+
+    // synchronizes with loadAcquire e.g. in QCoreApplication::postEvent
+    threadData.storeRelease(targetData);
+
+    // queued calls posted without the mutex may still be on their way to
+    // currentData; collect them before moving this object's events
+    currentData->postEventList.waitForPendingEvents();
+
     // move posted events
     int eventsMoved = 0;
     for (int i = 0; i < currentData->postEventList.size(); ++i) {
@@ -1783,13 +1832,6 @@ void QObjectPrivate::setThreadData_helper(QThreadData *currentData, QThreadData
 
     }
 
-    // set new thread data
-    targetData->ref();
-    threadData.loadRelaxed()->deref();
-
-    // synchronizes with loadAcquire e.g. in QCoreApplication::postEvent
-    threadData.storeRelease(targetData);
-
     for (int i = 0; i < children.size(); ++i) {
         QObject *child = children.at(i);
         child->d_func()->setThreadData_helper(currentData, targetData, status);
@@ -3063,7 +3105,7 @@ QMetaObject::Connection QObject::connect(const QObject *sender, const char *sign
     // ### Future work: attempt get the metatypes from the meta object first
     // because it's possible they're all registered.
     int *types = nullptr;
-    if ((type == Qt::QueuedConnection)
+    if ((type == Qt::QueuedConnection || isBatchedConnection(type))
             && !(types = queuedConnectionTypes(signalTypes.constData(), signalTypes.size()))) {
         return QMetaObject::Connection(nullptr);
     }
@@ -3146,7 +3188,8 @@ QMetaObject::Connection QObject::connect(const QObject *sender, const QMetaMetho
     }
 
     int *types = nullptr;
-    if ((type == Qt::QueuedConnection) && !(types = queuedConnectionTypes(signal)))
+    if ((type == Qt::QueuedConnection || isBatchedConnection(type))
+            && !(types = queuedConnectionTypes(signal)))
         return QMetaObject::Connection(nullptr);
 
 #ifndef QT_NO_DEBUG
@@ -3621,6 +3664,11 @@ QObjectPrivate::Connection *QMetaObjectPrivate::connect(const QObject *sender,
     const bool isSingleShot = type & Qt::SingleShotConnection;
     type &= ~Qt::SingleShotConnection;
 
+    const bool isCoalesced = type & Qt::CoalescedQueuedConnection;
+    const bool isBatched = isCoalesced || (type & Qt::BatchedQueuedConnection);
+    if (isBatched)
+        type = Qt::QueuedConnection;
+
     Q_ASSERT(type >= 0);
     Q_ASSERT(type <= 3);
 
@@ -3638,6 +3686,8 @@ QObjectPrivate::Connection *QMetaObjectPrivate::connect(const QObject *sender,
     c->argumentTypes.storeRelaxed(types);
     c->callFunction = callFunction;
     c->isSingleShot = isSingleShot;
+    c->isBatched = isBatched;
+    c->isCoalesced = isCoalesced;
 
     QObjectPrivate::get(s)->addConnection(signal_index, c.get());
 
@@ -3932,12 +3982,104 @@ private:
     QtPrivate::SlotObjUniquePtr m_slotObject;
 };
 
+/*
+    The event that a batched queued connection posts to its receiver. The
+    emissions that happen until it is delivered are added to it, and the
+    slot is then called once for each of them, or only for the last one if
+    the connection is coalesced.
+*/
+class QBatchedMetaCallEvent : public QAbstractMetaCallEvent
+{
+public:
+    QBatchedMetaCallEvent(QObjectPrivate::Connection *c, QObject *receiver, QMetaCallEvent *first)
+        : QAbstractMetaCallEvent(first->sender(), first->signalId()),
+          connection(c), receiver(receiver)
+    {
+        connection->ref();
+        connection->pendingBatch = this;
+        calls.append(first);
+    }
+    ~QBatchedMetaCallEvent() override
+    {
+        detach();
+        qDeleteAll(calls);
+        connection->deref();
+    }
+
+    // Must be called with the receiver's signalSlotLock() locked. Returns the
+    // call that \a ev replaces, which the caller deletes after unlocking.
+    QMetaCallEvent *add(QMetaCallEvent *ev)
+    {
+        if (connection->isCoalesced) {
+            std::swap(calls.last(), ev);
+            return ev;
+        }
+        calls.append(ev);
+        return nullptr;
+    }
+
+    void placeMetaCall(QObject *object) override
+    {
+        // emissions from now on go to a new event
+        detach();
+        QPointer<QObject> guard(object);
+        for (QMetaCallEvent *ev : std::as_const(calls)) {
+            ev->placeMetaCall(object);
+            if (!guard)
+                break;
+        }
+    }
+
+private:
+    void detach()
+    {
+        QMutexLocker locker(signalSlotLock(receiver));
+        if (connection->pendingBatch == this)
+            connection->pendingBatch = nullptr;
+    }
+
+    QObjectPrivate::Connection *connection;
+    QObject *receiver;
+    QVarLengthArray<QMetaCallEvent *, 1> calls;
+};
+
+namespace {
+/*
+    Collects the queued calls of a signal emission to receivers that live in
+    the emitting thread, so that they can be posted at once. The calls must
+    be posted before any slot is invoked directly, so that they stay ahead
+    of the events such a slot posts.
+*/
+struct QueuedCallBatch
+{
+    Q_DISABLE_COPY_MOVE(QueuedCallBatch)
+    QueuedCallBatch() = default;
+    ~QueuedCallBatch() { post(); }
+
+    void append(QObject *receiver, QEvent *event)
+    { events.emplace_back(receiver, event, Qt::NormalEventPriority); }
+
+    void post()
+    {
+        if (events.isEmpty())
+            return;
+        QCoreApplicationPrivate::postMetaCallEvents(events);
+        events.clear();
+    }
+
+private:
+    QVarLengthArray<QPostEvent, 16> events;
+};
+} // unnamed namespace
+
 /*!
     \internal
 
     \a signal must be in the signal index range (see QObjectPrivate::signalIndex()).
+    If \a batch is not null, the event is added to it instead of being posted.
 */
-static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connection *c, void **argv)
+static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connection *c,
+                            void **argv, QueuedCallBatch *batch = nullptr)
 {
     const int *argumentTypes = c->argumentTypes.loadRelaxed();
     if (!argumentTypes) {
@@ -3982,7 +4124,7 @@ static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connect
             types[n] = QMetaType(argumentTypes[n - 1]);
 
         for (int n = 1; n < nargs; ++n)
-            args[n] = types[n].create(argv[n]);
+            args[n] = ev->copyArgument(types[n], argv[n]);
     }
 
     if (c->isSingleShot && !QObjectPrivate::removeConnection(c)) {
@@ -3998,7 +4140,21 @@ static void queued_activate(QObject *sender, int signal, QObjectPrivate::Connect
         return;
     }
 
-    QCoreApplication::postEvent(receiver, ev);
+    QEvent *posted = ev;
+    if (c->isBatched) {
+        if (QBatchedMetaCallEvent *pending = c->pendingBatch) {
+            QMetaCallEvent *replaced = pending->add(ev);
+            locker.unlock();
+            delete replaced;
+            return;
+        }
+        posted = new QBatchedMetaCallEvent(c, receiver, ev);
+    }
+
+    if (batch)
+        batch->append(receiver, posted);
+    else
+        QCoreApplication::postEvent(receiver, posted);
 }
 
 template <bool callbacks_enabled>
@@ -4054,6 +4210,7 @@ void doActivate(QObject *sender, int signal_index, void **argv)
     // We need to check against the highest connection id to ensure that signals added
     // during the signal emission are not emitted in this emission.
     uint highestConnectionId = connections->currentConnectionId.loadRelaxed();
+    QueuedCallBatch queuedCalls;
     do {
         QObjectPrivate::Connection *c = list->first.loadRelaxed();
         if (!c)
@@ -4082,10 +4239,14 @@ void doActivate(QObject *sender, int signal_index, void **argv)
             // put into the event queue
             if ((c->connectionType == Qt::AutoConnection && !receiverInSameThread)
                 || (c->connectionType == Qt::QueuedConnection)) {
-                queued_activate(sender, signal_index, c, argv);
+                queued_activate(sender, signal_index, c, argv,
+                                receiverInSameThread ? &queuedCalls : nullptr);
                 continue;
+            }
+
+            queuedCalls.post();
 #if QT_CONFIG(thread)
-            } else if (c->connectionType == Qt::BlockingQueuedConnection) {
+            if (c->connectionType == Qt::BlockingQueuedConnection) {
                 if (receiverInSameThread) {
                     qWarning("Qt: Dead lock detected while activating a BlockingQueuedConnection: "
                     "Sender is %s(%p), receiver is %s(%p)",
@@ -4109,8 +4270,8 @@ void doActivate(QObject *sender, int signal_index, void **argv)
                 }
                 semaphore.acquire();
                 continue;
-#endif
             }
+#endif
 
             if (c->isSingleShot && !QObjectPrivate::removeConnection(c))
                 continue;
@@ -4162,6 +4323,8 @@ void doActivate(QObject *sender, int signal_index, void **argv)
         //start over for all signals;
         ((list = &signalVector->at(-1)), true));
 
+        queuedCalls.post();
+
         if (connections->currentConnectionId.loadRelaxed() == 0)
             senderDeleted = true;
     }
@@ -5293,6 +5456,11 @@ QMetaObject::Connection QObjectPrivate::connectImpl(const QObject *sender, int s
     const bool isSingleShot = type & Qt::SingleShotConnection;
     type &= ~Qt::SingleShotConnection;
 
+    const bool isCoalesced = type & Qt::CoalescedQueuedConnection;
+    const bool isBatched = isCoalesced || (type & Qt::BatchedQueuedConnection);
+    if (isBatched)
+        type = Qt::QueuedConnection;
+
     Q_ASSERT(type >= 0);
     Q_ASSERT(type <= 3);
 
@@ -5311,6 +5479,8 @@ QMetaObject::Connection QObjectPrivate::connectImpl(const QObject *sender, int s
         c->ownArgumentTypes = false;
     }
     c->isSingleShot = isSingleShot;
+    c->isBatched = isBatched;
+    c->isCoalesced = isCoalesced;
 
     QObjectPrivate::get(s)->addConnection(signal_index, c.get());
     QMetaObject::Connection ret(c.release());
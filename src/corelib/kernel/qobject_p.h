@@ -419,6 +419,8 @@ public:
     inline const QMetaType *types() const { return reinterpret_cast<QMetaType *>(d.args_ + d.nargs_); }
     inline QMetaType *types() { return reinterpret_cast<QMetaType *>(d.args_ + d.nargs_); }
 
+    void *copyArgument(QMetaType type, const void *copy);
+
     virtual void placeMetaCall(QObject *object) override;
 
 private:
@@ -435,6 +437,7 @@ private:
                                        int signal_index, size_t argc, const void * const argp[],
                                        const QMetaType metaTypes[]);
     inline void allocArgs();
+    inline bool isStoredInEvent(const void *argument) const;
 
     struct Data {
         QtPrivate::SlotObjUniquePtr slotObj_;
@@ -446,6 +449,9 @@ private:
     } d;
     // preallocate enough space for three arguments
     alignas(void *) char prealloc_[3 * sizeof(void *) + 3 * sizeof(QMetaType)];
+    // storage for small trivially copyable arguments, see copyArgument()
+    alignas(double) char argumentStorage_[4 * sizeof(void *)];
+    ushort argumentStorageUsed_ = 0;
 };
 
 class QBoolBlocker
@@ -25,6 +25,8 @@
 
 QT_BEGIN_NAMESPACE
 
+class QBatchedMetaCallEvent;
+
 // ConnectionList is a singly-linked list
 struct QObjectPrivate::ConnectionList
 {
@@ -82,6 +84,9 @@ struct QObjectPrivate::Connection : public ConnectionOrSignalVector
         QtPrivate::QSlotObjectBase *slotObj;
     };
     QAtomicPointer<const int> argumentTypes;
+    // the posted event that collects the emissions of a batched connection,
+    // protected by the receiver's signalSlotLock()
+    QBatchedMetaCallEvent *pendingBatch = nullptr;
     QAtomicInt ref_{
         2
     }; // ref_ is 2 for the use in the internal lists, and for the use in QMetaObject::Connection
@@ -93,7 +98,9 @@ struct QObjectPrivate::Connection : public ConnectionOrSignalVector
     ushort isSlotObject : 1;
     ushort ownArgumentTypes : 1;
     ushort isSingleShot : 1;
-    Connection() : ownArgumentTypes(true) { }
+    ushort isBatched : 1; // batched or coalesced queued connection
+    ushort isCoalesced : 1;
+    Connection() : ownArgumentTypes(true), isBatched(false), isCoalesced(false) { }
     ~Connection();
     int method() const
     {
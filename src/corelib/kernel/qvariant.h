@@ -96,7 +96,8 @@ public:
 
     struct Private
     {
-        static constexpr size_t MaxInternalSize = 3 * sizeof(void *);
+        // ### Qt 7: store trivially copyable types of up to 32 bytes internally
+        static constexpr size_t MaxInternalSize = QT6_ONLY(3) QT7_ONLY(4) * sizeof(void *);
         template <size_t S> static constexpr bool FitsInInternalSize = S <= MaxInternalSize;
         template<typename T> static constexpr bool CanUseInternalSpace =
                 (QTypeInfo<T>::isRelocatable && FitsInInternalSize<sizeof(T)> && alignof(T) <= alignof(double));
@@ -11,6 +11,7 @@
 #include "private/qstringconverter_p.h"
 #include "private/qcborvalue_p.h"
 #include "private/qnumeric_p.h"
+#include <private/qsimd_p.h>
 #include <private/qtools_p.h>
 
 static const int nestingLimit = 1024;
@@ -239,18 +240,53 @@ void Parser::eatBOM()
         json += 3;
 }
 
-bool Parser::eatSpace()
+static inline bool isJsonSpace(char c) noexcept
 {
-    while (json < end) {
-        if (*json > Space)
-            break;
-        if (*json != Space &&
-            *json != Tab &&
-            *json != LineFeed &&
-            *json != Return)
-            break;
-        ++json;
+    return c == Space || c == Tab || c == LineFeed || c == Return;
+}
+
+// Returns the first byte in [json, end) that is not whitespace
+static inline const char *skipJsonSpace(const char *json, const char *end) noexcept
+{
+#if defined(__SSE2__)
+    const __m128i space = _mm_set1_epi8(Space);
+    const __m128i tab = _mm_set1_epi8(Tab);
+    const __m128i lineFeed = _mm_set1_epi8(LineFeed);
+    const __m128i carriageReturn = _mm_set1_epi8(Return);
+    for ( ; end - json >= 16; json += 16) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(json));
+        __m128i ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(data, space),
+                                               _mm_cmpeq_epi8(data, tab)),
+                                  _mm_or_si128(_mm_cmpeq_epi8(data, lineFeed),
+                                               _mm_cmpeq_epi8(data, carriageReturn)));
+        uint n = ~_mm_movemask_epi8(ws) & 0xffff;
+        if (n)
+            return json + qCountTrailingZeroBits(n);
+    }
+#elif defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64)
+    const uint8x16_t space = vdupq_n_u8(Space);
+    const uint8x16_t tab = vdupq_n_u8(Tab);
+    const uint8x16_t lineFeed = vdupq_n_u8(LineFeed);
+    const uint8x16_t carriageReturn = vdupq_n_u8(Return);
+    for ( ; end - json >= 16; json += 16) {
+        uint8x16_t data = vld1q_u8(reinterpret_cast<const uchar *>(json));
+        uint8x16_t ws = vorrq_u8(vorrq_u8(vceqq_u8(data, space), vceqq_u8(data, tab)),
+                                 vorrq_u8(vceqq_u8(data, lineFeed), vceqq_u8(data, carriageReturn)));
+        if (vminvq_u8(ws) == 0)
+            break;      // the scalar loop below finds the exact position
     }
+#endif
+    while (json < end && isJsonSpace(*json))
+        ++json;
+    return json;
+}
+
+bool Parser::eatSpace()
+{
+    // Compact documents have no whitespace between tokens, so check the
+    // first byte before going wide for the indentation of pretty-printed ones.
+    if (json < end && isJsonSpace(*json))
+        json = skipJsonSpace(json + 1, end);
     return (json < end);
 }
 
@@ -791,6 +827,51 @@ static inline bool scanUtf8Char(const char *&json, const char *end, char32_t *re
     return true;
 }
 
+// Returns the first byte in [json, end) that the string scanner cannot
+// copy verbatim: a quote, a backslash or the start of a non-ASCII sequence.
+static inline const char *findStringSpecial(const char *json, const char *end) noexcept
+{
+#if defined(__SSE2__)
+#  ifdef __AVX2__
+    const __m256i quote32 = _mm256_set1_epi8('"');
+    const __m256i backslash32 = _mm256_set1_epi8('\\');
+    for ( ; end - json >= 32; json += 32) {
+        __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(json));
+        __m256i special = _mm256_or_si256(_mm256_cmpeq_epi8(data, quote32),
+                                          _mm256_cmpeq_epi8(data, backslash32));
+        // non-ASCII bytes already have their high bit set
+        uint n = _mm256_movemask_epi8(_mm256_or_si256(special, data));
+        if (n)
+            return json + qCountTrailingZeroBits(n);
+    }
+#  endif
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    for ( ; end - json >= 16; json += 16) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(json));
+        __m128i special = _mm_or_si128(_mm_cmpeq_epi8(data, quote),
+                                       _mm_cmpeq_epi8(data, backslash));
+        uint n = _mm_movemask_epi8(_mm_or_si128(special, data));
+        if (n)
+            return json + qCountTrailingZeroBits(n);
+    }
+#elif defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64)
+    const uint8x16_t quote = vdupq_n_u8('"');
+    const uint8x16_t backslash = vdupq_n_u8('\\');
+    const uint8x16_t nonAscii = vdupq_n_u8(0x80);
+    for ( ; end - json >= 16; json += 16) {
+        uint8x16_t data = vld1q_u8(reinterpret_cast<const uchar *>(json));
+        uint8x16_t special = vorrq_u8(vorrq_u8(vceqq_u8(data, quote), vceqq_u8(data, backslash)),
+                                      vcgeq_u8(data, nonAscii));
+        if (vmaxvq_u8(special))
+            break;      // the scalar loop below finds the exact position
+    }
+#endif
+    while (json < end && *json != '"' && *json != '\\' && uchar(*json) < 0x80)
+        ++json;
+    return json;
+}
+
 bool Parser::parseString()
 {
     const char *start = json;
@@ -801,6 +882,10 @@ bool Parser::parseString()
     bool isAscii = true;
     while (json < end) {
         char32_t ch = 0;
+        // plain ASCII needs no further checks
+        json = findStringSpecial(json, end);
+        if (json >= end)
+            break;
         if (*json == '"')
             break;
         if (*json == '\\') {
@@ -838,6 +923,11 @@ bool Parser::parseString()
     QString ucs4;
     while (json < end) {
         char32_t ch = 0;
+        if (const char *special = findStringSpecial(json, end); special != json) {
+            ucs4.append(QLatin1StringView(json, special - json));
+            json = special;
+            continue;
+        }
         if (*json == '"')
             break;
         else if (*json == '\\') {
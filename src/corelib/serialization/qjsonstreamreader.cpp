@@ -0,0 +1,1013 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qjsonstreamreader.h"
+
+#include <qcoreapplication.h>
+#include <qiodevice.h>
+#include <qvarlengtharray.h>
+
+#include <private/qnumeric_p.h>
+#include <private/qstringconverter_p.h>
+#include <private/qtools_p.h>
+
+#include <string.h>
+
+QT_BEGIN_NAMESPACE
+
+using namespace QtMiscUtils;
+
+// same limit as QJsonDocument::fromJson()
+static constexpr int nestingLimit = 1024;
+static constexpr qsizetype ReadChunkSize = 16 * 1024;
+
+class QJsonStreamReaderPrivate
+{
+public:
+    enum State : quint8 {
+        ExpectValue,            // at the top level, before a value
+        ExpectFirstElement,     // after '['
+        ExpectFirstMember,      // after '{'
+        ExpectSeparator         // after a complete value
+    };
+    enum class Result {
+        Ok,
+        End,
+        Incomplete,
+        Failed
+    };
+
+    void reset();
+    void compact();
+    bool readMore();
+    bool ensure(qsizetype n)
+    {
+        while (buffer.size() - cur < n) {
+            if (!readMore())
+                return false;
+        }
+        return true;
+    }
+    // Whether the input can still grow. Sequential devices report the end
+    // of their data by returning -1 from read(), like a closed socket does.
+    bool isFinal() const
+    {
+        if (inputFinished)
+            return true;
+        if (device)
+            return device->isSequential() ? !device->isReadable() : device->atEnd();
+        return !streaming;
+    }
+
+    QJsonStreamReader::TokenType readNext();
+    bool continueSkip();
+
+    Result parseNext();
+    Result parseMember();
+    Result parseValue();
+    Result closeContainer();
+    Result scanString(qsizetype *begin, qsizetype *end, bool *escaped);
+    Result scanLiteral(QByteArrayView literal, QJsonStreamReader::TokenType literalType);
+    Result scanNumber();
+    Result checkDelimiter(QJsonParseError::ParseError error);
+    bool skipWhitespace();
+    Result fail(QJsonParseError::ParseError error);
+
+    QString decode(qsizetype begin, qsizetype end, bool escaped) const;
+
+    QIODevice *device = nullptr;
+
+    // Only the bytes from 'start' onwards are needed: they belong to the
+    // current token, or to the one being parsed. Everything before is
+    // dropped the next time we need to read more data, so memory use is
+    // bounded by the largest token rather than by the size of the input.
+    QByteArray buffer;
+    qint64 bufferOffset = 0;
+    qsizetype start = 0;
+    qsizetype cur = 0;
+    // set by addData(): more input may follow what is in the buffer
+    bool streaming = false;
+    // set by finishInput(), or once the device reported the end of its data
+    bool inputFinished = false;
+
+    QVarLengthArray<char, 32> containers;
+    State state = ExpectValue;
+    bool atEnd = false;
+
+    QJsonStreamReader::TokenType type = QJsonStreamReader::NoToken;
+    qsizetype tokenBegin = 0;
+    qsizetype tokenEnd = 0;
+    qsizetype nameBegin = -1;
+    qsizetype nameEnd = -1;
+    bool tokenEscaped = false;
+    bool nameEscaped = false;
+
+    // progress of an interrupted skipCurrentElement()
+    int skipDepth = 0;
+    bool skipInString = false;
+    bool skipEscape = false;
+
+    QJsonStreamReader::Error error = QJsonStreamReader::NoError;
+    QJsonParseError::ParseError parseError = QJsonParseError::NoError;
+    qint64 errorOffset = -1;
+};
+
+void QJsonStreamReaderPrivate::reset()
+{
+    QIODevice *dev = device;
+    *this = QJsonStreamReaderPrivate();
+    device = dev;
+}
+
+void QJsonStreamReaderPrivate::compact()
+{
+    if (start == 0)
+        return;
+    buffer.remove(0, start);
+    bufferOffset += start;
+    cur -= start;
+    tokenBegin -= start;
+    tokenEnd -= start;
+    if (nameBegin >= 0) {
+        nameBegin -= start;
+        nameEnd -= start;
+    }
+    start = 0;
+}
+
+bool QJsonStreamReaderPrivate::readMore()
+{
+    if (!device)
+        return false;
+    compact();
+    const qsizetype oldSize = buffer.size();
+    buffer.resize(oldSize + ReadChunkSize);
+    const qint64 bytesRead = device->read(buffer.data() + oldSize, ReadChunkSize);
+    buffer.resize(oldSize + qMax(bytesRead, qint64(0)));
+    if (bytesRead < 0)
+        inputFinished = true;
+    return bytesRead > 0;
+}
+
+QJsonStreamReaderPrivate::Result QJsonStreamReaderPrivate::fail(QJsonParseError::ParseError e)
+{
+    error = QJsonStreamReader::NotWellFormedError;
+    parseError = e;
+    errorOffset = bufferOffset + cur;
+    return Result::Failed;
+}
+
+bool QJsonStreamReaderPrivate::skipWhitespace()
+{
+    forever {
+        const char *data = buffer.constData();
+        const qsizetype size = buffer.size();
+        for ( ; cur < size; ++cur) {
+            const char c = data[cur];
+            if (c != ' ' && c != '\t' && c != '\n' && c != '\r')
+                return true;
+        }
+        if (!readMore())
+            return false;
+    }
+}
+
+QJsonStreamReader::TokenType QJsonStreamReaderPrivate::readNext()
+{
+    start = cur;
+    nameBegin = nameEnd = -1;
+    tokenBegin = tokenEnd = cur;
+    tokenEscaped = nameEscaped = false;
+
+    const State oldState = state;
+    switch (parseNext()) {
+    case Result::Ok:
+        atEnd = false;
+        break;
+    case Result::End:
+        start = cur;
+        type = QJsonStreamReader::NoToken;
+        atEnd = true;
+        break;
+    case Result::Incomplete:
+        // rewind, so that we can try again once more data is available
+        cur = start;
+        state = oldState;
+        nameBegin = nameEnd = -1;
+        type = QJsonStreamReader::Invalid;
+        error = QJsonStreamReader::PrematureEndOfDocumentError;
+        errorOffset = bufferOffset + buffer.size();
+        atEnd = true;
+        break;
+    case Result::Failed:
+        type = QJsonStreamReader::Invalid;
+        atEnd = true;
+        break;
+    }
+    return type;
+}
+
+QJsonStreamReaderPrivate::Result QJsonStreamReaderPrivate::parseNext()
+{
+    if (!skipWhitespace()) {
+        const bool betweenDocuments = containers.isEmpty()
+                && (state == ExpectValue || state == ExpectSeparator);
+        return betweenDocuments ? Result::End : Result::Incomplete;
+    }
+
+    switch (state) {
+    case ExpectValue:
+        break;
+    case ExpectFirstElement:
+        if (buffer.at(cur) == ']')
+            return closeContainer();
+        break;
+    case ExpectFirstMember:
+        if (buffer.at(cur) == '}')
+            return closeContainer();
+        return parseMember();
+    case ExpectSeparator: {
+        if (containers.isEmpty())
+            break;      // another top-level value follows
+        const bool inObject = containers.last() == '{';
+        const char c = buffer.at(cur);
+        if (c == (inObject ? '}' : ']'))
+            return closeContainer();
+        if (c != ',') {
+            return fail(inObject ? QJsonParseError::UnterminatedObject
+                                 : QJsonParseError::UnterminatedArray);
+        }
+        ++cur;
+        if (!skipWhitespace())
+            return Result::Incomplete;
+        if (inObject) {
+            if (buffer.at(cur) == '}')
+                return fail(QJsonParseError::MissingObject);
+            return parseMember();
+        }
+        break;
+    }
+    }
+    return parseValue();
+}
+
+QJsonStreamReaderPrivate::Result QJsonStreamReaderPrivate::closeContainer()
+{
+    type = containers.last() == '[' ? QJsonStreamReader::EndArray : QJsonStreamReader::EndObject;
+    containers.removeLast();
+    tokenBegin = cur++;
+    tokenEnd = cur;
+    state = ExpectSeparator;
+    return Result::Ok;
+}
+
+QJsonStreamReaderPrivate::Result QJsonStreamReaderPrivate::parseMember()
+{
+    if (buffer.at(cur) != '"')
+        return fail(QJsonParseError::IllegalValue);
+    Result result = scanString(&nameBegin, &nameEnd, &nameEscaped);
+    if (result != Result::Ok)
+        return result;
+    if (!skipWhitespace())
+        return Result::Incomplete;
+    if (buffer.at(cur) != ':')
+        return fail(QJsonParseError::MissingNameSeparator);
+    ++cur;
+    if (!skipWhitespace())
+        return Result::Incomplete;
+    return parseValue();
+}
+
+QJsonStreamReaderPrivate::Result QJsonStreamReaderPrivate::parseValue()
+{
+    const char c = buffer.at(cur);
+    switch (c) {
+    case '[':
+    case '{':
+        if (containers.size() >= nestingLimit)
+            return fail(QJsonParseError::DeepNesting);
+        containers.append(c);
+        tokenBegin = cur++;
+        tokenEnd = cur;
+        type = c == '[' ? QJsonStreamReader::StartArray : QJsonStreamReader::StartObject;
+        state = c == '[' ? ExpectFirstElement : ExpectFirstMember;
+        return Result::Ok;
+    case '"': {
+        Result result = scanString(&tokenBegin, &tokenEnd, &tokenEscaped);
+        if (result != Result::Ok)
+            return result;
+        type = QJsonStreamReader::String;
+        state = ExpectSeparator;
+        return Result::Ok;
+    }
+    case 't':
+        return scanLiteral("true", QJsonStreamReader::Bool);
+    case 'f':
+        return scanLiteral("false", QJsonStreamReader::Bool);
+    case 'n':
+        return scanLiteral("null", QJsonStreamReader::Null);
+    default:
+        if (c == '-' || isAsciiDigit(c))
+            return scanNumber();
+        return fail(QJsonParseError::IllegalValue);
+    }
+}
+
+/*
+    Scans the string starting at the quote at cur. On success, \a begin and
+    \a end delimit its raw contents (without the quotes, escape sequences
+    still in place) and \a escaped tells whether there were any. Offsets
+    kept across readMore() are relative to start, which compaction moves.
+*/
+QJsonStreamReaderPrivate::Result
+QJsonStreamReaderPrivate::scanString(qsizetype *begin, qsizetype *end, bool *escaped)
+{
+    ++cur;
+    const qsizetype beginRel = cur - start;
+    bool hasEscapes = false;
+    bool isAscii = true;
+    forever {
+        if (cur == buffer.size() && !readMore())
+            return Result::Incomplete;
+        const char *data = buffer.constData();
+        const qsizetype size = buffer.size();
+        while (cur < size) {
+            const uchar c = uchar(data[cur]);
+            if (c == '"') {
+                *begin = start + beginRel;
+                *end = cur++;
+                *escaped = hasEscapes;
+                if (!isAscii) {
+                    const QByteArrayView contents(data + *begin, *end - *begin);
+                    if (!QUtf8::isValidUtf8(contents).isValidUtf8) {
+                        cur = *begin;
+                        return fail(QJsonParseError::IllegalUTF8String);
+                    }
+                }
+                return Result::Ok;
+            }
+            if (c == '\\') {
+                hasEscapes = true;
+                if (!ensure(2))
+                    return Result::Incomplete;
+                const char e = buffer.at(cur + 1);
+                if (e == 'u') {
+                    if (!ensure(6))
+                        return Result::Incomplete;
+                    for (int i = 2; i < 6; ++i) {
+                        if (fromHex(buffer.at(cur + i)) < 0)
+                            return fail(QJsonParseError::IllegalEscapeSequence);
+                    }
+                    cur += 6;
+                } else if (e && strchr("\"\\/bfnrt", e)) {
+                    cur += 2;
+                } else {
+                    return fail(QJsonParseError::IllegalEscapeSequence);
+                }
+                break;      // ensure() may have moved the buffer
+            }
+            if (c >= 0x80)
+                isAscii = false;
+            ++cur;
+        }
+    }
+}
+
+QJsonStreamReaderPrivate::Result
+QJsonStreamReaderPrivate::scanLiteral(QByteArrayView literal, QJsonStreamReader::TokenType literalType)
+{
+    if (!ensure(literal.size()))
+        return Result::Incomplete;
+    if (QByteArrayView(buffer).sliced(cur, literal.size()) != literal)
+        return fail(QJsonParseError::IllegalValue);
+    tokenBegin = cur;
+    cur += literal.size();
+    tokenEnd = cur;
+    Result result = checkDelimiter(QJsonParseError::IllegalValue);
+    if (result != Result::Ok)
+        return result;
+    type = literalType;
+    state = ExpectSeparator;
+    return Result::Ok;
+}
+
+static bool isValidJsonNumber(QByteArrayView s)
+{
+    const qsizetype n = s.size();
+    qsizetype i = 0;
+    const auto skipDigits = [&] {
+        const qsizetype first = i;
+        while (i < n && isAsciiDigit(s[i]))
+            ++i;
+        return i > first;
+    };
+
+    if (i < n && s[i] == '-')
+        ++i;
+    if (i < n && s[i] == '0')
+        ++i;
+    else if (!skipDigits())
+        return false;
+    if (i < n && s[i] == '.') {
+        ++i;
+        if (!skipDigits())
+            return false;
+    }
+    if (i < n && (s[i] == 'e' || s[i] == 'E')) {
+        ++i;
+        if (i < n && (s[i] == '+' || s[i] == '-'))
+            ++i;
+        if (!skipDigits())
+            return false;
+    }
+    return i == n;
+}
+
+QJsonStreamReaderPrivate::Result QJsonStreamReaderPrivate::scanNumber()
+{
+    const qsizetype beginRel = cur - start;
+    forever {
+        if (cur == buffer.size() && !readMore()) {
+            // inside a container, more must follow; at the top level the
+            // number ends with the input
+            if (!containers.isEmpty() || !isFinal())
+                return Result::Incomplete;
+            break;
+        }
+        const char c = buffer.at(cur);
+        if (!isAsciiDigit(c) && c != '-' && c != '+' && c != '.' && c != 'e' && c != 'E')
+            break;
+        ++cur;
+    }
+    tokenBegin = start + beginRel;
+    tokenEnd = cur;
+    if (!isValidJsonNumber(QByteArrayView(buffer).sliced(tokenBegin, tokenEnd - tokenBegin))) {
+        cur = tokenBegin;
+        return fail(QJsonParseError::IllegalNumber);
+    }
+    Result result = checkDelimiter(QJsonParseError::IllegalNumber);
+    if (result != Result::Ok)
+        return result;
+    type = QJsonStreamReader::Number;
+    state = ExpectSeparator;
+    return Result::Ok;
+}
+
+QJsonStreamReaderPrivate::Result QJsonStreamReaderPrivate::checkDelimiter(QJsonParseError::ParseError e)
+{
+    if (!ensure(1))
+        return containers.isEmpty() && isFinal() ? Result::Ok : Result::Incomplete;
+    switch (buffer.at(cur)) {
+    case ' ':
+    case '\t':
+    case '\n':
+    case '\r':
+    case ',':
+    case ']':
+    case '}':
+        return Result::Ok;
+    default:
+        return fail(e);
+    }
+}
+
+bool QJsonStreamReaderPrivate::continueSkip()
+{
+    // nothing before the current position is needed any more
+    start = cur;
+    nameBegin = nameEnd = -1;
+    forever {
+        const char *data = buffer.constData();
+        const qsizetype size = buffer.size();
+        while (cur < size) {
+            const char c = data[cur++];
+            if (skipInString) {
+                if (skipEscape)
+                    skipEscape = false;
+                else if (c == '\\')
+                    skipEscape = true;
+                else if (c == '"')
+                    skipInString = false;
+                continue;
+            }
+            switch (c) {
+            case '"':
+                skipInString = true;
+                break;
+            case '[':
+            case '{':
+                ++skipDepth;
+                break;
+            case ']':
+            case '}':
+                if (--skipDepth > 0)
+                    break;
+                --cur;
+                if (c != (containers.last() == '[' ? ']' : '}')) {
+                    type = QJsonStreamReader::Invalid;
+                    atEnd = true;
+                    fail(containers.last() == '[' ? QJsonParseError::UnterminatedArray
+                                                  : QJsonParseError::UnterminatedObject);
+                    return false;
+                }
+                start = cur;
+                closeContainer();
+                atEnd = false;
+                return true;
+            }
+        }
+        start = cur;
+        if (!readMore()) {
+            type = QJsonStreamReader::Invalid;
+            error = QJsonStreamReader::PrematureEndOfDocumentError;
+            errorOffset = bufferOffset + cur;
+            atEnd = true;
+            return false;
+        }
+    }
+}
+
+QString QJsonStreamReaderPrivate::decode(qsizetype begin, qsizetype end, bool escaped) const
+{
+    const char *data = buffer.constData();
+    if (!escaped)
+        return QString::fromUtf8(data + begin, end - begin);
+
+    QString result;
+    result.reserve(end - begin);
+    qsizetype segment = begin;
+    qsizetype i = begin;
+    while (i < end) {
+        if (data[i] != '\\') {
+            ++i;
+            continue;
+        }
+        result += QUtf8StringView(data + segment, i - segment);
+        char16_t ch = 0;
+        switch (data[i + 1]) {
+        case 'b': ch = u'\b'; break;
+        case 'f': ch = u'\f'; break;
+        case 'n': ch = u'\n'; break;
+        case 'r': ch = u'\r'; break;
+        case 't': ch = u'\t'; break;
+        case 'u':
+            for (int j = 2; j < 6; ++j)
+                ch = char16_t((ch << 4) | fromHex(data[i + j]));
+            i += 4;
+            break;
+        default:
+            ch = char16_t(data[i + 1]);
+            break;
+        }
+        // surrogate pairs arrive as two escapes and combine in UTF-16
+        result += QChar(ch);
+        i += 2;
+        segment = i;
+    }
+    result += QUtf8StringView(data + segment, end - segment);
+    return result;
+}
+
+/*!
+    \class QJsonStreamReader
+    \inmodule QtCore
+    \ingroup json
+    \ingroup qtserialization
+    \reentrant
+    \since 6.10
+
+    \brief The QJsonStreamReader class is a fast, pull-based reader for JSON
+    text.
+
+    QJsonStreamReader reads JSON incrementally from a QIODevice or from
+    data added with addData(), without building a QJsonDocument. The
+    application calls readNext() to advance to the next token and then
+    inspects it with tokenType(), name(), text() and the conversion
+    functions. Only the current token is kept in memory, so arbitrarily
+    large inputs can be processed with bounded memory, and
+    skipCurrentElement() skips whole arrays or objects without decoding
+    them.
+
+    A value that is a member of an object is reported as a single token;
+    its key is available from name(). The reader accepts any number of
+    top-level values separated by whitespace, which makes it suitable for
+    newline-delimited JSON logs:
+
+    \snippet code/src_corelib_serialization_qjsonstreamreader.cpp 0
+
+    If the input ends in the middle of a value, readNext() returns
+    \l Invalid and error() is \l PrematureEndOfDocumentError. Once more
+    data has been added with addData() or has arrived on the device(),
+    reading continues where it stopped. Any other error is fatal.
+
+    \sa QJsonDocument, QCborStreamReader, QXmlStreamReader
+*/
+
+/*!
+    \enum QJsonStreamReader::TokenType
+
+    This enum specifies the type of token the reader has just read.
+
+    \value NoToken      Nothing has been read yet, or the end of the input
+                        was reached between two top-level values.
+    \value Invalid      An error occurred; see error() and errorString().
+    \value StartArray   The start of an array.
+    \value EndArray     The end of an array.
+    \value StartObject  The start of an object.
+    \value EndObject    The end of an object.
+    \value String       A string; use text() to read it.
+    \value Number       A number; use toDouble() or toInteger() to read it.
+    \value Bool         A boolean; use toBool() to read it.
+    \value Null         The \c null value.
+*/
+
+/*!
+    \enum QJsonStreamReader::Error
+
+    This enum specifies the kind of error the reader encountered.
+
+    \value NoError      No error occurred.
+    \value NotWellFormedError The input is not valid JSON; parseError()
+                        has the details.
+    \value PrematureEndOfDocumentError The input ended in the middle of a
+                        value. Reading can continue once more data is
+                        available.
+*/
+
+/*!
+    Constructs a stream reader without input. Use setDevice() or
+    addData() to supply it.
+*/
+QJsonStreamReader::QJsonStreamReader()
+    : d_ptr(new QJsonStreamReaderPrivate)
+{
+}
+
+/*!
+    Constructs a stream reader that reads from \a device.
+*/
+QJsonStreamReader::QJsonStreamReader(QIODevice *device)
+    : QJsonStreamReader()
+{
+    setDevice(device);
+}
+
+/*!
+    Constructs a stream reader that reads from \a data. The data is not
+    copied.
+*/
+QJsonStreamReader::QJsonStreamReader(const QByteArray &data)
+    : QJsonStreamReader()
+{
+    d_ptr->buffer = data;
+}
+
+/*!
+    Destroys the reader.
+*/
+QJsonStreamReader::~QJsonStreamReader()
+{
+}
+
+/*!
+    Sets the current device to \a device and resets the reader. Any data
+    added with addData() is discarded.
+
+    \sa device(), clear()
+*/
+void QJsonStreamReader::setDevice(QIODevice *device)
+{
+    Q_D(QJsonStreamReader);
+    d->device = device;
+    d->reset();
+}
+
+/*!
+    Returns the device the reader reads from, or \nullptr.
+
+    \sa setDevice()
+*/
+QIODevice *QJsonStreamReader::device() const
+{
+    Q_D(const QJsonStreamReader);
+    return d->device;
+}
+
+/*!
+    Appends \a data to the reader's input. This must not be used while the
+    reader reads from a device().
+
+    Since more data may follow, a number or literal at the top level of the
+    input is only reported once the character after it has been added, or
+    finishInput() has been called.
+
+    After readNext() reported \l PrematureEndOfDocumentError, calling this
+    function lets parsing continue. Data that has already been consumed is
+    released, so feeding a long stream in chunks uses bounded memory.
+*/
+void QJsonStreamReader::addData(QByteArrayView data)
+{
+    Q_D(QJsonStreamReader);
+    if (d->device) {
+        qWarning("QJsonStreamReader: addData() with device()");
+        return;
+    }
+    d->compact();
+    d->buffer.append(data);
+    d->streaming = true;
+}
+
+/*!
+    Tells the reader that no more data follows what has been added with
+    addData() or what the device() currently has available, so that a
+    number or literal at the end of the input is reported.
+
+    This is not needed for random-access devices, nor for sequential
+    devices such as sockets and processes, whose read() reports the end of
+    their data once they are closed. It is needed for devices that have
+    nothing more to read but cannot tell whether more will arrive.
+
+    Calling setDevice() or clear() resets this.
+
+    \sa addData(), atEnd()
+*/
+void QJsonStreamReader::finishInput()
+{
+    Q_D(QJsonStreamReader);
+    d->inputFinished = true;
+}
+
+/*!
+    Removes any device() or data from the reader and resets it to its
+    initial state.
+*/
+void QJsonStreamReader::clear()
+{
+    Q_D(QJsonStreamReader);
+    d->device = nullptr;
+    d->reset();
+}
+
+/*!
+    Returns \c true if the last call to readNext() found no further token,
+    either because the input is exhausted or because an error occurred;
+    otherwise returns \c false.
+
+    \sa readNext(), error()
+*/
+bool QJsonStreamReader::atEnd() const
+{
+    Q_D(const QJsonStreamReader);
+    return d->atEnd;
+}
+
+/*!
+    Reads the next token and returns its type.
+
+    Returns \l NoToken if the input ends after a complete top-level value,
+    and \l Invalid if an error occurs. After a \l NotWellFormedError, all
+    further calls return \l Invalid.
+
+    \sa tokenType(), skipCurrentElement()
+*/
+QJsonStreamReader::TokenType QJsonStreamReader::readNext()
+{
+    Q_D(QJsonStreamReader);
+    if (d->error == NotWellFormedError)
+        return Invalid;
+    d->error = NoError;
+    if (d->skipDepth > 0) {
+        d->continueSkip();
+        return d->type;
+    }
+    return d->readNext();
+}
+
+/*!
+    If the current token is \l StartArray or \l StartObject, skips ahead to
+    the matching \l EndArray or \l EndObject, which becomes the current
+    token. This only tracks nesting and strings and does not decode or
+    validate the skipped contents, so it is much faster than reading them
+    token by token. For any other token this function does nothing.
+
+    Returns \c true on success. If the input ends before the element is
+    complete, returns \c false and error() is \l PrematureEndOfDocumentError;
+    calling this function or readNext() again once more data is available
+    continues skipping.
+*/
+bool QJsonStreamReader::skipCurrentElement()
+{
+    Q_D(QJsonStreamReader);
+    if (d->error == NotWellFormedError)
+        return false;
+    if (d->skipDepth == 0) {
+        if (d->type != StartArray && d->type != StartObject)
+            return true;
+        d->skipDepth = 1;
+        d->skipInString = d->skipEscape = false;
+    }
+    d->error = NoError;
+    return d->continueSkip();
+}
+
+/*!
+    Returns the type of the current token.
+
+    \sa tokenString(), readNext()
+*/
+QJsonStreamReader::TokenType QJsonStreamReader::tokenType() const
+{
+    Q_D(const QJsonStreamReader);
+    return d->type;
+}
+
+/*!
+    Returns the name of the current token type, for example "StartObject".
+*/
+QString QJsonStreamReader::tokenString() const
+{
+    static constexpr const char *names[] = {
+        "NoToken", "Invalid", "StartArray", "EndArray", "StartObject", "EndObject",
+        "String", "Number", "Bool", "Null"
+    };
+    return QString::fromLatin1(names[tokenType()]);
+}
+
+/*!
+    Returns the number of arrays and objects enclosing the current
+    position. After \l StartArray or \l StartObject, this includes the
+    container that was just entered.
+*/
+int QJsonStreamReader::depth() const
+{
+    Q_D(const QJsonStreamReader);
+    return int(d->containers.size());
+}
+
+/*!
+    Returns \c true if the current token is a member of an object, that is,
+    if it has a name().
+*/
+bool QJsonStreamReader::hasName() const
+{
+    Q_D(const QJsonStreamReader);
+    return d->nameBegin >= 0;
+}
+
+/*!
+    Returns the key of the current token if it is a member of an object;
+    otherwise returns a null string.
+
+    \sa nameEquals(), hasName()
+*/
+QString QJsonStreamReader::name() const
+{
+    Q_D(const QJsonStreamReader);
+    if (d->nameBegin < 0)
+        return QString();
+    return d->decode(d->nameBegin, d->nameEnd, d->nameEscaped);
+}
+
+/*!
+    Returns \c true if the current token is a member of an object and its
+    key is \a name. Unless the key contains escape sequences, this compares
+    the raw bytes and does not allocate memory.
+*/
+bool QJsonStreamReader::nameEquals(QUtf8StringView name) const
+{
+    Q_D(const QJsonStreamReader);
+    if (d->nameBegin < 0)
+        return false;
+    if (d->nameEscaped)
+        return QAnyStringView::equal(this->name(), name);
+    const QByteArrayView raw(d->buffer.constData() + d->nameBegin, d->nameEnd - d->nameBegin);
+    return raw == QByteArrayView(name.data(), name.size());
+}
+
+/*!
+    Returns the contents of the current token if it is a \l String, or its
+    textual representation if it is a \l Number, \l Bool or \l Null;
+    otherwise returns a null string.
+*/
+QString QJsonStreamReader::text() const
+{
+    Q_D(const QJsonStreamReader);
+    switch (d->type) {
+    case String:
+        return d->decode(d->tokenBegin, d->tokenEnd, d->tokenEscaped);
+    case Number:
+    case Bool:
+    case Null:
+        return QString::fromLatin1(rawToken());
+    default:
+        return QString();
+    }
+}
+
+/*!
+    Returns the bytes of the current token as they appear in the input. For
+    a \l String, the quotes are not included and escape sequences are not
+    decoded. The view is valid until the next call to readNext().
+*/
+QByteArrayView QJsonStreamReader::rawToken() const
+{
+    Q_D(const QJsonStreamReader);
+    if (d->type == NoToken || d->type == Invalid)
+        return QByteArrayView();
+    return QByteArrayView(d->buffer.constData() + d->tokenBegin, d->tokenEnd - d->tokenBegin);
+}
+
+/*!
+    Returns the value of the current token if it is a \l Number; otherwise
+    returns 0.
+*/
+double QJsonStreamReader::toDouble() const
+{
+    if (tokenType() != Number)
+        return 0;
+    return rawToken().toDouble();
+}
+
+/*!
+    Returns the value of the current token if it is a \l Number that is a
+    whole number representable as qint64; otherwise returns \a defaultValue.
+
+    \sa QJsonValue::toInteger()
+*/
+qint64 QJsonStreamReader::toInteger(qint64 defaultValue) const
+{
+    if (tokenType() != Number)
+        return defaultValue;
+    bool ok = false;
+    const qint64 value = rawToken().toLongLong(&ok);
+    if (ok)
+        return value;
+    qint64 dblInt;
+    if (convertDoubleTo<qint64>(toDouble(), &dblInt))
+        return dblInt;
+    return defaultValue;
+}
+
+/*!
+    Returns \c true if the current token is the \l Bool value \c true;
+    otherwise returns \c false.
+*/
+bool QJsonStreamReader::toBool() const
+{
+    Q_D(const QJsonStreamReader);
+    return d->type == Bool && d->buffer.at(d->tokenBegin) == 't';
+}
+
+/*!
+    Returns the kind of error that occurred, or \l NoError.
+
+    \sa errorString(), parseError(), offset()
+*/
+QJsonStreamReader::Error QJsonStreamReader::error() const
+{
+    Q_D(const QJsonStreamReader);
+    return d->error;
+}
+
+/*!
+    Returns a human-readable description of the last error.
+*/
+QString QJsonStreamReader::errorString() const
+{
+    Q_D(const QJsonStreamReader);
+    switch (d->error) {
+    case NoError:
+        break;
+    case PrematureEndOfDocumentError:
+        return QCoreApplication::translate("QJsonStreamReader", "premature end of document");
+    case NotWellFormedError:
+        return QJsonParseError{ 0, d->parseError }.errorString();
+    }
+    return QString();
+}
+
+/*!
+    If error() is \l NotWellFormedError, returns what was wrong with the
+    input; otherwise returns QJsonParseError::NoError.
+*/
+QJsonParseError::ParseError QJsonStreamReader::parseError() const
+{
+    Q_D(const QJsonStreamReader);
+    return d->error == NotWellFormedError ? d->parseError : QJsonParseError::NoError;
+}
+
+/*!
+    Returns the offset in bytes from the start of the input of the current
+    token or, if an error occurred, of the error.
+*/
+qint64 QJsonStreamReader::offset() const
+{
+    Q_D(const QJsonStreamReader);
+    if (d->error != NoError)
+        return d->errorOffset;
+    return d->bufferOffset + (d->type == NoToken ? d->cur : d->tokenBegin);
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qjsonstreamreader.cpp"
@@ -0,0 +1,94 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QJSONSTREAMREADER_H
+#define QJSONSTREAMREADER_H
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qbytearrayview.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qscopedpointer.h>
+#include <QtCore/qstring.h>
+
+QT_BEGIN_NAMESPACE
+
+class QIODevice;
+
+class QJsonStreamReaderPrivate;
+class Q_CORE_EXPORT QJsonStreamReader
+{
+    Q_GADGET
+public:
+    enum TokenType {
+        NoToken = 0,
+        Invalid,
+        StartArray,
+        EndArray,
+        StartObject,
+        EndObject,
+        String,
+        Number,
+        Bool,
+        Null
+    };
+    Q_ENUM(TokenType)
+
+    enum Error {
+        NoError = 0,
+        NotWellFormedError,
+        PrematureEndOfDocumentError
+    };
+    Q_ENUM(Error)
+
+    QJsonStreamReader();
+    explicit QJsonStreamReader(QIODevice *device);
+    explicit QJsonStreamReader(const QByteArray &data);
+    ~QJsonStreamReader();
+    Q_DISABLE_COPY(QJsonStreamReader)
+
+    void setDevice(QIODevice *device);
+    QIODevice *device() const;
+    void addData(QByteArrayView data);
+    void finishInput();
+    void clear();
+
+    bool atEnd() const;
+    TokenType readNext();
+    bool skipCurrentElement();
+    TokenType tokenType() const;
+    QString tokenString() const;
+    int depth() const;
+
+    bool isStartArray() const { return tokenType() == StartArray; }
+    bool isEndArray() const { return tokenType() == EndArray; }
+    bool isStartObject() const { return tokenType() == StartObject; }
+    bool isEndObject() const { return tokenType() == EndObject; }
+    bool isString() const { return tokenType() == String; }
+    bool isNumber() const { return tokenType() == Number; }
+    bool isBool() const { return tokenType() == Bool; }
+    bool isNull() const { return tokenType() == Null; }
+
+    bool hasName() const;
+    QString name() const;
+    bool nameEquals(QUtf8StringView name) const;
+
+    QString text() const;
+    QByteArrayView rawToken() const;
+    double toDouble() const;
+    qint64 toInteger(qint64 defaultValue = 0) const;
+    bool toBool() const;
+
+    Error error() const;
+    QString errorString() const;
+    QJsonParseError::ParseError parseError() const;
+    qint64 offset() const;
+    bool hasError() const { return error() != NoError; }
+
+private:
+    Q_DECLARE_PRIVATE(QJsonStreamReader)
+    QScopedPointer<QJsonStreamReaderPrivate> d_ptr;
+};
+
+QT_END_NAMESPACE
+
+#endif // QJSONSTREAMREADER_H
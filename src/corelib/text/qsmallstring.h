@@ -0,0 +1,272 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSMALLSTRING_H
+#define QSMALLSTRING_H
+
+#include <QtCore/qhashfunctions.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qstringview.h>
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+class QSmallString
+{
+    // The characters of an inline string share the storage of the QString
+    // that holds a long one. The char16_t at TagIndex overlaps the most
+    // significant bits of QString's size, whose sign bit is never set; for an
+    // inline string it holds InlineTag | size().
+    static constexpr qsizetype StorageSize = qsizetype(sizeof(QString) / sizeof(char16_t));
+    static constexpr qsizetype TagIndex = Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+            ? StorageSize - 1
+            : qsizetype((sizeof(QString) - sizeof(qsizetype)) / sizeof(char16_t));
+    static constexpr char16_t InlineTag = 0x8000;
+
+public:
+    // one code unit less than TagIndex, for the terminating '\0'
+    static constexpr qsizetype InlineCapacity = TagIndex - 1;
+
+    using value_type = QChar;
+    using size_type = qsizetype;
+    using difference_type = qptrdiff;
+    using const_pointer = const QChar *;
+    using const_reference = const QChar &;
+    using const_iterator = const QChar *;
+
+    QSmallString() noexcept
+    {
+        setInlineSize(0);
+    }
+    explicit QSmallString(QStringView str)
+    {
+        if (str.size() <= InlineCapacity) {
+            assignInline(str);
+        } else {
+            new (&heap) QString(str.toString());
+        }
+    }
+    explicit QSmallString(QLatin1StringView str)
+    {
+        if (str.size() <= InlineCapacity) {
+            for (qsizetype i = 0; i < str.size(); ++i)
+                buffer[i] = char16_t(uchar(str.data()[i]));
+            buffer[str.size()] = u'\0';
+            setInlineSize(str.size());
+        } else {
+            new (&heap) QString(str);
+        }
+    }
+    explicit QSmallString(const QString &str)
+    {
+        if (str.size() <= InlineCapacity) {
+            assignInline(str);
+        } else {
+            new (&heap) QString(str);
+        }
+    }
+    explicit QSmallString(QString &&str)
+    {
+        if (str.size() <= InlineCapacity) {
+            assignInline(str);
+        } else {
+            new (&heap) QString(std::move(str));
+        }
+    }
+    QSmallString(const QSmallString &other)
+    {
+        if (other.isInline())
+            memcpy(buffer, other.buffer, sizeof(buffer));
+        else
+            new (&heap) QString(other.heap);
+    }
+    QSmallString(QSmallString &&other) noexcept
+    {
+        if (other.isInline())
+            memcpy(buffer, other.buffer, sizeof(buffer));
+        else
+            new (&heap) QString(std::move(other.heap));
+    }
+    ~QSmallString()
+    {
+        if (!isInline())
+            heap.~QString();
+    }
+
+    QSmallString &operator=(const QSmallString &other)
+    {
+        if (this != &other)
+            QSmallString(other).swap(*this);
+        return *this;
+    }
+    QSmallString &operator=(QSmallString &&other) noexcept
+    {
+        QSmallString moved(std::move(other));
+        swap(moved);
+        return *this;
+    }
+    QSmallString &operator=(QStringView other)
+    {
+        QSmallString(other).swap(*this);
+        return *this;
+    }
+    QSmallString &operator=(const QString &other)
+    {
+        QSmallString(other).swap(*this);
+        return *this;
+    }
+    QSmallString &operator=(QString &&other)
+    {
+        QSmallString(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    void swap(QSmallString &other) noexcept
+    {
+        if (isInline() && other.isInline()) {
+            std::swap(buffer, other.buffer);
+        } else if (!isInline() && !other.isInline()) {
+            heap.swap(other.heap);
+        } else {
+            QSmallString &small = isInline() ? *this : other;
+            QSmallString &large = isInline() ? other : *this;
+            char16_t copy[StorageSize];
+            memcpy(copy, small.buffer, sizeof(copy));
+            new (&small.heap) QString(std::move(large.heap));
+            large.heap.~QString();
+            memcpy(large.buffer, copy, sizeof(copy));
+        }
+    }
+
+    [[nodiscard]] qsizetype size() const noexcept
+    { return isInline() ? inlineSize() : heap.size(); }
+    [[nodiscard]] qsizetype length() const noexcept { return size(); }
+    [[nodiscard]] bool isEmpty() const noexcept { return size() == 0; }
+
+    [[nodiscard]] const QChar *constData() const noexcept
+    { return isInline() ? reinterpret_cast<const QChar *>(buffer) : heap.constData(); }
+    [[nodiscard]] const QChar *data() const noexcept { return constData(); }
+    [[nodiscard]] const char16_t *utf16() const noexcept
+    { return reinterpret_cast<const char16_t *>(constData()); }
+
+    [[nodiscard]] QChar at(qsizetype i) const { return view().at(i); }
+    [[nodiscard]] QChar operator[](qsizetype i) const { return at(i); }
+
+    [[nodiscard]] const_iterator begin() const noexcept { return constData(); }
+    [[nodiscard]] const_iterator end() const noexcept { return constData() + size(); }
+    [[nodiscard]] const_iterator cbegin() const noexcept { return begin(); }
+    [[nodiscard]] const_iterator cend() const noexcept { return end(); }
+    [[nodiscard]] const_iterator constBegin() const noexcept { return begin(); }
+    [[nodiscard]] const_iterator constEnd() const noexcept { return end(); }
+
+    [[nodiscard]] QStringView view() const noexcept { return QStringView(constData(), size()); }
+    [[nodiscard]] QString toString() const
+    { return isInline() ? QString(reinterpret_cast<const QChar *>(buffer), inlineSize()) : heap; }
+
+    QSmallString &append(QStringView str)
+    {
+        if (!isInline()) {
+            heap.append(str);
+        } else if (str.isEmpty()) {
+            // nothing to do
+        } else if (const qsizetype n = inlineSize(); n + str.size() <= InlineCapacity) {
+            memmove(buffer + n, str.utf16(), str.size() * sizeof(char16_t));
+            buffer[n + str.size()] = u'\0';
+            setInlineSize(n + str.size());
+        } else {
+            promote(str);
+        }
+        return *this;
+    }
+    QSmallString &append(QChar ch) { return append(QStringView(&ch, 1)); }
+    QSmallString &operator+=(QStringView str) { return append(str); }
+    QSmallString &operator+=(QChar ch) { return append(ch); }
+
+    void clear() noexcept
+    {
+        if (!isInline())
+            heap.~QString();
+        buffer[0] = u'\0';
+        setInlineSize(0);
+    }
+
+private:
+    char16_t tag() const noexcept
+    {
+        // read the bytes, as they may belong to heap
+        char16_t t;
+        memcpy(&t, reinterpret_cast<const char *>(this) + TagIndex * sizeof(char16_t), sizeof(t));
+        return t;
+    }
+    bool isInline() const noexcept { return tag() & InlineTag; }
+    qsizetype inlineSize() const noexcept { return tag() & ~InlineTag; }
+    void setInlineSize(qsizetype size) noexcept { buffer[TagIndex] = char16_t(InlineTag | size); }
+
+    void assignInline(QStringView str) noexcept
+    {
+        if (!str.isEmpty())
+            memcpy(buffer, str.utf16(), str.size() * sizeof(char16_t));
+        buffer[str.size()] = u'\0';
+        setInlineSize(str.size());
+    }
+
+    Q_NEVER_INLINE void promote(QStringView tail)
+    {
+        QString str;
+        str.reserve(inlineSize() + tail.size());
+        str.append(QStringView(buffer, inlineSize())).append(tail);
+        new (&heap) QString(std::move(str));
+    }
+
+    friend bool comparesEqual(const QSmallString &lhs, const QSmallString &rhs) noexcept
+    { return lhs.size() == rhs.size() && QtPrivate::equalStrings(lhs.view(), rhs.view()); }
+    friend Qt::strong_ordering
+    compareThreeWay(const QSmallString &lhs, const QSmallString &rhs) noexcept
+    { return compareThreeWay(lhs.view(), rhs.view()); }
+    Q_DECLARE_STRONGLY_ORDERED(QSmallString)
+
+    friend bool comparesEqual(const QSmallString &lhs, QStringView rhs) noexcept
+    { return lhs.size() == rhs.size() && QtPrivate::equalStrings(lhs.view(), rhs); }
+    friend Qt::strong_ordering compareThreeWay(const QSmallString &lhs, QStringView rhs) noexcept
+    { return compareThreeWay(lhs.view(), rhs); }
+    Q_DECLARE_STRONGLY_ORDERED(QSmallString, QStringView)
+
+    friend bool comparesEqual(const QSmallString &lhs, const QString &rhs) noexcept
+    { return lhs.size() == rhs.size() && QtPrivate::equalStrings(lhs.view(), QStringView(rhs)); }
+    friend Qt::strong_ordering compareThreeWay(const QSmallString &lhs, const QString &rhs) noexcept
+    { return compareThreeWay(lhs.view(), QStringView(rhs)); }
+    Q_DECLARE_STRONGLY_ORDERED(QSmallString, QString)
+
+    friend bool comparesEqual(const QSmallString &lhs, QLatin1StringView rhs) noexcept
+    { return lhs.size() == rhs.size() && QtPrivate::equalStrings(lhs.view(), rhs); }
+    friend Qt::strong_ordering
+    compareThreeWay(const QSmallString &lhs, QLatin1StringView rhs) noexcept
+    {
+        const int res = QtPrivate::compareStrings(lhs.view(), rhs, Qt::CaseSensitive);
+        return Qt::compareThreeWay(res, 0);
+    }
+    Q_DECLARE_STRONGLY_ORDERED(QSmallString, QLatin1StringView)
+
+    friend size_t qHash(const QSmallString &key, size_t seed = 0) noexcept
+    { return qHash(key.view(), seed); }
+
+    // The whole buffer is initialized, so that it can be copied without
+    // looking at the size.
+    union {
+        char16_t buffer[StorageSize] = {};
+        QString heap;
+    };
+};
+
+static_assert(sizeof(QSmallString) == 3 * sizeof(void *));
+static_assert(offsetof(QString::DataPointer, size) == sizeof(QString) - sizeof(qsizetype),
+              "QSmallString's tag must overlap the size of QString");
+
+Q_DECLARE_SHARED(QSmallString)
+
+QT_END_NAMESPACE
+
+#endif // QSMALLSTRING_H
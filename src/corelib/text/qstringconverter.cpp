@@ -34,6 +34,8 @@
 #include <bit>
 #endif
 #include <string>
+#include <tuple>
+#include <utility>
 #include <QtCore/q20utility.h>
 
 QT_BEGIN_NAMESPACE
@@ -623,6 +625,424 @@ static void simdCompareAscii(const qchar8_t *&, const qchar8_t *, const char16_t
 }
 #endif
 
+#if (defined(__SSE2__) && QT_COMPILER_SUPPORTS_HERE(SSSE3)) \
+    || (defined(__ARM_NEON__) && defined(Q_PROCESSOR_ARM_64) && Q_BYTE_ORDER == Q_LITTLE_ENDIAN)
+// Transcoding of non-ASCII text, for runs without 4-byte UTF-8 sequences
+// (surrogate pairs in UTF-16). Each step looks up a byte shuffle that moves
+// every character into a 16- or 32-bit lane of its own, where its bits can
+// be rearranged with a few shifts and masks. Anything the tables don't cover,
+// including invalid input, is left to the scalar code in QUtf8Functions.
+#  define QT_HAVE_UTF8_SIMD_NONASCII
+namespace {
+struct Utf8DecodeTables
+{
+    // Shuffles 0 to 63 spread six characters of one or two bytes each into
+    // 16-bit lanes; bit n of the index is set if character n has two bytes.
+    // Shuffles 64 to 144 spread four characters of one to three bytes into
+    // 32-bit lanes; digit n of (index - 64) in base 3 is the length of
+    // character n minus one. Each lane holds the last byte of its character
+    // in its lowest byte, the first byte in its highest used byte.
+    static constexpr int TwoByteShuffles = 64;
+    static constexpr int ShuffleCount = TwoByteShuffles + 3 * 3 * 3 * 3;
+    static constexpr quint16 NoShuffle = 0;
+    static constexpr uchar Zero = 0x80;         // out of range for PSHUFB and TBL
+
+    // Indexed by the character boundaries in the first 12 bytes of a block
+    // (bit n set if byte n is the last one of a character), the shuffle index
+    // in the low byte and the number of bytes it consumes in the high byte.
+    std::array<quint16, 4096> shuffleForBoundaries = {};
+    std::array<std::array<uchar, 16>, ShuffleCount> shuffles = {};
+};
+
+constexpr Utf8DecodeTables makeUtf8DecodeTables()
+{
+    Utf8DecodeTables t = {};
+    std::array<int, Utf8DecodeTables::ShuffleCount> consumed = {};
+    for (int id = 0; id < Utf8DecodeTables::TwoByteShuffles; ++id) {
+        auto &shuffle = t.shuffles[id];
+        int pos = 0;
+        for (int n = 0; n < 8; ++n) {
+            shuffle[2 * n] = shuffle[2 * n + 1] = Utf8DecodeTables::Zero;
+            if (n >= 6)
+                continue;
+            const int len = 1 + ((id >> n) & 1);
+            for (int i = 0; i < len; ++i)
+                shuffle[2 * n + i] = uchar(pos + len - 1 - i);
+            pos += len;
+        }
+        consumed[id] = pos;
+    }
+    for (int id = Utf8DecodeTables::TwoByteShuffles; id < Utf8DecodeTables::ShuffleCount; ++id) {
+        auto &shuffle = t.shuffles[id];
+        int pos = 0;
+        for (int n = 0, digits = id - Utf8DecodeTables::TwoByteShuffles; n < 4; ++n, digits /= 3) {
+            const int len = 1 + digits % 3;
+            for (int i = 0; i < 4; ++i)
+                shuffle[4 * n + i] = i < len ? uchar(pos + len - 1 - i) : Utf8DecodeTables::Zero;
+            pos += len;
+        }
+        consumed[id] = pos;
+    }
+    for (int boundaries = 0; boundaries < 4096; ++boundaries) {
+        int lengths[6] = {};
+        int count = 0;
+        for (int n = 0, pos = 0; n < 12 && count < 6; ++n) {
+            if (boundaries & (1 << n)) {
+                lengths[count++] = n + 1 - pos;
+                pos = n + 1;
+            }
+        }
+
+        bool fits = count == 6;
+        int id = 0;
+        for (int n = 0; fits && n < 6; ++n) {
+            fits = lengths[n] <= 2;
+            id |= (lengths[n] - 1) << n;
+        }
+        if (!fits) {
+            fits = count >= 4;
+            id = 0;
+            for (int n = 3; fits && n >= 0; --n) {
+                fits = lengths[n] <= 3;
+                id = id * 3 + lengths[n] - 1;
+            }
+            id += Utf8DecodeTables::TwoByteShuffles;
+        }
+        if (fits)
+            t.shuffleForBoundaries[boundaries] = quint16(id | consumed[id] << 8);
+    }
+    return t;
+}
+constexpr Utf8DecodeTables utf8DecodeTables = makeUtf8DecodeTables();
+
+struct Utf8EncodeTables
+{
+    // For four characters in 32-bit lanes, each holding the character's UTF-8
+    // bytes first byte first, the shuffle that packs them together. Bit n of
+    // the index is set if character n needs two or more bytes, bit n + 4 if it
+    // needs three.
+    std::array<std::array<uchar, 16>, 256> shuffles = {};
+    std::array<uchar, 256> lengths = {};
+};
+
+constexpr Utf8EncodeTables makeUtf8EncodeTables()
+{
+    Utf8EncodeTables t = {};
+    for (int id = 0; id < 256; ++id) {
+        auto &shuffle = t.shuffles[id];
+        int pos = 0;
+        for (int n = 0; n < 4; ++n) {
+            const int len = 1 + ((id >> n) & 1) + ((id >> (n + 4)) & 1);
+            for (int i = 0; i < len; ++i)
+                shuffle[pos++] = uchar(4 * n + i);
+        }
+        t.lengths[id] = uchar(pos);
+        while (pos < 16)
+            shuffle[pos++] = Utf8DecodeTables::Zero;
+    }
+    return t;
+}
+constexpr Utf8EncodeTables utf8EncodeTables = makeUtf8EncodeTables();
+} // unnamed namespace
+#endif
+
+#if defined(QT_HAVE_UTF8_SIMD_NONASCII) && defined(__SSE2__)
+// PSHUFB needs SSSE3, so these two are selected at runtime
+static QT_FUNCTION_TARGET(SSSE3) std::pair<char16_t *, const uchar *>
+simdDecodeNonAscii_ssse3(char16_t *out, const uchar *in, const uchar *end) noexcept
+{
+    // unsigned comparison: x >= c if max(x, c) == x
+    auto atLeast = [](__m128i x, uchar c) {
+        return _mm_cmpeq_epi8(_mm_max_epu8(x, _mm_set1_epi8(char(c))), x);
+    };
+    auto equals = [](__m128i x, uchar c) {
+        return _mm_cmpeq_epi8(x, _mm_set1_epi8(char(c)));
+    };
+    // continuation bytes are 0x80 to 0xbf, i.e. less than -64 when signed
+    auto isContinuation = [](__m128i x) {
+        return _mm_cmplt_epi8(x, _mm_set1_epi8(-64));
+    };
+
+    bool stop = false;
+    while (!stop && end - in >= 64) {
+        // Find the character boundaries in 64 bytes up front, so the next
+        // step's shuffle doesn't have to wait for its data to be loaded.
+        quint64 continuation = 0;
+        for (int i = 0; i < 4; ++i) {
+            const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in) + i);
+            continuation |= quint64(ushort(_mm_movemask_epi8(isContinuation(data)))) << (16 * i);
+        }
+        const quint64 boundaries = ~continuation >> 1;
+
+        // each step loads 16 bytes, so stop when those would leave the 64
+        qptrdiff pos = 0;
+        do {
+            const uint entry = utf8DecodeTables.shuffleForBoundaries[(boundaries >> pos) & 0xfff];
+            if (entry == Utf8DecodeTables::NoShuffle) {
+                stop = true;
+                break;
+            }
+            const uint id = entry & 0xff;
+            const uint consumed = entry >> 8;
+            const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + pos));
+
+            // A byte must be a continuation byte if, and only if, the byte
+            // before it is a lead byte (0xc0 and up) or the one before that
+            // is the lead byte of a 3-byte sequence (0xe0 and up). Checking
+            // this up to and including the first byte we don't consume also
+            // catches truncated sequences.
+            const __m128i prev1 = _mm_slli_si128(data, 1);
+            const __m128i prev2 = _mm_slli_si128(data, 2);
+            const __m128i expected = _mm_or_si128(atLeast(prev1, 0xc0), atLeast(prev2, 0xe0));
+            uint error = _mm_movemask_epi8(_mm_xor_si128(expected, isContinuation(data)));
+            error &= (2U << consumed) - 1;
+
+            // reject overlong sequences (C0, C1, E0 80 to E0 9F), surrogates
+            // (ED A0 to ED BF) and 4-byte sequences
+            __m128i invalid = equals(_mm_and_si128(data, _mm_set1_epi8(char(0xfe))), 0xc0);
+            invalid = _mm_or_si128(invalid, atLeast(data, 0xf0));
+            invalid = _mm_or_si128(invalid, _mm_andnot_si128(atLeast(data, 0xa0), equals(prev1, 0xe0)));
+            invalid = _mm_or_si128(invalid, _mm_and_si128(atLeast(data, 0xa0), equals(prev1, 0xed)));
+            error |= _mm_movemask_epi8(invalid) & ((1U << consumed) - 1);
+            if (error) {
+                stop = true;
+                break;
+            }
+
+            const __m128i shuffle =
+                    _mm_loadu_si128(reinterpret_cast<const __m128i *>(utf8DecodeTables.shuffles[id].data()));
+            const __m128i lanes = _mm_shuffle_epi8(data, shuffle);
+            if (id < Utf8DecodeTables::TwoByteShuffles) {
+                // 110yyyyy 10xxxxxx or 0xxxxxxx -> 00000yyy yyxxxxxx
+                const __m128i high = _mm_srli_epi16(_mm_and_si128(lanes, _mm_set1_epi16(0x1f00)), 2);
+                const __m128i low = _mm_and_si128(lanes, _mm_set1_epi16(0x7f));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_or_si128(high, low));
+                out += 6;
+            } else {
+                // 1110zzzz 10yyyyyy 10xxxxxx -> zzzzyyyy yyxxxxxx
+                const __m128i high = _mm_srli_epi32(_mm_and_si128(lanes, _mm_set1_epi32(0x0f0000)), 4);
+                const __m128i middle = _mm_srli_epi32(_mm_and_si128(lanes, _mm_set1_epi32(0x3f00)), 2);
+                const __m128i low = _mm_and_si128(lanes, _mm_set1_epi32(0x7f));
+                __m128i result = _mm_or_si128(_mm_or_si128(high, middle), low);
+                result = _mm_shuffle_epi8(result, _mm_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13,
+                                                                -1, -1, -1, -1, -1, -1, -1, -1));
+                _mm_storel_epi64(reinterpret_cast<__m128i *>(out), result);
+                out += 4;
+            }
+            pos += consumed;
+
+            // six US-ASCII characters: simdDecodeAscii() is faster at those
+            stop = id == 0;
+        } while (!stop && pos <= 64 - 16);
+        in += pos;
+    }
+    return { out, in };
+}
+
+static QT_FUNCTION_TARGET(SSSE3) std::pair<uchar *, const char16_t *>
+simdEncodeNonAscii_ssse3(uchar *out, const char16_t *in, const char16_t *end) noexcept
+{
+    auto select = [](__m128i mask, __m128i a, __m128i b) {
+        return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+    };
+
+    while (end - in >= 8) {
+        const __m128i units = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(in));
+        const __m128i surrogates = _mm_cmpeq_epi16(_mm_and_si128(units, _mm_set1_epi16(short(0xf800))),
+                                                   _mm_set1_epi16(short(0xd800)));
+        if (_mm_movemask_epi8(surrogates) & 0xff)
+            break;
+
+        const __m128i u = _mm_unpacklo_epi16(units, _mm_setzero_si128());
+        const __m128i twoBytes = _mm_cmpgt_epi32(u, _mm_set1_epi32(0x7f));
+        const __m128i threeBytes = _mm_cmpgt_epi32(u, _mm_set1_epi32(0x7ff));
+        const uint id = _mm_movemask_ps(_mm_castsi128_ps(twoBytes))
+                | (_mm_movemask_ps(_mm_castsi128_ps(threeBytes)) << 4);
+
+        const __m128i continuationBits = _mm_set1_epi32(0x80);
+        const __m128i sixBits = _mm_set1_epi32(0x3f);
+        const __m128i last = _mm_or_si128(continuationBits, _mm_and_si128(u, sixBits));
+        const __m128i middle = _mm_or_si128(continuationBits, _mm_and_si128(_mm_srli_epi32(u, 6), sixBits));
+        const __m128i encoded2 = _mm_or_si128(_mm_or_si128(_mm_set1_epi32(0xc0), _mm_srli_epi32(u, 6)),
+                                              _mm_slli_epi32(last, 8));
+        const __m128i encoded3 = _mm_or_si128(_mm_or_si128(_mm_set1_epi32(0xe0), _mm_srli_epi32(u, 12)),
+                                              _mm_or_si128(_mm_slli_epi32(middle, 8), _mm_slli_epi32(last, 16)));
+        __m128i result = select(twoBytes, encoded2, u);
+        result = select(threeBytes, encoded3, result);
+
+        const __m128i shuffle =
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(utf8EncodeTables.shuffles[id].data()));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_shuffle_epi8(result, shuffle));
+        out += utf8EncodeTables.lengths[id];
+        in += 4;
+
+        // four US-ASCII characters: simdEncodeAscii() is faster at those
+        if (id == 0)
+            break;
+    }
+    return { out, in };
+}
+#elif defined(QT_HAVE_UTF8_SIMD_NONASCII)
+static inline uint neonMovemask(uint8x16_t mask) noexcept
+{
+    const uint8x8_t bits = qvset_n_u8(1, 1 << 1, 1 << 2, 1 << 3, 1 << 4, 1 << 5, 1 << 6, 1 << 7);
+    return vaddv_u8(vand_u8(vget_low_u8(mask), bits))
+            | (uint(vaddv_u8(vand_u8(vget_high_u8(mask), bits))) << 8);
+}
+
+static std::pair<char16_t *, const uchar *>
+simdDecodeNonAscii_neon(char16_t *out, const uchar *in, const uchar *end) noexcept
+{
+    // see simdDecodeNonAscii_ssse3() for the details
+    auto isContinuation = [](uint8x16_t x) {
+        return vceqq_u8(vandq_u8(x, vdupq_n_u8(0xc0)), vdupq_n_u8(0x80));
+    };
+
+    const uint8x16_t zero = vdupq_n_u8(0);
+    bool stop = false;
+    while (!stop && end - in >= 64) {
+        quint64 continuation = 0;
+        for (int i = 0; i < 4; ++i)
+            continuation |= quint64(neonMovemask(isContinuation(vld1q_u8(in + 16 * i)))) << (16 * i);
+        const quint64 boundaries = ~continuation >> 1;
+
+        qptrdiff pos = 0;
+        do {
+            const uint entry = utf8DecodeTables.shuffleForBoundaries[(boundaries >> pos) & 0xfff];
+            if (entry == Utf8DecodeTables::NoShuffle) {
+                stop = true;
+                break;
+            }
+            const uint id = entry & 0xff;
+            const uint consumed = entry >> 8;
+            const uint8x16_t data = vld1q_u8(in + pos);
+
+            const uint8x16_t prev1 = vextq_u8(zero, data, 15);
+            const uint8x16_t prev2 = vextq_u8(zero, data, 14);
+            const uint8x16_t expected = vorrq_u8(vcgeq_u8(prev1, vdupq_n_u8(0xc0)),
+                                                 vcgeq_u8(prev2, vdupq_n_u8(0xe0)));
+            uint error = neonMovemask(veorq_u8(expected, isContinuation(data)));
+            error &= (2U << consumed) - 1;
+
+            uint8x16_t invalid = vceqq_u8(vandq_u8(data, vdupq_n_u8(0xfe)), vdupq_n_u8(0xc0));
+            invalid = vorrq_u8(invalid, vcgeq_u8(data, vdupq_n_u8(0xf0)));
+            invalid = vorrq_u8(invalid, vandq_u8(vceqq_u8(prev1, vdupq_n_u8(0xe0)),
+                                                 vcltq_u8(data, vdupq_n_u8(0xa0))));
+            invalid = vorrq_u8(invalid, vandq_u8(vceqq_u8(prev1, vdupq_n_u8(0xed)),
+                                                 vcgeq_u8(data, vdupq_n_u8(0xa0))));
+            error |= neonMovemask(invalid) & ((1U << consumed) - 1);
+            if (error) {
+                stop = true;
+                break;
+            }
+
+            const uint8x16_t lanes = vqtbl1q_u8(data, vld1q_u8(utf8DecodeTables.shuffles[id].data()));
+            if (id < Utf8DecodeTables::TwoByteShuffles) {
+                const uint16x8_t lanes16 = vreinterpretq_u16_u8(lanes);
+                const uint16x8_t high = vshrq_n_u16(vandq_u16(lanes16, vdupq_n_u16(0x1f00)), 2);
+                const uint16x8_t low = vandq_u16(lanes16, vdupq_n_u16(0x7f));
+                vst1q_u16(reinterpret_cast<uint16_t *>(out), vorrq_u16(high, low));
+                out += 6;
+            } else {
+                const uint32x4_t lanes32 = vreinterpretq_u32_u8(lanes);
+                const uint32x4_t high = vshrq_n_u32(vandq_u32(lanes32, vdupq_n_u32(0x0f0000)), 4);
+                const uint32x4_t middle = vshrq_n_u32(vandq_u32(lanes32, vdupq_n_u32(0x3f00)), 2);
+                const uint32x4_t low = vandq_u32(lanes32, vdupq_n_u32(0x7f));
+                vst1_u16(reinterpret_cast<uint16_t *>(out),
+                         vmovn_u32(vorrq_u32(vorrq_u32(high, middle), low)));
+                out += 4;
+            }
+            pos += consumed;
+            stop = id == 0;
+        } while (!stop && pos <= 64 - 16);
+        in += pos;
+    }
+    return { out, in };
+}
+
+static std::pair<uchar *, const char16_t *>
+simdEncodeNonAscii_neon(uchar *out, const char16_t *in, const char16_t *end) noexcept
+{
+    // see simdEncodeNonAscii_ssse3() for the details
+    static const uint32_t laneBits[4] = { 1, 1 << 1, 1 << 2, 1 << 3 };
+    const uint32x4_t bits = vld1q_u32(laneBits);
+    while (end - in >= 8) {
+        const uint16x4_t units = vld1_u16(reinterpret_cast<const uint16_t *>(in));
+        const uint16x4_t surrogates = vceq_u16(vand_u16(units, vdup_n_u16(0xf800)), vdup_n_u16(0xd800));
+        if (vmaxv_u16(surrogates))
+            break;
+
+        const uint32x4_t u = vmovl_u16(units);
+        const uint32x4_t twoBytes = vcgtq_u32(u, vdupq_n_u32(0x7f));
+        const uint32x4_t threeBytes = vcgtq_u32(u, vdupq_n_u32(0x7ff));
+        const uint id = vaddvq_u32(vandq_u32(twoBytes, bits))
+                | (vaddvq_u32(vandq_u32(threeBytes, bits)) << 4);
+
+        const uint32x4_t continuationBits = vdupq_n_u32(0x80);
+        const uint32x4_t sixBits = vdupq_n_u32(0x3f);
+        const uint32x4_t last = vorrq_u32(continuationBits, vandq_u32(u, sixBits));
+        const uint32x4_t middle = vorrq_u32(continuationBits, vandq_u32(vshrq_n_u32(u, 6), sixBits));
+        const uint32x4_t encoded2 = vorrq_u32(vorrq_u32(vdupq_n_u32(0xc0), vshrq_n_u32(u, 6)),
+                                              vshlq_n_u32(last, 8));
+        const uint32x4_t encoded3 = vorrq_u32(vorrq_u32(vdupq_n_u32(0xe0), vshrq_n_u32(u, 12)),
+                                              vorrq_u32(vshlq_n_u32(middle, 8), vshlq_n_u32(last, 16)));
+        uint32x4_t result = vbslq_u32(twoBytes, encoded2, u);
+        result = vbslq_u32(threeBytes, encoded3, result);
+
+        const uint8x16_t shuffle = vld1q_u8(utf8EncodeTables.shuffles[id].data());
+        vst1q_u8(out, vqtbl1q_u8(vreinterpretq_u8_u32(result), shuffle));
+        out += utf8EncodeTables.lengths[id];
+        in += 4;
+        if (id == 0)
+            break;
+    }
+    return { out, in };
+}
+#endif
+
+// Called by the loops below where simdDecodeAscii() and simdEncodeAscii()
+// find non-ASCII text; this leaves at least four bytes or characters for the
+// scalar code after it. The kernels take and return the pointers by value, so
+// the callers can keep theirs in registers.
+static inline void simdDecodeNonAscii(char16_t *&dst, const uchar *&src, const uchar *end) noexcept
+{
+#ifdef QT_HAVE_UTF8_SIMD_NONASCII
+    // A single non-ASCII character between ASCII ones is faster done by the
+    // scalar code (src[2] is the byte after a 2-byte sequence), as are
+    // 4-byte sequences.
+    if (end - src < 64 || !(src[2] & 0x80) || src[0] >= 0xf0)
+        return;
+#  if defined(__SSE2__)
+    if (qCpuHasFeature(SSSE3))
+        std::tie(dst, src) = simdDecodeNonAscii_ssse3(dst, src, end);
+#  else
+    std::tie(dst, src) = simdDecodeNonAscii_neon(dst, src, end);
+#  endif
+#else
+    Q_UNUSED(dst);
+    Q_UNUSED(src);
+    Q_UNUSED(end);
+#endif
+}
+
+static inline void simdEncodeNonAscii(uchar *&dst, const char16_t *&src, const char16_t *end) noexcept
+{
+#ifdef QT_HAVE_UTF8_SIMD_NONASCII
+    if (end - src < 8 || src[1] < 0x80 || QChar::isSurrogate(src[0]))
+        return;
+#  if defined(__SSE2__)
+    if (qCpuHasFeature(SSSE3))
+        std::tie(dst, src) = simdEncodeNonAscii_ssse3(dst, src, end);
+#  else
+    std::tie(dst, src) = simdEncodeNonAscii_neon(dst, src, end);
+#  endif
+#else
+    Q_UNUSED(dst);
+    Q_UNUSED(src);
+    Q_UNUSED(end);
+#endif
+}
+
 enum { HeaderDone = 1 };
 
 template <typename OnErrorLambda> Q_ALWAYS_INLINE
@@ -639,6 +1059,7 @@ char *QUtf8::convertFromUnicode(char *out, QStringView in, OnErrorLambda &&onErr
         if (simdEncodeAscii(dst, nextAscii, src, end))
             break;
 
+        simdEncodeNonAscii(dst, src, end);
         do {
             char16_t u = *src++;
             int res = QUtf8Functions::toUtf8<QUtf8BaseTraits>(u, dst, src, end);
@@ -814,6 +1235,7 @@ QUtf8::convertToUnicode(char16_t *dst, QByteArrayView in, OnErrorLambda &&onErro
         if (simdDecodeAscii(dst, nextAscii, src, end))
             break;
 
+        simdDecodeNonAscii(dst, src, end);
         do {
             uchar b = *src++;
             const qsizetype res = QUtf8Functions::fromUtf8<QUtf8BaseTraits>(b, dst, src, end);
@@ -0,0 +1,273 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qepochreclamation_impl.h"
+
+#include <QtCore/qmutex.h>
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#if defined(Q_OS_LINUX) && __has_include(<linux/membarrier.h>)
+#  include <linux/membarrier.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#  define QT_EPOCH_HAVE_MEMBARRIER
+#endif
+
+QT_BEGIN_NAMESPACE
+
+namespace QtPrivate {
+
+// One per thread that ever entered a QEpochGuard or retired an object. Records
+// are never freed: when their thread exits, they are released for reuse by
+// the next thread that needs one.
+struct alignas(64) QEpochRecord
+{
+    struct Retired
+    {
+        void *object;
+        void (*deleter)(void *);
+        quint64 epoch;
+    };
+
+    // (epoch << 1) | Active while the thread is inside a QEpochGuard, 0 otherwise
+    std::atomic<quint64> state = 0;
+    std::atomic<bool> inUse = true;
+    QEpochRecord *next = nullptr;
+
+    // only accessed by the thread owning the record
+    bool hasProcessWideBarrier = false;
+    int nesting = 0;
+    int retiredSinceCollect = 0;
+    std::vector<Retired> retired;   // in order of increasing epoch
+};
+
+} // namespace QtPrivate
+
+using QtPrivate::QEpochRecord;
+using Retired = QEpochRecord::Retired;
+
+namespace {
+
+struct EpochDomain
+{
+    static constexpr quint64 Active = 1;
+    static constexpr int CollectInterval = 64;
+
+    std::atomic<quint64> epoch = 2;
+    std::atomic<QEpochRecord *> records = nullptr;
+
+    // objects retired by threads that exited before they could be deleted
+    QBasicMutex orphansMutex;
+    std::vector<Retired> *orphans = nullptr;
+
+    QEpochRecord *acquireRecord();
+    QEpochRecord *tryReuseRecord();
+    void releaseRecord(QEpochRecord *record);
+    bool tryAdvance(QEpochRecord *record);
+    void collect(QEpochRecord *record);
+};
+
+Q_CONSTINIT static EpochDomain epochDomain;
+
+// The record is looked up on every QEpochGuard, so keep that a plain pointer;
+// the object with the destructor that releases it only exists for cleanup.
+Q_CONSTINIT static thread_local QEpochRecord *currentEpochRecord = nullptr;
+
+struct ThreadEpochRecordReleaser
+{
+    ~ThreadEpochRecordReleaser()
+    {
+        if (currentEpochRecord)
+            epochDomain.releaseRecord(currentEpochRecord);
+        currentEpochRecord = nullptr;
+    }
+};
+
+static QEpochRecord *localEpochRecord()
+{
+    QEpochRecord *record = currentEpochRecord;
+    if (Q_UNLIKELY(!record)) {
+        static thread_local ThreadEpochRecordReleaser releaser;
+        Q_UNUSED(releaser);
+        record = currentEpochRecord = epochDomain.acquireRecord();
+    }
+    return record;
+}
+
+// Entering a guard must order the announcement of the epoch before any load of
+// a shared pointer. Where the system can do this on behalf of all threads of
+// the process (which is slow, but only needed when advancing the epoch), the
+// readers get away with a compiler barrier: a full fence per guard would stall
+// until all earlier cache misses are resolved.
+static bool registerProcessWideBarrier()
+{
+#ifdef QT_EPOCH_HAVE_MEMBARRIER
+    const long supported = syscall(__NR_membarrier, MEMBARRIER_CMD_QUERY, 0);
+    if (supported < 0 || !(supported & MEMBARRIER_CMD_PRIVATE_EXPEDITED))
+        return false;
+    return syscall(__NR_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0) == 0;
+#else
+    return false;
+#endif
+}
+
+static void processWideBarrier()
+{
+#ifdef QT_EPOCH_HAVE_MEMBARRIER
+    syscall(__NR_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0);
+#endif
+}
+
+static void deleteRetired(const std::vector<Retired> &objects)
+{
+    for (const Retired &r : objects)
+        r.deleter(r.object);
+}
+
+QEpochRecord *EpochDomain::acquireRecord()
+{
+    static const bool useProcessWideBarrier = registerProcessWideBarrier();
+    QEpochRecord *record = tryReuseRecord();
+    if (!record) {
+        record = new QEpochRecord;
+        QEpochRecord *head = records.load(std::memory_order_relaxed);
+        do {
+            record->next = head;
+        } while (!records.compare_exchange_weak(head, record, std::memory_order_release,
+                                                std::memory_order_relaxed));
+    }
+    record->hasProcessWideBarrier = useProcessWideBarrier;
+    return record;
+}
+
+QEpochRecord *EpochDomain::tryReuseRecord()
+{
+    for (QEpochRecord *r = records.load(std::memory_order_acquire); r; r = r->next) {
+        bool expected = false;
+        if (!r->inUse.load(std::memory_order_relaxed)
+            && r->inUse.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            return r;
+        }
+    }
+    return nullptr;
+}
+
+void EpochDomain::releaseRecord(QEpochRecord *record)
+{
+    Q_ASSERT(record->nesting == 0);
+    collect(record);
+    if (!record->retired.empty()) {
+        QMutexLocker locker(&orphansMutex);
+        if (!orphans)
+            orphans = new std::vector<Retired>;
+        orphans->insert(orphans->end(), record->retired.begin(), record->retired.end());
+        record->retired.clear();
+    }
+    record->retired.shrink_to_fit();
+    record->retiredSinceCollect = 0;
+    record->inUse.store(false, std::memory_order_release);
+}
+
+// The epoch can advance once all threads inside a QEpochGuard have observed
+// the current one. Objects retired in epoch E are unreachable for any thread
+// that entered a guard after that, so they can be deleted from epoch E + 2 on.
+bool EpochDomain::tryAdvance(QEpochRecord *record)
+{
+    quint64 current = epoch.load(std::memory_order_relaxed);
+    if (record->hasProcessWideBarrier)
+        processWideBarrier();
+    else
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    for (QEpochRecord *r = records.load(std::memory_order_acquire); r; r = r->next) {
+        const quint64 state = r->state.load(std::memory_order_relaxed);
+        if ((state & Active) && (state >> 1) != current)
+            return false;
+    }
+    return epoch.compare_exchange_strong(current, current + 1, std::memory_order_acq_rel,
+                                         std::memory_order_relaxed);
+}
+
+void EpochDomain::collect(QEpochRecord *record)
+{
+    tryAdvance(record);
+    const quint64 safe = epoch.load(std::memory_order_acquire) - 2;
+
+    // Take the objects out before deleting them: the deleters may retire more.
+    std::vector<Retired> ready;
+    auto isReady = [safe](const Retired &r) { return r.epoch <= safe; };
+    auto end = std::find_if_not(record->retired.begin(), record->retired.end(), isReady);
+    ready.assign(record->retired.begin(), end);
+    record->retired.erase(record->retired.begin(), end);
+
+    if (orphansMutex.tryLock()) {
+        if (orphans) {
+            auto end = std::find_if_not(orphans->begin(), orphans->end(), isReady);
+            ready.insert(ready.end(), orphans->begin(), end);
+            orphans->erase(orphans->begin(), end);
+        }
+        orphansMutex.unlock();
+    }
+    deleteRetired(ready);
+}
+
+} // unnamed namespace
+
+/*!
+    \class QtPrivate::QEpochGuard
+    \internal
+
+    Marks the scope in which the current thread may access memory that other
+    threads can retire with qEpochRetire() concurrently. Objects retired while
+    any thread is inside a QEpochGuard are only deleted after that thread has
+    left it. Guards nest, and entering and leaving one never blocks.
+*/
+QtPrivate::QEpochGuard::QEpochGuard()
+    : record(localEpochRecord())
+{
+    if (record->nesting++ == 0) {
+        // acquire pairs with the release in tryAdvance(): whatever was
+        // unlinked before the epoch we announce is visible to this thread
+        const quint64 epoch = epochDomain.epoch.load(std::memory_order_acquire);
+        record->state.store((epoch << 1) | EpochDomain::Active, std::memory_order_relaxed);
+        // make the announcement visible before we load any shared pointers
+        if (record->hasProcessWideBarrier)
+            std::atomic_signal_fence(std::memory_order_seq_cst);
+        else
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+}
+
+QtPrivate::QEpochGuard::~QEpochGuard()
+{
+    Q_ASSERT(record->nesting > 0);
+    if (--record->nesting == 0)
+        record->state.store(0, std::memory_order_release);
+}
+
+/*!
+    \internal
+
+    Calls \a deleter on \a object once no thread can still be accessing it
+    through a pointer loaded inside a QEpochGuard. \a object must already be
+    unreachable for threads entering a guard from now on.
+
+    Deleting happens lazily, from later calls to this function or when the
+    calling thread exits.
+*/
+void QtPrivate::qEpochRetire(void *object, void (*deleter)(void *))
+{
+    QEpochRecord *record = localEpochRecord();
+    // order the unlinking of object before reading the epoch
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const quint64 epoch = epochDomain.epoch.load(std::memory_order_relaxed);
+    record->retired.push_back({ object, deleter, epoch });
+    if (++record->retiredSinceCollect >= EpochDomain::CollectInterval) {
+        record->retiredSinceCollect = 0;
+        epochDomain.collect(record);
+    }
+}
+
+QT_END_NAMESPACE
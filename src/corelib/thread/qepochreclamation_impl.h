@@ -0,0 +1,40 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#if 0
+#pragma qt_sync_skip_header_check
+#pragma qt_sync_stop_processing
+#endif
+
+#ifndef QEPOCHRECLAMATION_IMPL_H
+#define QEPOCHRECLAMATION_IMPL_H
+
+#include <QtCore/qglobal.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace QtPrivate {
+
+struct QEpochRecord;
+
+// Epoch-based reclamation: memory that lock-free readers may still be looking
+// at is retired instead of deleted, and only deleted once every thread that was
+// inside a QEpochGuard at the time of retiring has left it.
+class Q_CORE_EXPORT QEpochGuard
+{
+public:
+    QEpochGuard();
+    ~QEpochGuard();
+
+private:
+    Q_DISABLE_COPY_MOVE(QEpochGuard)
+    QEpochRecord *record;
+};
+
+Q_CORE_EXPORT void qEpochRetire(void *object, void (*deleter)(void *));
+
+} // namespace QtPrivate
+
+QT_END_NAMESPACE
+
+#endif // QEPOCHRECLAMATION_IMPL_H
@@ -0,0 +1,87 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QREADCOPYUPDATE_H
+#define QREADCOPYUPDATE_H
+
+#include <QtCore/qepochreclamation_impl.h>
+#include <QtCore/qmutex.h>
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+template <typename T>
+class QReadCopyUpdate
+{
+public:
+    class Snapshot
+    {
+    public:
+        const T *get() const noexcept { return data; }
+        const T &operator*() const noexcept { return *data; }
+        const T *operator->() const noexcept { return data; }
+
+    private:
+        friend class QReadCopyUpdate;
+        explicit Snapshot(const QReadCopyUpdate *rcu)
+            : data(rcu->d.load(std::memory_order_acquire))
+        {}
+        Q_DISABLE_COPY_MOVE(Snapshot)
+
+        // the guard must be entered before the data is loaded
+        QtPrivate::QEpochGuard guard;
+        const T *data;
+    };
+
+    QReadCopyUpdate()
+        : d(new T())
+    {}
+    explicit QReadCopyUpdate(const T &value)
+        : d(new T(value))
+    {}
+    explicit QReadCopyUpdate(T &&value)
+        : d(new T(std::move(value)))
+    {}
+    ~QReadCopyUpdate()
+    {
+        delete d.load(std::memory_order_relaxed);
+    }
+
+    Snapshot read() const { return Snapshot(this); }
+    T load() const { return *read(); }
+
+    void store(const T &value) { publish(new T(value)); }
+    void store(T &&value) { publish(new T(std::move(value))); }
+
+    template <typename Function>
+    void update(Function function)
+    {
+        QMutexLocker locker(&writeMutex);
+        std::unique_ptr<T> copy(new T(*d.load(std::memory_order_relaxed)));
+        function(*copy);
+        retire(d.exchange(copy.release(), std::memory_order_acq_rel));
+    }
+
+private:
+    Q_DISABLE_COPY_MOVE(QReadCopyUpdate)
+
+    void publish(T *value)
+    {
+        QMutexLocker locker(&writeMutex);
+        retire(d.exchange(value, std::memory_order_acq_rel));
+    }
+    static void retire(T *value)
+    {
+        QtPrivate::qEpochRetire(value, [](void *p) { delete static_cast<T *>(p); });
+    }
+
+    std::atomic<T *> d;
+    QBasicMutex writeMutex;
+};
+
+QT_END_NAMESPACE
+
+#endif // QREADCOPYUPDATE_H
@@ -82,7 +82,12 @@ static bool contendedTryLockForWrite(QAtomicPointer<QReadWriteLockPrivate> &d_pt
     to lock for reading in a thread that already has locked for
     writing (and vice versa).
 
-    \sa QReadLocker, QWriteLocker, QMutex, QSemaphore
+    Every lockForRead() modifies the lock, so readers running on many CPU
+    cores at once still contend for it. For data that is read far more often
+    than it is written, QReadCopyUpdate lets readers proceed without
+    touching any shared state.
+
+    \sa QReadLocker, QWriteLocker, QMutex, QSemaphore, QReadCopyUpdate
 */
 
 /*!
@@ -8,6 +8,7 @@
 #include "qreadwritelock.h"
 #include "qabstracteventdispatcher.h"
 #include "qbindingstorage.h"
+#include "qyieldcpu.h"
 
 #include <qeventloop.h>
 
@@ -40,6 +41,61 @@ void QPostEventList::addEvent(const QPostEvent &ev)
     }
 }
 
+// Must be called with the mutex locked.
+void QPostEventList::takePendingEvents()
+{
+    PendingEvent *pe = pendingEvents.fetchAndStoreAcquire(nullptr);
+    if (!pe)
+        return;
+
+    // the most recently posted event is on top of the stack
+    PendingEvent *ordered = nullptr;
+    while (pe) {
+        PendingEvent *next = pe->next;
+        pe->next = ordered;
+        ordered = pe;
+        pe = next;
+    }
+    while (ordered) {
+        std::unique_ptr<PendingEvent> current(ordered);
+        ordered = ordered->next;
+        addEvent(current->event);
+    }
+}
+
+// Must be called with the mutex locked. Also waits for producers that
+// decided to post here before the receiver's thread data changed, so that
+// no event can arrive in this list after QObject::moveToThread() moved the
+// receiver's events away, or after removePostedEvents() returned.
+void QPostEventList::waitForPendingEvents()
+{
+    // pairs with the fence in QCoreApplication::postEvent()
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (producers.loadAcquire()) {
+        // Producers only hold their count for a few instructions and never
+        // block meanwhile, so give them a moment before going to sleep.
+        for (int spins = 0; spins < 64 && producers.loadAcquire(); ++spins)
+            qYieldCpu();
+        if (producers.loadAcquire()) {
+            // Only the holder of the mutex waits, so there is one waiter at
+            // most. The last producer to leave sees ProducerWaiter and wakes
+            // us; it takes producersMutex to do so, so it cannot miss us.
+            QMutexLocker locker(&producersMutex);
+            producers.fetchAndOrOrdered(ProducerWaiter);
+            while (producers.loadAcquire() != ProducerWaiter)
+                producersDone.wait(&producersMutex);
+            producers.fetchAndAndRelaxed(~ProducerWaiter);
+        }
+    }
+    takePendingEvents();
+}
+
+void QPostEventList::wakeProducerWaiter() noexcept
+{
+    QMutexLocker locker(&producersMutex);
+    producersDone.wakeAll();
+}
+
 
 /*
   QThreadData
@@ -82,6 +138,7 @@ QThreadData::~QThreadData()
     thread.storeRelease(nullptr);
     delete t;
 
+    postEventList.takePendingEvents();
     for (int i = 0; i < postEventList.size(); ++i) {
         const QPostEvent &pe = postEventList.at(i);
         if (pe.event) {
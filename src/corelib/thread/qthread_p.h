@@ -72,11 +72,50 @@ public:
 
     QMutex mutex;
 
+    // Events that QCoreApplication::postEvent() added without taking the
+    // mutex. Producers push onto this stack while holding a count in
+    // 'producers'; whoever holds the mutex moves the events into the list,
+    // in posting order, before looking at it.
+    struct PendingEvent
+    {
+        QPostEvent event;
+        PendingEvent *next;
+    };
+    QAtomicPointer<PendingEvent> pendingEvents;
+    // the number of producers, plus ProducerWaiter while the holder of the
+    // mutex waits in waitForPendingEvents() for them to finish
+    QAtomicInt producers;
+    static constexpr int ProducerWaiter = 0x40000000;
+    QMutex producersMutex;
+    QWaitCondition producersDone;
+
     inline QPostEventList() : QList<QPostEvent>(), recursion(0), startOffset(0), insertionOffset(0) { }
 
     void addEvent(const QPostEvent &ev);
 
+    void pushPendingEvent(PendingEvent *pe) noexcept
+    { pushPendingEvents(pe, pe); }
+    // pushes the chain from top to bottom, linked through 'next', at once
+    void pushPendingEvents(PendingEvent *top, PendingEvent *bottom) noexcept
+    {
+        PendingEvent *head = pendingEvents.loadRelaxed();
+        do {
+            bottom->next = head;
+        } while (!pendingEvents.testAndSetRelease(head, top, head));
+    }
+    bool hasPendingEvents() const noexcept
+    { return pendingEvents.loadRelaxed() != nullptr; }
+    void releaseProducer() noexcept
+    {
+        if (Q_UNLIKELY(producers.fetchAndSubOrdered(1) == ProducerWaiter + 1))
+            wakeProducerWaiter();
+    }
+    void takePendingEvents();
+    void waitForPendingEvents();
+
 private:
+    void wakeProducerWaiter() noexcept;
+
     //hides because they do not keep that list sorted. addEvent must be used
     using QList<QPostEvent>::append;
     using QList<QPostEvent>::insert;
@@ -317,7 +356,7 @@ public:
     bool canWaitLocked()
     {
         QMutexLocker locker(&postEventList.mutex);
-        return canWait;
+        return canWait && !postEventList.hasPendingEvents();
     }
 
 private:
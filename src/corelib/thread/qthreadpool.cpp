@@ -27,10 +27,18 @@ public:
     QThreadPoolThread(QThreadPoolPrivate *manager);
     void run() override;
     void registerThreadInactive();
+    QRunnable *takeLocalRunnable();
 
     QWaitCondition runnableReady;
     QThreadPoolPrivate *manager;
     QRunnable *runnable;
+
+    // Runnables this thread took from the shared queue in one go, so that it
+    // does not need manager->mutex for each of them. Idle threads steal from
+    // the back. If both are needed, manager->mutex must be locked first.
+    QMutex localMutex;
+    QQueue<QRunnable *> localQueue;
+    int localPriority = 0;
 };
 
 /*
@@ -59,45 +67,65 @@ void QThreadPoolThread::run()
 
         do {
             if (r) {
-                // If autoDelete() is false, r might already be deleted after run(), so check status now.
-                const bool del = r->autoDelete();
-
-                // run the task
+                // run the task, followed by the ones in the local queue
                 locker.unlock();
+                do {
+                    // If autoDelete() is false, r might already be deleted after run(), so check status now.
+                    const bool del = r->autoDelete();
 #ifndef QT_NO_EXCEPTIONS
-                try {
+                    try {
 #endif
-                    r->run();
+                        r->run();
 #ifndef QT_NO_EXCEPTIONS
-                } catch (...) {
-                    qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
-                             "This is not supported, exceptions thrown in worker threads must be\n"
-                             "caught before control returns to Qt Concurrent.");
-                    registerThreadInactive();
-                    throw;
-                }
+                    } catch (...) {
+                        qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
+                                 "This is not supported, exceptions thrown in worker threads must be\n"
+                                 "caught before control returns to Qt Concurrent.");
+                        locker.relock();
+                        manager->requeueLocalRunnables(this);
+                        registerThreadInactive();
+                        throw;
+                    }
 #endif
 
-                if (del)
-                    delete r;
+                    if (del)
+                        delete r;
+                } while ((r = takeLocalRunnable()));
                 locker.relock();
             }
 
             // if too many threads are active, stop working in this one
-            if (manager->tooManyThreadsActive())
+            if (manager->tooManyThreadsActive()) {
+                manager->requeueLocalRunnables(this);
                 break;
+            }
 
-            // all work is done, time to wait for more
-            if (manager->queue.isEmpty())
-                break;
+            if (manager->queue.isEmpty()) {
+                // finish the local queue, then help the other threads with theirs
+                {
+                    QMutexLocker localLocker(&localMutex);
+                    if (!localQueue.isEmpty()) {
+                        r = localQueue.dequeue();
+                        continue;
+                    }
+                }
+                r = manager->stealRunnable(this);
+
+                // all work is done, time to wait for more
+                if (!r)
+                    break;
+                continue;
+            }
 
             QueuePage *page = manager->queue.constFirst();
             r = page->pop();
+            manager->fillLocalQueue(this, page);
 
             if (page->isFinished()) {
                 manager->queue.removeFirst();
                 delete page;
             }
+            manager->updateQueuedPriority();
         } while (true);
 
         // this thread is about to be deleted, do not wait or expire
@@ -135,6 +163,22 @@ void QThreadPoolThread::registerThreadInactive()
         manager->noActiveThreads.wakeAll();
 }
 
+/*
+    \internal
+
+    Returns the next runnable from this thread's local queue without locking
+    manager->mutex, or \nullptr if the local queue is empty or if runnables
+    with a higher priority have been queued in the meantime.
+*/
+QRunnable *QThreadPoolThread::takeLocalRunnable()
+{
+    if (manager->queuedPriority.loadRelaxed() > localPriority)
+        return nullptr;
+
+    QMutexLocker locker(&localMutex);
+    return localQueue.isEmpty() ? nullptr : localQueue.dequeue();
+}
+
 
 /*
     \internal
@@ -200,6 +244,123 @@ void QThreadPoolPrivate::enqueueTask(QRunnable *runnable, int priority)
     }
     auto it = std::upper_bound(queue.constBegin(), queue.constEnd(), priority, comparePriority);
     queue.insert(std::distance(queue.constBegin(), it), new QueuePage(runnable, priority));
+    updateQueuedPriority();
+}
+
+void QThreadPoolPrivate::updateQueuedPriority()
+{
+    queuedPriority.storeRelaxed(queue.isEmpty() ? std::numeric_limits<int>::min()
+                                                : queue.constFirst()->priority());
+}
+
+/*!
+    \internal
+
+    Moves a batch of runnables from \a page to the local queue of \a thread.
+    The thread can then run them without locking the mutex each time. mutex
+    must be locked.
+
+    The batch grows with the share of the page that falls to each thread,
+    but never drops below a fixed minimum: otherwise pools with many threads
+    would take single runnables, as a page never holds more than a few
+    hundred. Threads that run out of work steal from the local queues, so a
+    batch taken while there is little work does not leave the others idle.
+*/
+void QThreadPoolPrivate::fillLocalQueue(QThreadPoolThread *thread, QueuePage *page)
+{
+    constexpr int MinLocalBatch = 4;
+    constexpr int MaxLocalBatch = 16;
+    const int batch = qBound(MinLocalBatch, page->size() / (2 * maxThreadCount()), MaxLocalBatch);
+
+    QMutexLocker locker(&thread->localMutex);
+    if (!thread->localQueue.isEmpty())
+        return;
+
+    thread->localPriority = page->priority();
+    for (int i = 0; i < batch && !page->isFinished(); ++i)
+        thread->localQueue.enqueue(page->pop());
+}
+
+/*!
+    \internal
+
+    Puts the runnables in the local queue of \a thread back at the front of
+    the shared queue, e.g. because the thread is about to stop working.
+    mutex must be locked.
+*/
+void QThreadPoolPrivate::requeueLocalRunnables(QThreadPoolThread *thread)
+{
+    QMutexLocker locker(&thread->localMutex);
+    if (thread->localQueue.isEmpty())
+        return;
+
+    const int priority = thread->localPriority;
+    auto page = std::make_unique<QueuePage>(thread->localQueue.dequeue(), priority);
+    while (!thread->localQueue.isEmpty())
+        page->push(thread->localQueue.dequeue());
+
+    // in front of the pages with the same priority, as these runnables were queued earlier
+    auto it = std::find_if(queue.constBegin(), queue.constEnd(), [priority](const QueuePage *p) {
+        return p->priority() <= priority;
+    });
+    queue.insert(std::distance(queue.constBegin(), it), page.release());
+    updateQueuedPriority();
+}
+
+/*!
+    \internal
+
+    Returns the thread other than \a except with the longest local queue, or
+    \nullptr if all local queues are empty. mutex must be locked.
+*/
+QThreadPoolThread *QThreadPoolPrivate::busiestThread(const QThreadPoolThread *except)
+{
+    QThreadPoolThread *busiest = nullptr;
+    qsizetype busiestSize = 0;
+    for (QThreadPoolThread *thread : std::as_const(allThreads)) {
+        if (thread == except)
+            continue;
+        QMutexLocker locker(&thread->localMutex);
+        if (thread->localQueue.size() > busiestSize) {
+            busiest = thread;
+            busiestSize = thread->localQueue.size();
+        }
+    }
+    return busiest;
+}
+
+/*!
+    \internal
+
+    Takes half of the local queue of the busiest other thread, moves it to the
+    local queue of \a thief and returns the first runnable of it. Returns
+    \nullptr if no thread has runnables to spare. mutex must be locked.
+*/
+QRunnable *QThreadPoolPrivate::stealRunnable(QThreadPoolThread *thief)
+{
+    QThreadPoolThread *victim = busiestThread(thief);
+    if (!victim)
+        return nullptr;
+
+    QList<QRunnable *> stolen;
+    int priority;
+    {
+        QMutexLocker locker(&victim->localMutex);
+        // the victim may have made progress since we looked
+        const qsizetype count = (victim->localQueue.size() + 1) / 2;
+        if (count == 0)
+            return nullptr;
+        stolen = victim->localQueue.sliced(victim->localQueue.size() - count);
+        victim->localQueue.resize(victim->localQueue.size() - count);
+        priority = victim->localPriority;
+    }
+
+    QMutexLocker locker(&thief->localMutex);
+    Q_ASSERT(thief->localQueue.isEmpty());
+    thief->localPriority = priority;
+    for (qsizetype i = 1; i < stolen.size(); ++i)
+        thief->localQueue.enqueue(stolen.at(i));
+    return stolen.constFirst();
 }
 
 int QThreadPoolPrivate::activeThreadCount() const
@@ -210,10 +371,39 @@ int QThreadPoolPrivate::activeThreadCount() const
             + reservedThreads);
 }
 
+/*!
+    \internal
+
+    Moves the last runnable of the longest local queue to the shared queue,
+    so that a thread that becomes available can start it. Returns \c false
+    if all local queues are empty. mutex must be locked.
+*/
+bool QThreadPoolPrivate::requeueStolenRunnable()
+{
+    QThreadPoolThread *victim = busiestThread();
+    if (!victim)
+        return false;
+
+    QRunnable *runnable;
+    int priority;
+    {
+        QMutexLocker locker(&victim->localMutex);
+        // the victim may have made progress since we looked
+        if (victim->localQueue.isEmpty())
+            return false;
+        runnable = victim->localQueue.takeLast();
+        priority = victim->localPriority;
+    }
+    enqueueTask(runnable, priority);
+    return true;
+}
+
 void QThreadPoolPrivate::tryToStartMoreThreads()
 {
-    // try to push tasks on the queue to any available threads
-    while (!queue.isEmpty()) {
+    // try to push tasks on the queue to any available threads, followed by
+    // the ones that busy threads hold in their local queues: a runnable that
+    // released its thread may be waiting for one of those
+    while (!queue.isEmpty() || (!areAllThreadsActive() && requeueStolenRunnable())) {
         QueuePage *page = queue.constFirst();
         if (!tryStart(page->first()))
             break;
@@ -225,6 +415,7 @@ void QThreadPoolPrivate::tryToStartMoreThreads()
             delete page;
         }
     }
+    updateQueuedPriority();
 }
 
 bool QThreadPoolPrivate::areAllThreadsActive() const
@@ -308,6 +499,8 @@ bool QThreadPoolPrivate::waitForDone(const QDeadlineTimer &timer)
 void QThreadPoolPrivate::clear()
 {
     QMutexLocker locker(&mutex);
+    for (QThreadPoolThread *thread : std::as_const(allThreads))
+        requeueLocalRunnables(thread);
     while (!queue.isEmpty()) {
         auto *page = queue.takeLast();
         while (!page->isFinished()) {
@@ -320,6 +513,7 @@ void QThreadPoolPrivate::clear()
         }
         delete page;
     }
+    updateQueuedPriority();
 }
 
 /*!
@@ -352,11 +546,18 @@ bool QThreadPool::tryTake(QRunnable *runnable)
             if (page->isFinished()) {
                 d->queue.removeOne(page);
                 delete page;
+                d->updateQueuedPriority();
             }
             return true;
         }
     }
 
+    for (QThreadPoolThread *thread : std::as_const(d->allThreads)) {
+        QMutexLocker localLocker(&thread->localMutex);
+        if (thread->localQueue.removeOne(runnable))
+            return true;
+    }
+
     return false;
 }
 
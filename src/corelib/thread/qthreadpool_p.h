@@ -24,6 +24,8 @@
 #include "QtCore/qqueue.h"
 #include "private/qobject_p.h"
 
+#include <limits>
+
 QT_REQUIRE_CONFIG(thread);
 
 QT_BEGIN_NAMESPACE
@@ -43,6 +45,9 @@ public:
 
     bool isFinished() { return m_firstIndex > m_lastIndex; }
 
+    // upper bound, entries removed by tryTake() are still counted
+    int size() const { return m_lastIndex - m_firstIndex + 1; }
+
     void push(QRunnable *runnable)
     {
         Q_ASSERT(runnable != nullptr);
@@ -133,6 +138,13 @@ public:
     void stealAndRunRunnable(QRunnable *runnable);
     void deletePageIfFinished(QueuePage *page);
 
+    void updateQueuedPriority();
+    void fillLocalQueue(QThreadPoolThread *thread, QueuePage *page);
+    void requeueLocalRunnables(QThreadPoolThread *thread);
+    QRunnable *stealRunnable(QThreadPoolThread *thief);
+    QThreadPoolThread *busiestThread(const QThreadPoolThread *except = nullptr);
+    bool requeueStolenRunnable();
+
     static QThreadPool *qtGuiInstance();
 
     mutable QMutex mutex;
@@ -140,6 +152,9 @@ public:
     QQueue<QThreadPoolThread *> waitingThreads;
     QQueue<QThreadPoolThread *> expiredThreads;
     QList<QueuePage *> queue;
+    // priority of the first queued runnable, or INT_MIN if the queue is
+    // empty; lets workers check for more urgent work without locking mutex
+    QAtomicInt queuedPriority = std::numeric_limits<int>::min();
     QWaitCondition noActiveThreads;
     QString objectName;
 
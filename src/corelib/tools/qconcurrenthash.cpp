@@ -0,0 +1,145 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qconcurrenthash.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QConcurrentHash
+    \inmodule QtCore
+    \since 6.10
+    \brief The QConcurrentHash class is a template class that provides a hash table that can
+    be accessed from several threads at once.
+
+    \ingroup tools
+    \threadsafe
+
+    QConcurrentHash\<Key, T\> stores pairs of keys and values, like QHash does,
+    but all of its member functions can be called from any number of threads
+    concurrently without further synchronization. It is meant for data that is
+    shared between threads and read much more often than it is modified, such
+    as caches, where a QHash protected by a QReadWriteLock makes all readers
+    contend for the lock.
+
+    Looking keys up with value() and contains() does not lock and never waits
+    for other threads, not even for threads that are modifying the hash at
+    the same time. Modifications with insert(), tryInsert() and remove() lock
+    one of several stripes of the hash, so that threads that modify
+    different keys usually do not wait for each other either.
+
+    Keys are hashed with qHash() and the global seed (see QHashSeed), so a key
+    type that can be used with QHash can also be used with QConcurrentHash.
+    The value type must be copyable: as another thread may be reading a
+    value while it is being replaced, values are returned by value and are
+    copied when the hash grows.
+
+    Memory of removed and replaced entries is reclaimed lazily, once no thread
+    can be reading them anymore. The destructor must not run concurrently
+    with any other member function.
+
+    QConcurrentHash does not provide iterators, as entries can be added and
+    removed at any time by other threads.
+
+    \sa QHash, QReadWriteLock
+*/
+
+/*! \fn template <typename Key, typename T> QConcurrentHash<Key, T>::QConcurrentHash()
+
+    Constructs an empty hash.
+*/
+
+/*! \fn template <typename Key, typename T> QConcurrentHash<Key, T>::QConcurrentHash(qsizetype capacity)
+
+    Constructs an empty hash with space for at least \a capacity entries.
+
+    \sa reserve()
+*/
+
+/*! \fn template <typename Key, typename T> QConcurrentHash<Key, T>::~QConcurrentHash()
+
+    Destroys the hash. No other thread may be using the hash at this point.
+*/
+
+/*! \fn template <typename Key, typename T> qsizetype QConcurrentHash<Key, T>::size() const
+
+    Returns the number of entries in the hash.
+
+    If other threads modify the hash at the same time, the returned number
+    may already be outdated.
+
+    \sa isEmpty(), count()
+*/
+
+/*! \fn template <typename Key, typename T> qsizetype QConcurrentHash<Key, T>::count() const
+
+    Same as size().
+*/
+
+/*! \fn template <typename Key, typename T> bool QConcurrentHash<Key, T>::isEmpty() const
+
+    Returns \c true if the hash contains no entries; otherwise returns \c false.
+
+    \sa size()
+*/
+
+/*! \fn template <typename Key, typename T> bool QConcurrentHash<Key, T>::contains(const Key &key) const
+
+    Returns \c true if the hash contains an entry with the \a key; otherwise
+    returns \c false.
+
+    This function does not lock.
+
+    \sa value()
+*/
+
+/*! \fn template <typename Key, typename T> T QConcurrentHash<Key, T>::value(const Key &key, const T &defaultValue) const
+
+    Returns a copy of the value associated with the \a key, or \a defaultValue
+    if the hash contains no entry with the \a key.
+
+    This function does not lock.
+
+    \sa contains()
+*/
+
+/*! \fn template <typename Key, typename T> void QConcurrentHash<Key, T>::insert(const Key &key, const T &value)
+    \fn template <typename Key, typename T> void QConcurrentHash<Key, T>::insert(const Key &key, T &&value)
+
+    Inserts a new entry with the \a key and the \a value. If there already is
+    an entry with the \a key, its value is replaced.
+
+    \sa tryInsert(), remove()
+*/
+
+/*! \fn template <typename Key, typename T> bool QConcurrentHash<Key, T>::tryInsert(const Key &key, const T &value)
+    \fn template <typename Key, typename T> bool QConcurrentHash<Key, T>::tryInsert(const Key &key, T &&value)
+
+    Inserts a new entry with the \a key and the \a value, unless there already
+    is an entry with the \a key. Returns \c true if the entry was inserted.
+
+    \sa insert()
+*/
+
+/*! \fn template <typename Key, typename T> bool QConcurrentHash<Key, T>::remove(const Key &key)
+
+    Removes the entry with the \a key from the hash. Returns \c true if there
+    was such an entry; otherwise returns \c false.
+
+    \sa clear()
+*/
+
+/*! \fn template <typename Key, typename T> void QConcurrentHash<Key, T>::clear()
+
+    Removes all entries from the hash.
+
+    \sa remove()
+*/
+
+/*! \fn template <typename Key, typename T> void QConcurrentHash<Key, T>::reserve(qsizetype size)
+
+    Makes sure that the hash has space for at least \a size entries, so that
+    inserting that many entries does not need to grow it.
+*/
+
+QT_END_NAMESPACE
@@ -0,0 +1,276 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QCONCURRENTHASH_H
+#define QCONCURRENTHASH_H
+
+#include <QtCore/qepochreclamation_impl.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+
+#include <atomic>
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+template <typename Key, typename T>
+class QConcurrentHash
+{
+    // Nodes are never modified once they are reachable by readers: replacing
+    // a value links a new node in place of the old one.
+    struct Node
+    {
+        template <typename K, typename V>
+        Node(size_t h, K &&k, V &&v)
+            : hash(h), key(std::forward<K>(k)), value(std::forward<V>(v))
+        {}
+
+        std::atomic<Node *> next = nullptr;
+        const size_t hash;
+        const Key key;
+        const T value;
+    };
+
+    struct Table
+    {
+        explicit Table(size_t n)
+            : numBuckets(n), buckets(new std::atomic<Node *>[n]())
+        {}
+        ~Table()
+        {
+            for (size_t i = 0; i < numBuckets; ++i) {
+                Node *n = buckets[i].load(std::memory_order_relaxed);
+                while (n) {
+                    Node *next = n->next.load(std::memory_order_relaxed);
+                    delete n;
+                    n = next;
+                }
+            }
+        }
+        std::atomic<Node *> &bucket(size_t hash) const noexcept
+        {
+            return buckets[hash & (numBuckets - 1)];
+        }
+
+        const size_t numBuckets;
+        const std::unique_ptr<std::atomic<Node *>[]> buckets;
+    };
+
+    // Writers lock the stripe of the key's hash; as the number of buckets is a
+    // multiple of NStripes, all keys of a bucket belong to the same stripe.
+    // Rehashing and clearing lock all stripes.
+    static constexpr size_t NStripes = 32;
+    struct alignas(64) Stripe
+    {
+        QBasicMutex mutex;
+        std::atomic<qsizetype> count = 0;
+    };
+
+    std::atomic<Table *> table;
+    Stripe stripes[NStripes];
+    const size_t seed = QHashSeed::globalSeed();
+
+    class AllStripesLocker
+    {
+    public:
+        explicit AllStripesLocker(QConcurrentHash *h) : d(h)
+        {
+            for (Stripe &s : d->stripes)
+                s.mutex.lock();
+        }
+        ~AllStripesLocker()
+        {
+            for (Stripe &s : d->stripes)
+                s.mutex.unlock();
+        }
+
+    private:
+        Q_DISABLE_COPY_MOVE(AllStripesLocker)
+        QConcurrentHash *d;
+    };
+
+    static size_t bucketsForCapacity(qsizetype size) noexcept
+    {
+        size_t n = NStripes;
+        while (n < size_t(size))
+            n *= 2;
+        return n;
+    }
+
+    static void retire(Node *n)
+    {
+        QtPrivate::qEpochRetire(n, [](void *p) { delete static_cast<Node *>(p); });
+    }
+    static void retire(Table *t)
+    {
+        QtPrivate::qEpochRetire(t, [](void *p) { delete static_cast<Table *>(p); });
+    }
+
+    const Node *findNode(const Key &key, size_t hash) const noexcept
+    {
+        const Table *t = table.load(std::memory_order_acquire);
+        const Node *n = t->bucket(hash).load(std::memory_order_acquire);
+        while (n) {
+            if (n->hash == hash && qHashEquals(n->key, key))
+                return n;
+            n = n->next.load(std::memory_order_acquire);
+        }
+        return nullptr;
+    }
+
+    template <typename V>
+    bool insertImpl(const Key &key, V &&value, bool replace)
+    {
+        const size_t hash = QHashPrivate::calculateHash(key, seed);
+        Stripe &stripe = stripes[hash % NStripes];
+        size_t bucketsNeeded = 0;
+        {
+            QMutexLocker locker(&stripe.mutex);
+            // the table cannot be replaced while we hold a stripe
+            Table *t = table.load(std::memory_order_relaxed);
+            std::atomic<Node *> *link = &t->bucket(hash);
+            for (Node *n = link->load(std::memory_order_relaxed); n;
+                 link = &n->next, n = link->load(std::memory_order_relaxed)) {
+                if (n->hash != hash || !qHashEquals(n->key, key))
+                    continue;
+                if (!replace)
+                    return false;
+                Node *node = new Node(hash, key, std::forward<V>(value));
+                node->next.store(n->next.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                link->store(node, std::memory_order_release);
+                retire(n);
+                return true;
+            }
+
+            std::atomic<Node *> &head = t->bucket(hash);
+            Node *node = new Node(hash, key, std::forward<V>(value));
+            node->next.store(head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            head.store(node, std::memory_order_release);
+
+            const qsizetype count = stripe.count.load(std::memory_order_relaxed) + 1;
+            stripe.count.store(count, std::memory_order_relaxed);
+            if (size_t(count) * NStripes > t->numBuckets)
+                bucketsNeeded = t->numBuckets * 2;
+        }
+        if (bucketsNeeded)
+            rehash(bucketsNeeded);
+        return true;
+    }
+
+    void rehash(size_t numBuckets)
+    {
+        Table *old;
+        {
+            AllStripesLocker locker(this);
+            old = table.load(std::memory_order_relaxed);
+            if (old->numBuckets >= numBuckets)
+                return;
+
+            // readers may be walking the old table, so copy the nodes
+            // instead of relinking them
+            std::unique_ptr<Table> t(new Table(numBuckets));
+            for (size_t i = 0; i < old->numBuckets; ++i) {
+                const Node *n = old->buckets[i].load(std::memory_order_relaxed);
+                for (; n; n = n->next.load(std::memory_order_relaxed)) {
+                    std::atomic<Node *> &head = t->bucket(n->hash);
+                    Node *node = new Node(n->hash, n->key, n->value);
+                    node->next.store(head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                    head.store(node, std::memory_order_relaxed);
+                }
+            }
+            table.store(t.release(), std::memory_order_release);
+        }
+        retire(old);
+    }
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using size_type = qsizetype;
+
+    QConcurrentHash()
+        : table(new Table(NStripes))
+    {}
+    explicit QConcurrentHash(qsizetype capacity)
+        : table(new Table(bucketsForCapacity(capacity)))
+    {}
+    ~QConcurrentHash()
+    {
+        delete table.load(std::memory_order_relaxed);
+    }
+
+    qsizetype size() const noexcept
+    {
+        qsizetype total = 0;
+        for (const Stripe &s : stripes)
+            total += s.count.load(std::memory_order_relaxed);
+        return total;
+    }
+    qsizetype count() const noexcept { return size(); }
+    bool isEmpty() const noexcept { return size() == 0; }
+
+    bool contains(const Key &key) const
+    {
+        const size_t hash = QHashPrivate::calculateHash(key, seed);
+        QtPrivate::QEpochGuard guard;
+        return findNode(key, hash) != nullptr;
+    }
+    T value(const Key &key, const T &defaultValue = T()) const
+    {
+        const size_t hash = QHashPrivate::calculateHash(key, seed);
+        QtPrivate::QEpochGuard guard;
+        if (const Node *n = findNode(key, hash))
+            return n->value;
+        return defaultValue;
+    }
+
+    void insert(const Key &key, const T &value) { insertImpl(key, value, true); }
+    void insert(const Key &key, T &&value) { insertImpl(key, std::move(value), true); }
+    bool tryInsert(const Key &key, const T &value) { return insertImpl(key, value, false); }
+    bool tryInsert(const Key &key, T &&value) { return insertImpl(key, std::move(value), false); }
+
+    bool remove(const Key &key)
+    {
+        const size_t hash = QHashPrivate::calculateHash(key, seed);
+        Stripe &stripe = stripes[hash % NStripes];
+        QMutexLocker locker(&stripe.mutex);
+        Table *t = table.load(std::memory_order_relaxed);
+        std::atomic<Node *> *link = &t->bucket(hash);
+        for (Node *n = link->load(std::memory_order_relaxed); n;
+             link = &n->next, n = link->load(std::memory_order_relaxed)) {
+            if (n->hash != hash || !qHashEquals(n->key, key))
+                continue;
+            link->store(n->next.load(std::memory_order_relaxed), std::memory_order_release);
+            stripe.count.store(stripe.count.load(std::memory_order_relaxed) - 1,
+                               std::memory_order_relaxed);
+            retire(n);
+            return true;
+        }
+        return false;
+    }
+
+    void clear()
+    {
+        Table *old;
+        {
+            AllStripesLocker locker(this);
+            old = table.load(std::memory_order_relaxed);
+            table.store(new Table(NStripes), std::memory_order_release);
+            for (Stripe &s : stripes)
+                s.count.store(0, std::memory_order_relaxed);
+        }
+        retire(old);
+    }
+
+    void reserve(qsizetype size)
+    {
+        rehash(bucketsForCapacity(size));
+    }
+
+private:
+    Q_DISABLE_COPY_MOVE(QConcurrentHash)
+};
+
+QT_END_NAMESPACE
+
+#endif // QCONCURRENTHASH_H
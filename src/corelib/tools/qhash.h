@@ -684,6 +684,11 @@ struct Data
                 QHashHeterogeneousSearch<std::remove_cv_t<Key>, K>::value);
         Q_ASSERT(numBuckets > 0);
         size_t hash = QHashPrivate::calculateHash(key, seed);
+        return findBucketWithHash(key, hash);
+    }
+
+    template <typename K> Bucket findBucketWithHash(const K &key, size_t hash) const noexcept
+    {
         Bucket bucket(this, GrowthPolicy::bucketForHash(numBuckets, hash));
         // loop over the buckets until we find the entry we search for
         // or an empty slot, in which case we know the entry doesn't exist
@@ -717,14 +722,18 @@ struct Data
     template <typename K> InsertionResult findOrInsert(const K &key) noexcept
     {
         Bucket it(static_cast<Span *>(nullptr), 0);
+        size_t hash = 0;
         if (numBuckets > 0) {
-            it = findBucket(key);
+            hash = QHashPrivate::calculateHash(key, seed);
+            it = findBucketWithHash(key, hash);
             if (!it.isUnused())
                 return { it.toIterator(this), true };
         }
         if (shouldGrow()) {
             rehash(size + 1);
-            it = findBucket(key); // need to get a new iterator after rehashing
+            // need to get a new iterator after rehashing; rehash() keeps
+            // the seed, so the hash is still valid if we calculated it
+            it = it.span ? findBucketWithHash(key, hash) : findBucket(key);
         }
         Q_ASSERT(it.span != nullptr);
         Q_ASSERT(it.isUnused());
@@ -85,6 +85,13 @@ void BitOStream::write(QByteArrayView src, bool compressed)
     }
 }
 
+void BitOStream::writeOctets(QByteArrayView octets)
+{
+    Q_ASSERT(!(bitsSet % 8));
+    buffer.insert(buffer.end(), octets.begin(), octets.end());
+    bitsSet += quint64(octets.size()) * 8;
+}
+
 quint64 BitOStream::bitLength() const
 {
     return bitsSet;
@@ -270,6 +277,7 @@ bool BitIStream::read(QByteArray *dstPtr)
             }
 
             BitIStream slice(first + offset / 8, first + offset / 8 + len);
+            dst.resize(0); // Replace the contents like above, but keep the capacity.
             if (huffman_decode_string(slice, &dst)) {
                 offset += quint64(len) * 8;
                 return true;
@@ -51,9 +51,14 @@ public:
 
     void clear();
 
+    // Appends already encoded octets, must be on a byte boundary:
+    void writeOctets(QByteArrayView octets);
+
 private:
     Q_DISABLE_COPY_MOVE(BitOStream);
 
+    friend void huffman_encode_string(QByteArrayView inputData, BitOStream &outputStream);
+
     std::vector<uchar> &buffer;
     quint64 bitsSet;
 };
@@ -135,6 +140,8 @@ public:
 private:
     void setError(Error newState);
 
+    friend bool huffman_decode_string(BitIStream &inputStream, QByteArray *outputBuffer);
+
     const uchar *first;
     const uchar *last;
     quint64 offset;
@@ -152,6 +152,24 @@ bool Encoder::encodeResponse(BitOStream &outputStream, const HttpHeader &header)
     return true;
 }
 
+bool Encoder::encodeRequest(BitOStream &outputStream, const HttpHeader &header,
+                            const PreEncodedHeaders &commonHeaders)
+{
+    if (!encodeRequest(outputStream, header))
+        return false;
+    outputStream.writeOctets(commonHeaders.encoded());
+    return true;
+}
+
+bool Encoder::encodeResponse(BitOStream &outputStream, const HttpHeader &header,
+                             const PreEncodedHeaders &commonHeaders)
+{
+    if (!encodeResponse(outputStream, header))
+        return false;
+    outputStream.writeOctets(commonHeaders.encoded());
+    return true;
+}
+
 bool Encoder::encodeSizeUpdate(BitOStream &outputStream, quint32 newSize)
 {
     if (!lookupTable.updateDynamicTableSize(newSize)) {
@@ -370,6 +388,35 @@ bool Encoder::encodeLiteralField(BitOStream &outputStream, BitPattern fieldType,
     return true;
 }
 
+std::optional<PreEncodedHeaders> PreEncodedHeaders::encode(const HttpHeader &header,
+                                                           bool compressStrings)
+{
+    PreEncodedHeaders result;
+    BitOStream outputStream(result.encodedData);
+    for (const HeaderField &field : header) {
+        if (field.name.startsWith(':')) {
+            qCritical() << "pseudo-header" << field.name << "cannot be pre-encoded";
+            return std::nullopt;
+        }
+
+        if (const auto index = FieldLookupTable::indexOfStatic(field.name, field.value)) {
+            write_bit_pattern(Indexed, outputStream);
+            outputStream.write(index);
+            continue;
+        }
+
+        // Literal without indexing, with an indexed name if possible:
+        write_bit_pattern(LiteralNoIndexing, outputStream);
+        const auto nameIndex = FieldLookupTable::indexOfStatic(field.name);
+        outputStream.write(nameIndex);
+        if (!nameIndex)
+            outputStream.write(field.name, compressStrings);
+        outputStream.write(field.value, compressStrings);
+    }
+    result.fields = header;
+    return result;
+}
+
 Decoder::Decoder(quint32 size)
     : lookupTable{size, false /* we do not need search index ... */}
 {
@@ -32,6 +32,30 @@ namespace HPack
 using HttpHeader = std::vector<HeaderField>;
 HeaderSize header_size(const HttpHeader &header);
 struct BitPattern;
+
+// A part of a header block, encoded once and then appended to the header
+// blocks of any number of requests or responses, on any connection.
+// It only refers to the static table and its fields are not indexed,
+// so it neither depends on nor changes the dynamic table of an encoder.
+// Pseudo-headers must precede all other fields, so they cannot be part of it.
+class Q_AUTOTEST_EXPORT PreEncodedHeaders
+{
+public:
+    PreEncodedHeaders() = default;
+
+    static std::optional<PreEncodedHeaders> encode(const HttpHeader &header,
+                                                   bool compressStrings = true);
+
+    bool isEmpty() const { return fields.empty(); }
+    const HttpHeader &header() const { return fields; }
+    QByteArrayView encoded() const
+    { return QByteArrayView(encodedData.data(), qsizetype(encodedData.size())); }
+
+private:
+    HttpHeader fields;
+    std::vector<uchar> encodedData;
+};
+
 class Q_AUTOTEST_EXPORT Encoder
 {
 public:
@@ -41,8 +65,14 @@ public:
 
     bool encodeRequest(class BitOStream &outputStream,
                        const HttpHeader &header);
+    bool encodeRequest(BitOStream &outputStream,
+                       const HttpHeader &header,
+                       const PreEncodedHeaders &commonHeaders);
     bool encodeResponse(BitOStream &outputStream,
                         const HttpHeader &header);
+    bool encodeResponse(BitOStream &outputStream,
+                        const HttpHeader &header,
+                        const PreEncodedHeaders &commonHeaders);
 
     bool encodeSizeUpdate(BitOStream &outputStream,
                           quint32 newSize);
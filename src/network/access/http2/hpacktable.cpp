@@ -5,9 +5,6 @@
 
 #include <QtCore/qdebug.h>
 
-#include <algorithm>
-#include <cstddef>
-#include <cstring>
 #include <limits>
 
 
@@ -34,81 +31,11 @@ HeaderSize entry_size(QByteArrayView name, QByteArrayView value)
     return HeaderSize(true, quint32(sum + 32));
 }
 
-namespace
-{
-
-int compare(const QByteArray &lhs, const QByteArray &rhs)
-{
-    if (const int minLen = std::min(lhs.size(), rhs.size())) {
-        // We use memcmp, since strings in headers are allowed
-        // to contain '\0'.
-        const int cmp = std::memcmp(lhs.constData(), rhs.constData(), std::size_t(minLen));
-        if (cmp)
-            return cmp;
-    }
-
-    return lhs.size() - rhs.size();
-}
-
-} // unnamed namespace
-
-FieldLookupTable::SearchEntry::SearchEntry()
-    : field(),
-      chunk(),
-      offset(),
-      table()
-{
-}
-
-FieldLookupTable::SearchEntry::SearchEntry(const HeaderField *f,
-                                           const Chunk *c,
-                                           quint32 o,
-                                           const FieldLookupTable *t)
-    : field(f),
-      chunk(c),
-      offset(o),
-      table(t)
-{
-    Q_ASSERT(field);
-}
-
-bool FieldLookupTable::SearchEntry::operator < (const SearchEntry &rhs)const
-{
-    Q_ASSERT(field);
-    Q_ASSERT(rhs.field);
-
-    int cmp = compare(field->name, rhs.field->name);
-    if (cmp)
-        return cmp < 0;
-
-    cmp = compare(field->value, rhs.field->value);
-    if (cmp)
-        return cmp < 0;
-
-    if (!chunk) // 'this' is not in the searchIndex.
-        return rhs.chunk;
-
-    if (!rhs.chunk) // not in the searchIndex.
-        return false;
-
-    Q_ASSERT(table);
-    Q_ASSERT(rhs.table == table);
-
-    const quint32 leftChunkIndex = table->indexOfChunk(chunk);
-    const quint32 rightChunkIndex = rhs.table->indexOfChunk(rhs.chunk);
-
-    // Later added - smaller is chunk index (since we push_front).
-    if (leftChunkIndex != rightChunkIndex)
-        return leftChunkIndex > rightChunkIndex;
-
-    // Later added - smaller is offset.
-    return offset > rhs.offset;
-}
-
 FieldLookupTable::FieldLookupTable(quint32 maxSize, bool use)
     : maxTableSize(maxSize),
       tableCapacity(maxSize),
       useIndex(use),
+      insertionCount(),
       nDynamic(),
       begin(),
       end(),
@@ -148,10 +75,10 @@ bool FieldLookupTable::prependField(const QByteArray &name, const QByteArray &va
     newField.value = value;
 
     if (useIndex) {
-        const auto result = searchIndex.insert(frontKey());
-        Q_UNUSED(result);
-        Q_ASSERT(result.second);
+        fieldIndex.insert({ name, value }, insertionCount);
+        nameIndex.insert(name, insertionCount);
     }
+    ++insertionCount;
 
     return true;
 }
@@ -163,13 +90,20 @@ void FieldLookupTable::evictEntry()
 
     Q_ASSERT(end != begin);
 
+    const HeaderField &field = back();
     if (useIndex) {
-        const auto res = searchIndex.erase(backKey());
-        Q_UNUSED(res);
-        Q_ASSERT(res == 1);
+        // Only forget the entry if there is no newer duplicate:
+        const quint64 insertion = insertionCount - nDynamic;
+        const auto pos = fieldIndex.constFind({ field.name, field.value });
+        Q_ASSERT(pos != fieldIndex.cend());
+        if (pos.value() == insertion)
+            fieldIndex.erase(pos);
+        const auto namePos = nameIndex.constFind(field.name);
+        Q_ASSERT(namePos != nameIndex.cend());
+        if (namePos.value() == insertion)
+            nameIndex.erase(namePos);
     }
 
-    const HeaderField &field = back();
     const auto entrySize = entry_size(field);
     Q_ASSERT(entrySize.first);
     Q_ASSERT(dataSize >= entrySize.second);
@@ -209,7 +143,8 @@ quint32 FieldLookupTable::dynamicDataSize() const
 
 void FieldLookupTable::clearDynamicTable()
 {
-    searchIndex.clear();
+    fieldIndex.clear();
+    nameIndex.clear();
     chunks.clear();
     begin = 0;
     end = 0;
@@ -225,13 +160,8 @@ bool FieldLookupTable::indexIsValid(quint32 index) const
 quint32 FieldLookupTable::indexOf(const QByteArray &name, const QByteArray &value)const
 {
     // Start from the static part first:
-    const auto &table = staticPart();
-    const HeaderField field(name, value);
-    const auto staticPos = findInStaticPart(field, CompareMode::nameAndValue);
-    if (staticPos != table.end()) {
-        if (staticPos->name == name && staticPos->value == value)
-            return quint32(staticPos - table.begin() + 1);
-    }
+    if (const quint32 index = indexOfStatic(name, value))
+        return index;
 
     // Now we have to lookup in our dynamic part ...
     if (!useIndex) {
@@ -239,27 +169,15 @@ quint32 FieldLookupTable::indexOf(const QByteArray &name, const QByteArray &valu
         return 0;
     }
 
-    const SearchEntry key(&field, nullptr, 0, this);
-    const auto pos = searchIndex.lower_bound(key);
-    if (pos != searchIndex.end()) {
-        const HeaderField &found = *pos->field;
-        if (found.name == name && found.value == value)
-            return keyToIndex(*pos);
-    }
-
-    return 0;
+    const auto pos = fieldIndex.constFind({ name, value });
+    return pos != fieldIndex.cend() ? dynamicIndex(pos.value()) : 0;
 }
 
 quint32 FieldLookupTable::indexOf(const QByteArray &name) const
 {
     // Start from the static part first:
-    const auto &table = staticPart();
-    const HeaderField field(name, QByteArray());
-    const auto staticPos = findInStaticPart(field, CompareMode::nameOnly);
-    if (staticPos != table.end()) {
-        if (staticPos->name == name)
-            return quint32(staticPos - table.begin() + 1);
-    }
+    if (const quint32 index = indexOfStatic(name))
+        return index;
 
     // Now we have to lookup in our dynamic part ...
     if (!useIndex) {
@@ -267,15 +185,8 @@ quint32 FieldLookupTable::indexOf(const QByteArray &name) const
         return 0;
     }
 
-    const SearchEntry key(&field, nullptr, 0, this);
-    const auto pos = searchIndex.lower_bound(key);
-    if (pos != searchIndex.end()) {
-        const HeaderField &found = *pos->field;
-        if (found.name == name)
-            return keyToIndex(*pos);
-    }
-
-    return 0;
+    const auto pos = nameIndex.constFind(name);
+    return pos != nameIndex.cend() ? dynamicIndex(pos.value()) : 0;
 }
 
 bool FieldLookupTable::field(quint32 index, QByteArray *name, QByteArray *value) const
@@ -339,46 +250,10 @@ const HeaderField &FieldLookupTable::back() const
     return (*chunks[chunkIndex])[offset];
 }
 
-quint32 FieldLookupTable::indexOfChunk(const Chunk *chunk) const
-{
-    Q_ASSERT(chunk);
-
-    for (size_type i = 0; i < chunks.size(); ++i) {
-        if (chunks[i].get() == chunk)
-            return quint32(i);
-    }
-
-    Q_UNREACHABLE_RETURN(0);
-}
-
-quint32 FieldLookupTable::keyToIndex(const SearchEntry &key) const
+quint32 FieldLookupTable::dynamicIndex(quint64 insertion) const
 {
-    Q_ASSERT(key.chunk);
-
-    const auto chunkIndex = indexOfChunk(key.chunk);
-    const auto offset = key.offset;
-    Q_ASSERT(offset < ChunkSize);
-    Q_ASSERT(chunkIndex || offset >= begin);
-
-    return quint32(offset + chunkIndex * ChunkSize - begin + 1 + staticPart().size());
-}
-
-FieldLookupTable::SearchEntry FieldLookupTable::frontKey() const
-{
-    Q_ASSERT(chunks.size() && end != begin);
-    return SearchEntry(&front(), chunks.front().get(), begin, this);
-}
-
-FieldLookupTable::SearchEntry FieldLookupTable::backKey() const
-{
-    Q_ASSERT(chunks.size() && end != begin);
-
-    const HeaderField &field = back();
-    const quint32 absIndex = end - 1;
-    const auto offset = absIndex % ChunkSize;
-    const auto chunk = chunks[absIndex / ChunkSize].get();
-
-    return SearchEntry(&field, chunk, offset, this);
+    Q_ASSERT(insertion < insertionCount && insertionCount - insertion <= nDynamic);
+    return quint32(insertionCount - insertion + staticPart().size());
 }
 
 bool FieldLookupTable::updateDynamicTableSize(quint32 size)
@@ -409,8 +284,7 @@ void FieldLookupTable::setMaxDynamicTableSize(quint32 size)
     updateDynamicTableSize(size);
 }
 
-// This data is from the HPACK's specs and it's quite conveniently sorted,
-// except ... 'accept' is in the wrong position, see how we handle it below.
+// This data is from the HPACK's specs, lookups go through staticPartIndex().
 const std::vector<HeaderField> &FieldLookupTable::staticPart()
 {
     static std::vector<HeaderField> table = {
@@ -480,30 +354,42 @@ const std::vector<HeaderField> &FieldLookupTable::staticPart()
     return table;
 }
 
-std::vector<HeaderField>::const_iterator FieldLookupTable::findInStaticPart(const HeaderField &field, CompareMode mode)
+namespace
 {
-    const auto &table = staticPart();
-    const auto acceptPos = table.begin() + 18;
-    if (field.name == "accept") {
-        if (mode == CompareMode::nameAndValue && field.value != "")
-            return table.end();
-        return acceptPos;
+
+struct StaticPartIndex
+{
+    StaticPartIndex()
+    {
+        const auto &table = FieldLookupTable::staticPart();
+        for (quint32 i = 0; i < quint32(table.size()); ++i) {
+            fields.insert({ table[i].name, table[i].value }, i + 1);
+            // Several entries share a name, the first one wins:
+            if (!names.contains(table[i].name))
+                names.insert(table[i].name, i + 1);
+        }
     }
 
-    auto predicate = [mode](const HeaderField &lhs, const HeaderField &rhs) {
-        const int cmp = compare(lhs.name, rhs.name);
-        if (cmp)
-            return cmp < 0;
-        else if (mode == CompareMode::nameAndValue)
-            return compare(lhs.value, rhs.value) < 0;
-        return false;
-    };
+    QHash<std::pair<QByteArray, QByteArray>, quint32> fields;
+    QHash<QByteArray, quint32> names;
+};
 
-    const auto staticPos = std::lower_bound(table.begin(), acceptPos, field, predicate);
-    if (staticPos != acceptPos)
-        return staticPos;
+const StaticPartIndex &staticPartIndex()
+{
+    static const StaticPartIndex index;
+    return index;
+}
+
+} // unnamed namespace
 
-    return std::lower_bound(acceptPos + 1, table.end(), field, predicate);
+quint32 FieldLookupTable::indexOfStatic(const QByteArray &name, const QByteArray &value)
+{
+    return staticPartIndex().fields.value({ name, value });
+}
+
+quint32 FieldLookupTable::indexOfStatic(const QByteArray &name)
+{
+    return staticPartIndex().names.value(name);
 }
 
 }
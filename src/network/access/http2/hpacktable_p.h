@@ -16,11 +16,11 @@
 //
 
 #include <QtCore/qbytearray.h>
+#include <QtCore/qhash.h>
 
 #include <vector>
 #include <memory>
 #include <deque>
-#include <set>
 #include <utility>
 
 QT_BEGIN_NAMESPACE
@@ -86,24 +86,20 @@ inline HeaderSize entry_size(const HeaderField &entry)
     Given a 'linear' index we can find a chunk number and
     offset in this chunk - random access.
 
-    Lookup in a static part is straightforward:
-    it's an (immutable) vector, data is sorted,
-    contains no duplicates, we use binary search comparing string values.
-
-    To provide a lookup in dynamic table faster than a linear search,
-    we have an std::set of 'SearchEntries', where each entry contains:
-     - a pointer to a (name|value) pair (to compare
-       name|value strings).
-     - a pointer to a chunk containing this pair and
-     - an offset within this chunk - to calculate a
-       'linear' index.
-
-    Entries in a table can be duplicated (HPACK, 2.3.2),
-    if we evict an entry, we must update our index removing
-    the exactly right key, thus keys in this set are sorted
-    by name|value pairs first, and then by chunk index/offset
-    (so that NewSearchEntryKey < OldSearchEntry even if strings
-    are equal).
+    Lookups, in both the static and the dynamic part, are hash lookups
+    by name|value pair or by name only.
+
+    The static part's hashes are built once, they map to the lowest
+    index of a pair/name.
+
+    Entries in the dynamic part are numbered in the order they were
+    inserted: the most recent entry has the lowest index, so an entry's
+    index follows from its number and the number of the most recent
+    entry. The dynamic part's hashes map to the number of the most recent
+    entry with that pair/name. Entries in a table can be duplicated
+    (HPACK, 2.3.2): since entries are always evicted from the back (they
+    are the oldest), we remove an evicted entry from the hashes only if
+    they still refer to it (that is, there is no newer duplicate).
 */
 
 class Q_AUTOTEST_EXPORT FieldLookupTable
@@ -137,6 +133,8 @@ public:
     void setMaxDynamicTableSize(quint32 size);
 
     static const std::vector<HeaderField> &staticPart();
+    static quint32 indexOfStatic(const QByteArray &name, const QByteArray &value);
+    static quint32 indexOfStatic(const QByteArray &name);
 
 private:
     // Table's maximum size is controlled
@@ -153,28 +151,14 @@ private:
     std::deque<ChunkPtr> chunks;
     using size_type = std::deque<ChunkPtr>::size_type;
 
-    struct SearchEntry;
-    friend struct SearchEntry;
-
-    struct SearchEntry
-    {
-        SearchEntry();
-        SearchEntry(const HeaderField *f, const Chunk *c,
-                    quint32 o, const FieldLookupTable *t);
-
-        const HeaderField *field;
-        const Chunk *chunk;
-        const quint32 offset;
-        const FieldLookupTable *table;
-
-        bool operator < (const SearchEntry &rhs) const;
-    };
-
     bool useIndex;
-    std::set<SearchEntry> searchIndex;
+    // Number of entries inserted in the dynamic part so far, the front
+    // entry is number insertionCount - 1:
+    quint64 insertionCount;
+    QHash<std::pair<QByteArray, QByteArray>, quint64> fieldIndex;
+    QHash<QByteArray, quint64> nameIndex;
 
-    SearchEntry frontKey() const;
-    SearchEntry backKey() const;
+    quint32 dynamicIndex(quint64 insertion) const;
 
     bool fieldAt(quint32 index, HeaderField *field) const;
 
@@ -187,16 +171,6 @@ private:
     quint32 end;
     quint32 dataSize;
 
-    quint32 indexOfChunk(const Chunk *chunk) const;
-    quint32 keyToIndex(const SearchEntry &key) const;
-
-    enum class CompareMode {
-        nameOnly,
-        nameAndValue
-    };
-
-    static std::vector<HeaderField>::const_iterator findInStaticPart(const HeaderField &field, CompareMode mode);
-
     mutable QByteArray dummyDst;
 
     Q_DISABLE_COPY_MOVE(FieldLookupTable)
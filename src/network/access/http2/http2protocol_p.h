@@ -116,6 +116,11 @@ const qint32 maxSessionReceiveWindowSize((quint32(1) << 31) - 1);
 // Presumably, we never use up to 100 streams so let it be 10 simultaneous:
 const qint32 qtDefaultStreamReceiveWindowSize = maxSessionReceiveWindowSize / 10;
 
+// Upper limits for receive windows grown from the estimated bandwidth-delay
+// product (QHttp2Configuration::setAdaptiveReceiveWindowEnabled()):
+const qint32 maxAdaptiveStreamReceiveWindowSize(16 * 1024 * 1024);
+const qint32 maxAdaptiveSessionReceiveWindowSize(64 * 1024 * 1024);
+
 struct Frame Q_AUTOTEST_EXPORT configurationToSettingsFrame(const QHttp2Configuration &configuration);
 QByteArray settingsFrameToBase64(const Frame &settingsFrame);
 void appendProtocolUpgradeHeaders(const QHttp2Configuration &configuration, QHttpNetworkRequest *request);
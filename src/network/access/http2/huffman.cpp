@@ -6,7 +6,7 @@
 
 #include <QtCore/qbytearray.h>
 
-#include <algorithm>
+#include <array>
 #include <limits>
 
 QT_BEGIN_NAMESPACE
@@ -24,32 +24,21 @@ namespace HPack
     code length. All codes were left-aligned - for implementation
     convenience.
 
-    Using binary trees to implement decoding would be prohibitively
-    expensive (both memory and time-wise). Instead we use a table-based
-    approach and any given code itself works as an index into such table(s).
-    We have 256 possible byte values and code lengths in
-    a range [5, 26]. This would require a huge table (and most of entries
-    would be 'wasted', since we only have to encode 256 elements).
-    Instead we use multi-level tables. The first level table
-    is using 9-bit length index; some entries in this table are 'terminal',
-    some reference the next level table(s).
-
-    For example, bytes with values 48 and 49 (ASCII codes for '0' and '1')
-    both have code length 5, Huffman codes are: 00000 and 00001. They
-    both are placed in the 'root' table,
-    the 'root' table has index length == 9:
-    [00000 | 4 remaining bits]
-     ...
-    [00001 | 4 remaining bits]
-
-    All entries with indices between these two will 'point' to value 48
-    with bitLength == 5 so that bit stream (for example) 000001010 will be
-    decoded as: 48 + "put 1010 back into bitstream".
-
-    A good description can be found here:
-    http://commandlinefanatic.com/cgi-bin/showarticle.cgi?article=art007
-    or just google "Efficient Huffman Decoding".
-    Also see comments below about 'filling holes'.
+    Decoding walks the code tree 4 bits at a time: every inner node
+    of the tree is a state of a finite state machine and for every state
+    and each of the 16 possible 4-bit inputs we precompute the next state
+    and the byte value decoded on the way, if any. The shortest code is 5
+    bits long, so 4 bits never complete more than one code. A byte of the
+    input is then decoded with two table lookups, instead of walking the
+    tree bit by bit. The tree has 256 inner nodes (for 257 symbols,
+    including EOS), so the table has 256 * 16 entries.
+
+    At the end of the input the machine must be either in the root state,
+    or in a state reached by at most 7 one-bits - that's the padding
+    (HPACK, 5.2). Reaching EOS is an error.
+
+    Encoding appends codes to a 64-bit accumulator and stores whole bytes
+    from it, instead of writing codes into the stream bit by bit.
 */
 
 namespace
@@ -316,30 +305,6 @@ const CodeEntry staticHuffmanCodeTable[]
     {256, 0xfffffffcul, 30}   // EOS 11111111|11111111|11111111|111111
 };
 
-void write_huffman_code(BitOStream &outputStream, CodeEntry code)
-{
-    // Append octet by octet.
-    auto bitLength = code.bitLength;
-    const auto hc = code.huffmanCode >> (32 - bitLength);
-
-    if (bitLength > 24) {
-        outputStream.writeBits(uchar(hc >> 24), bitLength - 24);
-        bitLength = 24;
-    }
-
-    if (bitLength > 16) {
-        outputStream.writeBits(uchar(hc >> 16), bitLength - 16);
-        bitLength = 16;
-    }
-
-    if (bitLength > 8) {
-        outputStream.writeBits(uchar(hc >> 8), bitLength - 8);
-        bitLength = 8;
-    }
-
-    outputStream.writeBits(uchar(hc), bitLength);
-}
-
 }
 
 // That's from HPACK's specs - we deal with octets.
@@ -348,191 +313,142 @@ static_assert(std::numeric_limits<uchar>::digits == 8, "octets expected");
 quint64 huffman_encoded_bit_length(QByteArrayView inputData)
 {
     quint64 bitLength = 0;
-    for (int i = 0, e = inputData.size(); i < e; ++i)
-        bitLength += staticHuffmanCodeTable[int(inputData[i])].bitLength;
+    for (char c : inputData)
+        bitLength += staticHuffmanCodeTable[uchar(c)].bitLength;
 
     return bitLength;
 }
 
 void huffman_encode_string(QByteArrayView inputData, BitOStream &outputStream)
 {
-    for (int i = 0, e = inputData.size(); i < e; ++i) {
-        const auto value = uchar(inputData[i]);
-        write_huffman_code(outputStream, staticHuffmanCodeTable[value]);
+    std::vector<uchar> &buffer = outputStream.buffer;
+    // Bits not yet stored in 'buffer', the least significant 'pendingBits' of them:
+    quint64 pending = 0;
+    quint32 pendingBits = outputStream.bitsSet % 8;
+    if (pendingBits) {
+        // Continue the partially used byte:
+        pending = buffer.back() >> (8 - pendingBits);
+        buffer.pop_back();
     }
 
-    // Pad bits ...
-    if (outputStream.bitLength() % 8)
-        outputStream.writeBits(0xff, 8 - outputStream.bitLength() % 8);
-}
+    const quint64 totalBits = pendingBits + huffman_encoded_bit_length(inputData);
+    const size_t startPos = buffer.size();
+    buffer.resize(startPos + (totalBits + 7) / 8);
+    uchar *dst = buffer.data() + startPos;
+
+    for (char c : inputData) {
+        const CodeEntry &code = staticHuffmanCodeTable[uchar(c)];
+        // At most 7 + 30 bits, the bits shifted out were stored already:
+        pending = (pending << code.bitLength) | (code.huffmanCode >> (32 - code.bitLength));
+        pendingBits += code.bitLength;
+        while (pendingBits >= 8) {
+            pendingBits -= 8;
+            *dst++ = uchar(pending >> pendingBits);
+        }
+    }
 
-static constexpr
-bool padding_is_valid(quint32 chunk, quint32 nBits)
-{
-    Q_ASSERT(nBits);
+    // Pad bits ...
+    if (pendingBits)
+        *dst++ = uchar(pending << (8 - pendingBits)) | uchar(0xff >> pendingBits);
+    Q_ASSERT(dst == buffer.data() + buffer.size());
 
-    // HPACK, 5.2: "A padding strictly longer than 7 bits MUST be
-    // treated as a decoding error."
-    if (nBits > 7)
-        return false;
-    // HPACK, 5.2:
-    // "A padding not corresponding to the most significant bits
-    // of the code for the EOS symbol MUST be treated as a decoding error."
-    return (chunk >> (32 - nBits)) == quint32((1 << nBits) - 1);
+    outputStream.bitsSet = quint64(buffer.size()) * 8;
 }
 
 HuffmanDecoder::HuffmanDecoder()
-    : minCodeLength()
 {
-    const auto nCodes = sizeof staticHuffmanCodeTable / sizeof staticHuffmanCodeTable[0];
-
-    std::vector<CodeEntry> symbols(staticHuffmanCodeTable, staticHuffmanCodeTable + nCodes);
-    // Now we sort: by bit length first (in the descending order) and by the symbol
-    // value (descending). Descending order: to make sure we do not create prefix tables with
-    // short 'indexLength' first and having longer codes that do not fit into such tables later.
-    std::sort(symbols.begin(), symbols.end(), [](CodeEntry code1, CodeEntry code2) {
-        if (code1.bitLength == code2.bitLength)
-            return code1.byteValue > code2.byteValue;
-        return code1.bitLength > code2.bitLength;
-    });
-
-    minCodeLength = symbols.back().bitLength; // The shortest one, currently it's 5.
-
-    // TODO: add a verification - Huffman codes
-    // within a given bit length range also
-    // should be in descending order.
-
-    // Initialize 'prefixTables' and 'tableData'.
-    addTable(0, quint32(BitConstants::rootPrefix)); // 'root' table.
-
-    for (const auto &s : symbols) {
-        quint32 tableIndex = 0;
-        while (true) {
-            Q_ASSERT(tableIndex < prefixTables.size());
-            // Note, by value - since prefixTables will be updated in between.
-            const auto table = prefixTables[tableIndex];
-            // We skip prefixed bits (if any) and use indexed bits only:
-            const auto entryIndex = s.huffmanCode << table.prefixLength >> (32 - table.indexLength);
-            // Again, by value.
-            PrefixTableEntry entry = tableEntry(table, entryIndex);
-            // How many bits were coded by previous tables and this table:
-            const auto codedLength = table.prefixLength + table.indexLength;
-            if (codedLength < s.bitLength) {
-                // We have to add a new prefix table ... (if it's not done yet).
-                if (!entry.bitLength) {
-                    entry.nextTable = addTable(codedLength, std::min<quint32>(quint32(BitConstants::childPrefix),
-                                                                              s.bitLength - codedLength));
-                    entry.bitLength = s.bitLength;
-                    entry.byteValue = s.byteValue;
-                    setTableEntry(table, entryIndex, entry);
-                }
-                tableIndex = entry.nextTable;
+    // Build the code tree first. Inner nodes refer to their children
+    // by index, leaves are stored as -(byteValue + 1):
+    std::vector<std::array<qint16, 2>> nodes(1);
+    for (const CodeEntry &code : staticHuffmanCodeTable) {
+        quint32 node = 0;
+        for (quint32 i = 0; i < code.bitLength; ++i) {
+            const quint32 bit = (code.huffmanCode >> (31 - i)) & 1;
+            if (i + 1 == code.bitLength) {
+                nodes[node][bit] = qint16(-qint16(code.byteValue) - 1);
             } else {
-                // We found the slot for our code (terminal entry):
-                entry.byteValue = s.byteValue;
-                entry.bitLength = s.bitLength;
-                // Refer to our own table as 'nextTable':
-                entry.nextTable = tableIndex;
-                setTableEntry(table, entryIndex, entry);
-                break;
+                if (!nodes[node][bit]) {
+                    nodes[node][bit] = qint16(nodes.size());
+                    nodes.push_back({});
+                }
+                node = nodes[node][bit];
             }
         }
     }
+    Q_ASSERT(nodes.size() == StateCount);
 
-    // Now, we have a table(s) and have to fill 'holes' to
-    // 'fix' terminal entries.
-    for (const auto &table : prefixTables) {
-        const quint32 codedLength = table.prefixLength + table.indexLength;
-        for (quint32 j = 0; j < table.size();) {
-            const PrefixTableEntry &entry = tableEntry(table, j);
-            if (entry.bitLength && entry.bitLength < codedLength) {
-                const quint32 range = 1 << (codedLength - entry.bitLength);
-                for (quint32 k = 1; k < range; ++k)
-                    setTableEntry(table, j + k, entry);
-                j += range;
-            } else {
-                ++j;
+    // States reached by at most 7 one-bits are valid padding (HPACK, 5.2):
+    std::array<bool, StateCount> validPadding = {};
+    for (qint16 node = 0, depth = 0; depth < 8; ++depth, node = nodes[node][1]) {
+        Q_ASSERT(node >= 0);
+        validPadding[node] = true;
+    }
+
+    for (quint32 state = 0; state < nodes.size(); ++state) {
+        for (quint32 input = 0; input < 16; ++input) {
+            Transition &transition = transitions[state][input];
+            qint16 node = qint16(state);
+            for (int i = 3; i >= 0; --i) {
+                node = nodes[node][(input >> i) & 1];
+                if (node >= 0)
+                    continue;
+                const qint16 byteValue = qint16(-node - 1);
+                if (byteValue == 256) { // EOS
+                    transition.flags = Failure;
+                    break;
+                }
+                Q_ASSERT(!(transition.flags & Emit)); // The shortest code has 5 bits
+                transition.byteValue = uchar(byteValue);
+                transition.flags |= Emit;
+                node = 0;
             }
+            if (transition.flags & Failure)
+                continue;
+            transition.state = uchar(node);
+            if (validPadding[node])
+                transition.flags |= Accepting;
         }
     }
 }
 
-bool HuffmanDecoder::decodeStream(BitIStream &inputStream, QByteArray &outputBuffer)
+bool HuffmanDecoder::decodeStream(QByteArrayView input, QByteArray &outputBuffer) const
 {
-    while (true) {
-        quint32 chunk = 0;
-        const quint32 readBits = inputStream.peekBits(inputStream.streamOffset(), 32, &chunk);
-        if (!readBits)
-            return !inputStream.hasMoreBits();
-
-        if (readBits < minCodeLength) {
-            inputStream.skipBits(readBits);
-            return padding_is_valid(chunk, readBits);
-        }
-
-        quint32 tableIndex = 0;
-        const PrefixTable *table = &prefixTables[tableIndex];
-        quint32 entryIndex = chunk >> (32 - table->indexLength);
-        PrefixTableEntry entry = tableEntry(*table, entryIndex);
-
-        while (true) {
-            if (entry.nextTable == tableIndex)
-                break;
-
-            tableIndex = entry.nextTable;
-            table = &prefixTables[tableIndex];
-            entryIndex = chunk << table->prefixLength >> (32 - table->indexLength);
-            entry = tableEntry(*table, entryIndex);
-        }
-
-        if (entry.bitLength > readBits) {
-            inputStream.skipBits(readBits);
-            return padding_is_valid(chunk, readBits);
-        }
-
-        if (!entry.bitLength || entry.byteValue == 256) {
-            //EOS (256) == compression error (HPACK).
-            inputStream.skipBits(readBits);
-            return false;
+    // The shortest code is 5 bits long:
+    const qsizetype startPos = outputBuffer.size();
+    outputBuffer.resize(startPos + input.size() * 8 / 5);
+    char *dst = outputBuffer.data() + startPos;
+
+    uchar state = 0;
+    bool accepting = true;
+    for (char c : input) {
+        for (uchar nibble : { uchar(uchar(c) >> 4), uchar(c & 0xf) }) {
+            const Transition transition = transitions[state][nibble];
+            if (transition.flags & Failure) {
+                outputBuffer.truncate(startPos);
+                return false;
+            }
+            if (transition.flags & Emit)
+                *dst++ = char(transition.byteValue);
+            state = transition.state;
+            accepting = transition.flags & Accepting;
         }
-
-        outputBuffer.append(entry.byteValue);
-        inputStream.skipBits(entry.bitLength);
     }
 
-    return false;
-}
-
-quint32 HuffmanDecoder::addTable(quint32 prefix, quint32 index)
-{
-    PrefixTable newTable{prefix, index};
-    newTable.offset = quint32(tableData.size());
-    prefixTables.push_back(newTable);
-    // Add entries for this table:
-    tableData.resize(tableData.size() + newTable.size());
-
-    return quint32(prefixTables.size() - 1);
-}
-
-PrefixTableEntry HuffmanDecoder::tableEntry(PrefixTable table, quint32 index)
-{
-    Q_ASSERT(index < table.size());
-    return tableData[table.offset + index];
-}
-
-void HuffmanDecoder::setTableEntry(PrefixTable table, quint32 index,
-                                   PrefixTableEntry entry)
-{
-    Q_ASSERT(index < table.size());
-    tableData[table.offset + index] = entry;
+    outputBuffer.truncate(dst - outputBuffer.constData());
+    return accepting;
 }
 
 bool huffman_decode_string(BitIStream &inputStream, QByteArray *outputBuffer)
 {
     Q_ASSERT(outputBuffer);
-
-    static HuffmanDecoder decoder;
-    return decoder.decodeStream(inputStream, *outputBuffer);
+    Q_ASSERT(!(inputStream.offset % 8));
+
+    static const HuffmanDecoder decoder;
+    const uchar *begin = inputStream.first + inputStream.offset / 8;
+    const bool result = decoder.decodeStream(QByteArrayView(begin, inputStream.last),
+                                             *outputBuffer);
+    inputStream.offset = inputStream.bitLength();
+    return result;
 }
 
 }
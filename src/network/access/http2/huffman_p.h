@@ -34,91 +34,34 @@ class BitOStream;
 quint64 huffman_encoded_bit_length(QByteArrayView inputData);
 void huffman_encode_string(QByteArrayView inputData, BitOStream &outputStream);
 
-// PrefixTable:
-// Huffman codes with a small bit length
-// fit into a table (these are 'terminal' symbols),
-// codes with longer codes require additional
-// tables, so several symbols will have the same index
-// in a table - pointing into the next table.
-// Every table has an 'indexLength' - that's
-// how many bits can fit in table's indices +
-// 'prefixLength' - how many bits were addressed
-// by its 'parent' table(s).
-// All PrefixTables are kept in 'prefixTables' array.
-// PrefixTable itself does not have any entries,
-// it just holds table's prefix/index + 'offset' -
-// there table's data starts in an array of all
-// possible entries ('tableData').
-
-struct PrefixTable
-{
-    PrefixTable()
-        : prefixLength(),
-          indexLength(),
-          offset()
-    {
-    }
-
-    PrefixTable(quint32 prefix, quint32 index)
-        : prefixLength(prefix),
-          indexLength(index),
-          offset()
-    {
-    }
-
-    quint32 size()const
-    {
-        // Number of entries table contains:
-        return 1 << indexLength;
-    }
-
-    quint32 prefixLength;
-    quint32 indexLength;
-    quint32 offset;
-};
-
-// Table entry is either a terminal entry (thus probably the code found)
-// or points into another table ('nextTable' - index into
-// 'prefixTables' array). If it's a terminal, 'nextTable' index
-// refers to the same table.
-
-struct PrefixTableEntry
-{
-    PrefixTableEntry()
-        : bitLength(),
-          nextTable(),
-          byteValue()
-    {
-    }
-
-    quint32 bitLength;
-    quint32 nextTable;
-    quint32 byteValue;
-};
-
 class BitIStream;
 
+// Decodes 4 bits at a time, see the comments in huffman.cpp:
 class HuffmanDecoder
 {
 public:
-    enum class BitConstants
-    {
-        rootPrefix = 9,
-        childPrefix = 6
-    };
-
     HuffmanDecoder();
 
-    bool decodeStream(BitIStream &inputStream, QByteArray &outputBuffer);
+    bool decodeStream(QByteArrayView input, QByteArray &outputBuffer) const;
 
 private:
-    quint32 addTable(quint32 prefixLength, quint32 indexLength);
-    PrefixTableEntry tableEntry(PrefixTable table, quint32 index);
-    void setTableEntry(PrefixTable table, quint32 index, PrefixTableEntry entry);
+    enum TransitionFlag : uchar
+    {
+        Emit = 0x1,      // byteValue was decoded
+        Accepting = 0x2, // the input may end in this state
+        Failure = 0x4    // EOS was decoded
+    };
+
+    struct Transition
+    {
+        uchar state = 0;
+        uchar byteValue = 0;
+        uchar flags = 0;
+    };
 
-    std::vector<PrefixTable> prefixTables;
-    std::vector<PrefixTableEntry> tableData;
-    quint32 minCodeLength;
+    // Every inner node of the code tree is a state:
+    static constexpr int StateCount = 256;
+    Transition transitions[StateCount][16];
 };
 
 bool huffman_decode_string(BitIStream &inputStream, QByteArray *outputBuffer);
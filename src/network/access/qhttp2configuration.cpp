@@ -67,6 +67,7 @@ public:
     unsigned maxFrameSize = Http2::minPayloadLimit; // Initial (default) value of 16Kb.
 
     bool pushEnabled = false;
+    bool adaptiveReceiveWindow = false;
     // TODO: for now those two below are noop.
     bool huffmanCompressionEnabled = true;
 };
@@ -81,6 +82,7 @@ public:
         \li Window size for connection-level flow control is 65535 octets
         \li Window size for stream-level flow control is 65535 octets
         \li Frame size is 16384 octets
+        \li Adaptive receive windows are disabled
     \endlist
 */
 QHttp2Configuration::QHttp2Configuration()
@@ -253,6 +255,43 @@ unsigned QHttp2Configuration::maxFrameSize() const
     return d->maxFrameSize;
 }
 
+/*!
+    \since 6.10
+
+    If \a enable is \c true, the receive windows start at
+    sessionReceiveWindowSize() and streamReceiveWindowSize() and grow while
+    the peer keeps using them up faster than one round trip allows: the
+    bandwidth-delay product of the connection is estimated from the round
+    trip time measured with PING frames and the rate at which data arrives.
+    This lets a transfer approach the link speed without committing large
+    buffers to every stream up front. Stream windows grow to at most
+    16 MiB and the connection window to at most 64 MiB, unless configured
+    larger.
+
+    The default is \c false.
+
+    \note QNetworkAccessManager does not use this setting yet.
+
+    \sa adaptiveReceiveWindowEnabled(), setStreamReceiveWindowSize()
+*/
+void QHttp2Configuration::setAdaptiveReceiveWindowEnabled(bool enable)
+{
+    d->adaptiveReceiveWindow = enable;
+}
+
+/*!
+    \since 6.10
+
+    Returns \c true if the receive windows grow with the estimated
+    bandwidth-delay product of the connection.
+
+    \sa setAdaptiveReceiveWindowEnabled()
+*/
+bool QHttp2Configuration::adaptiveReceiveWindowEnabled() const
+{
+    return d->adaptiveReceiveWindow;
+}
+
 /*!
     Swaps this configuration with the \a other configuration.
 */
@@ -284,7 +323,8 @@ bool QHttp2Configuration::isEqual(const QHttp2Configuration &other) const noexce
     return d->pushEnabled == other.d->pushEnabled
            && d->huffmanCompressionEnabled == other.d->huffmanCompressionEnabled
            && d->sessionWindowSize == other.d->sessionWindowSize
-           && d->streamWindowSize == other.d->streamWindowSize;
+           && d->streamWindowSize == other.d->streamWindowSize
+           && d->adaptiveReceiveWindow == other.d->adaptiveReceiveWindow;
 }
 
 QT_END_NAMESPACE
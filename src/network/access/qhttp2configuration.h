@@ -39,6 +39,9 @@ public:
     bool setMaxFrameSize(unsigned size);
     unsigned maxFrameSize() const;
 
+    void setAdaptiveReceiveWindowEnabled(bool enable);
+    bool adaptiveReceiveWindowEnabled() const;
+
     void swap(QHttp2Configuration &other) noexcept;
 
 private:
@@ -358,6 +358,7 @@ bool QHttp2Stream::sendDATA(QNonContiguousByteDevice *device, bool endStream)
             getConnection(), m_streamID, device);
     m_uploadByteDevice = device;
     m_endStreamAfterDATA = endStream;
+    m_sentEND_STREAM = false;
     connect(m_uploadByteDevice, &QNonContiguousByteDevice::readyRead, this,
             &QHttp2Stream::maybeResumeUpload);
     connect(m_uploadByteDevice, &QObject::destroyed, this, &QHttp2Stream::uploadDeviceDestroyed);
@@ -368,12 +369,23 @@ bool QHttp2Stream::sendDATA(QNonContiguousByteDevice *device, bool endStream)
     return true;
 }
 
+static void writeFrameHeader(char *dst, FrameType type, FrameFlags flags, quint32 streamID,
+                             quint32 payloadSize)
+{
+    Q_ASSERT(payloadSize <= quint32(maxPayloadSize));
+    dst[0] = char(payloadSize >> 16);
+    dst[1] = char(payloadSize >> 8);
+    dst[2] = char(payloadSize);
+    dst[3] = char(type);
+    dst[4] = char(flags.toInt());
+    qToBigEndian(streamID, dst + 5);
+}
+
 void QHttp2Stream::internalSendDATA()
 {
     Q_ASSERT(m_uploadByteDevice);
     QHttp2Connection *connection = getConnection();
     Q_ASSERT(connection->maxFrameSize > frameHeaderSize);
-    QIODevice *socket = connection->getSocket();
 
     qCDebug(qHttp2ConnectionLog,
             "[%p] stream %u, about to write to socket, current session window size: %d, stream "
@@ -381,87 +393,154 @@ void QHttp2Stream::internalSendDATA()
             connection, m_streamID, connection->sessionSendWindowSize, m_sendWindow,
             m_uploadByteDevice->size() - m_uploadByteDevice->pos());
 
-    qint32 remainingWindowSize = std::min<qint32>(connection->sessionSendWindowSize, m_sendWindow);
-    FrameWriter &frameWriter = connection->frameWriter;
+    if (connection->m_sendScheduled) {
+        // Other streams are waiting for their share of the session window,
+        // do not jump the queue:
+        connection->scheduleDATA(this);
+        return;
+    }
+
+    // Collect all frames and write them to the socket at once:
+    QByteArray batch;
     qint64 totalBytesWritten = 0;
-    const auto deviceCanRead = [this, connection] {
-        // We take advantage of knowing the internals of one of the devices used.
-        // It will request X bytes to move over to the http thread if there's
-        // not enough left, so we give it a large size. It will anyway return
-        // the size it can actually provide.
-        const qint64 requestSize = connection->maxFrameSize * 10ll;
-        qint64 tmp = 0;
-        return m_uploadByteDevice->readPointer(requestSize, tmp) != nullptr && tmp > 0;
-    };
+    while (const qint32 bytesWritten = appendDATAFrame(batch, nextDATAFrameSize()))
+        totalBytesWritten += bytesWritten;
+    appendEndOfDATA(batch);
 
-    bool sentEND_STREAM = false;
-    while (remainingWindowSize && deviceCanRead()) {
-        quint32 bytesWritten = 0;
-        qint32 remainingBytesInFrame = qint32(connection->maxFrameSize);
-        frameWriter.start(FrameType::DATA, FrameFlag::EMPTY, streamID());
-
-        while (remainingWindowSize && deviceCanRead() && remainingBytesInFrame) {
-            const qint32 maxToWrite = std::min(remainingWindowSize, remainingBytesInFrame);
-
-            qint64 outBytesAvail = 0;
-            const char *readPointer = m_uploadByteDevice->readPointer(maxToWrite, outBytesAvail);
-            if (!readPointer || outBytesAvail <= 0) {
-                qCDebug(qHttp2ConnectionLog,
-                        "[%p] stream %u, cannot write data, device (%p) has %lld bytes available",
-                        connection, m_streamID, m_uploadByteDevice, outBytesAvail);
-                break;
-            }
-            const qint32 bytesToWrite = qint32(std::min<qint64>(maxToWrite, outBytesAvail));
-            frameWriter.append(QByteArrayView(readPointer, bytesToWrite));
-            m_uploadByteDevice->advanceReadPointer(bytesToWrite);
-
-            bytesWritten += bytesToWrite;
-
-            m_sendWindow -= bytesToWrite;
-            Q_ASSERT(m_sendWindow >= 0);
-            connection->sessionSendWindowSize -= bytesToWrite;
-            Q_ASSERT(connection->sessionSendWindowSize >= 0);
-            remainingBytesInFrame -= bytesToWrite;
-            Q_ASSERT(remainingBytesInFrame >= 0);
-            remainingWindowSize -= bytesToWrite;
-            Q_ASSERT(remainingWindowSize >= 0);
-        }
+    qCDebug(qHttp2ConnectionLog,
+            "[%p] stream %u, writing %lld bytes total, if the device is not exhausted, we'll "
+            "write more later. Remaining window size: %d",
+            connection, m_streamID, totalBytesWritten,
+            std::min(connection->sessionSendWindowSize, m_sendWindow));
+
+    if (!batch.isEmpty() && !connection->writeBatch(batch)) {
+        qCDebug(qHttp2ConnectionLog, "[%p] stream %u, failed to write to socket", connection,
+                m_streamID);
+        return finishWithError(INTERNAL_ERROR, "failed to write to socket"_L1);
+    }
+    finishDATABatch(totalBytesWritten);
+}
 
-        qCDebug(qHttp2ConnectionLog, "[%p] stream %u, writing %u bytes to socket", connection,
-                m_streamID, bytesWritten);
-        if (!deviceCanRead() && m_uploadByteDevice->atEnd() && m_endStreamAfterDATA) {
-            sentEND_STREAM = true;
-            frameWriter.addFlag(FrameFlag::END_STREAM);
-        }
-        if (!frameWriter.write(*socket)) {
-            qCDebug(qHttp2ConnectionLog, "[%p] stream %u, failed to write to socket", connection,
-                    m_streamID);
-            return finishWithError(INTERNAL_ERROR, "failed to write to socket"_L1);
-        }
+bool QHttp2Stream::uploadDeviceCanRead() const
+{
+    // We take advantage of knowing the internals of one of the devices used.
+    // It will request X bytes to move over to the http thread if there's
+    // not enough left, so we give it a large size. It will anyway return
+    // the size it can actually provide.
+    const qint64 requestSize = getConnection()->maxFrameSize * 10ll;
+    qint64 tmp = 0;
+    return m_uploadByteDevice->readPointer(requestSize, tmp) != nullptr && tmp > 0;
+}
 
-        totalBytesWritten += bytesWritten;
+bool QHttp2Stream::uploadDeviceExhausted() const
+{
+    return !uploadDeviceCanRead() && m_uploadByteDevice->atEnd();
+}
+
+/*
+    Returns the size of the next DATA frame this stream could send right now,
+    limited by the frame size, the flow control windows and the data the
+    upload device has ready.
+*/
+qint32 QHttp2Stream::nextDATAFrameSize() const
+{
+    const QHttp2Connection *connection = getConnection();
+    const qint32 windowSize = std::min(connection->sessionSendWindowSize, m_sendWindow);
+    if (m_sentEND_STREAM || windowSize <= 0)
+        return 0;
+    qint64 available = 0;
+    if (!m_uploadByteDevice->readPointer(connection->maxFrameSize * 10ll, available))
+        return 0;
+    return qint32(std::min<qint64>({ qint64(connection->maxFrameSize), qint64(windowSize),
+                                     available }));
+}
+
+/*
+    Appends a DATA frame with up to \a maxPayload bytes from the upload device
+    to \a out, setting END_STREAM if it exhausts the device. Returns the size
+    of the payload.
+*/
+qint32 QHttp2Stream::appendDATAFrame(QByteArray &out, qint32 maxPayload)
+{
+    if (maxPayload <= 0)
+        return 0;
+    QHttp2Connection *connection = getConnection();
+    Q_ASSERT(maxPayload <= qint32(connection->maxFrameSize));
+    Q_ASSERT(maxPayload <= m_sendWindow && maxPayload <= connection->sessionSendWindowSize);
+
+    const qsizetype headerPos = out.size();
+    out.resize(headerPos + frameHeaderSize);
+    qint32 payloadSize = 0;
+    while (payloadSize < maxPayload) {
+        qint64 outBytesAvail = 0;
+        const char *readPointer = m_uploadByteDevice->readPointer(maxPayload - payloadSize,
+                                                                   outBytesAvail);
+        if (!readPointer || outBytesAvail <= 0) {
+            qCDebug(qHttp2ConnectionLog,
+                    "[%p] stream %u, cannot write data, device (%p) has %lld bytes available",
+                    connection, m_streamID, m_uploadByteDevice, outBytesAvail);
+            break;
+        }
+        const qint32 bytesToWrite = qint32(std::min<qint64>(maxPayload - payloadSize,
+                                                            outBytesAvail));
+        out.append(readPointer, bytesToWrite);
+        m_uploadByteDevice->advanceReadPointer(bytesToWrite);
+        payloadSize += bytesToWrite;
+    }
+    if (!payloadSize) {
+        out.truncate(headerPos);
+        return 0;
     }
 
-    qCDebug(qHttp2ConnectionLog,
-            "[%p] stream %u, wrote %lld bytes total, if the device is not exhausted, we'll write "
-            "more later. Remaining window size: %d",
-            connection, m_streamID, totalBytesWritten, remainingWindowSize);
+    m_sendWindow -= payloadSize;
+    Q_ASSERT(m_sendWindow >= 0);
+    connection->sessionSendWindowSize -= payloadSize;
+    Q_ASSERT(connection->sessionSendWindowSize >= 0);
 
-    emit bytesWritten(totalBytesWritten);
-    if (sentEND_STREAM || (!deviceCanRead() && m_uploadByteDevice->atEnd())) {
+    FrameFlags flags = FrameFlag::EMPTY;
+    if (m_endStreamAfterDATA && uploadDeviceExhausted()) {
+        m_sentEND_STREAM = true;
+        flags = FrameFlag::END_STREAM;
+    }
+    writeFrameHeader(out.data() + headerPos, FrameType::DATA, flags, m_streamID,
+                     quint32(payloadSize));
+    return payloadSize;
+}
+
+/*
+    If the upload device is exhausted but the last DATA frame did not carry
+    END_STREAM, appends an empty DATA frame with END_STREAM to \a out.
+*/
+void QHttp2Stream::appendEndOfDATA(QByteArray &out)
+{
+    if (m_sentEND_STREAM || !m_endStreamAfterDATA || !uploadDeviceExhausted())
+        return;
+    // This can happen if we got a final readyRead to signify no more data
+    // available, but we hadn't sent the END_STREAM flag yet.
+    m_sentEND_STREAM = true;
+    const qsizetype headerPos = out.size();
+    out.resize(headerPos + frameHeaderSize);
+    writeFrameHeader(out.data() + headerPos, FrameType::DATA, FrameFlag::END_STREAM, m_streamID,
+                     0);
+}
+
+/*
+    Called once the frames built by appendDATAFrame(), with \a bytesWritten
+    bytes of payload in total, were written to the socket.
+*/
+void QHttp2Stream::finishDATABatch(qint64 bytesWritten)
+{
+    QHttp2Connection *connection = getConnection();
+    if (bytesWritten)
+        emit this->bytesWritten(bytesWritten);
+    if (!isUploadingDATA())
+        return;
+    if (m_sentEND_STREAM || uploadDeviceExhausted()) {
         qCDebug(qHttp2ConnectionLog,
                 "[%p] stream %u, exhausted device %p, sent END_STREAM? %d, %ssending end stream "
                 "after DATA",
-                connection, m_streamID, m_uploadByteDevice, sentEND_STREAM,
+                connection, m_streamID, m_uploadByteDevice, m_sentEND_STREAM,
                 m_endStreamAfterDATA ? "" : "not ");
-        if (!sentEND_STREAM && m_endStreamAfterDATA) {
-            // We need to send an empty DATA frame with END_STREAM since we
-            // have exhausted the device, but we haven't sent END_STREAM yet.
-            // This can happen if we got a final readyRead to signify no more
-            // data available, but we hadn't sent the END_STREAM flag yet.
-            frameWriter.start(FrameType::DATA, FrameFlag::END_STREAM, streamID());
-            frameWriter.write(*socket);
-        }
         finishSendDATA();
     } else if (isUploadBlocked()) {
         qCDebug(qHttp2ConnectionLog, "[%p] stream %u, upload blocked", connection, m_streamID);
@@ -523,10 +602,28 @@ void QHttp2Stream::uploadDeviceReadChannelFinished()
     this function will return \c false. Otherwise, it will return \c true.
 */
 bool QHttp2Stream::sendHEADERS(const HPack::HttpHeader &headers, bool endStream, quint8 priority)
+{
+    return sendHEADERS(headers, {}, endStream, priority);
+}
+
+/*!
+    \overload
+
+    Sends a HEADERS frame with the given \a headers, followed by
+    \a commonHeaders, which were encoded once with
+    HPack::PreEncodedHeaders::encode() and can be shared by any number of
+    streams. \a headers must contain the pseudo-headers.
+*/
+bool QHttp2Stream::sendHEADERS(const HPack::HttpHeader &headers,
+                               const HPack::PreEncodedHeaders &commonHeaders, bool endStream,
+                               quint8 priority)
 {
     using namespace HPack;
-    if (auto hs = header_size(headers);
-        !hs.first || hs.second > getConnection()->maxHeaderListSize()) {
+    const auto hs = header_size(headers);
+    const auto commonSize = header_size(commonHeaders.header());
+    if (!hs.first || !commonSize.first
+        || hs.second > getConnection()->maxHeaderListSize()
+        || commonSize.second > getConnection()->maxHeaderListSize() - hs.second) {
         return false;
     }
 
@@ -548,14 +645,15 @@ bool QHttp2Stream::sendHEADERS(const HPack::HttpHeader &headers, bool endStream,
 
     frameWriter.append(quint32()); // No stream dependency in Qt.
     frameWriter.append(priority);
+    m_priority = priority;
 
     // Compress in-place:
     BitOStream outputStream(frameWriter.outboundFrame().buffer);
     if (connection->m_connectionType == QHttp2Connection::Type::Client) {
-        if (!connection->encoder.encodeRequest(outputStream, headers))
+        if (!connection->encoder.encodeRequest(outputStream, headers, commonHeaders))
             return false;
     } else {
-        if (!connection->encoder.encodeResponse(outputStream, headers))
+        if (!connection->encoder.encodeResponse(outputStream, headers, commonHeaders))
             return false;
     }
 
@@ -685,9 +783,15 @@ void QHttp2Stream::handleDATA(const Frame &inboundFrame)
         m_downloadBuffer.append(std::move(fragment));
     }
 
-    if (!endStream && m_recvWindow < connection->streamInitialReceiveWindowSize / 2) {
+    if (!endStream && m_recvWindow < m_recvWindowTarget / 2) {
         // @future[consider]: emit signal instead
-        sendWINDOW_UPDATE(quint32(connection->streamInitialReceiveWindowSize - m_recvWindow));
+        const qint32 maxWindow = std::max(connection->streamInitialReceiveWindowSize,
+                                          maxAdaptiveStreamReceiveWindowSize);
+        m_recvWindowTarget = connection->adaptReceiveWindow(m_recvWindowTarget, maxWindow,
+                                                            &m_lastWindowUpdateTime);
+        const quint32 delta = quint32(m_recvWindowTarget - m_recvWindow);
+        m_recvWindow = m_recvWindowTarget;
+        connection->queueWINDOW_UPDATE(m_streamID, delta);
     }
 }
 
@@ -915,6 +1019,7 @@ QHttp2Stream *QHttp2Connection::createStreamInternal_impl(quint32 streamID)
         return nullptr;
     stream = new QHttp2Stream(this, streamID);
     stream->m_recvWindow = streamInitialReceiveWindowSize;
+    stream->m_recvWindowTarget = streamInitialReceiveWindowSize;
     stream->m_sendWindow = streamInitialSendWindowSize;
 
     connect(stream, &QHttp2Stream::uploadBlocked, this, [this, stream] {
@@ -1012,6 +1117,7 @@ QHttp2Connection::QHttp2Connection(QIODevice *socket) : QObject(socket)
     // in the http2 protocol handler, which is used by
     // QHttpNetworkConnectionChannel. Which in turn owns and deals with all the
     // socket connections.
+    m_clock.start();
 }
 
 QHttp2Connection::~QHttp2Connection() noexcept
@@ -1217,6 +1323,7 @@ void QHttp2Connection::setH2Configuration(QHttp2Configuration config)
     maxSessionReceiveWindowSize = qint32(m_config.sessionReceiveWindowSize());
     pushPromiseEnabled = m_config.serverPushEnabled();
     streamInitialReceiveWindowSize = qint32(m_config.streamReceiveWindowSize());
+    adaptiveReceiveWindow = m_config.adaptiveReceiveWindowEnabled();
     encoder.setCompressStrings(m_config.huffmanCompressionEnabled());
 }
 
@@ -1332,6 +1439,177 @@ bool QHttp2Connection::sendWINDOW_UPDATE(quint32 streamID, quint32 delta)
     return frameWriter.write(*getSocket());
 }
 
+/*
+    Queues a WINDOW_UPDATE frame, all the frames queued during one event-loop
+    turn are written with a single socket write.
+*/
+void QHttp2Connection::queueWINDOW_UPDATE(quint32 streamID, quint32 delta)
+{
+    qCDebug(qHttp2ConnectionLog, "[%p] Queueing WINDOW_UPDATE frame, stream %d, delta %u", this,
+            streamID, delta);
+    const qsizetype headerPos = m_pendingFrames.size();
+    m_pendingFrames.resize(headerPos + frameHeaderSize + sizeof(delta));
+    writeFrameHeader(m_pendingFrames.data() + headerPos, FrameType::WINDOW_UPDATE,
+                     FrameFlag::EMPTY, streamID, sizeof(delta));
+    qToBigEndian(delta, m_pendingFrames.data() + headerPos + frameHeaderSize);
+    if (!std::exchange(m_flushScheduled, true)) {
+        QMetaObject::invokeMethod(this, &QHttp2Connection::flushPendingFrames,
+                                  Qt::QueuedConnection);
+    }
+}
+
+void QHttp2Connection::flushPendingFrames()
+{
+    m_flushScheduled = false;
+    if (!m_pendingFrames.isEmpty() && !writeBatch({}))
+        qCDebug(qHttp2ConnectionLog, "[%p] Failed to write queued frames", this);
+}
+
+/*
+    Writes \a batch, preceded by any queued frames, to the socket with a
+    single write.
+*/
+bool QHttp2Connection::writeBatch(const QByteArray &batch)
+{
+    QIODevice *socket = getSocket();
+    if (m_pendingFrames.isEmpty())
+        return batch.isEmpty() || socket->write(batch) == batch.size();
+    m_pendingFrames.append(batch);
+    const QByteArray frames = std::exchange(m_pendingFrames, {});
+    return socket->write(frames) == frames.size();
+}
+
+/*
+    Returns the receive window to top up to, given the current \a window.
+    With the adaptive receive window enabled, the window is doubled, up to
+    \a maxWindow, when the peer used up half of it within two round trips
+    of the previous update: the window, rather than the peer, limits the
+    throughput then. \a lastUpdateTime is the time of the previous update.
+*/
+qint32 QHttp2Connection::adaptReceiveWindow(qint32 window, qint32 maxWindow,
+                                            qint64 *lastUpdateTime)
+{
+    if (!adaptiveReceiveWindow)
+        return window;
+    const qint64 now = m_clock.nsecsElapsed();
+    const qint64 previous = std::exchange(*lastUpdateTime, now);
+    if (m_roundTripTime <= 0 || previous < 0 || window >= maxWindow
+        || now - previous >= 2 * m_roundTripTime) {
+        return window;
+    }
+    const qint32 newWindow = qint32(std::min(2 * qint64(window), qint64(maxWindow)));
+    qCDebug(qHttp2ConnectionLog, "[%p] Growing receive window from %d to %d bytes", this, window,
+            newWindow);
+    return newWindow;
+}
+
+static constexpr char rttPingSignature[8] = { 'q', 't', 'h', '2', 'r', 't', 't', '0' };
+
+/*
+    Sends a PING, its ACK gives us the round trip time the adaptive receive
+    window is based on.
+*/
+void QHttp2Connection::measureRoundTripTime()
+{
+    if (std::exchange(m_rttPingSent, true))
+        return;
+    frameWriter.start(FrameType::PING, FrameFlag::EMPTY, connectionStreamID);
+    frameWriter.append(QByteArrayView(rttPingSignature, sizeof(rttPingSignature)));
+    m_rttPingTime = m_clock.nsecsElapsed();
+    frameWriter.write(*getSocket());
+}
+
+/*
+    Adds \a stream, if any, to the streams waiting to send DATA and schedules
+    a call to sendScheduledDATA(), once per event-loop turn.
+*/
+void QHttp2Connection::scheduleDATA(QHttp2Stream *stream)
+{
+    if (stream)
+        m_blockedStreams.insert(stream->streamID());
+    if (!std::exchange(m_sendScheduled, true)) {
+        QMetaObject::invokeMethod(this, &QHttp2Connection::sendScheduledDATA,
+                                  Qt::QueuedConnection);
+    }
+}
+
+/*
+    Shares the session send window between the streams waiting to send DATA,
+    in proportion to their priority (weighted deficit round robin), and writes
+    all the resulting frames with a single socket write.
+*/
+void QHttp2Connection::sendScheduledDATA()
+{
+    m_sendScheduled = false;
+
+    struct ScheduledStream
+    {
+        QPointer<QHttp2Stream> stream;
+        qint64 bytesWritten = 0;
+        bool done = false;
+    };
+    QVarLengthArray<ScheduledStream, 16> scheduled;
+    const auto waiting = std::exchange(m_blockedStreams, {});
+    for (quint32 streamID : waiting) {
+        QHttp2Stream *stream = m_streams.value(streamID);
+        if (stream && stream->isActive() && stream->isUploadingDATA())
+            scheduled.append({ stream });
+    }
+    // Serve the streams in the order they were opened:
+    std::sort(scheduled.begin(), scheduled.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.stream->streamID() < rhs.stream->streamID();
+    });
+
+    QByteArray batch;
+    qsizetype remaining = scheduled.size();
+    while (remaining && sessionSendWindowSize > 0) {
+        for (ScheduledStream &entry : scheduled) {
+            if (entry.done)
+                continue;
+            // The remaining streams keep their deficit for the next window:
+            if (sessionSendWindowSize <= 0)
+                break;
+            QHttp2Stream *stream = entry.stream;
+            stream->m_sendDeficit += qint64(maxFrameSize) * (stream->priority() + 1) / 256;
+            while (true) {
+                const qint32 frameSize = stream->nextDATAFrameSize();
+                if (frameSize <= 0 && sessionSendWindowSize <= 0)
+                    break;
+                if (frameSize <= 0) {
+                    // Blocked by its own window, or no data ready:
+                    stream->m_sendDeficit = 0;
+                    entry.done = true;
+                    --remaining;
+                    break;
+                }
+                if (stream->m_sendDeficit < frameSize)
+                    break;
+                entry.bytesWritten += stream->appendDATAFrame(batch, frameSize);
+                stream->m_sendDeficit -= frameSize;
+            }
+        }
+    }
+    for (ScheduledStream &entry : scheduled) {
+        entry.stream->appendEndOfDATA(batch);
+        // Do not let a stream save up for a burst while it waits for the window:
+        entry.stream->m_sendDeficit = std::min(entry.stream->m_sendDeficit, qint64(maxFrameSize));
+    }
+
+    qCDebug(qHttp2ConnectionLog,
+            "[%p] Writing %lld bytes of DATA frames for %lld streams, remaining session window "
+            "size: %d",
+            this, qlonglong(batch.size()), qlonglong(scheduled.size()), sessionSendWindowSize);
+    const bool written = writeBatch(batch);
+    for (const ScheduledStream &entry : scheduled) {
+        if (!entry.stream)
+            continue;
+        if (!written)
+            entry.stream->finishWithError(INTERNAL_ERROR, "failed to write to socket"_L1);
+        else
+            entry.stream->finishDATABatch(entry.bytesWritten);
+    }
+}
+
 bool QHttp2Connection::sendGOAWAY(Http2::Http2Error errorCode)
 {
     frameWriter.start(FrameType::GOAWAY, FrameFlag::EMPTY,
@@ -1379,6 +1657,8 @@ void QHttp2Connection::handleDATA()
     }
 
     sessionReceiveWindowSize -= inboundFrame.payloadSize();
+    if (adaptiveReceiveWindow)
+        measureRoundTripTime();
 
     auto it = m_streams.constFind(streamID);
     if (it != m_streams.cend() && it.value())
@@ -1389,9 +1669,12 @@ void QHttp2Connection::handleDATA()
 
     if (sessionReceiveWindowSize < maxSessionReceiveWindowSize / 2) {
         // @future[consider]: emit signal instead
-        QMetaObject::invokeMethod(this, &QHttp2Connection::sendWINDOW_UPDATE, Qt::QueuedConnection,
-                                  quint32(connectionStreamID),
-                                  quint32(maxSessionReceiveWindowSize - sessionReceiveWindowSize));
+        const qint32 maxWindow = std::max(qint32(m_config.sessionReceiveWindowSize()),
+                                          maxAdaptiveSessionReceiveWindowSize);
+        maxSessionReceiveWindowSize = adaptReceiveWindow(maxSessionReceiveWindowSize, maxWindow,
+                                                         &m_lastSessionWindowUpdateTime);
+        queueWINDOW_UPDATE(connectionStreamID,
+                           quint32(maxSessionReceiveWindowSize - sessionReceiveWindowSize));
         sessionReceiveWindowSize = maxSessionReceiveWindowSize;
     }
 }
@@ -1481,10 +1764,11 @@ void QHttp2Connection::handlePRIORITY()
     const bool exclusive = streamDependency & 0x80000000;
     streamDependency &= ~0x80000000;
 
-    // Ignore this for now ...
-    // Can be used for streams (re)prioritization - 5.3
+    // The dependency tree is ignored for now, the weight decides the
+    // stream's share of the connection's send window - 5.3
     Q_UNUSED(exclusive);
-    Q_UNUSED(weight);
+    if (QHttp2Stream *stream = m_streams.value(streamID))
+        stream->setPriority(weight);
 }
 
 void QHttp2Connection::handleRST_STREAM()
@@ -1676,6 +1960,13 @@ void QHttp2Connection::handlePING()
 
     if (inboundFrame.flags() & FrameFlag::ACK) {
         QByteArrayView pingSignature(reinterpret_cast<const char *>(inboundFrame.dataBegin()), 8);
+        if (m_rttPingSent && !m_roundTripTime
+            && pingSignature == QByteArrayView(rttPingSignature, sizeof(rttPingSignature))) {
+            m_roundTripTime = std::max(m_clock.nsecsElapsed() - m_rttPingTime, qint64(1));
+            qCDebug(qHttp2ConnectionLog, "[%p] Round trip time is %lld us", this,
+                    m_roundTripTime / 1000);
+            return;
+        }
         if (!m_lastPingSignature.has_value()) {
             emit pingFrameRecived(PingState::PongNoPingSent);
             qCWarning(qHttp2ConnectionLog, "[%p] PING with ACK received but no PING was sent.", this);
@@ -1774,16 +2065,9 @@ void QHttp2Connection::handleWINDOW_UPDATE()
             return connectionError(PROTOCOL_ERROR, "WINDOW_UPDATE invalid delta");
         sessionSendWindowSize = sum;
 
-        // Stream may have been unblocked, so maybe try to write again:
-        const auto blockedStreams = std::exchange(m_blockedStreams, {});
-        for (quint32 blockedStreamID : blockedStreams) {
-            const QPointer<QHttp2Stream> stream = m_streams.value(blockedStreamID);
-            if (!stream || !stream->isActive())
-                continue;
-            if (stream->isUploadingDATA() && !stream->isUploadBlocked())
-                QMetaObject::invokeMethod(stream, &QHttp2Stream::maybeResumeUpload,
-                                          Qt::QueuedConnection);
-        }
+        // Streams may have been unblocked, share the window between them:
+        if (!m_blockedStreams.isEmpty())
+            scheduleDATA(nullptr);
     } else {
         QHttp2Stream *stream = m_streams.value(streamID);
         if (!stream || !stream->isActive()) {
@@ -1945,10 +2229,8 @@ bool QHttp2Connection::acceptSetting(Http2::Settings identifier, quint32 newValu
                 continue;
             }
             stream->m_sendWindow = sum;
-            if (delta > 0 && stream->isUploadingDATA() && !stream->isUploadBlocked()) {
-                QMetaObject::invokeMethod(stream, &QHttp2Stream::maybeResumeUpload,
-                                          Qt::QueuedConnection);
-            }
+            if (delta > 0 && stream->isUploadingDATA() && !stream->isUploadBlocked())
+                scheduleDATA(stream);
         }
         break;
     }
@@ -19,6 +19,7 @@
 
 #include <QtCore/qobject.h>
 #include <QtCore/qhash.h>
+#include <QtCore/qelapsedtimer.h>
 #include <QtCore/qset.h>
 #include <QtCore/qvarlengtharray.h>
 #include <QtCore/qxpfunctional.h>
@@ -116,6 +117,9 @@ public:
     bool wasResetbyPeer() const noexcept { return m_RST_STREAM_received.has_value(); }
     quint32 RST_STREAMCodeReceived() const noexcept { return m_RST_STREAM_received.value_or(0); }
     quint32 RST_STREAMCodeSent() const noexcept { return m_RST_STREAM_sent.value_or(0); }
+    // The weight of the stream when the connection shares its send window:
+    quint8 priority() const noexcept { return m_priority; }
+    void setPriority(quint8 priority) noexcept { m_priority = priority; }
     // Just the list of headers, as received, may contain duplicates:
     HPack::HttpHeader receivedHeaders() const noexcept { return m_headers; }
 
@@ -141,6 +145,8 @@ public Q_SLOTS:
     bool sendRST_STREAM(Http2::Http2Error errorCode);
     bool sendHEADERS(const HPack::HttpHeader &headers, bool endStream,
                      quint8 priority = DefaultPriority);
+    bool sendHEADERS(const HPack::HttpHeader &headers, const HPack::PreEncodedHeaders &commonHeaders,
+                     bool endStream, quint8 priority = DefaultPriority);
     bool sendDATA(const QByteArray &payload, bool endStream);
     bool sendDATA(QIODevice *device, bool endStream);
     bool sendDATA(QNonContiguousByteDevice *device, bool endStream);
@@ -170,6 +176,12 @@ private:
     void setState(State newState);
     void transitionState(StateTransition transition);
     void internalSendDATA();
+    bool uploadDeviceCanRead() const;
+    bool uploadDeviceExhausted() const;
+    qint32 nextDATAFrameSize() const;
+    qint32 appendDATAFrame(QByteArray &out, qint32 maxPayload);
+    void appendEndOfDATA(QByteArray &out);
+    void finishDATABatch(qint64 bytesWritten);
     void finishSendDATA();
 
     void handleDATA(const Http2::Frame &inboundFrame);
@@ -187,7 +199,14 @@ private:
     const quint32 m_streamID = 0;
     qint32 m_recvWindow = 0;
     qint32 m_sendWindow = 0;
+    // The receive window we keep topping up to, grows with the adaptive window:
+    qint32 m_recvWindowTarget = 0;
+    qint64 m_lastWindowUpdateTime = -1;
+    // Weighted fair sharing of the connection's send window:
+    qint64 m_sendDeficit = 0;
+    quint8 m_priority = DefaultPriority;
     bool m_endStreamAfterDATA = false;
+    bool m_sentEND_STREAM = false;
     std::optional<quint32> m_RST_STREAM_received;
     std::optional<quint32> m_RST_STREAM_sent;
 
@@ -293,6 +312,14 @@ private:
     bool sendServerPreface();
     bool serverCheckClientPreface();
     bool sendWINDOW_UPDATE(quint32 streamID, quint32 delta);
+    void queueWINDOW_UPDATE(quint32 streamID, quint32 delta);
+    qint32 adaptReceiveWindow(qint32 window, qint32 maxWindow, qint64 *lastUpdateTime);
+    void measureRoundTripTime();
+
+    void scheduleDATA(QHttp2Stream *stream);
+    void sendScheduledDATA();
+    void flushPendingFrames();
+    bool writeBatch(const QByteArray &batch);
     bool sendGOAWAY(Http2::Http2Error errorCode);
     bool sendSETTINGS_ACK();
 
@@ -327,6 +354,7 @@ private:
 
     QHttp2Configuration m_config;
     QHash<quint32, QPointer<QHttp2Stream>> m_streams;
+    // Streams waiting for the send window or for the next scheduling round:
     QSet<quint32> m_blockedStreams;
     QHash<QUrl, quint32> m_promisedStreams;
     QList<quint32> m_resetStreamIDs;
@@ -342,6 +370,13 @@ private:
     Http2::Frame inboundFrame;
     Http2::FrameWriter frameWriter;
 
+    // Frames queued during this event-loop turn, written with a single
+    // socket write by flushPendingFrames():
+    QByteArray m_pendingFrames;
+    bool m_flushScheduled = false;
+    // A sendScheduledDATA() call is pending:
+    bool m_sendScheduled = false;
+
     // Temporary storage to assemble HEADERS' block
     // from several CONTINUATION frames ...
     bool continuationExpected = false;
@@ -357,8 +392,8 @@ private:
     // sending requests and creating streams while maxConcurrentStreams allows).
 
     // This is our (client-side) maximum possible receive window size, we set
-    // it in a ctor from QHttp2Configuration, it does not change after that.
-    // The default is 64Kb:
+    // it in a ctor from QHttp2Configuration, it only changes after that if
+    // the adaptive receive window is enabled. The default is 64Kb:
     qint32 maxSessionReceiveWindowSize = Http2::defaultSessionWindowSize;
 
     // Our session current receive window size, updated in a ctor from
@@ -369,6 +404,16 @@ private:
     // from QHttp2Configuration. Again, signed - can become negative.
     qint32 streamInitialReceiveWindowSize = Http2::defaultSessionWindowSize;
 
+    // Adaptive receive windows: the round trip time is measured with a PING
+    // and the windows are doubled when the peer uses them up in less than
+    // two round trips, see adaptReceiveWindow().
+    bool adaptiveReceiveWindow = false;
+    bool m_rttPingSent = false;
+    qint64 m_rttPingTime = 0;
+    qint64 m_roundTripTime = 0; // nsecs, 0 if not measured yet
+    qint64 m_lastSessionWindowUpdateTime = -1;
+    QElapsedTimer m_clock;
+
     // These are our peer's receive window sizes, they will be updated by the
     // peer's SETTINGS and WINDOW_UPDATE frames, defaults presumed to be 64Kb.
     qint32 sessionSendWindowSize = Http2::defaultSessionWindowSize;
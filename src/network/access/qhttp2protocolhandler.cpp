@@ -199,6 +199,11 @@ void QHttp2ProtocolHandler::_q_uploadDataDestroyed(QObject *uploadData)
 
 void QHttp2ProtocolHandler::_q_readyRead()
 {
+    // Also emulated by QHttpNetworkConnectionPrivate::readMoreLater(), once
+    // a throttled reply's data was consumed.
+    if (!throttledStreams.empty())
+        resumeThrottledStreams();
+
     if (!goingAway || activeStreams.size())
         _q_receiveReply();
 }
@@ -564,6 +569,14 @@ void QHttp2ProtocolHandler::handleDATA()
             if (inboundFrame.flags().testFlag(FrameFlag::END_STREAM)) {
                 finishStream(stream);
                 deleteActiveStream(stream.streamID);
+            } else if (stream.recvWindow < streamInitialReceiveWindowSize / 2
+                       && downstreamIsFull(stream.reply())) {
+                // The reply's reader does not keep up. Stop extending the window,
+                // so the server has to pause once it is exhausted.
+                if (std::find(throttledStreams.begin(), throttledStreams.end(),
+                              stream.streamID) == throttledStreams.end()) {
+                    throttledStreams.push_back(stream.streamID);
+                }
             } else if (stream.recvWindow < streamInitialReceiveWindowSize / 2) {
                 QMetaObject::invokeMethod(this, "sendWINDOW_UPDATE", Qt::QueuedConnection,
                                           Q_ARG(quint32, stream.streamID),
@@ -1396,6 +1409,39 @@ void QHttp2ProtocolHandler::markAsReset(quint32 streamID)
     recycledStreams.insert(it, streamID);
 }
 
+bool QHttp2ProtocolHandler::downstreamIsFull(QHttpNetworkReply *reply)
+{
+    // This mirrors QHttpProtocolHandler, which stops reading from the socket
+    // while a reply with a limited read buffer holds enough unfetched data.
+    if (!reply)
+        return false;
+    const auto replyPrivate = reply->d_func();
+    return replyPrivate->downstreamLimited
+           && replyPrivate->responseData.byteAmount() >= replyPrivate->readBufferMaxSize;
+}
+
+void QHttp2ProtocolHandler::resumeThrottledStreams()
+{
+    for (auto it = throttledStreams.begin(); it != throttledStreams.end();) {
+        const auto streamIt = activeStreams.find(*it);
+        if (streamIt == activeStreams.end()) {
+            it = throttledStreams.erase(it);
+            continue;
+        }
+
+        Stream &stream = streamIt.value();
+        if (downstreamIsFull(stream.reply())) {
+            ++it;
+            continue;
+        }
+
+        it = throttledStreams.erase(it);
+        const quint32 delta = streamInitialReceiveWindowSize - stream.recvWindow;
+        stream.recvWindow = streamInitialReceiveWindowSize;
+        sendWINDOW_UPDATE(stream.streamID, delta);
+    }
+}
+
 quint32 QHttp2ProtocolHandler::popStreamToResume()
 {
     quint32 streamID = connectionStreamID;
@@ -129,6 +129,9 @@ private:
     QHash<QObject *, int> streamIDs;
     QHash<quint32, Stream> activeStreams;
     std::deque<quint32> suspendedStreams[3]; // 3 for priorities: High, Normal, Low.
+    // Streams whose replies hold more than their read buffer size; we
+    // do not extend their receive windows until the data is consumed.
+    std::deque<quint32> throttledStreams;
     inline static const std::deque<quint32>::size_type maxRecycledStreams = 10000;
     std::deque<quint32> recycledStreams;
 
@@ -178,6 +181,8 @@ private:
     // the headers size), we never enforce it, it's just a hint to our peer.
 
     Q_INVOKABLE void resumeSuspendedStreams();
+    static bool downstreamIsFull(QHttpNetworkReply *reply);
+    void resumeThrottledStreams();
     // Our stream IDs (all odd), the first valid will be 1.
     quint32 nextID = 1;
     quint32 allocateStreamID();
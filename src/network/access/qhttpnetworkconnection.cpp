@@ -1200,6 +1200,13 @@ void QHttpNetworkConnectionPrivate::readMoreLater(QHttpNetworkReply *reply)
             return;
         }
     }
+
+    // HTTP/2 replies share their channel without being its current reply,
+    // the protocol handler resumes their flow control on readyRead().
+    if (reply->isHttp2Used()) {
+        if (QHttpNetworkConnectionChannel *channel = reply->d_func()->connectionChannel)
+            QMetaObject::invokeMethod(channel, "_q_readyRead", Qt::QueuedConnection);
+    }
 }
 
 
@@ -460,25 +460,17 @@ void QHttpThreadDelegate::readyReadSlot()
         return;
 
     if (readBufferMaxSize) {
-        if (bytesEmitted < readBufferMaxSize) {
-            qint64 sizeEmitted = 0;
-            while (httpReply->readAnyAvailable() && (sizeEmitted < (readBufferMaxSize-bytesEmitted))) {
-                if (httpReply->sizeNextBlock() > (readBufferMaxSize-bytesEmitted)) {
-                    sizeEmitted = readBufferMaxSize-bytesEmitted;
-                    bytesEmitted += sizeEmitted;
-                    pendingDownloadData->fetchAndAddRelease(1);
-                    emit downloadData(httpReply->read(sizeEmitted));
-                } else {
-                    sizeEmitted = httpReply->sizeNextBlock();
-                    bytesEmitted += sizeEmitted;
-                    pendingDownloadData->fetchAndAddRelease(1);
-                    emit downloadData(httpReply->readAny());
-                }
-            }
-        } else {
-            // We need to wait until we empty data from the read buffer in the reply.
+        // The read buffer size is a high-water mark: hand whole chunks over to the
+        // reply until it holds at least that much. Chunks are shared, not copied,
+        // and are no larger than the read buffer size (HTTP/1) or one DATA frame
+        // (HTTP/2). The rest stays in httpReply, which stops reading from the
+        // network until we fetch it.
+        while (bytesEmitted < readBufferMaxSize && httpReply->readAnyAvailable()) {
+            const QByteArray data = httpReply->readAny();
+            bytesEmitted += data.size();
+            pendingDownloadData->fetchAndAddRelease(1);
+            emit downloadData(data);
         }
-
     } else {
         while (httpReply->readAnyAvailable()) {
             pendingDownloadData->fetchAndAddRelease(1);
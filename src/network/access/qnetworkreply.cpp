@@ -506,7 +506,13 @@ qint64 QNetworkReply::readBufferSize() const
     guarantee precision in the read buffer size. That is,
     bytesAvailable() can return more than \a size.
 
-    \sa readBufferSize()
+    With HTTP/2, several replies share one connection, so reading from it
+    cannot stop for one of them. Instead, QNetworkReply stops granting the
+    server more flow-control credit for this reply. The server can then send
+    up to the stream receive window size before it has to pause; use
+    QHttp2Configuration::setStreamReceiveWindowSize() to limit this.
+
+    \sa readBufferSize(), QNetworkRequest::setHttp2Configuration()
 */
 void QNetworkReply::setReadBufferSize(qint64 size)
 {
@@ -103,6 +103,25 @@ int main()
 "
 )
 
+# sendmmsg
+qt_config_compile_test(sendmmsg
+    LABEL "recvmmsg()/sendmmsg()"
+    CODE
+"#define _GNU_SOURCE 1
+#include <sys/types.h>
+#include <sys/socket.h>
+
+int main(void)
+{
+    /* BEGIN TEST: */
+mmsghdr msgs[2] = {};
+(void) recvmmsg(-1, msgs, 2, MSG_DONTWAIT, nullptr);
+(void) sendmmsg(-1, msgs, 2, 0);
+    /* END TEST: */
+    return 0;
+}
+")
+
 # sctp
 qt_config_compile_test(sctp
     LABEL "SCTP support"
@@ -270,6 +289,10 @@ qt_feature("udpsocket" PUBLIC
     PURPOSE "Provides access to UDP sockets."
 )
 qt_feature_definition("udpsocket" "QT_NO_UDPSOCKET" NEGATE VALUE "1")
+qt_feature("sendmmsg" PRIVATE
+    LABEL "recvmmsg()/sendmmsg()"
+    CONDITION UNIX AND QT_FEATURE_udpsocket AND TEST_sendmmsg
+)
 qt_feature("networkproxy" PUBLIC
     SECTION "Networking"
     LABEL "QNetworkProxy"
@@ -376,6 +399,7 @@ qt_configure_add_summary_entry(
 )
 qt_configure_add_summary_entry(ARGS "dtls")
 qt_configure_add_summary_entry(ARGS "ocsp")
+qt_configure_add_summary_entry(ARGS "sendmmsg")
 qt_configure_add_summary_entry(ARGS "sctp")
 qt_configure_add_summary_entry(ARGS "system-proxies")
 qt_configure_add_summary_entry(ARGS "gssapi")
@@ -69,6 +69,7 @@ private:
     QNetworkDatagramPrivate *d;
     friend class QUdpSocket;
     friend class QSctpSocket;
+    friend class QNetworkDatagramPrivate;
 
     explicit QNetworkDatagram(QNetworkDatagramPrivate &dd);
     QNetworkDatagram makeReply_helper(const QByteArray &data) const;
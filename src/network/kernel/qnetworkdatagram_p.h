@@ -17,6 +17,7 @@
 
 #include <QtNetwork/private/qtnetworkglobal_p.h>
 #include <QtNetwork/qhostaddress.h>
+#include <QtNetwork/qnetworkdatagram.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -59,6 +60,12 @@ public:
         : data(data), header(header)
     {}
 
+#ifndef QT_NO_UDPSOCKET
+    static QNetworkDatagramPrivate *get(QNetworkDatagram &datagram) { return datagram.d; }
+    static const QNetworkDatagramPrivate *get(const QNetworkDatagram &datagram)
+    { return datagram.d; }
+#endif
+
     QByteArray data;
     QIpPacketHeader header;
 };
@@ -517,6 +517,8 @@ void QAbstractSocketPrivate::resetSocketLayer()
 #endif
 
     hasPendingData = false;
+    pendingFiles.clear();
+    notifyWritable = false;
     if (socketEngine) {
         socketEngine->close();
         socketEngine->disconnect();
@@ -719,6 +721,16 @@ bool QAbstractSocketPrivate::canWriteNotification()
     qDebug("QAbstractSocketPrivate::canWriteNotification() flushing");
 #endif
 
+    if (std::exchange(notifyWritable, false) && writableCallback) {
+        Q_Q(QAbstractSocket);
+        QPointer<QAbstractSocket> that = q;
+        // the callback may reset writableCallback
+        const auto callback = writableCallback;
+        callback();
+        if (!that)
+            return false;
+    }
+
     return writeToSocket();
 }
 
@@ -751,7 +763,7 @@ void QAbstractSocketPrivate::connectionNotification()
 bool QAbstractSocketPrivate::writeToSocket()
 {
     Q_Q(QAbstractSocket);
-    if (!socketEngine || !socketEngine->isValid() || (writeBuffer.isEmpty()
+    if (!socketEngine || !socketEngine->isValid() || (!hasPendingWrites()
         && socketEngine->bytesToWrite() == 0)) {
 #if defined (QABSTRACTSOCKET_DEBUG)
     qDebug("QAbstractSocketPrivate::writeToSocket() nothing to do: valid ? %s, writeBuffer.isEmpty() ? %s",
@@ -762,14 +774,19 @@ bool QAbstractSocketPrivate::writeToSocket()
         if (state == QAbstractSocket::ClosingState) {
             q->disconnectFromHost();
         } else {
-            if (socketEngine)
+            if (socketEngine && !notifyWritable)
                 socketEngine->setWriteNotificationEnabled(false);
         }
 
         return false;
     }
 
+    if (!pendingFiles.isEmpty() && pendingFiles.constFirst().precedingBytes == 0)
+        return writeFileToSocket();
+
     qint64 nextSize = writeBuffer.nextDataBlockSize();
+    if (!pendingFiles.isEmpty())
+        nextSize = qMin(nextSize, pendingFiles.constFirst().precedingBytes);
     const char *ptr = writeBuffer.readPointer();
 
     // Attempt to write it all in one chunk.
@@ -793,12 +810,86 @@ bool QAbstractSocketPrivate::writeToSocket()
     if (written > 0) {
         // Remove what we wrote so far.
         writeBuffer.free(written);
+        if (!pendingFiles.isEmpty())
+            pendingFiles.first().precedingBytes -= written;
 
         // Emit notifications.
         emitBytesWritten(written);
     }
 
-    if (writeBuffer.isEmpty() && socketEngine && !socketEngine->bytesToWrite())
+    if (!hasPendingWrites() && socketEngine && !socketEngine->bytesToWrite() && !notifyWritable)
+        socketEngine->setWriteNotificationEnabled(false);
+    if (state == QAbstractSocket::ClosingState)
+        q->disconnectFromHost();
+
+    return written > 0;
+}
+
+/*! \internal
+
+    Returns \c true if file regions queued with QAbstractSocket::sendFile()
+    can be transmitted without copying them through user space.
+*/
+bool QAbstractSocketPrivate::canSendFile() const
+{
+    return socketEngine && socketEngine->canSendFile();
+}
+
+/*! \internal
+
+    Makes sure that a file region that was just queued with
+    QAbstractSocket::sendFile() gets written once the socket is writable.
+*/
+void QAbstractSocketPrivate::scheduleFileWrite()
+{
+    socketEngine->setWriteNotificationEnabled(true);
+}
+
+/*! \internal
+
+    Writes as much as possible of the first file region queued with
+    QAbstractSocket::sendFile() to the socket, without copying it through
+    user space.
+
+    Emits bytesWritten().
+*/
+bool QAbstractSocketPrivate::writeFileToSocket()
+{
+    Q_Q(QAbstractSocket);
+    PendingFile &pending = pendingFiles.first();
+    const int fd = pending.file ? pending.file->handle() : -1;
+    if (fd < 0) {
+        setErrorAndEmit(QAbstractSocket::UnknownSocketError,
+                        QAbstractSocket::tr("File to send was closed"));
+        q->abort();
+        return false;
+    }
+
+    const qint64 written = socketEngine->sendFile(fd, pending.offset, pending.remaining);
+    if (written < 0) {
+#if defined (QABSTRACTSOCKET_DEBUG)
+        qDebug() << "QAbstractSocketPrivate::writeFileToSocket() write error, aborting."
+                 << socketEngine->errorString();
+#endif
+        setErrorAndEmit(socketEngine->error(), socketEngine->errorString());
+        q->abort();
+        return false;
+    }
+
+#if defined (QABSTRACTSOCKET_DEBUG)
+    qDebug("QAbstractSocketPrivate::writeFileToSocket() %lld bytes written to the network",
+           written);
+#endif
+
+    pending.offset += written;
+    pending.remaining -= written;
+    if (pending.remaining == 0)
+        pendingFiles.removeFirst();
+
+    if (written > 0)
+        emitBytesWritten(written);
+
+    if (!hasPendingWrites() && socketEngine && !socketEngine->bytesToWrite() && !notifyWritable)
         socketEngine->setWriteNotificationEnabled(false);
     if (state == QAbstractSocket::ClosingState)
         q->disconnectFromHost();
@@ -816,7 +907,7 @@ bool QAbstractSocketPrivate::flush()
 {
     bool dataWasWritten = false;
 
-    while (!allWriteBuffersEmpty() && writeToSocket())
+    while ((!allWriteBuffersEmpty() || !pendingFiles.isEmpty()) && writeToSocket())
         dataWasWritten = true;
 
     return dataWasWritten;
@@ -1740,7 +1831,10 @@ void QAbstractSocket::connectToHost(const QHostAddress &address, quint16 port,
 */
 qint64 QAbstractSocket::bytesToWrite() const
 {
-    const qint64 pendingBytes = QIODevice::bytesToWrite();
+    Q_D(const QAbstractSocket);
+    qint64 pendingBytes = QIODevice::bytesToWrite();
+    for (const QAbstractSocketPrivate::PendingFile &pending : d->pendingFiles)
+        pendingBytes += pending.remaining;
 #if defined(QABSTRACTSOCKET_DEBUG)
     qDebug("QAbstractSocket::bytesToWrite() == %lld", pendingBytes);
 #endif
@@ -2165,7 +2259,7 @@ bool QAbstractSocket::waitForReadyRead(int msecs)
 
         bool readyToRead = false;
         bool readyToWrite = false;
-        if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite, true, !d->writeBuffer.isEmpty(),
+        if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite, true, d->hasPendingWrites(),
                                                  deadline)) {
 #if defined (QABSTRACTSOCKET_DEBUG)
             qDebug("QAbstractSocket::waitForReadyRead(%i) failed (%i, %s)",
@@ -2217,7 +2311,7 @@ bool QAbstractSocket::waitForBytesWritten(int msecs)
         return false;
     }
 
-    if (d->writeBuffer.isEmpty())
+    if (!d->hasPendingWrites())
         return false;
 
     QDeadlineTimer deadline{msecs};
@@ -2233,7 +2327,7 @@ bool QAbstractSocket::waitForBytesWritten(int msecs)
         bool readyToWrite = false;
         if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite,
                                   !d->readBufferMaxSize || d->buffer.size() < d->readBufferMaxSize,
-                                  !d->writeBuffer.isEmpty(),
+                                  d->hasPendingWrites(),
                                   deadline)) {
 #if defined (QABSTRACTSOCKET_DEBUG)
             qDebug("QAbstractSocket::waitForBytesWritten(%i) failed (%i, %s)",
@@ -2312,7 +2406,7 @@ bool QAbstractSocket::waitForDisconnected(int msecs)
         bool readyToRead = false;
         bool readyToWrite = false;
         if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite, state() == ConnectedState,
-                                               !d->writeBuffer.isEmpty(),
+                                               d->hasPendingWrites(),
                                                deadline)) {
 #if defined (QABSTRACTSOCKET_DEBUG)
             qDebug("QAbstractSocket::waitForReadyRead(%i) failed (%i, %s)",
@@ -2379,6 +2473,85 @@ bool QAbstractSocket::flush()
     return d_func()->flush();
 }
 
+/*!
+    \since 6.10
+
+    Queues \a length bytes of \a file, starting at \a offset, for sending
+    on this socket. If \a length is -1, everything from \a offset to the
+    end of the file is sent. The data is sent in order with respect to
+    any data passed to write() before and after this call, and progress
+    is reported through bytesWritten() as usual.
+
+    On platforms that support it, such as Linux, the contents of a
+    regular local file are transmitted without being copied through the
+    application, using the operating system's sendfile() facility. In
+    that case \a file must stay open and unchanged until bytesToWrite()
+    drops to the number of bytes queued before the file. Otherwise, for
+    example for sequential devices, text-mode files or encrypted
+    sockets without kernel TLS (see QSsl::SslOptionEnableKernelTls), the
+    data is read from \a file and written to the socket immediately. The current position of \a file is not changed.
+
+    Returns \c true if the data was queued; otherwise returns \c false.
+
+    \sa write(), bytesToWrite()
+*/
+bool QAbstractSocket::sendFile(QFile *file, qint64 offset, qint64 length)
+{
+    Q_D(QAbstractSocket);
+    if (!file || !file->isReadable() || offset < 0) {
+        qWarning("QAbstractSocket::sendFile: File is not readable or offset is invalid");
+        return false;
+    }
+    if (d->state != QAbstractSocket::ConnectedState) {
+        d->setError(UnknownSocketError, tr("Socket is not connected"));
+        return false;
+    }
+    if (!isWritable()) {
+        qWarning("QAbstractSocket::sendFile: Socket is not open for writing");
+        return false;
+    }
+
+    const qint64 available = file->isSequential() ? length : file->size() - offset;
+    if (length < 0 || (available >= 0 && length > available))
+        length = available;
+    if (length < 0)
+        return false;
+    if (length == 0)
+        return true;
+
+    if (file->isWritable())
+        file->flush();
+
+    if (!d->canSendFile() || file->handle() < 0
+        || file->isSequential() || file->isTextModeEnabled()) {
+        // No zero-copy path; go through write() so that subclasses such
+        // as QSslSocket still get to process the data.
+        const qint64 oldPos = file->pos();
+        if (!file->isSequential() && !file->seek(offset))
+            return false;
+        QByteArray chunk;
+        bool ok = true;
+        while (length > 0) {
+            chunk = file->read(qMin<qint64>(length, 64 * 1024));
+            if (chunk.isEmpty() || write(chunk) != chunk.size()) {
+                ok = false;
+                break;
+            }
+            length -= chunk.size();
+        }
+        if (!file->isSequential())
+            file->seek(oldPos);
+        return ok;
+    }
+
+    qint64 precedingBytes = d->writeBuffer.size();
+    for (const QAbstractSocketPrivate::PendingFile &pending : std::as_const(d->pendingFiles))
+        precedingBytes -= pending.precedingBytes;
+    d->pendingFiles.append({ file, offset, length, precedingBytes });
+    d->scheduleFileWrite();
+    return true;
+}
+
 /*! \reimp
 */
 qint64 QAbstractSocket::readData(char *data, qint64 maxSize)
@@ -2431,7 +2604,7 @@ qint64 QAbstractSocket::writeData(const char *data, qint64 size)
     }
 
     if (!d->isBuffered && d->socketType == TcpSocket
-        && d->socketEngine && d->writeBuffer.isEmpty()) {
+        && d->socketEngine && !d->hasPendingWrites()) {
         // This code is for the new Unbuffered QTcpSocket use case
         qint64 written = size ? d->socketEngine->write(data, size) : Q_INT64_C(0);
         if (written < 0) {
@@ -2659,7 +2832,7 @@ void QAbstractSocket::disconnectFromHost()
 
         // Wait for pending data to be written.
         if (d->socketEngine && d->socketEngine->isValid() && (!d->allWriteBuffersEmpty()
-            || d->socketEngine->bytesToWrite() > 0)) {
+            || !d->pendingFiles.isEmpty() || d->socketEngine->bytesToWrite() > 0)) {
             d->socketEngine->setWriteNotificationEnabled(true);
 
 #if defined(QABSTRACTSOCKET_DEBUG)
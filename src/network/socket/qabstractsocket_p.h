@@ -18,12 +18,16 @@
 #include <QtNetwork/private/qtnetworkglobal_p.h>
 #include "QtNetwork/qabstractsocket.h"
 #include "QtCore/qbytearray.h"
+#include "QtCore/qfile.h"
 #include "QtCore/qlist.h"
+#include "QtCore/qpointer.h"
 #include "QtCore/qtimer.h"
 #include "private/qiodevice_p.h"
 #include "private/qabstractsocketengine_p.h"
 #include "qnetworkproxy.h"
 
+#include <functional>
+
 QT_BEGIN_NAMESPACE
 
 class QHostInfo;
@@ -101,12 +105,41 @@ public:
     void fetchConnectionParameters();
     bool readFromSocket();
     virtual bool writeToSocket();
+    bool writeFileToSocket();
+    virtual bool canSendFile() const;
+    virtual void scheduleFileWrite();
+    inline bool hasPendingWrites() const
+    { return !writeBuffer.isEmpty() || !pendingFiles.isEmpty(); }
     void emitReadyRead(int channel = 0);
     void emitBytesWritten(qint64 bytes, int channel = 0);
 
     void setError(QAbstractSocket::SocketError errorCode, const QString &errorString);
     void setErrorAndEmit(QAbstractSocket::SocketError errorCode, const QString &errorString);
 
+    // A file region queued with sendFile(), written after precedingBytes
+    // more bytes of writeBuffer have been written.
+    struct PendingFile
+    {
+        QPointer<QFile> file;
+        qint64 offset;
+        qint64 remaining;
+        qint64 precedingBytes;
+    };
+    QList<PendingFile> pendingFiles;
+
+    // Lets a writer that bypasses writeBuffer, such as a TLS backend writing
+    // records to the descriptor itself, wait for the socket to become
+    // writable through the engine's write notifier: notifyWhenWritable()
+    // has writableCallback called from the next write notification.
+    void notifyWhenWritable()
+    {
+        notifyWritable = true;
+        if (socketEngine)
+            socketEngine->setWriteNotificationEnabled(true);
+    }
+    std::function<void()> writableCallback;
+    bool notifyWritable = false;
+
     qint64 readBufferMaxSize = 0;
     bool isBuffered = false;
     bool hasPendingData = false;
@@ -233,6 +233,98 @@ int QAbstractSocketEngine::outboundStreamCount() const
     return d_func()->outboundStreamCount;
 }
 
+/*!
+    \internal
+
+    Returns \c true if sendFile() can transfer file contents to this socket
+    without copying them through user space. The default implementation
+    returns \c false.
+*/
+bool QAbstractSocketEngine::canSendFile() const
+{
+    return false;
+}
+
+/*!
+    \internal
+
+    Writes up to \a maxSize bytes, starting at \a offset, from the file
+    referred to by \a fileDescriptor to the socket. Returns the number of
+    bytes written, or -1 if an error occurred. Only called if canSendFile()
+    returned \c true.
+*/
+qint64 QAbstractSocketEngine::sendFile(qintptr fileDescriptor, qint64 offset, qint64 maxSize)
+{
+    Q_UNUSED(fileDescriptor);
+    Q_UNUSED(offset);
+    Q_UNUSED(maxSize);
+    setError(QAbstractSocket::UnsupportedSocketOperationError,
+             tr("Operation is not supported"));
+    return -1;
+}
+
+#ifndef QT_NO_UDPSOCKET
+/*!
+    \internal
+
+    Receives up to \a count pending datagrams into \a datagrams, reading at
+    most \a maxSize bytes of each (or the whole datagram if \a maxSize is
+    -1). Returns the number of datagrams received, -2 if none was
+    available, or -1 if an error occurred.
+
+    The default implementation calls readDatagram() once per datagram;
+    engines that can receive several datagrams in one system call
+    reimplement it.
+*/
+qint64 QAbstractSocketEngine::readDatagrams(QNetworkDatagram *datagrams, qint64 count,
+                                            qint64 maxSize, PacketHeaderOptions options)
+{
+    qint64 received = 0;
+    for ( ; received < count; ++received) {
+        if (received && !hasPendingDatagrams())
+            break;
+        // don't leave the datagram holding on to more than it needs
+        const qint64 pendingSize = pendingDatagramSize();
+        if (pendingSize < 0)
+            break;
+        const qint64 size = maxSize < 0 ? pendingSize : qMin(maxSize, pendingSize);
+        QNetworkDatagramPrivate *d = QNetworkDatagramPrivate::get(datagrams[received]);
+        d->data.resize(size);
+        const qint64 readBytes = readDatagram(d->data.data(), size, &d->header, options);
+        if (readBytes < 0) {
+            d->data.clear();
+            if (received == 0)
+                return readBytes;
+            break;
+        }
+        d->data.truncate(readBytes);
+    }
+    return received;
+}
+
+/*!
+    \internal
+
+    Sends the \a count datagrams in \a datagrams. Returns the number of
+    datagrams that were sent, -2 if the first one could not be sent
+    because the socket buffer is full, or -1 if an error occurred before
+    anything was sent.
+
+    The default implementation calls writeDatagram() once per datagram.
+*/
+qint64 QAbstractSocketEngine::writeDatagrams(const QNetworkDatagram *datagrams, qint64 count)
+{
+    qint64 sent = 0;
+    for ( ; sent < count; ++sent) {
+        const QNetworkDatagramPrivate *d = QNetworkDatagramPrivate::get(datagrams[sent]);
+        const qint64 result = writeDatagram(d->data.constData(), d->data.size(), d->header);
+        if (result < 0)
+            return sent ? sent : result;
+    }
+    return sent;
+}
+#endif // QT_NO_UDPSOCKET
+
 QT_END_NAMESPACE
 
 #include "moc_qabstractsocketengine_p.cpp"
@@ -109,6 +109,9 @@ public:
     virtual qint64 read(char *data, qint64 maxlen) = 0;
     virtual qint64 write(const char *data, qint64 len) = 0;
 
+    virtual bool canSendFile() const;
+    virtual qint64 sendFile(qintptr fileDescriptor, qint64 offset, qint64 maxSize);
+
 #ifndef QT_NO_UDPSOCKET
 #ifndef QT_NO_NETWORKINTERFACE
     virtual bool joinMulticastGroup(const QHostAddress &groupAddress,
@@ -126,6 +129,11 @@ public:
     virtual qint64 readDatagram(char *data, qint64 maxlen, QIpPacketHeader *header = nullptr,
                                 PacketHeaderOptions = WantNone) = 0;
     virtual qint64 writeDatagram(const char *data, qint64 len, const QIpPacketHeader &header) = 0;
+#ifndef QT_NO_UDPSOCKET
+    virtual qint64 readDatagrams(QNetworkDatagram *datagrams, qint64 count, qint64 maxSize,
+                                 PacketHeaderOptions options);
+    virtual qint64 writeDatagrams(const QNetworkDatagram *datagrams, qint64 count);
+#endif
     virtual qint64 bytesToWrite() const = 0;
 
     virtual int option(SocketOption option) const = 0;
@@ -866,6 +866,43 @@ qint64 QNativeSocketEngine::writeDatagram(const char *data, qint64 size, const Q
     return d->nativeSendDatagram(data, size, header);
 }
 
+#if QT_CONFIG(sendmmsg)
+/*!
+    Receives up to \a count datagrams into \a datagrams with a single
+    system call. Returns the number of datagrams received, -2 if none was
+    available, or -1 if an error occurred.
+
+    \sa readDatagram()
+*/
+qint64 QNativeSocketEngine::readDatagrams(QNetworkDatagram *datagrams, qint64 count,
+                                          qint64 maxSize, PacketHeaderOptions options)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::readDatagrams(), -1);
+    Q_CHECK_STATES(QNativeSocketEngine::readDatagrams(), QAbstractSocket::BoundState,
+                   QAbstractSocket::ConnectedState, -1);
+
+    return d->nativeReceiveDatagrams(datagrams, count, maxSize, options);
+}
+
+/*!
+    Sends the \a count datagrams in \a datagrams with a single system
+    call. Returns the number of datagrams sent, -2 if the socket's send
+    buffer is full, or -1 if an error occurred.
+
+    \sa writeDatagram()
+*/
+qint64 QNativeSocketEngine::writeDatagrams(const QNetworkDatagram *datagrams, qint64 count)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::writeDatagrams(), -1);
+    Q_CHECK_STATES(QNativeSocketEngine::writeDatagrams(), QAbstractSocket::BoundState,
+                   QAbstractSocket::ConnectedState, -1);
+
+    return d->nativeSendDatagrams(datagrams, count);
+}
+#endif // QT_CONFIG(sendmmsg)
+
 /*!
     Writes a block of \a size bytes from \a data to the socket.
     Returns the number of bytes written, or -1 if an error occurred.
@@ -888,6 +925,37 @@ qint64 QNativeSocketEngine::bytesToWrite() const
     return 0;
 }
 
+/*!
+    Returns \c true if file contents can be written to this socket with
+    sendFile() without being copied through user space.
+*/
+bool QNativeSocketEngine::canSendFile() const
+{
+#ifdef Q_OS_LINUX
+    Q_D(const QNativeSocketEngine);
+    return d->socketType == QAbstractSocket::TcpSocket;
+#else
+    return false;
+#endif
+}
+
+/*!
+    Writes up to \a maxSize bytes from the file \a fileDescriptor, starting
+    at \a offset, to the socket without copying them through user space.
+    Returns the number of bytes written, or -1 if an error occurred.
+*/
+qint64 QNativeSocketEngine::sendFile(qintptr fileDescriptor, qint64 offset, qint64 maxSize)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::sendFile(), -1);
+    Q_CHECK_STATE(QNativeSocketEngine::sendFile(), QAbstractSocket::ConnectedState, -1);
+#ifdef Q_OS_LINUX
+    return d->nativeSendFile(int(fileDescriptor), offset, maxSize);
+#else
+    return QAbstractSocketEngine::sendFile(fileDescriptor, offset, maxSize);
+#endif
+}
+
 /*!
     Reads up to \a maxSize bytes into \a data from the socket.
     Returns the number of bytes read, or -1 if an error occurred.
@@ -124,6 +124,9 @@ public:
     qint64 read(char *data, qint64 maxlen) override;
     qint64 write(const char *data, qint64 len) override;
 
+    bool canSendFile() const override;
+    qint64 sendFile(qintptr fileDescriptor, qint64 offset, qint64 maxSize) override;
+
 #ifndef QT_NO_UDPSOCKET
 #ifndef QT_NO_NETWORKINTERFACE
     bool joinMulticastGroup(const QHostAddress &groupAddress,
@@ -141,6 +144,11 @@ public:
     qint64 readDatagram(char *data, qint64 maxlen, QIpPacketHeader * = nullptr,
                         PacketHeaderOptions = WantNone) override;
     qint64 writeDatagram(const char *data, qint64 len, const QIpPacketHeader &) override;
+#if QT_CONFIG(sendmmsg)
+    qint64 readDatagrams(QNetworkDatagram *datagrams, qint64 count, qint64 maxSize,
+                         PacketHeaderOptions options) override;
+    qint64 writeDatagrams(const QNetworkDatagram *datagrams, qint64 count) override;
+#endif
     qint64 bytesToWrite() const override;
 
 #if 0   // currently unused
@@ -144,8 +144,21 @@ public:
     qint64 nativeReceiveDatagram(char *data, qint64 maxLength, QIpPacketHeader *header,
                                  QAbstractSocketEngine::PacketHeaderOptions options);
     qint64 nativeSendDatagram(const char *data, qint64 length, const QIpPacketHeader &header);
+#if QT_CONFIG(sendmmsg)
+    qint64 nativeReceiveDatagrams(QNetworkDatagram *datagrams, qint64 count, qint64 maxSize,
+                                  QAbstractSocketEngine::PacketHeaderOptions options);
+    qint64 nativeSendDatagrams(const QNetworkDatagram *datagrams, qint64 count);
+    QByteArray datagramScratchBuffer;
+#endif
+#ifndef Q_OS_WIN
+    qint64 datagramReceiveError() const;
+    qint64 datagramSendError() const;
+#endif
     qint64 nativeRead(char *data, qint64 maxLength);
     qint64 nativeWrite(const char *data, qint64 length);
+#ifdef Q_OS_LINUX
+    qint64 nativeSendFile(int fileDescriptor, qint64 offset, qint64 maxSize);
+#endif
     int nativeSelect(QDeadlineTimer deadline, bool selectForRead) const;
     int nativeSelect(QDeadlineTimer deadline, bool checkRead, bool checkWrite,
                      bool *selectForRead, bool *selectForWrite) const;
@@ -34,6 +34,9 @@
 #ifdef Q_OS_BSD4
 #  include <net/if_dl.h>
 #endif
+#ifdef Q_OS_LINUX
+#  include <sys/sendfile.h>
+#endif
 
 QT_BEGIN_NAMESPACE
 
@@ -867,11 +870,11 @@ qint64 QNativeSocketEnginePrivate::nativePendingDatagramSize() const
     return qint64(recvResult);
 }
 
-qint64 QNativeSocketEnginePrivate::nativeReceiveDatagram(char *data, qint64 maxSize, QIpPacketHeader *header,
-                                                         QAbstractSocketEngine::PacketHeaderOptions options)
+namespace {
+// we use quintptr to force the alignment
+struct ReceiveControlBuffer
 {
-    // we use quintptr to force the alignment
-    quintptr cbuf[(CMSG_SPACE(sizeof(struct in6_pktinfo)) + CMSG_SPACE(sizeof(int))
+    quintptr data[(CMSG_SPACE(sizeof(struct in6_pktinfo)) + CMSG_SPACE(sizeof(int))
 #if !defined(IP_PKTINFO) && defined(IP_RECVIF) && defined(Q_OS_BSD4)
                    + CMSG_SPACE(sizeof(sockaddr_dl))
 #endif
@@ -879,116 +882,148 @@ qint64 QNativeSocketEnginePrivate::nativeReceiveDatagram(char *data, qint64 maxS
                    + CMSG_SPACE(sizeof(struct sctp_sndrcvinfo))
 #endif
                    + sizeof(quintptr) - 1) / sizeof(quintptr)];
+};
 
-    struct msghdr msg;
-    struct iovec vec;
-    qt_sockaddr aa;
-    char c;
-    memset(&msg, 0, sizeof(msg));
-    memset(&aa, 0, sizeof(aa));
+struct SendControlBuffer
+{
+    quintptr data[(CMSG_SPACE(sizeof(struct in6_pktinfo)) + CMSG_SPACE(sizeof(int))
+#ifndef QT_NO_SCTP
+                   + CMSG_SPACE(sizeof(struct sctp_sndrcvinfo))
+#endif
+                   + sizeof(quintptr) - 1) / sizeof(quintptr)];
+};
+} // unnamed namespace
 
-    // we need to receive at least one byte, even if our user isn't interested in it
-    vec.iov_base = maxSize ? data : &c;
-    vec.iov_len = maxSize ? maxSize : 1;
-    msg.msg_iov = &vec;
-    msg.msg_iovlen = 1;
+static void qt_prepareDatagramReceive(msghdr *msg, qt_sockaddr *aa, ReceiveControlBuffer *cbuf,
+                                      QAbstractSocketEngine::PacketHeaderOptions options)
+{
     if (options & QAbstractSocketEngine::WantDatagramSender) {
-        msg.msg_name = &aa;
-        msg.msg_namelen = sizeof(aa);
+        msg->msg_name = aa;
+        msg->msg_namelen = sizeof(*aa);
     }
     if (options & (QAbstractSocketEngine::WantDatagramHopLimit | QAbstractSocketEngine::WantDatagramDestination
                    | QAbstractSocketEngine::WantStreamNumber)) {
-        msg.msg_control = cbuf;
-        msg.msg_controllen = sizeof(cbuf);
+        msg->msg_control = cbuf;
+        msg->msg_controllen = sizeof(*cbuf);
     }
+}
 
-    ssize_t recvResult = 0;
-    do {
-        recvResult = ::recvmsg(socketDescriptor, &msg, 0);
-    } while (recvResult == -1 && errno == EINTR);
-
-    if (recvResult == -1) {
-        switch (errno) {
-#if defined(EWOULDBLOCK) && EWOULDBLOCK != EAGAIN
-        case EWOULDBLOCK:
-#endif
-        case EAGAIN:
-            // No datagram was available for reading
-            recvResult = -2;
-            break;
-        case ECONNREFUSED:
-            setError(QAbstractSocket::ConnectionRefusedError, ConnectionRefusedErrorString);
-            break;
-        default:
-            setError(QAbstractSocket::NetworkError, ReceiveDatagramErrorString);
+static void qt_parseDatagramHeader(msghdr *msg, const qt_sockaddr *aa, quint16 localPort,
+                                   QIpPacketHeader *header)
+{
+    qt_socket_getPortAndAddress(aa, &header->senderPort, &header->senderAddress);
+    header->destinationPort = localPort;
+    header->endOfRecord = (msg->msg_flags & MSG_EOR) != 0;
+
+    // parse the ancillary data
+    struct cmsghdr *cmsgptr;
+    QT_WARNING_PUSH
+    QT_WARNING_DISABLE_CLANG("-Wsign-compare")
+    for (cmsgptr = CMSG_FIRSTHDR(msg); cmsgptr != nullptr;
+         cmsgptr = CMSG_NXTHDR(msg, cmsgptr)) {
+        QT_WARNING_POP
+        if (cmsgptr->cmsg_level == IPPROTO_IPV6 && cmsgptr->cmsg_type == IPV6_PKTINFO
+                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in6_pktinfo))) {
+            in6_pktinfo *info = reinterpret_cast<in6_pktinfo *>(CMSG_DATA(cmsgptr));
+
+            header->destinationAddress.setAddress(reinterpret_cast<quint8 *>(&info->ipi6_addr));
+            header->ifindex = info->ipi6_ifindex;
+            if (header->ifindex)
+                header->destinationAddress.setScopeId(QString::number(info->ipi6_ifindex));
         }
-        if (header)
-            header->clear();
-    } else if (options != QAbstractSocketEngine::WantNone) {
-        Q_ASSERT(header);
-        qt_socket_getPortAndAddress(&aa, &header->senderPort, &header->senderAddress);
-        header->destinationPort = localPort;
-        header->endOfRecord = (msg.msg_flags & MSG_EOR) != 0;
-
-        // parse the ancillary data
-        struct cmsghdr *cmsgptr;
-        QT_WARNING_PUSH
-        QT_WARNING_DISABLE_CLANG("-Wsign-compare")
-        for (cmsgptr = CMSG_FIRSTHDR(&msg); cmsgptr != nullptr;
-             cmsgptr = CMSG_NXTHDR(&msg, cmsgptr)) {
-            QT_WARNING_POP
-            if (cmsgptr->cmsg_level == IPPROTO_IPV6 && cmsgptr->cmsg_type == IPV6_PKTINFO
-                    && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in6_pktinfo))) {
-                in6_pktinfo *info = reinterpret_cast<in6_pktinfo *>(CMSG_DATA(cmsgptr));
-
-                header->destinationAddress.setAddress(reinterpret_cast<quint8 *>(&info->ipi6_addr));
-                header->ifindex = info->ipi6_ifindex;
-                if (header->ifindex)
-                    header->destinationAddress.setScopeId(QString::number(info->ipi6_ifindex));
-            }
 
 #ifdef IP_PKTINFO
-            if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_PKTINFO
-                    && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in_pktinfo))) {
-                in_pktinfo *info = reinterpret_cast<in_pktinfo *>(CMSG_DATA(cmsgptr));
+        if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_PKTINFO
+                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in_pktinfo))) {
+            in_pktinfo *info = reinterpret_cast<in_pktinfo *>(CMSG_DATA(cmsgptr));
 
-                header->destinationAddress.setAddress(ntohl(info->ipi_addr.s_addr));
-                header->ifindex = info->ipi_ifindex;
-            }
+            header->destinationAddress.setAddress(ntohl(info->ipi_addr.s_addr));
+            header->ifindex = info->ipi_ifindex;
+        }
 #else
 #  ifdef IP_RECVDSTADDR
-            if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_RECVDSTADDR
-                    && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in_addr))) {
-                in_addr *addr = reinterpret_cast<in_addr *>(CMSG_DATA(cmsgptr));
+        if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_RECVDSTADDR
+                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in_addr))) {
+            in_addr *addr = reinterpret_cast<in_addr *>(CMSG_DATA(cmsgptr));
 
-                header->destinationAddress.setAddress(ntohl(addr->s_addr));
-            }
+            header->destinationAddress.setAddress(ntohl(addr->s_addr));
+        }
 #  endif
 #  if defined(IP_RECVIF) && defined(Q_OS_BSD4)
-            if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_RECVIF
-                    && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(sockaddr_dl))) {
-                sockaddr_dl *sdl = reinterpret_cast<sockaddr_dl *>(CMSG_DATA(cmsgptr));
-                header->ifindex = sdl->sdl_index;
-            }
+        if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_RECVIF
+                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(sockaddr_dl))) {
+            sockaddr_dl *sdl = reinterpret_cast<sockaddr_dl *>(CMSG_DATA(cmsgptr));
+            header->ifindex = sdl->sdl_index;
+        }
 #  endif
 #endif
 
-            if (cmsgptr->cmsg_len == CMSG_LEN(sizeof(int))
-                    && ((cmsgptr->cmsg_level == IPPROTO_IPV6 && cmsgptr->cmsg_type == IPV6_HOPLIMIT)
-                        || (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_TTL))) {
-                static_assert(sizeof(header->hopLimit) == sizeof(int));
-                memcpy(&header->hopLimit, CMSG_DATA(cmsgptr), sizeof(header->hopLimit));
-            }
+        if (cmsgptr->cmsg_len == CMSG_LEN(sizeof(int))
+                && ((cmsgptr->cmsg_level == IPPROTO_IPV6 && cmsgptr->cmsg_type == IPV6_HOPLIMIT)
+                    || (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_TTL))) {
+            static_assert(sizeof(header->hopLimit) == sizeof(int));
+            memcpy(&header->hopLimit, CMSG_DATA(cmsgptr), sizeof(header->hopLimit));
+        }
 
 #ifndef QT_NO_SCTP
-            if (cmsgptr->cmsg_level == IPPROTO_SCTP && cmsgptr->cmsg_type == SCTP_SNDRCV
-                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(sctp_sndrcvinfo))) {
-                sctp_sndrcvinfo *rcvInfo = reinterpret_cast<sctp_sndrcvinfo *>(CMSG_DATA(cmsgptr));
+        if (cmsgptr->cmsg_level == IPPROTO_SCTP && cmsgptr->cmsg_type == SCTP_SNDRCV
+            && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(sctp_sndrcvinfo))) {
+            sctp_sndrcvinfo *rcvInfo = reinterpret_cast<sctp_sndrcvinfo *>(CMSG_DATA(cmsgptr));
 
-                header->streamNumber = int(rcvInfo->sinfo_stream);
-            }
-#endif
+            header->streamNumber = int(rcvInfo->sinfo_stream);
         }
+#endif
+    }
+}
+
+qint64 QNativeSocketEnginePrivate::datagramReceiveError() const
+{
+    switch (errno) {
+#if defined(EWOULDBLOCK) && EWOULDBLOCK != EAGAIN
+    case EWOULDBLOCK:
+#endif
+    case EAGAIN:
+        // No datagram was available for reading
+        return -2;
+    case ECONNREFUSED:
+        setError(QAbstractSocket::ConnectionRefusedError, ConnectionRefusedErrorString);
+        break;
+    default:
+        setError(QAbstractSocket::NetworkError, ReceiveDatagramErrorString);
+    }
+    return -1;
+}
+
+qint64 QNativeSocketEnginePrivate::nativeReceiveDatagram(char *data, qint64 maxSize, QIpPacketHeader *header,
+                                                         QAbstractSocketEngine::PacketHeaderOptions options)
+{
+    ReceiveControlBuffer cbuf;
+    struct msghdr msg;
+    struct iovec vec;
+    qt_sockaddr aa;
+    char c;
+    memset(&msg, 0, sizeof(msg));
+    memset(&aa, 0, sizeof(aa));
+
+    // we need to receive at least one byte, even if our user isn't interested in it
+    vec.iov_base = maxSize ? data : &c;
+    vec.iov_len = maxSize ? maxSize : 1;
+    msg.msg_iov = &vec;
+    msg.msg_iovlen = 1;
+    qt_prepareDatagramReceive(&msg, &aa, &cbuf, options);
+
+    ssize_t recvResult = 0;
+    do {
+        recvResult = ::recvmsg(socketDescriptor, &msg, 0);
+    } while (recvResult == -1 && errno == EINTR);
+
+    if (recvResult == -1) {
+        recvResult = datagramReceiveError();
+        if (header)
+            header->clear();
+    } else if (options != QAbstractSocketEngine::WantNone) {
+        Q_ASSERT(header);
+        qt_parseDatagramHeader(&msg, &aa, localPort, header);
     }
 
 #if defined (QNATIVESOCKETENGINE_DEBUG)
@@ -1003,37 +1038,29 @@ qint64 QNativeSocketEnginePrivate::nativeReceiveDatagram(char *data, qint64 maxS
     return qint64((maxSize || recvResult < 0) ? recvResult : Q_INT64_C(0));
 }
 
-qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 len, const QIpPacketHeader &header)
+static void qt_prepareDatagramSend(QNativeSocketEnginePrivate *d, msghdr *msg, iovec *vec,
+                                   qt_sockaddr *aa, SendControlBuffer *cbuf,
+                                   const char *data, qint64 len, const QIpPacketHeader &header)
 {
-    // we use quintptr to force the alignment
-    quintptr cbuf[(CMSG_SPACE(sizeof(struct in6_pktinfo)) + CMSG_SPACE(sizeof(int))
-#ifndef QT_NO_SCTP
-                   + CMSG_SPACE(sizeof(struct sctp_sndrcvinfo))
-#endif
-                   + sizeof(quintptr) - 1) / sizeof(quintptr)];
-
     struct cmsghdr *cmsgptr = reinterpret_cast<struct cmsghdr *>(cbuf);
-    struct msghdr msg;
-    struct iovec vec;
-    qt_sockaddr aa;
 
-    memset(&msg, 0, sizeof(msg));
-    memset(&aa, 0, sizeof(aa));
-    vec.iov_base = const_cast<char *>(data);
-    vec.iov_len = len;
-    msg.msg_iov = &vec;
-    msg.msg_iovlen = 1;
-    msg.msg_control = &cbuf;
+    memset(msg, 0, sizeof(*msg));
+    memset(aa, 0, sizeof(*aa));
+    vec->iov_base = const_cast<char *>(data);
+    vec->iov_len = len;
+    msg->msg_iov = vec;
+    msg->msg_iovlen = 1;
+    msg->msg_control = cbuf;
 
     if (header.destinationPort != 0) {
-        msg.msg_name = &aa.a;
-        setPortAndAddress(header.destinationPort, header.destinationAddress,
-                          &aa, &msg.msg_namelen);
+        msg->msg_name = &aa->a;
+        d->setPortAndAddress(header.destinationPort, header.destinationAddress,
+                             aa, &msg->msg_namelen);
     }
 
-    if (msg.msg_namelen == sizeof(aa.a6)) {
+    if (msg->msg_namelen == sizeof(aa->a6)) {
         if (header.hopLimit != -1) {
-            msg.msg_controllen += CMSG_SPACE(sizeof(int));
+            msg->msg_controllen += CMSG_SPACE(sizeof(int));
             cmsgptr->cmsg_len = CMSG_LEN(sizeof(int));
             cmsgptr->cmsg_level = IPPROTO_IPV6;
             cmsgptr->cmsg_type = IPV6_HOPLIMIT;
@@ -1043,7 +1070,7 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
         if (header.ifindex != 0 || !header.senderAddress.isNull()) {
             struct in6_pktinfo *data = reinterpret_cast<in6_pktinfo *>(CMSG_DATA(cmsgptr));
             memset(data, 0, sizeof(*data));
-            msg.msg_controllen += CMSG_SPACE(sizeof(*data));
+            msg->msg_controllen += CMSG_SPACE(sizeof(*data));
             cmsgptr->cmsg_len = CMSG_LEN(sizeof(*data));
             cmsgptr->cmsg_level = IPPROTO_IPV6;
             cmsgptr->cmsg_type = IPV6_PKTINFO;
@@ -1055,7 +1082,7 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
         }
     } else {
         if (header.hopLimit != -1) {
-            msg.msg_controllen += CMSG_SPACE(sizeof(int));
+            msg->msg_controllen += CMSG_SPACE(sizeof(int));
             cmsgptr->cmsg_len = CMSG_LEN(sizeof(int));
             cmsgptr->cmsg_level = IPPROTO_IP;
             cmsgptr->cmsg_type = IP_TTL;
@@ -1077,7 +1104,7 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
             data->s_addr = htonl(header.senderAddress.toIPv4Address());
 #  endif
             cmsgptr->cmsg_level = IPPROTO_IP;
-            msg.msg_controllen += CMSG_SPACE(sizeof(*data));
+            msg->msg_controllen += CMSG_SPACE(sizeof(*data));
             cmsgptr->cmsg_len = CMSG_LEN(sizeof(*data));
             cmsgptr = reinterpret_cast<cmsghdr *>(reinterpret_cast<char *>(cmsgptr) + CMSG_SPACE(sizeof(*data)));
         }
@@ -1088,7 +1115,7 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
     if (header.streamNumber != -1) {
         struct sctp_sndrcvinfo *data = reinterpret_cast<sctp_sndrcvinfo *>(CMSG_DATA(cmsgptr));
         memset(data, 0, sizeof(*data));
-        msg.msg_controllen += CMSG_SPACE(sizeof(sctp_sndrcvinfo));
+        msg->msg_controllen += CMSG_SPACE(sizeof(sctp_sndrcvinfo));
         cmsgptr->cmsg_len = CMSG_LEN(sizeof(sctp_sndrcvinfo));
         cmsgptr->cmsg_level = IPPROTO_SCTP;
         cmsgptr->cmsg_type =  SCTP_SNDRCV;
@@ -1097,28 +1124,41 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
     }
 #endif
 
-    if (msg.msg_controllen == 0)
-        msg.msg_control = nullptr;
-    ssize_t sentBytes = qt_safe_sendmsg(socketDescriptor, &msg, 0);
+    if (msg->msg_controllen == 0)
+        msg->msg_control = nullptr;
+}
 
-    if (sentBytes < 0) {
-        switch (errno) {
+qint64 QNativeSocketEnginePrivate::datagramSendError() const
+{
+    switch (errno) {
 #if defined(EWOULDBLOCK) && EWOULDBLOCK != EAGAIN
-        case EWOULDBLOCK:
+    case EWOULDBLOCK:
 #endif
-        case EAGAIN:
-            sentBytes = -2;
-            break;
-        case EMSGSIZE:
-            setError(QAbstractSocket::DatagramTooLargeError, DatagramTooLargeErrorString);
-            break;
-        case ECONNRESET:
-            setError(QAbstractSocket::RemoteHostClosedError, RemoteHostClosedErrorString);
-            break;
-        default:
-            setError(QAbstractSocket::NetworkError, SendDatagramErrorString);
-        }
+    case EAGAIN:
+        return -2;
+    case EMSGSIZE:
+        setError(QAbstractSocket::DatagramTooLargeError, DatagramTooLargeErrorString);
+        break;
+    case ECONNRESET:
+        setError(QAbstractSocket::RemoteHostClosedError, RemoteHostClosedErrorString);
+        break;
+    default:
+        setError(QAbstractSocket::NetworkError, SendDatagramErrorString);
     }
+    return -1;
+}
+
+qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 len, const QIpPacketHeader &header)
+{
+    SendControlBuffer cbuf;
+    struct msghdr msg;
+    struct iovec vec;
+    qt_sockaddr aa;
+    qt_prepareDatagramSend(this, &msg, &vec, &aa, &cbuf, data, len, header);
+
+    ssize_t sentBytes = qt_safe_sendmsg(socketDescriptor, &msg, 0);
+    if (sentBytes < 0)
+        sentBytes = datagramSendError();
 
 #if defined (QNATIVESOCKETENGINE_DEBUG)
     qDebug("QNativeSocketEngine::sendDatagram(%p \"%s\", %lli, \"%s\", %i) == %lli", data,
@@ -1130,6 +1170,99 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
     return qint64(sentBytes);
 }
 
+#if QT_CONFIG(sendmmsg)
+// Upper bound for the number of datagrams transferred in one system call;
+// larger requests are split up by the caller.
+static constexpr qint64 MaxDatagramBatch = 64;
+// The largest payload a UDP datagram can carry, and so the largest slot we
+// ever need to receive a datagram into.
+static constexpr qint64 MaxDatagramPayload = 65536;
+
+qint64 QNativeSocketEnginePrivate::nativeReceiveDatagrams(QNetworkDatagram *datagrams, qint64 count,
+                                                          qint64 maxSize,
+                                                          QAbstractSocketEngine::PacketHeaderOptions options)
+{
+    count = qMin(count, MaxDatagramBatch);
+    if (count <= 0)
+        return 0;
+
+    // Receive into a scratch buffer that is kept for the lifetime of the
+    // socket, with slots large enough for any datagram we may return, and
+    // copy out what actually arrived, so that the datagrams we return only
+    // hold on to the memory they need. The kernel only touches the bytes it
+    // writes, so most of the buffer stays uncommitted when the datagrams
+    // are small.
+    const qint64 slotSize = maxSize < 0 ? MaxDatagramPayload
+                                        : qBound(Q_INT64_C(1), maxSize, MaxDatagramPayload);
+    if (datagramScratchBuffer.size() < count * slotSize)
+        datagramScratchBuffer.resize(count * slotSize);
+
+    QVarLengthArray<mmsghdr, MaxDatagramBatch> msgs(count);
+    QVarLengthArray<iovec, MaxDatagramBatch> vecs(count);
+    QVarLengthArray<qt_sockaddr, MaxDatagramBatch> addrs(count);
+    QVarLengthArray<ReceiveControlBuffer, MaxDatagramBatch> cbufs(count);
+    memset(msgs.data(), 0, count * sizeof(mmsghdr));
+    memset(addrs.data(), 0, count * sizeof(qt_sockaddr));
+
+    for (qint64 i = 0; i < count; ++i) {
+        vecs[i].iov_base = datagramScratchBuffer.data() + i * slotSize;
+        vecs[i].iov_len = slotSize;
+        msgs[i].msg_hdr.msg_iov = &vecs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        qt_prepareDatagramReceive(&msgs[i].msg_hdr, &addrs[i], &cbufs[i], options);
+    }
+
+    const int received = qt_safe_recvmmsg(socketDescriptor, msgs.data(), uint(count), MSG_DONTWAIT);
+    if (received < 0)
+        return datagramReceiveError();
+
+    for (qint64 i = 0; i < received; ++i) {
+        QNetworkDatagramPrivate *d = QNetworkDatagramPrivate::get(datagrams[i]);
+        const qint64 size = maxSize == 0 ? 0 : qint64(msgs[i].msg_len);
+        d->data = QByteArray(datagramScratchBuffer.constData() + i * slotSize, size);
+        if (options != QAbstractSocketEngine::WantNone)
+            qt_parseDatagramHeader(&msgs[i].msg_hdr, &addrs[i], localPort, &d->header);
+    }
+
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEnginePrivate::nativeReceiveDatagrams(%p, %lli, %lli) == %i",
+           datagrams, count, maxSize, received);
+#endif
+
+    return received;
+}
+
+qint64 QNativeSocketEnginePrivate::nativeSendDatagrams(const QNetworkDatagram *datagrams, qint64 count)
+{
+    count = qMin(count, MaxDatagramBatch);
+    if (count <= 0)
+        return 0;
+
+    QVarLengthArray<mmsghdr, MaxDatagramBatch> msgs(count);
+    QVarLengthArray<iovec, MaxDatagramBatch> vecs(count);
+    QVarLengthArray<qt_sockaddr, MaxDatagramBatch> addrs(count);
+    QVarLengthArray<SendControlBuffer, MaxDatagramBatch> cbufs(count);
+
+    for (qint64 i = 0; i < count; ++i) {
+        const QNetworkDatagramPrivate *d = QNetworkDatagramPrivate::get(datagrams[i]);
+        qt_prepareDatagramSend(this, &msgs[i].msg_hdr, &vecs[i], &addrs[i], &cbufs[i],
+                               d->data.constData(), d->data.size(), d->header);
+        msgs[i].msg_len = 0;
+    }
+
+    int sent = qt_safe_sendmmsg(socketDescriptor, msgs.data(), uint(count), 0);
+    if (sent < 0)
+        return datagramSendError();
+
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEnginePrivate::nativeSendDatagrams(%p, %lli) == %i",
+           datagrams, count, sent);
+#endif
+
+    return sent;
+}
+#endif // QT_CONFIG(sendmmsg)
+
 bool QNativeSocketEnginePrivate::fetchConnectionParameters()
 {
     localPort = 0;
@@ -1297,6 +1430,53 @@ qint64 QNativeSocketEnginePrivate::nativeWrite(const char *data, qint64 len)
 
     return qint64(writtenBytes);
 }
+
+#ifdef Q_OS_LINUX
+qint64 QNativeSocketEnginePrivate::nativeSendFile(int fileDescriptor, qint64 offset, qint64 maxSize)
+{
+    Q_Q(QNativeSocketEngine);
+
+    // sendfile() transfers at most this much in one call anyway
+    maxSize = qMin(maxSize, Q_INT64_C(0x7ffff000));
+
+    qt_ignore_sigpipe();
+    off_t fileOffset = offset;
+    ssize_t writtenBytes;
+    QT_EINTR_LOOP(writtenBytes, ::sendfile(socketDescriptor, fileDescriptor, &fileOffset, maxSize));
+
+    if (writtenBytes < 0) {
+        switch (errno) {
+        case EPIPE:
+        case ECONNRESET:
+            writtenBytes = -1;
+            setError(QAbstractSocket::RemoteHostClosedError, RemoteHostClosedErrorString);
+            q->close();
+            break;
+#if EWOULDBLOCK != EAGAIN
+        case EWOULDBLOCK:
+#endif
+        case EAGAIN:
+            writtenBytes = 0;
+            break;
+        default:
+            setError(QAbstractSocket::UnknownSocketError, WriteErrorString);
+            break;
+        }
+    } else if (writtenBytes == 0 && maxSize > 0) {
+        // the file is shorter than expected, e.g. because it was truncated
+        writtenBytes = -1;
+        setError(QAbstractSocket::UnknownSocketError, WriteErrorString);
+    }
+
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEnginePrivate::nativeSendFile(%d, %lld, %lld) == %lld",
+           fileDescriptor, offset, maxSize, qint64(writtenBytes));
+#endif
+
+    return qint64(writtenBytes);
+}
+#endif // Q_OS_LINUX
+
 /*
 */
 qint64 QNativeSocketEnginePrivate::nativeRead(char *data, qint64 maxSize)
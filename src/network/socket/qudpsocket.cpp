@@ -66,6 +66,9 @@
 #include "qnetworkdatagram.h"
 #include "qnetworkinterface.h"
 #include "qabstractsocket_p.h"
+#include <QtCore/qvarlengtharray.h>
+
+#include <utility>
 
 QT_BEGIN_NAMESPACE
 
@@ -395,6 +398,81 @@ qint64 QUdpSocket::writeDatagram(const QNetworkDatagram &datagram)
     return sent;
 }
 
+/*!
+    \since 6.10
+
+    Sends the datagrams in \a datagrams, in order, to the destinations
+    they contain. Where the operating system supports it (for example
+    sendmmsg() on Linux), many datagrams are handed to the kernel in a
+    single system call, which is considerably cheaper than calling
+    writeDatagram() once per datagram.
+
+    Returns the number of datagrams that were sent. This can be less than
+    the number passed in if the socket's send buffer filled up, or if the
+    socket is bound to an IPv4 address and a datagram is addressed to an
+    IPv6 destination; sending stops before that datagram. Returns -1
+    if an error occurred before any datagram was sent; call error() to
+    find out what happened. bytesWritten() is emitted once with the
+    combined payload size of all datagrams sent.
+
+    \sa writeDatagram(), receiveDatagrams()
+*/
+qsizetype QUdpSocket::writeDatagrams(QSpan<const QNetworkDatagram> datagrams)
+{
+    Q_D(QUdpSocket);
+#if defined QUDPSOCKET_DEBUG
+    qDebug("QUdpSocket::writeDatagrams(%lld)", qlonglong(datagrams.size()));
+#endif
+    if (datagrams.empty())
+        return 0;
+    if (!d->doEnsureInitialized(QHostAddress::Any, 0, datagrams.front().destinationAddress()))
+        return -1;
+    if (state() == UnconnectedState)
+        bind();
+
+    // A socket bound to a specific IPv4 address cannot reach IPv6
+    // destinations; only send the datagrams up to the first such one
+    // instead of letting the engine mangle its address.
+    qsizetype sendable = datagrams.size();
+    if (d->socketEngine->protocol() == QAbstractSocket::IPv4Protocol) {
+        for (qsizetype i = 0; i < datagrams.size(); ++i) {
+            bool isIPv4 = false;
+            datagrams[i].d->header.destinationAddress.toIPv4Address(&isIPv4);
+            if (!isIPv4) {
+                sendable = i;
+                break;
+            }
+        }
+    }
+
+    qsizetype sent = 0;
+    qint64 bytes = 0;
+    qint64 result = 0;
+    while (sent < sendable) {
+        result = d->socketEngine->writeDatagrams(datagrams.data() + sent, sendable - sent);
+        if (result <= 0)
+            break;
+        for (qsizetype i = sent; i < sent + result; ++i)
+            bytes += datagrams[i].d->data.size();
+        sent += result;
+    }
+    d->cachedSocketDescriptor = d->socketEngine->socketDescriptor();
+
+    if (sent > 0)
+        emit bytesWritten(bytes);
+    if (result == -1) {
+        d->setErrorAndEmit(d->socketEngine->error(), d->socketEngine->errorString());
+        if (sent == 0)
+            return -1;
+    } else if (sent == sendable && sendable < datagrams.size()) {
+        d->setErrorAndEmit(QAbstractSocket::UnsupportedSocketOperationError,
+                           tr("Cannot send an IPv6 datagram on an IPv4 socket"));
+        if (sent == 0)
+            return -1;
+    }
+    return sent;
+}
+
 /*!
     \since 5.8
 
@@ -441,6 +519,63 @@ QNetworkDatagram QUdpSocket::receiveDatagram(qint64 maxSize)
     return result;
 }
 
+/*!
+    \since 6.10
+
+    Receives up to \a maxCount pending datagrams and returns them, along
+    with the sender's host address and port and, where possible, their
+    destination address, port and hop count. Where the operating system
+    supports it (for example recvmmsg() on Linux), many datagrams are
+    fetched from the kernel in a single system call, which is considerably
+    cheaper than calling receiveDatagram() once per datagram.
+
+    Datagrams larger than \a maxSize bytes are truncated. If \a maxSize is
+    -1 (the default), this function attempts to read each datagram in
+    full; passing the largest size you expect avoids an extra copy.
+
+    Returns an empty list if no datagram was pending or an error occurred.
+
+    \sa receiveDatagram(), writeDatagrams(), hasPendingDatagrams()
+*/
+QList<QNetworkDatagram> QUdpSocket::receiveDatagrams(qsizetype maxCount, qint64 maxSize)
+{
+    Q_D(QUdpSocket);
+
+#if defined QUDPSOCKET_DEBUG
+    qDebug("QUdpSocket::receiveDatagrams(%lld, %lld)", qlonglong(maxCount), maxSize);
+#endif
+    QT_CHECK_BOUND("QUdpSocket::receiveDatagrams()", QList<QNetworkDatagram>());
+
+    QList<QNetworkDatagram> result;
+    if (maxCount <= 0)
+        return result;
+
+    // The engine fills a small batch of datagrams at a time; only those
+    // actually received are moved into the result.
+    constexpr qsizetype BatchSize = 64;
+    QVarLengthArray<QNetworkDatagram, BatchSize> batch(qMin(maxCount, BatchSize));
+    result.reserve(batch.size());
+
+    qint64 readCount = 0;
+    while (result.size() < maxCount) {
+        readCount = d->socketEngine->readDatagrams(batch.data(),
+                                                   qMin(maxCount - result.size(), batch.size()),
+                                                   maxSize, QAbstractSocketEngine::WantAll);
+        if (readCount <= 0)
+            break;
+        for (qint64 i = 0; i < readCount; ++i)
+            result.append(std::exchange(batch[i], QNetworkDatagram()));
+    }
+
+    d->hasPendingData = false;
+    d->hasPendingDatagram = false;
+    d->socketEngine->setReadNotificationEnabled(true);
+    if (readCount == -1)
+        d->setErrorAndEmit(d->socketEngine->error(), d->socketEngine->errorString());
+
+    return result;
+}
+
 /*!
     Receives a datagram no larger than \a maxSize bytes and stores
     it in \a data. The sender's host address and port is stored in
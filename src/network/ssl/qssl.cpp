@@ -126,6 +126,15 @@ Q_LOGGING_CATEGORY(lcSsl, "qt.network.ssl");
     chosen based on the servers preferences rather than the order ciphers were
     sent by the client. This option is only relevant to server sockets, and is
     only honored by the OpenSSL backend.
+    \value [since 6.10] SslOptionEnableKernelTls Lets the operating system
+    encrypt outgoing records after the handshake (kernel TLS), instead of
+    encrypting them in the application. Encrypted data is then written
+    directly to the socket, and QAbstractSocket::sendFile() can send files
+    without copying them through the application. This option is only
+    honored by the OpenSSL backend (OpenSSL 3.0 or later) on Linux, for
+    sockets that are not using a proxy. If the kernel or the negotiated
+    cipher does not support kernel TLS, records are encrypted by OpenSSL as
+    usual.
 
     By default, SslOptionDisableEmptyFragments is turned on since this causes
     problems with a large number of servers. SslOptionDisableLegacyRenegotiation
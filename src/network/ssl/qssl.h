@@ -78,7 +78,8 @@ namespace QSsl {
         SslOptionDisableLegacyRenegotiation = 0x10,
         SslOptionDisableSessionSharing = 0x20,
         SslOptionDisableSessionPersistence = 0x40,
-        SslOptionDisableServerCipherPreference = 0x80
+        SslOptionDisableServerCipherPreference = 0x80,
+        SslOptionEnableKernelTls = 0x100
     };
     Q_ENUM_NS(SslOption)
     Q_DECLARE_FLAGS(SslOptions, SslOption)
@@ -190,6 +190,7 @@ bool QSslConfiguration::operator==(const QSslConfiguration &other) const
         d->sslOptions == other.d->sslOptions &&
         d->sslSession == other.d->sslSession &&
         d->sslSessionTicketLifeTimeHint == other.d->sslSessionTicketLifeTimeHint &&
+        d->sessionCache == other.d->sessionCache &&
         d->nextAllowedProtocols == other.d->nextAllowedProtocols &&
         d->nextNegotiatedProtocol == other.d->nextNegotiatedProtocol &&
         d->nextProtocolNegotiationStatus == other.d->nextProtocolNegotiationStatus &&
@@ -237,6 +238,7 @@ bool QSslConfiguration::isNull() const
             d->sslOptions == QSslConfigurationPrivate::defaultSslOptions &&
             d->sslSession.isNull() &&
             d->sslSessionTicketLifeTimeHint == -1 &&
+            d->sessionCache.isNull() &&
             d->preSharedKeyIdentityHint.isNull() &&
             d->nextAllowedProtocols.isEmpty() &&
             d->nextNegotiatedProtocol.isNull() &&
@@ -815,6 +817,38 @@ int QSslConfiguration::sessionTicketLifeTimeHint() const
     return d->sslSessionTicketLifeTimeHint;
 }
 
+/*!
+    \since 6.10
+
+    Returns the session cache used by client sockets with this configuration,
+    or \nullptr if none was set (the default).
+
+    \sa setSessionCache()
+*/
+QSslSessionCache *QSslConfiguration::sessionCache() const
+{
+    return d->sessionCache.data();
+}
+
+/*!
+    \since 6.10
+
+    Sets the session cache used by client sockets with this configuration
+    to \a cache. Before a handshake, the socket looks up a session for its
+    peer in the cache and tries to resume it; sessions issued by the server
+    are stored in the cache. This happens regardless of
+    QSsl::SslOptionDisableSessionPersistence.
+
+    The configuration does not take ownership of \a cache. Passing \nullptr
+    disables the cache.
+
+    \sa sessionCache(), QSslSessionCache
+*/
+void QSslConfiguration::setSessionCache(QSslSessionCache *cache)
+{
+    d->sessionCache = cache;
+}
+
 /*!
    \since 5.7
 
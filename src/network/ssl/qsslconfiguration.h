@@ -35,6 +35,7 @@ class QSslCipher;
 class QSslKey;
 class QSslEllipticCurve;
 class QSslDiffieHellmanParameters;
+class QSslSessionCache;
 
 class QSslConfigurationPrivate;
 class Q_NETWORK_EXPORT QSslConfiguration
@@ -105,6 +106,9 @@ public:
     void setSessionTicket(const QByteArray &sessionTicket);
     int sessionTicketLifeTimeHint() const;
 
+    QSslSessionCache *sessionCache() const;
+    void setSessionCache(QSslSessionCache *cache);
+
     QSslKey ephemeralServerKey() const;
 
     // EC settings
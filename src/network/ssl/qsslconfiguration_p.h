@@ -32,6 +32,7 @@
 //
 
 #include <QtCore/qmap.h>
+#include <QtCore/qpointer.h>
 #include <QtNetwork/private/qtnetworkglobal_p.h>
 #include "qsslconfiguration.h"
 #include "qlist.h"
@@ -40,6 +41,7 @@
 #include "qsslkey.h"
 #include "qsslellipticcurve.h"
 #include "qssldiffiehellmanparameters.h"
+#include "qsslsessioncache.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -92,6 +94,7 @@ public:
 
     QByteArray sslSession;
     int sslSessionTicketLifeTimeHint;
+    QPointer<QSslSessionCache> sessionCache;
 
     QSslKey ephemeralServerKey;
 
@@ -0,0 +1,469 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qsslsessioncache.h"
+#include "qsslsessioncache_p.h"
+
+#include "qsslcertificate.h"
+#include "qsslcipher.h"
+#include "qsslconfiguration.h"
+#include "qsslellipticcurve.h"
+#include "qssl_p.h"
+
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatastream.h>
+#include <QtCore/qdatetime.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qsavefile.h>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+static constexpr quint32 StorageMagic = 0x51534331; // 'QSC1'
+static constexpr qint32 StorageVersion = 1;
+
+/*!
+    \class QSslSessionCache
+    \since 6.10
+
+    \ingroup network
+    \ingroup ssl
+    \inmodule QtNetwork
+
+    \brief The QSslSessionCache class stores TLS sessions so that later
+    connections to the same server can resume them.
+
+    Resuming a session replaces the full TLS handshake, including the
+    public key operations and the certificate verification, with an
+    abbreviated one. Without a session cache, a client can only resume a
+    session if the application passes QSslConfiguration::sessionTicket()
+    from one socket to the next.
+
+    A QSslSessionCache does this automatically for all client sockets
+    whose configuration refers to it (see QSslConfiguration::setSessionCache()).
+    Before starting a handshake, the socket looks up a session for its
+    peer name, its port and a key derived from those parts of its
+    configuration that affect which sessions may be resumed (protocol,
+    ciphers, certificates, verification settings and so on). When the
+    server issues a new session, the socket stores it in the cache.
+
+    \code
+    auto *cache = new QSslSessionCache(qApp);
+    cache->setStorageFileName(dataDir + "/tls-sessions"_L1);
+    QSslConfiguration configuration = QSslConfiguration::defaultConfiguration();
+    configuration.setSessionCache(cache);
+    QSslConfiguration::setDefaultConfiguration(configuration);
+    \endcode
+
+    The cache keeps the most recently used sessions in memory, up to
+    maximumCacheSize() bytes. If a storage file name is set, sessions are
+    read from that file when the name is set, and written to it by save()
+    and when the cache is destroyed, so that they survive the process.
+    Sessions contain secret key material; the file is created readable
+    and writable by its owner only.
+
+    The lookupCount(), hitCount() and resumedCount() functions report how
+    effective the cache is.
+
+    The cache may be used by sockets in different threads at the same time.
+    The virtual functions session(), insert(), remove() and clear() can be
+    reimplemented to store sessions elsewhere, for example in a cache shared
+    between several processes; reimplementations must be thread-safe, too.
+
+    \note Only the OpenSSL backend supports session caching.
+
+    \sa QSslConfiguration::setSessionCache(), QSsl::SslOptionDisableSessionTickets
+*/
+
+QSslSessionCachePrivate::QSslSessionCachePrivate()
+    : sessions(DefaultMaximumCacheSize)
+{
+}
+
+/*!
+    \internal
+
+    Reads the sessions stored in the storage file, skipping those
+    that have expired. Must be called with the mutex locked.
+*/
+bool QSslSessionCachePrivate::load()
+{
+    QFile file(storageFileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0;
+    qint32 version = 0;
+    in >> magic >> version;
+    if (magic != StorageMagic || version != StorageVersion)
+        return false;
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    while (!in.atEnd()) {
+        Key key;
+        Entry entry;
+        in >> key.peerName >> key.port >> key.configurationKey >> entry.session >> entry.expiresAt;
+        if (in.status() != QDataStream::Ok)
+            return false;
+        if (entry.expiresAt && entry.expiresAt <= now)
+            continue;
+        const qsizetype entryCost = cost(key, entry);
+        sessions.insert(key, new Entry(std::move(entry)), entryCost);
+    }
+    return true;
+}
+
+/*!
+    \internal
+
+    Returns a key identifying the parts of \a configuration that must
+    match for a session to be resumed.
+*/
+QByteArray QSslSessionCachePrivate::configurationKey(const QSslConfiguration &configuration)
+{
+    QByteArray data;
+    {
+        QDataStream out(&data, QIODevice::WriteOnly);
+        out.setVersion(QDataStream::Qt_6_0);
+        out << qint32(configuration.protocol())
+            << qint32(configuration.peerVerifyMode())
+            << qint32(configuration.peerVerifyDepth())
+            << quint32(configuration.testSslOption(QSsl::SslOptionDisableSessionTickets))
+            << configuration.allowedNextProtocols()
+            << configuration.preSharedKeyIdentityHint();
+        const auto ciphers = configuration.ciphers();
+        out << quint32(ciphers.size());
+        for (const QSslCipher &cipher : ciphers)
+            out << cipher.name();
+        const auto curves = configuration.ellipticCurves();
+        out << quint32(curves.size());
+        for (const QSslEllipticCurve &curve : curves)
+            out << curve.shortName();
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(data);
+    // The client certificate identifies us to the server, and the CA
+    // certificates decided whether the server was trusted: a session
+    // established under different ones must not be resumed.
+    for (const QSslCertificate &certificate : configuration.localCertificateChain())
+        hash.addData(certificate.toDer());
+    hash.addData("\0"_ba);
+    for (const QSslCertificate &certificate : configuration.caCertificates())
+        hash.addData(certificate.toDer());
+    return hash.result();
+}
+
+/*!
+    \internal
+
+    Looks up a session in \a cache on behalf of a TLS backend and updates
+    the statistics. Returns an empty byte array if \a cache has been
+    destroyed.
+*/
+QByteArray QSslSessionCachePrivate::lookup(const QPointer<QSslSessionCache> &cache,
+                                           const QString &peerName, quint16 port,
+                                           const QByteArray &configurationKey)
+{
+    if (!cache)
+        return QByteArray();
+    const QByteArray session = cache->session(peerName, port, configurationKey);
+    auto *d = cache->d_func();
+    QMutexLocker locker(&d->mutex);
+    ++d->lookups;
+    if (!session.isEmpty())
+        ++d->hits;
+    return session;
+}
+
+/*!
+    \internal
+
+    Called by a TLS backend when a handshake that consulted \a cache has
+    finished, \a resumed tells whether the session was resumed.
+*/
+void QSslSessionCachePrivate::handshakeFinished(const QPointer<QSslSessionCache> &cache,
+                                                bool resumed)
+{
+    if (!cache || !resumed)
+        return;
+    auto *d = cache->d_func();
+    QMutexLocker locker(&d->mutex);
+    ++d->resumed;
+}
+
+/*!
+    Constructs an empty session cache with the given \a parent.
+*/
+QSslSessionCache::QSslSessionCache(QObject *parent)
+    : QObject(*new QSslSessionCachePrivate, parent)
+{
+}
+
+/*!
+    Destroys the cache. If a storage file name is set, the sessions are
+    saved first.
+
+    \sa save()
+*/
+QSslSessionCache::~QSslSessionCache()
+{
+    Q_D(QSslSessionCache);
+    if (!d->storageFileName.isEmpty())
+        save();
+}
+
+/*!
+    Returns the maximum number of bytes the cache keeps in memory.
+    The default is 1 MiB, enough for several hundred sessions.
+
+    \sa setMaximumCacheSize(), cacheSize()
+*/
+qint64 QSslSessionCache::maximumCacheSize() const
+{
+    Q_D(const QSslSessionCache);
+    QMutexLocker locker(&d->mutex);
+    return d->sessions.maxCost();
+}
+
+/*!
+    Sets the maximum number of bytes the cache keeps in memory to \a size.
+    If the cache holds more than that, the least recently used sessions
+    are evicted.
+
+    \sa maximumCacheSize()
+*/
+void QSslSessionCache::setMaximumCacheSize(qint64 size)
+{
+    Q_D(QSslSessionCache);
+    QMutexLocker locker(&d->mutex);
+    d->sessions.setMaxCost(qsizetype(qMax(size, qint64(0))));
+}
+
+/*!
+    Returns the number of bytes currently used by the sessions in the cache.
+
+    \sa maximumCacheSize()
+*/
+qint64 QSslSessionCache::cacheSize() const
+{
+    Q_D(const QSslSessionCache);
+    QMutexLocker locker(&d->mutex);
+    return d->sessions.totalCost();
+}
+
+/*!
+    Returns the name of the file the sessions are persisted to, or an empty
+    string if the cache lives in memory only (the default).
+
+    \sa setStorageFileName()
+*/
+QString QSslSessionCache::storageFileName() const
+{
+    Q_D(const QSslSessionCache);
+    QMutexLocker locker(&d->mutex);
+    return d->storageFileName;
+}
+
+/*!
+    Sets the name of the file the sessions are persisted to to \a fileName,
+    and adds the unexpired sessions found in that file to the cache.
+    Passing an empty string disables persistence.
+
+    \sa storageFileName(), save()
+*/
+void QSslSessionCache::setStorageFileName(const QString &fileName)
+{
+    Q_D(QSslSessionCache);
+    QMutexLocker locker(&d->mutex);
+    if (d->storageFileName == fileName)
+        return;
+    d->storageFileName = fileName;
+    if (!fileName.isEmpty() && QFile::exists(fileName) && !d->load())
+        qCWarning(lcSsl) << "Could not read TLS sessions from" << fileName;
+}
+
+/*!
+    Writes the unexpired sessions to the storage file. Returns \c true on
+    success, \c false if no storage file name is set or the file could not
+    be written.
+
+    Only the sessions kept in memory by this class are saved; a subclass
+    storing its sessions elsewhere is responsible for persisting them.
+
+    \sa setStorageFileName()
+*/
+bool QSslSessionCache::save()
+{
+    Q_D(QSslSessionCache);
+    QMutexLocker locker(&d->mutex);
+    if (d->storageFileName.isEmpty())
+        return false;
+
+    QSaveFile file(d->storageFileName);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    file.setPermissions(QFileDevice::ReadOwner | QFileDevice::WriteOwner);
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << StorageMagic << StorageVersion;
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    const auto keys = d->sessions.keys();
+    for (const auto &key : keys) {
+        const auto *entry = d->sessions.object(key);
+        if (entry->expiresAt && entry->expiresAt <= now)
+            continue;
+        out << key.peerName << key.port << key.configurationKey << entry->session
+            << entry->expiresAt;
+    }
+    return out.status() == QDataStream::Ok && file.commit();
+}
+
+/*!
+    Returns the session stored for the server \a peerName on \a port by a
+    socket whose configuration had the key \a configurationKey, or an empty
+    byte array if there is none or it has expired.
+
+    The session is returned in the serialized form also used by
+    QSslConfiguration::sessionTicket().
+
+    \sa insert()
+*/
+QByteArray QSslSessionCache::session(const QString &peerName, quint16 port,
+                                     const QByteArray &configurationKey)
+{
+    Q_D(QSslSessionCache);
+    QMutexLocker locker(&d->mutex);
+    const QSslSessionCachePrivate::Key key{peerName, configurationKey, port};
+    const auto *entry = d->sessions.object(key);
+    if (!entry)
+        return {};
+    if (entry->expiresAt && entry->expiresAt <= QDateTime::currentMSecsSinceEpoch()) {
+        d->sessions.remove(key);
+        return {};
+    }
+    return entry->session;
+}
+
+/*!
+    Stores \a session for the server \a peerName on \a port and the
+    configuration key \a configurationKey, replacing the session stored
+    before, if any. \a lifetimeHint is the lifetime of the session in
+    seconds as announced by the server; if it is not positive, the session
+    is kept until it is evicted.
+
+    \sa session(), remove()
+*/
+void QSslSessionCache::insert(const QString &peerName, quint16 port,
+                              const QByteArray &configurationKey, const QByteArray &session,
+                              int lifetimeHint)
+{
+    Q_D(QSslSessionCache);
+    if (session.isEmpty())
+        return;
+    QSslSessionCachePrivate::Key key{peerName, configurationKey, port};
+    QSslSessionCachePrivate::Entry entry{session, 0};
+    if (lifetimeHint > 0)
+        entry.expiresAt = QDateTime::currentMSecsSinceEpoch() + qint64(lifetimeHint) * 1000;
+    const qsizetype cost = QSslSessionCachePrivate::cost(key, entry);
+    QMutexLocker locker(&d->mutex);
+    d->sessions.insert(std::move(key), new QSslSessionCachePrivate::Entry(std::move(entry)), cost);
+}
+
+/*!
+    Removes the session stored for \a peerName, \a port and
+    \a configurationKey. Returns \c true if there was one.
+
+    \sa insert(), clear()
+*/
+bool QSslSessionCache::remove(const QString &peerName, quint16 port,
+                              const QByteArray &configurationKey)
+{
+    Q_D(QSslSessionCache);
+    QMutexLocker locker(&d->mutex);
+    return d->sessions.remove({peerName, configurationKey, port});
+}
+
+/*!
+    Removes all sessions from the cache. The storage file, if any, is not
+    touched until the next save().
+
+    \sa remove()
+*/
+void QSslSessionCache::clear()
+{
+    Q_D(QSslSessionCache);
+    QMutexLocker locker(&d->mutex);
+    d->sessions.clear();
+}
+
+/*!
+    Returns the number of handshakes that consulted this cache.
+
+    \sa hitCount(), resumedCount(), resetStatistics()
+*/
+qint64 QSslSessionCache::lookupCount() const
+{
+    Q_D(const QSslSessionCache);
+    QMutexLocker locker(&d->mutex);
+    return d->lookups;
+}
+
+/*!
+    Returns the number of handshakes for which this cache had a session.
+
+    \sa lookupCount(), resumedCount()
+*/
+qint64 QSslSessionCache::hitCount() const
+{
+    Q_D(const QSslSessionCache);
+    QMutexLocker locker(&d->mutex);
+    return d->hits;
+}
+
+/*!
+    Returns the number of handshakes that resumed a session found in this
+    cache. This can be lower than hitCount() if the server declined to
+    resume some of the sessions, for instance because it forgot them.
+
+    \sa lookupCount(), hitCount(), resumptionRate()
+*/
+qint64 QSslSessionCache::resumedCount() const
+{
+    Q_D(const QSslSessionCache);
+    QMutexLocker locker(&d->mutex);
+    return d->resumed;
+}
+
+/*!
+    Returns the fraction of the handshakes consulting this cache that
+    resumed a session, between 0 and 1.
+
+    \sa resumedCount(), lookupCount()
+*/
+double QSslSessionCache::resumptionRate() const
+{
+    Q_D(const QSslSessionCache);
+    QMutexLocker locker(&d->mutex);
+    return d->lookups ? double(d->resumed) / double(d->lookups) : 0.0;
+}
+
+/*!
+    Resets lookupCount(), hitCount() and resumedCount() to zero.
+*/
+void QSslSessionCache::resetStatistics()
+{
+    Q_D(QSslSessionCache);
+    QMutexLocker locker(&d->mutex);
+    d->lookups = 0;
+    d->hits = 0;
+    d->resumed = 0;
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qsslsessioncache.cpp"
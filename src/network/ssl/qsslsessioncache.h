@@ -0,0 +1,55 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSSLSESSIONCACHE_H
+#define QSSLSESSIONCACHE_H
+
+#include <QtNetwork/qtnetworkglobal.h>
+
+QT_REQUIRE_CONFIG(ssl);
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qstring.h>
+
+QT_BEGIN_NAMESPACE
+
+class QSslSessionCachePrivate;
+
+class Q_NETWORK_EXPORT QSslSessionCache : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(QSslSessionCache)
+
+public:
+    explicit QSslSessionCache(QObject *parent = nullptr);
+    ~QSslSessionCache() override;
+
+    qint64 maximumCacheSize() const;
+    void setMaximumCacheSize(qint64 size);
+    qint64 cacheSize() const;
+
+    QString storageFileName() const;
+    void setStorageFileName(const QString &fileName);
+    bool save();
+
+    virtual QByteArray session(const QString &peerName, quint16 port,
+                               const QByteArray &configurationKey);
+    virtual void insert(const QString &peerName, quint16 port, const QByteArray &configurationKey,
+                        const QByteArray &session, int lifetimeHint);
+    virtual bool remove(const QString &peerName, quint16 port, const QByteArray &configurationKey);
+    virtual void clear();
+
+    qint64 lookupCount() const;
+    qint64 hitCount() const;
+    qint64 resumedCount() const;
+    double resumptionRate() const;
+    void resetStatistics();
+
+private:
+    Q_DECLARE_PRIVATE(QSslSessionCache)
+};
+
+QT_END_NAMESPACE
+
+#endif // QSSLSESSIONCACHE_H
@@ -0,0 +1,86 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSSLSESSIONCACHE_P_H
+#define QSSLSESSIONCACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API. It exists purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtNetwork/private/qtnetworkglobal_p.h>
+
+#include "qsslsessioncache.h"
+
+#include <QtCore/qcache.h>
+#include <QtCore/qhashfunctions.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/private/qobject_p.h>
+
+QT_BEGIN_NAMESPACE
+
+class QSslConfiguration;
+
+class Q_NETWORK_EXPORT QSslSessionCachePrivate : public QObjectPrivate
+{
+public:
+    Q_DECLARE_PUBLIC(QSslSessionCache)
+
+    static constexpr qint64 DefaultMaximumCacheSize = 1024 * 1024; // 1 MiB
+
+    struct Key
+    {
+        QString peerName;
+        QByteArray configurationKey;
+        quint16 port = 0;
+
+        friend bool operator==(const Key &lhs, const Key &rhs) noexcept
+        {
+            return lhs.port == rhs.port && lhs.peerName == rhs.peerName
+                    && lhs.configurationKey == rhs.configurationKey;
+        }
+        friend size_t qHash(const Key &key, size_t seed = 0) noexcept
+        { return qHashMulti(seed, key.peerName, key.port, key.configurationKey); }
+    };
+
+    struct Entry
+    {
+        QByteArray session;
+        qint64 expiresAt = 0; // msecs since epoch, 0 if unknown
+    };
+
+    QSslSessionCachePrivate();
+
+    static qsizetype cost(const Key &key, const Entry &entry)
+    {
+        return key.peerName.size() * qsizetype(sizeof(QChar)) + key.configurationKey.size()
+                + entry.session.size();
+    }
+
+    bool load();
+
+    // Used by the TLS backends:
+    static QByteArray configurationKey(const QSslConfiguration &configuration);
+    static QByteArray lookup(const QPointer<QSslSessionCache> &cache, const QString &peerName,
+                             quint16 port, const QByteArray &configurationKey);
+    static void handshakeFinished(const QPointer<QSslSessionCache> &cache, bool resumed);
+
+    mutable QMutex mutex;
+    QCache<Key, Entry> sessions;
+    QString storageFileName;
+    qint64 lookups = 0;
+    qint64 hits = 0;
+    qint64 resumed = 0;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSSLSESSIONCACHE_P_H
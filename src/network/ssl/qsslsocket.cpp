@@ -352,6 +352,7 @@
 #include "qsslconfiguration_p.h"
 #include "qsslsocket_p.h"
 
+#include <QtCore/qdeadlinetimer.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qdir.h>
 #include <QtCore/qmutex.h>
@@ -807,7 +808,10 @@ qint64 QSslSocket::bytesToWrite() const
     Q_D(const QSslSocket);
     if (d->mode == UnencryptedMode)
         return d->plainSocket ? d->plainSocket->bytesToWrite() : 0;
-    return d->writeBuffer.size();
+    qint64 pendingBytes = d->writeBuffer.size();
+    for (const QSslSocketPrivate::PendingFile &pending : d->pendingFiles)
+        pendingBytes += pending.remaining;
+    return pendingBytes;
 }
 
 /*!
@@ -869,7 +873,7 @@ void QSslSocket::close()
     if (auto *backend = d->backend.get())
         backend->cancelCAFetch();
 
-    if (!d->abortCalled && (encryptedBytesToWrite() || !d->writeBuffer.isEmpty()))
+    if (!d->abortCalled && (encryptedBytesToWrite() || d->hasPendingWrites()))
         flush();
     if (d->plainSocket) {
         if (d->abortCalled)
@@ -882,6 +886,7 @@ void QSslSocket::close()
     // must be cleared, reading/writing not possible on closed socket:
     d->buffer.clear();
     d->writeBuffer.clear();
+    d->pendingFiles.clear();
 }
 
 /*!
@@ -965,6 +970,7 @@ void QSslSocket::setSslConfiguration(const QSslConfiguration &configuration)
     d->configuration.sslOptions = configuration.d->sslOptions;
     d->configuration.sslSession = configuration.sessionTicket();
     d->configuration.sslSessionTicketLifeTimeHint = configuration.sessionTicketLifeTimeHint();
+    d->configuration.sessionCache = configuration.d->sessionCache;
     d->configuration.nextAllowedProtocols = configuration.allowedNextProtocols();
     d->configuration.nextNegotiatedProtocol = configuration.nextNegotiatedProtocol();
     d->configuration.nextProtocolNegotiationStatus = configuration.nextProtocolNegotiationStatus();
@@ -1346,7 +1352,7 @@ bool QSslSocket::waitForReadyRead(int msecs)
         }
     }
 
-    if (!d->writeBuffer.isEmpty()) {
+    if (d->hasPendingWrites()) {
         // empty our cleartext write buffer first
         d->transmit();
     }
@@ -1380,6 +1386,8 @@ bool QSslSocket::waitForBytesWritten(int msecs)
         if (!waitForEncrypted(msecs))
             return false;
     }
+    if (d->backend && d->backend->writesToSocketDescriptor())
+        return d->waitForDirectWrite(qt_subtract_from_timeout(msecs, stopWatch.elapsed()));
     if (!d->writeBuffer.isEmpty()) {
         // empty our cleartext write buffer first
         d->transmit();
@@ -1421,8 +1429,15 @@ bool QSslSocket::waitForDisconnected(int msecs)
     }
     // We are delaying the disconnect, if the write buffer is not empty.
     // So, start the transmission.
-    if (!d->writeBuffer.isEmpty())
+    if (d->hasPendingWrites())
         d->transmit();
+    if (d->backend && d->backend->writesToSocketDescriptor()) {
+        // The plain socket does not see our data, wait for it to be written
+        // before waiting for the disconnect.
+        while (d->hasPendingWrites() && state() != UnconnectedState
+               && d->waitForDirectWrite(qt_subtract_from_timeout(msecs, stopWatch.elapsed()))) {
+        }
+    }
 
     // At this point, the socket might be disconnected, if disconnectFromHost()
     // was called just after the connectToHostEncrypted() call. Also, we can
@@ -1905,7 +1920,7 @@ void QSslSocket::disconnectFromHost()
         emit stateChanged(d->state);
     }
 
-    if (!d->writeBuffer.isEmpty()) {
+    if (d->hasPendingWrites()) {
         d->pendingClose = true;
         return;
     }
@@ -2051,6 +2066,7 @@ void QSslSocketPrivate::init()
 
     buffer.clear();
     writeBuffer.clear();
+    pendingFiles.clear();
     configuration.peerCertificate.clear();
     configuration.peerCertificateChain.clear();
 
@@ -2302,6 +2318,7 @@ void QSslConfigurationPrivate::deepCopyDefaultConfiguration(QSslConfigurationPri
     ptr->sslOptions = global->sslOptions;
     ptr->ellipticCurves = global->ellipticCurves;
     ptr->backendConfig = global->backendConfig;
+    ptr->sessionCache = global->sessionCache;
 #if QT_CONFIG(dtls)
     ptr->dtlsCookieEnabled = global->dtlsCookieEnabled;
 #endif
@@ -2593,7 +2610,7 @@ void QSslSocketPrivate::_q_bytesWrittenSlot(qint64 written)
         emit q->bytesWritten(written);
     else
         emit q->encryptedBytesWritten(written);
-    if (state == QAbstractSocket::ClosingState && writeBuffer.isEmpty())
+    if (state == QAbstractSocket::ClosingState && !hasPendingWrites())
         q->disconnectFromHost();
 }
 
@@ -2626,7 +2643,7 @@ void QSslSocketPrivate::_q_flushWriteBuffer()
     // need to notice if knock-on effects of this flush (e.g. a readReady() via transmit())
     // make another necessary, so clear flag before calling:
     flushTriggered = false;
-    if (!writeBuffer.isEmpty())
+    if (hasPendingWrites())
         q->flush();
 }
 
@@ -2747,6 +2764,14 @@ QIODevicePrivate::QRingBufferRef &QSslSocketPrivate::tlsWriteBuffer()
     return writeBuffer;
 }
 
+/*!
+    \internal
+*/
+QList<QAbstractSocketPrivate::PendingFile> &QSslSocketPrivate::tlsPendingFiles()
+{
+    return pendingFiles;
+}
+
 /*!
     \internal
 */
@@ -2859,6 +2884,56 @@ bool QSslSocketPrivate::flush()
     return plainSocket && plainSocket->flush();
 }
 
+/*!
+    \internal
+
+    Files queued with sendFile() are written by the TLS backend if it can
+    encrypt them without reading them into the application.
+*/
+bool QSslSocketPrivate::canSendFile() const
+{
+    return mode != QSslSocket::UnencryptedMode && connectionEncrypted && backend
+           && backend->canSendFile();
+}
+
+/*!
+    \internal
+*/
+void QSslSocketPrivate::scheduleFileWrite()
+{
+    Q_Q(QSslSocket);
+    if (!flushTriggered) {
+        flushTriggered = true;
+        QMetaObject::invokeMethod(q, "_q_flushWriteBuffer", Qt::QueuedConnection);
+    }
+}
+
+/*!
+    \internal
+
+    Used instead of the plain socket's waitForBytesWritten() if the backend
+    writes encrypted data directly to the socket descriptor. Returns \c true
+    once some of the pending data was written within \a msecs milliseconds.
+*/
+bool QSslSocketPrivate::waitForDirectWrite(int msecs)
+{
+    Q_Q(QSslSocket);
+    if (!hasPendingWrites())
+        return false;
+
+    auto *plainSocketPrivate = static_cast<QAbstractSocketPrivate *>(QObjectPrivate::get(plainSocket));
+    QAbstractSocketEngine *engine = plainSocketPrivate->socketEngine;
+    const QDeadlineTimer deadline(msecs);
+    const qint64 pendingBytes = q->bytesToWrite();
+    transmit();
+    while (q->bytesToWrite() == pendingBytes) {
+        if (!engine || !engine->isValid() || !engine->waitForWrite(deadline))
+            return false;
+        transmit();
+    }
+    return true;
+}
+
 /*!
     \internal
 */
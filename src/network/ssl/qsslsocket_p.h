@@ -118,6 +118,9 @@ public:
     qint64 peek(char *data, qint64 maxSize) override;
     QByteArray peek(qint64 maxSize) override;
     bool flush() override;
+    bool canSendFile() const override;
+    void scheduleFileWrite() override;
+    bool waitForDirectWrite(int msecs);
 
     void startClientEncryption();
     void startServerEncryption();
@@ -147,6 +150,7 @@ public:
     void setMaxReadBufferSize(qint64 maxSize);
     void setEncrypted(bool enc);
     QRingBufferRef &tlsWriteBuffer();
+    QList<PendingFile> &tlsPendingFiles();
     QRingBufferRef &tlsBuffer();
     bool &tlsEmittedBytesWritten();
     bool *readyReadPointer();
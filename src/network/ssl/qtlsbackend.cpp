@@ -1916,6 +1916,33 @@ QList<QOcspResponse> TlsCryptograph::ocsps() const
     return {};
 }
 
+/*!
+    \internal
+
+    Returns \c true if the backend writes encrypted data directly to the
+    descriptor of the plain socket, bypassing its write buffer, for example
+    to let the kernel encrypt the records. QSslSocket then cannot rely on the
+    plain socket to report written bytes. The default implementation returns
+    \c false.
+*/
+bool TlsCryptograph::writesToSocketDescriptor() const
+{
+    return false;
+}
+
+/*!
+    \internal
+
+    Returns \c true if file regions queued with QAbstractSocket::sendFile()
+    can be encrypted and sent by the backend without reading them into the
+    application. The backend then writes QSslSocketPrivate's pending files in
+    transmit(). The default implementation returns \c false.
+*/
+bool TlsCryptograph::canSendFile() const
+{
+    return false;
+}
+
 /*!
     \internal
 
@@ -177,6 +177,8 @@ public:
     virtual void transmit() = 0;
     virtual bool hasUndecryptedData() const;
     virtual QList<QOcspResponse> ocsps() const;
+    virtual bool writesToSocketDescriptor() const;
+    virtual bool canSendFile() const;
 
     static bool isMatchingHostname(const QSslCertificate &cert, const QString &peerName);
 
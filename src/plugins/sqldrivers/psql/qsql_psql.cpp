@@ -3,6 +3,7 @@
 
 #include "qsql_psql_p.h"
 
+#include <qcache.h>
 #include <qcoreapplication.h>
 #include <qvariant.h>
 #include <qdatetime.h>
@@ -25,6 +26,12 @@
 #include <libpq-fe.h>
 #include <pg_config.h>
 
+#ifdef Q_OS_WIN
+#  include <winsock2.h>
+#else
+#  include <QtCore/private/qcore_unix_p.h>
+#endif
+
 #include <cmath>
 
 // workaround for postgres defining their OIDs in a private header file
@@ -112,6 +119,20 @@ protected:
     QVariant lastInsertId() const override;
     bool prepare(const QString &query) override;
     bool exec() override;
+    bool execBatch(bool arrayBind) override;
+};
+
+class QPSQLDriverPrivate;
+
+// A server-side prepared statement that is not used by any result, kept for reuse
+struct QPSQLCachedStatement
+{
+    QPSQLCachedStatement(QPSQLDriverPrivate *drv, const QString &id) : drv(drv), id(id) {}
+    ~QPSQLCachedStatement();
+    Q_DISABLE_COPY_MOVE(QPSQLCachedStatement)
+
+    QPSQLDriverPrivate *drv;
+    QString id;
 };
 
 class QPSQLDriverPrivate final : public QSqlDriverPrivate
@@ -129,6 +150,14 @@ public:
     mutable bool pendingNotifyCheck = false;
     bool hasBackslashEscape = false;
 
+    // least recently used prepared statements, keyed by their SQL text;
+    // disabled unless QPSQL_STATEMENT_CACHE_SIZE is set
+    QCache<QString, QPSQLCachedStatement> statementCache{0};
+    // bumped when the connection is closed, as that drops all prepared statements
+    quint32 statementCacheGeneration = 0;
+    qint64 statementCacheHits = 0;
+    qint64 statementCacheMisses = 0;
+
     void appendTables(QStringList &tl, QSqlQuery &t, QChar type);
     PGresult *exec(const char *stmt);
     PGresult *exec(const QString &stmt);
@@ -138,6 +167,7 @@ public:
     void finishQuery(StatementId stmtId);
     void discardResults() const;
     StatementId generateStatementId();
+    void deallocatePreparedStmt(const QString &stmtId);
     void checkPendingNotifications() const;
     QPSQLDriver::Protocol getPSQLVersion();
     bool setEncodingUtf8();
@@ -260,9 +290,16 @@ public:
 
     QString fieldSerial(qsizetype i) const override { return QString("$%1"_L1).arg(i + 1); }
     void deallocatePreparedStmt();
+    void releasePreparedStmt();
+    QString executeStatement(const QList<QVariant> &values) const;
+#ifdef LIBPQ_HAS_PIPELINING
+    bool execBatchPipelined();
+#endif
 
     std::queue<PGresult*> nextResultSets;
     QString preparedStmtId;
+    QString cacheKey; // non-empty if preparedStmtId may be returned to the statement cache
+    quint32 cacheGeneration = 0;
     PGresult *result = nullptr;
     StatementId stmtId = InvalidStatementId;
     int currentSize = -1;
@@ -378,19 +415,44 @@ static QMetaType qDecodePSQLType(int t)
     return QMetaType(type);
 }
 
-void QPSQLResultPrivate::deallocatePreparedStmt()
+void QPSQLDriverPrivate::deallocatePreparedStmt(const QString &stmtId)
 {
-    if (drv_d_func()) {
-        const QString stmt = QStringLiteral("DEALLOCATE ") + preparedStmtId;
-        PGresult *result = drv_d_func()->exec(stmt);
+    const QString stmt = QStringLiteral("DEALLOCATE ") + stmtId;
+    PGresult *result = exec(stmt);
 
-        if (PQresultStatus(result) != PGRES_COMMAND_OK) {
-            const QString msg = QString::fromUtf8(PQerrorMessage(drv_d_func()->connection));
-            qCWarning(lcPsql, "Unable to free statement: %ls.", qUtf16Printable(msg));
-        }
-        PQclear(result);
+    if (PQresultStatus(result) != PGRES_COMMAND_OK) {
+        const QString msg = QString::fromUtf8(PQerrorMessage(connection));
+        qCWarning(lcPsql, "Unable to free statement: %ls.", qUtf16Printable(msg));
     }
+    PQclear(result);
+}
+
+QPSQLCachedStatement::~QPSQLCachedStatement()
+{
+    // evicted from the cache while the connection is still open
+    if (drv->connection && !id.isEmpty())
+        drv->deallocatePreparedStmt(id);
+}
+
+void QPSQLResultPrivate::deallocatePreparedStmt()
+{
+    if (drv_d_func())
+        const_cast<QPSQLDriverPrivate *>(drv_d_func())->deallocatePreparedStmt(preparedStmtId);
     preparedStmtId.clear();
+    cacheKey.clear();
+}
+
+void QPSQLResultPrivate::releasePreparedStmt()
+{
+    QPSQLDriverPrivate *drv = const_cast<QPSQLDriverPrivate *>(drv_d_func());
+    if (cacheKey.isEmpty() || !drv || !drv->connection
+        || cacheGeneration != drv->statementCacheGeneration) {
+        deallocatePreparedStmt();
+        return;
+    }
+
+    drv->statementCache.insert(std::exchange(cacheKey, QString()),
+                               new QPSQLCachedStatement(drv, std::exchange(preparedStmtId, QString())));
 }
 
 QPSQLResult::QPSQLResult(const QPSQLDriver *db)
@@ -406,7 +468,7 @@ QPSQLResult::~QPSQLResult()
     cleanup();
 
     if (d->preparedQueriesEnabled && !d->preparedStmtId.isNull())
-        d->deallocatePreparedStmt();
+        d->releasePreparedStmt();
 }
 
 QVariant QPSQLResult::handle() const
@@ -833,6 +895,15 @@ static QString qCreateParamString(const QList<QVariant> &boundValues, const QSql
     return params;
 }
 
+QString QPSQLResultPrivate::executeStatement(const QList<QVariant> &values) const
+{
+    Q_Q(const QPSQLResult);
+    const QString params = qCreateParamString(values, q->driver());
+    if (params.isEmpty())
+        return QStringLiteral("EXECUTE %1").arg(preparedStmtId);
+    return QStringLiteral("EXECUTE %1 (%2)").arg(preparedStmtId, params);
+}
+
 QString qMakePreparedStmtId()
 {
     Q_CONSTINIT static QBasicAtomicInt qPreparedStmtCount = Q_BASIC_ATOMIC_INITIALIZER(0);
@@ -849,7 +920,21 @@ bool QPSQLResult::prepare(const QString &query)
     cleanup();
 
     if (!d->preparedStmtId.isEmpty())
-        d->deallocatePreparedStmt();
+        d->releasePreparedStmt();
+
+    QPSQLDriverPrivate *drv = const_cast<QPSQLDriverPrivate *>(d->drv_d_func());
+    const bool useCache = drv->statementCache.maxCost() > 0;
+    if (useCache) {
+        if (QPSQLCachedStatement *cached = drv->statementCache.take(query)) {
+            d->preparedStmtId = std::exchange(cached->id, QString());
+            d->cacheKey = query;
+            d->cacheGeneration = drv->statementCacheGeneration;
+            delete cached;
+            ++drv->statementCacheHits;
+            return true;
+        }
+        ++drv->statementCacheMisses;
+    }
 
     const QString stmtId = qMakePreparedStmtId();
     const QString stmt = QStringLiteral("PREPARE %1 AS ").arg(stmtId).append(d->positionalToNamedBinding(query));
@@ -866,6 +951,10 @@ bool QPSQLResult::prepare(const QString &query)
 
     PQclear(result);
     d->preparedStmtId = stmtId;
+    if (useCache) {
+        d->cacheKey = query;
+        d->cacheGeneration = drv->statementCacheGeneration;
+    }
     return true;
 }
 
@@ -877,14 +966,7 @@ bool QPSQLResult::exec()
 
     cleanup();
 
-    QString stmt;
-    const QString params = qCreateParamString(boundValues(), driver());
-    if (params.isEmpty())
-        stmt = QStringLiteral("EXECUTE %1").arg(d->preparedStmtId);
-    else
-        stmt = QStringLiteral("EXECUTE %1 (%2)").arg(d->preparedStmtId, params);
-
-    d->stmtId = d->drv_d_func()->sendQuery(stmt);
+    d->stmtId = d->drv_d_func()->sendQuery(d->executeStatement(boundValues()));
     if (d->stmtId == InvalidStatementId) {
         setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
                                 "Unable to send query"), QSqlError::StatementError, d->drv_d_func()));
@@ -903,6 +985,160 @@ bool QPSQLResult::exec()
     return d->processResults();
 }
 
+bool QPSQLResult::execBatch(bool arrayBind)
+{
+#ifdef LIBPQ_HAS_PIPELINING
+    Q_D(QPSQLResult);
+    if (d->preparedQueriesEnabled && !d->preparedStmtId.isEmpty() && !d->values.isEmpty())
+        return d->execBatchPipelined();
+#endif
+    return QSqlResult::execBatch(arrayBind);
+}
+
+#ifdef LIBPQ_HAS_PIPELINING
+// Waits until the connection's socket is readable or, if forWrite is set,
+// writable.
+static bool waitForSocket(PGconn *connection, bool forWrite)
+{
+#ifdef Q_OS_WIN
+    WSAPOLLFD pfd = {};
+    pfd.fd = SOCKET(PQsocket(connection));
+    pfd.events = POLLRDNORM | (forWrite ? POLLWRNORM : 0);
+    return WSAPoll(&pfd, 1, -1) > 0;
+#else
+    pollfd pfd = qt_make_pollfd(PQsocket(connection), POLLIN | (forWrite ? POLLOUT : 0));
+    return qt_safe_poll(&pfd, 1, QDeadlineTimer::Forever) > 0;
+#endif
+}
+
+/*
+    Sends the EXECUTE statements for the rows of a batch in pipeline mode,
+    without waiting for the result of each, followed by a single sync point.
+    The server runs the whole batch as one implicit transaction, unless a
+    transaction is open already: outside a transaction, a failing row leaves
+    none of the rows committed. This is documented in sql-driver.qdoc and
+    tested by tst_QSqlQuery::psql_batchExecLarge().
+
+    The server stops reading statements while it cannot send their results,
+    so the connection is put in nonblocking mode and results are read as they
+    arrive, whenever the socket does not take more statements.
+*/
+bool QPSQLResultPrivate::execBatchPipelined()
+{
+    Q_Q(QPSQLResult);
+    q->cleanup();
+    QPSQLDriverPrivate *drv = const_cast<QPSQLDriverPrivate *>(drv_d_func());
+    PGconn *connection = drv->connection;
+    drv->discardResults();
+    const bool wasNonblocking = PQisnonblocking(connection);
+    if (!wasNonblocking && PQsetnonblocking(connection, 1) != 0)
+        return q->QSqlResult::execBatch();
+    if (!PQenterPipelineMode(connection)) {
+        if (!wasNonblocking)
+            PQsetnonblocking(connection, 0);
+        return q->QSqlResult::execBatch();
+    }
+    // results of other queries on this connection are gone now, and the
+    // batch's own results belong to this query
+    drv->currentStmtId = drv->generateStatementId();
+    stmtId = drv->currentStmtId;
+
+    const QList<QVariant> columns = values;
+    const qsizetype batchCount = columns.at(0).toList().size();
+    QList<QVariantList> columnValues;
+    columnValues.reserve(columns.size());
+    for (const QVariant &column : columns)
+        columnValues.append(column.toList());
+
+    PGresult *lastResult = nullptr;
+    QSqlError error;
+    const auto setError = [&](const QString &text, PGresult *result = nullptr) {
+        if (!error.isValid())
+            error = qMakeError(text, QSqlError::StatementError, drv, result);
+    };
+
+    qsizetype sent = 0;
+    bool syncSent = false;
+    bool synced = false;
+    // the result of a statement was read, the null result ending it is next
+    bool resultRead = false;
+    while (!synced) {
+        // send until the socket does not take more; stop sending statements
+        // once one of them failed, as the server skips the rest anyway
+        int flushed = PQflush(connection);
+        while (flushed == 0 && !syncSent) {
+            if (sent < batchCount && !error.isValid()) {
+                for (qsizetype j = 0; j < columnValues.size(); ++j)
+                    q->bindValue(j, columnValues.at(j).at(sent), QSql::In);
+                const QByteArray stmt = executeStatement(q->boundValues()).toUtf8();
+                if (PQsendQueryParams(connection, stmt.constData(), 0, nullptr, nullptr, nullptr,
+                                      nullptr, 0)) {
+                    ++sent;
+                } else {
+                    setError(QCoreApplication::translate("QPSQLResult", "Unable to send query"));
+                }
+            } else if (PQpipelineSync(connection)) {
+                syncSent = true;
+            } else {
+                flushed = -1;
+                break;
+            }
+            flushed = PQflush(connection);
+        }
+        if (flushed < 0 || !waitForSocket(connection, flushed > 0)
+            || !PQconsumeInput(connection)) {
+            setError(QCoreApplication::translate("QPSQLResult", "Unable to execute batch"));
+            break;
+        }
+
+        while (!synced && !PQisBusy(connection)) {
+            PGresult *result = PQgetResult(connection);
+            if (!result) {
+                if (!resultRead)
+                    break; // nothing else has arrived yet
+                resultRead = false;
+                continue;
+            }
+            switch (PQresultStatus(result)) {
+            case PGRES_PIPELINE_SYNC:
+                synced = true;
+                break;
+            case PGRES_COMMAND_OK:
+            case PGRES_TUPLES_OK:
+                if (lastResult)
+                    PQclear(lastResult);
+                lastResult = std::exchange(result, nullptr);
+                resultRead = true;
+                break;
+            case PGRES_PIPELINE_ABORTED:
+                // skipped because an earlier statement failed
+                resultRead = true;
+                break;
+            default:
+                setError(QCoreApplication::translate("QPSQLResult", "Unable to execute batch"),
+                         result);
+                resultRead = true;
+                break;
+            }
+            PQclear(result);
+        }
+    }
+    PQexitPipelineMode(connection);
+    if (!wasNonblocking)
+        PQsetnonblocking(connection, 0);
+    values = columns;
+
+    if (error.isValid()) {
+        PQclear(lastResult);
+        q->setLastError(error);
+        q->setActive(false);
+        return false;
+    }
+    result = lastResult;
+    return processResults();
+}
+#endif
+
 ///////////////////////////////////////////////////////////////////
 
 bool QPSQLDriverPrivate::setEncodingUtf8()
@@ -1114,6 +1350,7 @@ QPSQLDriver::~QPSQLDriver()
 {
     Q_D(QPSQLDriver);
     PQfinish(d->connection);
+    d->connection = nullptr;
 }
 
 QVariant QPSQLDriver::handle() const
@@ -1122,6 +1359,18 @@ QVariant QPSQLDriver::handle() const
     return QVariant::fromValue(d->connection);
 }
 
+qint64 QPSQLDriver::statementCacheHits() const
+{
+    Q_D(const QPSQLDriver);
+    return d->statementCacheHits;
+}
+
+qint64 QPSQLDriver::statementCacheMisses() const
+{
+    Q_D(const QPSQLDriver);
+    return d->statementCacheMisses;
+}
+
 bool QPSQLDriver::hasFeature(DriverFeature f) const
 {
     Q_D(const QPSQLDriver);
@@ -1183,11 +1432,27 @@ bool QPSQLDriver::open(const QString &db,
     if (port != -1)
         connectString.append(" port="_L1).append(qQuote(QString::number(port)));
 
-    // add any connect options - the server will handle error detection
+    // add any connect options - the server will handle error detection -
+    // except for the ones handled by this driver
+    int statementCacheSize = 0;
     if (!connOpts.isEmpty()) {
-        QString opt = connOpts;
-        opt.replace(';'_L1, ' '_L1, Qt::CaseInsensitive);
-        connectString.append(u' ').append(opt);
+        static const auto statementCacheOption = "QPSQL_STATEMENT_CACHE_SIZE"_L1;
+        QString opt;
+        const auto opts = QStringView{connOpts}.split(u';', Qt::SkipEmptyParts);
+        for (auto option : opts) {
+            if (option.trimmed().startsWith(statementCacheOption)) {
+                option = option.trimmed().mid(statementCacheOption.size()).trimmed();
+                if (option.startsWith(u'=')) {
+                    bool ok;
+                    const int size = option.mid(1).trimmed().toInt(&ok);
+                    if (ok && size >= 0)
+                        statementCacheSize = size;
+                }
+                continue;
+            }
+            opt.append(u' ').append(option);
+        }
+        connectString.append(opt);
     }
 
     d->connection = PQconnectdb(std::move(connectString).toLocal8Bit().constData());
@@ -1211,6 +1476,9 @@ bool QPSQLDriver::open(const QString &db,
     d->setDatestyle();
     d->setByteaOutput();
     d->setUtcTimeZone();
+    d->statementCache.setMaxCost(statementCacheSize);
+    d->statementCacheHits = 0;
+    d->statementCacheMisses = 0;
 
     setOpen(true);
     setOpenError(false);
@@ -1230,6 +1498,9 @@ void QPSQLDriver::close()
 
     PQfinish(d->connection);
     d->connection = nullptr;
+    // the statements are gone with the connection, no need to deallocate them
+    d->statementCache.clear();
+    ++d->statementCacheGeneration;
     setOpen(false);
     setOpenError(false);
 }
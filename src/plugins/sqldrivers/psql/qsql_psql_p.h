@@ -35,6 +35,8 @@ class Q_EXPORT_SQLDRIVER_PSQL QPSQLDriver : public QSqlDriver
     friend class QPSQLResultPrivate;
     Q_DECLARE_PRIVATE(QPSQLDriver)
     Q_OBJECT
+    Q_PROPERTY(qint64 statementCacheHits READ statementCacheHits)
+    Q_PROPERTY(qint64 statementCacheMisses READ statementCacheMisses)
 public:
     enum Protocol {
         VersionUnknown = -1,
@@ -81,6 +83,9 @@ public:
     Protocol protocol() const;
     QVariant handle() const override;
 
+    qint64 statementCacheHits() const;
+    qint64 statementCacheMisses() const;
+
     QString escapeIdentifier(const QString &identifier, IdentifierType type) const override;
     QString formatValue(const QSqlField &field, bool trimStrings) const override;
 
@@ -16,8 +16,8 @@
 #include <QtSql/private/qsqldriver_p.h>
 #include <qstringlist.h>
 #include <qvariant.h>
-#if QT_CONFIG(regularexpression)
 #include <qcache.h>
+#if QT_CONFIG(regularexpression)
 #include <qregularexpression.h>
 #endif
 #include <QScopedValueRollback>
@@ -95,6 +95,16 @@ protected:
     void virtual_hook(int id, void *data) override;
 };
 
+// A prepared statement that is not used by any result, kept for reuse
+struct QSQLiteCachedStatement
+{
+    explicit QSQLiteCachedStatement(sqlite3_stmt *stmt) : stmt(stmt) {}
+    ~QSQLiteCachedStatement() { sqlite3_finalize(stmt); }
+    Q_DISABLE_COPY_MOVE(QSQLiteCachedStatement)
+
+    sqlite3_stmt *stmt;
+};
+
 class QSQLiteDriverPrivate : public QSqlDriverPrivate
 {
     Q_DECLARE_PUBLIC(QSQLiteDriver)
@@ -108,6 +118,12 @@ public:
     sqlite3 *access = nullptr;
     QList<QSQLiteResult *> results;
     QStringList notificationid;
+
+    // least recently used statements, keyed by their SQL text; disabled
+    // unless QSQLITE_STATEMENT_CACHE_SIZE is set
+    QCache<QString, QSQLiteCachedStatement> statementCache{0};
+    qint64 statementCacheHits = 0;
+    qint64 statementCacheMisses = 0;
 };
 
 bool QSQLiteDriverPrivate::isIdentifierEscaped(QStringView identifier) const
@@ -172,8 +188,10 @@ public:
     // initializes the recordInfo and the cache
     void initColumns(bool emptyResultset);
     void finalize();
+    void releaseStatement();
 
     sqlite3_stmt *stmt = nullptr;
+    QString cacheKey; // non-empty if stmt may be returned to the statement cache
     QSqlRecord rInf;
     QList<QVariant> firstRow;
     bool skippedStatus = false; // the status of the fetchNext() that's skipped
@@ -183,7 +201,7 @@ public:
 void QSQLiteResultPrivate::cleanup()
 {
     Q_Q(QSQLiteResult);
-    finalize();
+    releaseStatement();
     rInf.clear();
     skippedStatus = false;
     skipRow = false;
@@ -199,6 +217,22 @@ void QSQLiteResultPrivate::finalize()
 
     sqlite3_finalize(stmt);
     stmt = nullptr;
+    cacheKey.clear();
+}
+
+void QSQLiteResultPrivate::releaseStatement()
+{
+    QSQLiteDriverPrivate *drv = const_cast<QSQLiteDriverPrivate *>(drv_d_func());
+    if (!stmt || cacheKey.isEmpty() || !drv || !drv->access) {
+        finalize();
+        return;
+    }
+
+    // bring it back into the state sqlite3_prepare() left it in
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+    drv->statementCache.insert(std::exchange(cacheKey, QString()),
+                               new QSQLiteCachedStatement(std::exchange(stmt, nullptr)));
 }
 
 void QSQLiteResultPrivate::initColumns(bool emptyResultset)
@@ -390,6 +424,19 @@ bool QSQLiteResult::prepare(const QString &query)
 
     setSelect(false);
 
+    QSQLiteDriverPrivate *drv = const_cast<QSQLiteDriverPrivate *>(d->drv_d_func());
+    const bool useCache = drv->statementCache.maxCost() > 0;
+    if (useCache) {
+        if (QSQLiteCachedStatement *cached = drv->statementCache.take(query)) {
+            d->stmt = std::exchange(cached->stmt, nullptr);
+            d->cacheKey = query;
+            delete cached;
+            ++drv->statementCacheHits;
+            return true;
+        }
+        ++drv->statementCacheMisses;
+    }
+
     const void *pzTail = nullptr;
     const auto size = int((query.size() + 1) * sizeof(QChar));
 
@@ -412,6 +459,8 @@ bool QSQLiteResult::prepare(const QString &query)
         d->finalize();
         return false;
     }
+    if (useCache)
+        d->cacheKey = query;
     return true;
 }
 
@@ -750,6 +799,7 @@ bool QSQLiteDriver::open(const QString & db, const QString &, const QString &, c
 
 
     int timeOut = 5000;
+    int statementCacheSize = 0;
     bool sharedCache = false;
     bool openReadOnlyOption = false;
     bool openUriOption = false;
@@ -774,6 +824,14 @@ bool QSQLiteDriver::open(const QString & db, const QString &, const QString &, c
                 if (ok)
                     timeOut = nt;
             }
+        } else if (option.startsWith("QSQLITE_STATEMENT_CACHE_SIZE"_L1)) {
+            option = option.mid(28).trimmed();
+            if (option.startsWith(u'=')) {
+                bool ok;
+                const int size = option.mid(1).trimmed().toInt(&ok);
+                if (ok && size >= 0)
+                    statementCacheSize = size;
+            }
         } else if (option == "QSQLITE_USE_QT_VFS"_L1) {
             useQtVfs = true;
         } else if (option == "QSQLITE_OPEN_READONLY"_L1) {
@@ -828,6 +886,9 @@ bool QSQLiteDriver::open(const QString & db, const QString &, const QString &, c
     if (res == SQLITE_OK) {
         sqlite3_busy_timeout(d->access, timeOut);
         sqlite3_extended_result_codes(d->access, useExtendedResultCodes);
+        d->statementCache.setMaxCost(statementCacheSize);
+        d->statementCacheHits = 0;
+        d->statementCacheMisses = 0;
         setOpen(true);
         setOpenError(false);
 #if QT_CONFIG(regularexpression)
@@ -865,6 +926,7 @@ void QSQLiteDriver::close()
     if (isOpen()) {
         for (QSQLiteResult *result : std::as_const(d->results))
             result->d_func()->finalize();
+        d->statementCache.clear();
 
         if (d->access && (d->notificationid.size() > 0)) {
             d->notificationid.clear();
@@ -992,6 +1054,18 @@ QVariant QSQLiteDriver::handle() const
     return QVariant::fromValue(d->access);
 }
 
+qint64 QSQLiteDriver::statementCacheHits() const
+{
+    Q_D(const QSQLiteDriver);
+    return d->statementCacheHits;
+}
+
+qint64 QSQLiteDriver::statementCacheMisses() const
+{
+    Q_D(const QSQLiteDriver);
+    return d->statementCacheMisses;
+}
+
 QString QSQLiteDriver::escapeIdentifier(const QString &identifier, IdentifierType type) const
 {
     Q_D(const QSQLiteDriver);
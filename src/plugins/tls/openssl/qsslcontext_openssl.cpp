@@ -112,6 +112,10 @@ QT_WARNING_POP
 
     if (!(sslOptions & QSsl::SslOptionDisableServerCipherPreference))
         options |= SSL_OP_CIPHER_SERVER_PREFERENCE;
+#ifdef SSL_OP_ENABLE_KTLS
+    if (sslOptions & QSsl::SslOptionEnableKernelTls)
+        options |= SSL_OP_ENABLE_KTLS;
+#endif
 
     return options;
 }
@@ -110,6 +110,8 @@ DEFINEFUNC2(int, OPENSSL_init_ssl, uint64_t opts, opts, const OPENSSL_INIT_SETTI
 DEFINEFUNC2(int, OPENSSL_init_crypto, uint64_t opts, opts, const OPENSSL_INIT_SETTINGS *settings, settings, return 0, return)
 DEFINEFUNC(BIO *, BIO_new, const BIO_METHOD *a, a, return nullptr, return)
 DEFINEFUNC(const BIO_METHOD *, BIO_s_mem, void, DUMMYARG, return nullptr, return)
+DEFINEFUNC2(BIO *, BIO_new_socket, int sock, sock, int close_flag, close_flag, return nullptr, return)
+DEFINEFUNC(uint64_t, BIO_number_written, BIO *bio, bio, return 0, return)
 DEFINEFUNC2(int, BN_is_word, BIGNUM *a, a, BN_ULONG w, w, return 0, return)
 DEFINEFUNC(int, EVP_CIPHER_CTX_reset, EVP_CIPHER_CTX *c, c, return 0, return)
 DEFINEFUNC(int, EVP_PKEY_up_ref, EVP_PKEY *a, a, return 0, return)
@@ -337,6 +339,9 @@ DEFINEFUNC2(int, SSL_CTX_use_psk_identity_hint, SSL_CTX* ctx, ctx, const char *h
 #endif // !OPENSSL_NO_PSK
 
 DEFINEFUNC3(int, SSL_write, SSL *a, a, const void *b, b, int c, c, return -1, return)
+#if defined(OPENSSL_VERSION_MAJOR) && OPENSSL_VERSION_MAJOR >= 3
+DEFINEFUNC5(ossl_ssize_t, SSL_sendfile, SSL *s, s, int fd, fd, off_t offset, offset, size_t size, size, int flags, flags, return -1, return)
+#endif // OPENSSL_VERSION_MAJOR >= 3
 DEFINEFUNC2(int, X509_cmp, X509 *a, a, X509 *b, b, return -1, return)
 DEFINEFUNC4(int, X509_digest, const X509 *x509, x509, const EVP_MD *type, type, unsigned char *md, md, unsigned int *len, len, return -1, return)
 DEFINEFUNC(X509 *, X509_dup, X509 *a, a, return nullptr, return)
@@ -991,6 +996,8 @@ bool q_resolveOpenSslSymbols()
         RESOLVEFUNC(BIO_new_mem_buf)
         RESOLVEFUNC(BIO_read)
         RESOLVEFUNC(BIO_s_mem)
+        RESOLVEFUNC(BIO_new_socket)
+        RESOLVEFUNC(BIO_number_written)
         RESOLVEFUNC(BIO_write)
         RESOLVEFUNC(BIO_set_flags)
         RESOLVEFUNC(BIO_clear_flags)
@@ -1171,6 +1178,9 @@ bool q_resolveOpenSslSymbols()
 #endif // !OPENSSL_NO_PSK
 
         RESOLVEFUNC(SSL_write)
+#if defined(OPENSSL_VERSION_MAJOR) && OPENSSL_VERSION_MAJOR >= 3
+        RESOLVEFUNC(SSL_sendfile)
+#endif // OPENSSL_VERSION_MAJOR >= 3
         RESOLVEFUNC(X509_NAME_entry_count)
         RESOLVEFUNC(X509_NAME_get_entry)
         RESOLVEFUNC(X509_NAME_ENTRY_get_data)
@@ -199,6 +199,8 @@ const unsigned char * q_ASN1_STRING_get0_data(const ASN1_STRING *x);
 
 BIO *q_BIO_new(const BIO_METHOD *a);
 const BIO_METHOD *q_BIO_s_mem();
+BIO *q_BIO_new_socket(int sock, int close_flag);
+uint64_t q_BIO_number_written(BIO *bio);
 
 void q_AUTHORITY_INFO_ACCESS_free(AUTHORITY_INFO_ACCESS *a);
 int q_EVP_CIPHER_CTX_reset(EVP_CIPHER_CTX *c);
@@ -460,6 +462,9 @@ void q_SSL_set_psk_server_callback(SSL *ssl, q_psk_server_callback_t callback);
 int q_SSL_CTX_use_psk_identity_hint(SSL_CTX *ctx, const char *hint);
 #endif // !OPENSSL_NO_PSK
 int q_SSL_write(SSL *a, const void *b, int c);
+#if defined(OPENSSL_VERSION_MAJOR) && OPENSSL_VERSION_MAJOR >= 3
+ossl_ssize_t q_SSL_sendfile(SSL *s, int fd, off_t offset, size_t size, int flags);
+#endif // OPENSSL_VERSION_MAJOR >= 3
 int q_X509_cmp(X509 *a, X509 *b);
 X509 *q_X509_dup(X509 *a);
 void q_X509_print(BIO *a, X509*b);
@@ -537,6 +542,9 @@ void q_PKCS12_free(PKCS12 *pkcs12);
 #define q_BIO_get_mem_data(b, pp) (int)q_BIO_ctrl(b,BIO_CTRL_INFO,0,(char *)pp)
 #define q_BIO_pending(b) (int)q_BIO_ctrl(b,BIO_CTRL_PENDING,0,NULL)
 #define q_SSL_CTX_set_mode(ctx,op) q_SSL_CTX_ctrl((ctx),SSL_CTRL_MODE,(op),NULL)
+#define q_SSL_set_mode(ssl,op) q_SSL_ctrl((ssl),SSL_CTRL_MODE,(op),NULL)
+#define q_BIO_set_fd(b,fd,c) q_BIO_ctrl(b,BIO_C_SET_FD,(c),(char *)&(fd))
+#define q_BIO_get_ktls_send(b) (q_BIO_ctrl(b,BIO_CTRL_GET_KTLS_SEND,0,NULL) > 0)
 #define q_sk_GENERAL_NAME_num(st) q_SKM_sk_num((st))
 #define q_sk_GENERAL_NAME_value(st, i) q_SKM_sk_value(GENERAL_NAME, (st), (i))
 
@@ -13,12 +13,19 @@
 #include <QtNetwork/private/qsslcertificate_p.h>
 #include <QtNetwork/private/qocspresponse_p.h>
 #include <QtNetwork/private/qsslsocket_p.h>
+#include <QtNetwork/private/qsslsessioncache_p.h>
 
 #include <QtNetwork/qsslpresharedkeyauthenticator.h>
 
+#include <QtCore/qfile.h>
 #include <QtCore/qscopedvaluerollback.h>
 #include <QtCore/qscopeguard.h>
 
+#ifdef QT_OPENSSL_KTLS
+#include <pthread.h>
+#include <signal.h>
+#endif
+
 #include <algorithm>
 #include <cstring>
 
@@ -28,6 +35,69 @@ using namespace Qt::StringLiterals;
 
 namespace  {
 
+// OpenSSL's socket BIO writes with write(), which raises SIGPIPE when the
+// peer has closed the connection, and Linux has no per-socket option to
+// prevent that (MSG_NOSIGNAL needs send()). Instead, while OpenSSL may write
+// to the descriptor, block SIGPIPE in the calling thread and discard a
+// SIGPIPE raised meanwhile, as libpq does. Other threads and the process's
+// signal disposition are left alone.
+class SigPipeGuard
+{
+public:
+    explicit SigPipeGuard(bool active) noexcept
+    {
+#ifdef QT_OPENSSL_KTLS
+        if (!active)
+            return;
+        const sigset_t sigpipe = sigPipeSet();
+        if (pthread_sigmask(SIG_BLOCK, &sigpipe, &previousMask) != 0)
+            return;
+        blocked = true;
+        sigset_t pending;
+        wasPending = sigpending(&pending) == 0 && sigismember(&pending, SIGPIPE) == 1;
+#else
+        Q_UNUSED(active);
+#endif
+    }
+
+    ~SigPipeGuard()
+    {
+#ifdef QT_OPENSSL_KTLS
+        if (!blocked)
+            return;
+        sigset_t pending;
+        if (!wasPending && sigpending(&pending) == 0 && sigismember(&pending, SIGPIPE) == 1) {
+            const sigset_t sigpipe = sigPipeSet();
+            const timespec noWait = {};
+            while (sigtimedwait(&sigpipe, nullptr, &noWait) < 0 && errno == EINTR) {
+            }
+        }
+        pthread_sigmask(SIG_SETMASK, &previousMask, nullptr);
+#endif
+    }
+
+private:
+    Q_DISABLE_COPY_MOVE(SigPipeGuard)
+#ifdef QT_OPENSSL_KTLS
+    static sigset_t sigPipeSet() noexcept
+    {
+        sigset_t set;
+        sigemptyset(&set);
+        sigaddset(&set, SIGPIPE);
+        return set;
+    }
+
+    sigset_t previousMask;
+    bool blocked = false;
+    bool wasPending = false;
+#endif
+};
+
+QAbstractSocketPrivate *socketPrivate(QAbstractSocket *socket)
+{
+    return static_cast<QAbstractSocketPrivate *>(QObjectPrivate::get(socket));
+}
+
 QSsl::AlertLevel tlsAlertLevel(int value)
 {
     using QSsl::AlertLevel;
@@ -562,7 +632,11 @@ bool TlsCryptographOpenSSL::startHandshake()
     q_SSL_set_ex_data(ssl, QTlsBackendOpenSSL::s_indexForSSLExtraData + socketOffsetInExData, this);
     q_SSL_set_info_callback(ssl, qt_AlertInfoCallback);
 
-    int result = (mode == QSslSocket::SslClientMode) ? q_SSL_connect(ssl) : q_SSL_accept(ssl);
+    int result = 0;
+    {
+        const SigPipeGuard sigPipeGuard(socketWriteBio);
+        result = (mode == QSslSocket::SslClientMode) ? q_SSL_connect(ssl) : q_SSL_accept(ssl);
+    }
     q_SSL_set_ex_data(ssl, QTlsBackendOpenSSL::s_indexForSSLExtraData + errorOffsetInExData, nullptr);
     // Note, unlike errors as external data on SSL object, we do not unset
     // a callback/ex-data if alert notifications are enabled: an alert can
@@ -594,8 +668,11 @@ bool TlsCryptographOpenSSL::startHandshake()
     // Check if we're encrypted or not.
     if (result <= 0) {
         switch (q_SSL_get_error(ssl, result)) {
-        case SSL_ERROR_WANT_READ:
         case SSL_ERROR_WANT_WRITE:
+            if (socketWriteBio)
+                waitForSocketWritable();
+            Q_FALLTHROUGH();
+        case SSL_ERROR_WANT_READ:
             // The handshake is not yet complete.
             break;
         default:
@@ -769,6 +846,15 @@ void TlsCryptographOpenSSL::continueHandshake()
     if (q_SSL_session_reused(ssl))
         QTlsBackend::setPeerSessionShared(d, true);
 
+    if (sessionCacheConsulted) {
+        sessionCacheConsulted = false;
+        QSslSessionCachePrivate::handshakeFinished(sessionCache, q_SSL_session_reused(ssl));
+    }
+    // TLS 1.3 sessions only become resumable with a NewSessionTicket message
+    // after the handshake, they are cached in handleNewSessionTicket().
+    if (q_SSL_version(ssl) < 0x304)
+        storeSessionInCache(q_SSL_get_session(ssl));
+
 #ifdef QT_DECRYPT_SSL_TRAFFIC
     if (q_SSL_get_session(ssl)) {
         size_t master_key_len = q_SSL_SESSION_get_master_key(q_SSL_get_session(ssl), nullptr, 0);
@@ -873,6 +959,7 @@ void TlsCryptographOpenSSL::transmit()
         return;
 
     auto &writeBuffer = d->tlsWriteBuffer();
+    auto &pendingFiles = d->tlsPendingFiles();
     auto &buffer = d->tlsBuffer();
     auto *plainSocket = d->plainTcpSocket();
     Q_ASSERT(plainSocket);
@@ -884,16 +971,44 @@ void TlsCryptographOpenSSL::transmit()
 
         // If the connection is secure, we can transfer data from the write
         // buffer (in plain text) to the write BIO through SSL_write.
-        if (q->isEncrypted() && !writeBuffer.isEmpty()) {
+        if (q->isEncrypted() && (!writeBuffer.isEmpty() || !pendingFiles.isEmpty())) {
             qint64 totalBytesWritten = 0;
-            int nextDataBlockSize;
-            while ((nextDataBlockSize = writeBuffer.nextDataBlockSize()) > 0) {
-                int writtenBytes = q_SSL_write(ssl, writeBuffer.readPointer(), nextDataBlockSize);
+            qint64 fileBytesWritten = 0;
+            for (;;) {
+                int nextDataBlockSize = writeBuffer.nextDataBlockSize();
+                if (!pendingFiles.isEmpty()) {
+                    // Files queued by sendFile() are only accepted if the kernel
+                    // encrypts for us, see canSendFile().
+                    const qint64 precedingBytes = pendingFiles.constFirst().precedingBytes;
+                    if (precedingBytes == 0) {
+                        const qint64 sentBytes = writePendingFile();
+                        if (sentBytes < 0)
+                            return;
+                        if (sentBytes == 0)
+                            break;
+                        fileBytesWritten += sentBytes;
+                        totalBytesWritten += sentBytes;
+                        continue;
+                    }
+                    nextDataBlockSize = int(qMin<qint64>(nextDataBlockSize, precedingBytes));
+                }
+                if (nextDataBlockSize <= 0)
+                    break;
+
+                int writtenBytes = 0;
+                {
+                    const SigPipeGuard sigPipeGuard(socketWriteBio);
+                    writtenBytes = q_SSL_write(ssl, writeBuffer.readPointer(), nextDataBlockSize);
+                }
                 if (writtenBytes <= 0) {
                     int error = q_SSL_get_error(ssl, writtenBytes);
                     //write can result in a want_write_error - not an error - continue transmitting
                     if (error == SSL_ERROR_WANT_WRITE) {
-                        transmitting = true;
+                        // With a socket BIO, retrying right away would just spin.
+                        if (socketWriteBio)
+                            waitForSocketWritable();
+                        else
+                            transmitting = true;
                         break;
                     } else if (error == SSL_ERROR_WANT_READ) {
                         //write can result in a want_read error, possibly due to renegotiation - not an error - stop transmitting
@@ -912,6 +1027,8 @@ void TlsCryptographOpenSSL::transmit()
                 qCDebug(lcTlsBackend) << "TlsCryptographOpenSSL::transmit: encrypted" << writtenBytes << "bytes";
 #endif
                 writeBuffer.free(writtenBytes);
+                if (!pendingFiles.isEmpty())
+                    pendingFiles.first().precedingBytes -= writtenBytes;
                 totalBytesWritten += writtenBytes;
 
                 if (writtenBytes < nextDataBlockSize) {
@@ -930,9 +1047,12 @@ void TlsCryptographOpenSSL::transmit()
                 }
                 emit q->channelBytesWritten(0, totalBytesWritten);
             }
+            if (socketWriteBio)
+                reportSocketWrites(fileBytesWritten);
         }
 
         // Check if we've got any data to be written to the socket.
+        // With a socket BIO there never is, OpenSSL has written it already.
         QVarLengthArray<char, 4096> data;
         int pendingBytes;
         while (plainSocket->isValid() && (pendingBytes = q_BIO_pending(writeBio)) > 0
@@ -1030,7 +1150,11 @@ void TlsCryptographOpenSSL::transmit()
             }
             // Don't use SSL_pending(). It's very unreliable.
             inSslRead = true;
-            readBytes = q_SSL_read(ssl, buffer.reserve(bytesToRead), bytesToRead);
+            {
+                // may answer a key update or renegotiation
+                const SigPipeGuard sigPipeGuard(socketWriteBio);
+                readBytes = q_SSL_read(ssl, buffer.reserve(bytesToRead), bytesToRead);
+            }
             inSslRead = false;
             if (renegotiated) {
                 renegotiated = false;
@@ -1115,7 +1239,12 @@ void TlsCryptographOpenSSL::disconnectFromHost()
 {
     if (ssl) {
         if (!shutdown && !q_SSL_in_init(ssl) && !systemOrSslErrorDetected) {
-            if (q_SSL_shutdown(ssl) != 1) {
+            int result = 0;
+            {
+                const SigPipeGuard sigPipeGuard(socketWriteBio);
+                result = q_SSL_shutdown(ssl);
+            }
+            if (result != 1) {
                 // Some error may be queued, clear it.
                 QTlsBackendOpenSSL::clearErrorQueue();
             }
@@ -1135,6 +1264,9 @@ void TlsCryptographOpenSSL::disconnected()
     auto *plainSocket = d->plainTcpSocket();
     Q_ASSERT(plainSocket);
     d->setEncrypted(false);
+    // The descriptor is closed (and may be reused), nothing must be written
+    // to it anymore.
+    detachSocketWriteBio();
 
     if (plainSocket->bytesAvailable() <= 0) {
         destroySslContext();
@@ -1187,6 +1319,21 @@ QList<QOcspResponse> TlsCryptographOpenSSL::ocsps() const
     return ocspResponses;
 }
 
+bool TlsCryptographOpenSSL::writesToSocketDescriptor() const
+{
+    return socketWriteBio;
+}
+
+bool TlsCryptographOpenSSL::canSendFile() const
+{
+#ifdef QT_OPENSSL_KTLS
+    // SSL_sendfile() only works once the kernel has the keys.
+    return ssl && socketWriteBio && q_BIO_get_ktls_send(writeBio);
+#else
+    return false;
+#endif
+}
+
 bool TlsCryptographOpenSSL::checkSslErrors()
 {
     Q_ASSERT(q);
@@ -1229,7 +1376,8 @@ int TlsCryptographOpenSSL::handleNewSessionTicket(SSL *connection)
     Q_ASSERT(q);
     Q_ASSERT(d);
 
-    if (q->sslConfiguration().testSslOption(QSsl::SslOptionDisableSessionPersistence)) {
+    const bool persistent = !q->sslConfiguration().testSslOption(QSsl::SslOptionDisableSessionPersistence);
+    if (!persistent && !sessionCache) {
         // We silently ignore, do nothing, remove from cache.
         return 0;
     }
@@ -1253,6 +1401,10 @@ int TlsCryptographOpenSSL::handleNewSessionTicket(SSL *connection)
     }
 #endif // TLS1_3_VERSION
 
+    storeSessionInCache(currentSession);
+    if (!persistent)
+        return 0;
+
     const int sessionSize = q_i2d_SSL_SESSION(currentSession, nullptr);
     if (sessionSize <= 0) {
         qCWarning(lcTlsBackend, "could not store persistent version of SSL session");
@@ -1403,14 +1555,22 @@ bool TlsCryptographOpenSSL::initSslContext()
             if (!q_SSL_ctrl(ssl, SSL_CTRL_SET_TLSEXT_HOSTNAME, TLSEXT_NAMETYPE_host_name, ace.data()))
                 qCWarning(lcTlsBackend, "could not set SSL_CTRL_SET_TLSEXT_HOSTNAME, Server Name Indication disabled");
         }
+
+        resumeCachedSession(tlsHostName);
     }
 
     // Clear the session.
     errorList.clear();
 
-    // Initialize memory BIOs for encryption and decryption.
+    // Initialize memory BIOs for encryption and decryption. If kernel TLS
+    // was requested, write directly to the socket instead, so that OpenSSL
+    // can enable it once the handshake is done.
     readBio = q_BIO_new(q_BIO_s_mem());
-    writeBio = q_BIO_new(q_BIO_s_mem());
+    writeBio = configuration.testSslOption(QSsl::SslOptionEnableKernelTls)
+            ? createSocketWriteBio() : nullptr;
+    socketWriteBio = writeBio != nullptr;
+    if (!writeBio)
+        writeBio = q_BIO_new(q_BIO_s_mem());
     if (!readBio || !writeBio) {
         setErrorAndEmit(d, QAbstractSocket::SslInternalError,
                         QSslSocket::tr("Error creating SSL session: %1").arg(QTlsBackendOpenSSL::getErrorsFromOpenSsl()));
@@ -1418,6 +1578,7 @@ bool TlsCryptographOpenSSL::initSslContext()
             q_BIO_free(readBio);
         if (writeBio)
             q_BIO_free(writeBio);
+        socketWriteBio = false;
         return false;
     }
 
@@ -1489,6 +1650,7 @@ bool TlsCryptographOpenSSL::initSslContext()
 void TlsCryptographOpenSSL::destroySslContext()
 {
     if (ssl) {
+        detachSocketWriteBio();
         if (!q_SSL_in_init(ssl) && !systemOrSslErrorDetected) {
             // We do not send a shutdown alert here. Just mark the session as
             // resumable for qhttpnetworkconnection's "optimization", otherwise
@@ -1502,9 +1664,215 @@ void TlsCryptographOpenSSL::destroySslContext()
         q_SSL_free(ssl);
         ssl = nullptr;
     }
+    if (socketWriteBio) {
+        if (auto *plainSocket = d ? d->plainTcpSocket() : nullptr) {
+            QAbstractSocketPrivate *plainSocketPrivate = socketPrivate(plainSocket);
+            plainSocketPrivate->writableCallback = nullptr;
+            plainSocketPrivate->notifyWritable = false;
+        }
+    }
+    socketWriteBio = false;
+    sessionCache = nullptr;
+    sessionCacheConsulted = false;
     sslContextPointer.reset();
 }
 
+/*
+    Returns a socket BIO that writes to the descriptor of the plain socket,
+    or nullptr if the encrypted data has to go through the plain socket. With
+    SSL_OP_ENABLE_KTLS, OpenSSL then passes the keys to the kernel when the
+    handshake is done, and the kernel encrypts everything written later.
+    Incoming data still goes through the plain socket and the memory BIO.
+*/
+BIO *TlsCryptographOpenSSL::createSocketWriteBio()
+{
+#ifdef QT_OPENSSL_KTLS
+    Q_ASSERT(d);
+    auto *plainSocket = d->plainTcpSocket();
+    const qintptr descriptor = plainSocket->socketDescriptor();
+    if (descriptor < 0 || plainSocket->bytesToWrite() > 0)
+        return nullptr;
+    QAbstractSocketPrivate *plainSocketPrivate = socketPrivate(plainSocket);
+#ifndef QT_NO_NETWORKPROXY
+    // A proxy's socket engine keeps its own buffers on top of the descriptor.
+    const QNetworkProxy::ProxyType proxyType = plainSocketPrivate->proxyInUse.type();
+    if (proxyType != QNetworkProxy::NoProxy && proxyType != QNetworkProxy::DefaultProxy)
+        return nullptr;
+#endif
+
+    BIO *bio = q_BIO_new_socket(int(descriptor), BIO_NOCLOSE);
+    if (!bio)
+        return nullptr;
+
+    // A retried SSL_write() may see the write buffer reallocated.
+    q_SSL_set_mode(ssl, SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+
+    // The plain socket's own write notifier tells us when we can continue.
+    plainSocketPrivate->writableCallback = [this] { transmit(); };
+    socketBytesReported = 0;
+    return bio;
+#else
+    return nullptr;
+#endif
+}
+
+/*
+    Points the socket BIO to an invalid descriptor, so that OpenSSL can no
+    longer write to the plain socket's descriptor once it is closed.
+*/
+void TlsCryptographOpenSSL::detachSocketWriteBio()
+{
+    if (!socketWriteBio)
+        return;
+
+    if (auto *plainSocket = d ? d->plainTcpSocket() : nullptr)
+        socketPrivate(plainSocket)->notifyWritable = false;
+    int invalidDescriptor = -1;
+    q_BIO_set_fd(writeBio, invalidDescriptor, BIO_NOCLOSE);
+}
+
+/*
+    Called when OpenSSL could not write to the socket BIO. The plain socket
+    does not know about our data, so have it notify us once its descriptor
+    is writable again, and continue in transmit() then.
+*/
+void TlsCryptographOpenSSL::waitForSocketWritable()
+{
+    Q_ASSERT(socketWriteBio);
+    Q_ASSERT(d);
+    auto *plainSocket = d->plainTcpSocket();
+    if (plainSocket && plainSocket->isValid())
+        socketPrivate(plainSocket)->notifyWhenWritable();
+}
+
+/*
+    Sends as much as possible of the first file queued by sendFile() using
+    SSL_sendfile(), which lets the kernel read and encrypt the file without
+    copying it through user space. Returns the number of bytes sent, 0 if the
+    socket is not writable, or -1 after reporting an error.
+*/
+qint64 TlsCryptographOpenSSL::writePendingFile()
+{
+#ifdef QT_OPENSSL_KTLS
+    using ScopedBool = QScopedValueRollback<bool>;
+
+    auto &pendingFiles = d->tlsPendingFiles();
+    auto &pending = pendingFiles.first();
+    const int fd = pending.file ? pending.file->handle() : -1;
+    if (fd < 0) {
+        const ScopedBool bg(inSetAndEmitError, true);
+        setErrorAndEmit(d, QAbstractSocket::UnknownSocketError,
+                        QSslSocket::tr("File to send was closed"));
+        return -1;
+    }
+
+    // sendfile() transfers at most this much in one call anyway
+    const qint64 maxSize = qMin(pending.remaining, Q_INT64_C(0x7ffff000));
+    ossl_ssize_t sentBytes = 0;
+    {
+        const SigPipeGuard sigPipeGuard(true);
+        sentBytes = q_SSL_sendfile(ssl, fd, off_t(pending.offset), size_t(maxSize), 0);
+    }
+    if (sentBytes <= 0) {
+        if (sentBytes < 0 && q_SSL_get_error(ssl, int(sentBytes)) == SSL_ERROR_WANT_WRITE) {
+            waitForSocketWritable();
+            return 0;
+        }
+        const ScopedBool bg(inSetAndEmitError, true);
+        setErrorAndEmit(d, QAbstractSocket::SslInternalError,
+                        QSslSocket::tr("Unable to write data: %1").arg(
+                        QTlsBackendOpenSSL::getErrorsFromOpenSsl()));
+        return -1;
+    }
+
+    pending.offset += sentBytes;
+    pending.remaining -= sentBytes;
+    if (pending.remaining == 0)
+        pendingFiles.removeFirst();
+    return sentBytes;
+#else
+    Q_UNREACHABLE_RETURN(-1);
+#endif
+}
+
+/*
+    With a socket BIO, the plain socket never emits bytesWritten() for the
+    encrypted data. Emit encryptedBytesWritten() and finish a pending
+    disconnectFromHost() from the event loop, as QSslSocket does when the
+    plain socket reports written data. \a fileBytes were sent by
+    SSL_sendfile(), bypassing the BIO's byte counter.
+*/
+void TlsCryptographOpenSSL::reportSocketWrites(qint64 fileBytes)
+{
+    const quint64 written = q_BIO_number_written(writeBio);
+    const qint64 encryptedBytes = qint64(written - socketBytesReported) + fileBytes;
+    socketBytesReported = written;
+    if (encryptedBytes > 0) {
+        QMetaObject::invokeMethod(q, "_q_bytesWrittenSlot", Qt::QueuedConnection,
+                                  Q_ARG(qint64, encryptedBytes));
+    }
+}
+
+/*
+    Looks up a session for \a peerName in the configuration's session cache
+    and asks OpenSSL to resume it. A session the SSL context already cached
+    (or one set by QSslConfiguration::setSessionTicket()) takes precedence.
+*/
+void TlsCryptographOpenSSL::resumeCachedSession(const QString &peerName)
+{
+    Q_ASSERT(ssl);
+    Q_ASSERT(q);
+
+    sessionCache = q->sslConfiguration().sessionCache();
+    sessionCacheConsulted = false;
+    if (!sessionCache || peerName.isEmpty())
+        return;
+
+    sessionCachePeerName = peerName;
+    sessionCachePort = q->peerPort();
+    sessionCacheKey = QSslSessionCachePrivate::configurationKey(q->sslConfiguration());
+    if (q_SSL_get_session(ssl))
+        return;
+
+    sessionCacheConsulted = true;
+    const QByteArray asn1 = QSslSessionCachePrivate::lookup(sessionCache, sessionCachePeerName,
+                                                            sessionCachePort, sessionCacheKey);
+    if (asn1.isEmpty())
+        return;
+
+    const auto *data = reinterpret_cast<const unsigned char *>(asn1.constData());
+    SSL_SESSION *session = q_d2i_SSL_SESSION(nullptr, &data, asn1.size());
+    if (!session) {
+        // the cache may have been destroyed while looking the session up
+        if (sessionCache)
+            sessionCache->remove(sessionCachePeerName, sessionCachePort, sessionCacheKey);
+        return;
+    }
+    if (!q_SSL_set_session(ssl, session))
+        qCWarning(lcTlsBackend, "could not set SSL session from the session cache");
+    q_SSL_SESSION_free(session); // SSL_set_session() took its own reference
+}
+
+/*
+    Stores \a session in the session cache consulted by resumeCachedSession().
+*/
+void TlsCryptographOpenSSL::storeSessionInCache(SSL_SESSION *session)
+{
+    if (!sessionCache || sessionCacheKey.isEmpty() || !session)
+        return;
+
+    const int sessionSize = q_i2d_SSL_SESSION(session, nullptr);
+    if (sessionSize <= 0)
+        return;
+    QByteArray asn1(sessionSize, Qt::Uninitialized);
+    auto *data = reinterpret_cast<unsigned char *>(asn1.data());
+    if (!q_i2d_SSL_SESSION(session, &data) || !sessionCache)
+        return;
+
+    sessionCache->insert(sessionCachePeerName, sessionCachePort, sessionCacheKey, asn1,
+                         int(q_SSL_SESSION_get_ticket_lifetime_hint(session)));
+}
+
 void TlsCryptographOpenSSL::storePeerCertificates()
 {
     Q_ASSERT(d);
@@ -23,11 +23,17 @@
 
 #include <QtNetwork/qsslcertificate.h>
 #include <QtNetwork/qocspresponse.h>
+#include <QtNetwork/qsslsessioncache.h>
 
 #include <QtCore/qsharedpointer.h>
 #include <QtCore/qbytearray.h>
 #include <QtCore/qglobal.h>
 #include <QtCore/qlist.h>
+#include <QtCore/qpointer.h>
+
+#if defined(Q_OS_LINUX) && defined(SSL_OP_ENABLE_KTLS)
+#define QT_OPENSSL_KTLS
+#endif
 
 QT_BEGIN_NAMESPACE
 
@@ -61,6 +67,8 @@ public:
     QSslCipher sessionCipher() const override;
     QSsl::SslProtocol sessionProtocol() const override;
     QList<QOcspResponse> ocsps() const override;
+    bool writesToSocketDescriptor() const override;
+    bool canSendFile() const override;
 
     bool checkSslErrors();
     int handleNewSessionTicket(SSL *connection);
@@ -100,6 +108,17 @@ private:
     bool initSslContext();
     void destroySslContext();
 
+    // Kernel TLS: encrypted records are written directly to the socket.
+    BIO *createSocketWriteBio();
+    void detachSocketWriteBio();
+    void waitForSocketWritable();
+    qint64 writePendingFile();
+    void reportSocketWrites(qint64 fileBytes);
+
+    // QSslSessionCache support, client side only.
+    void resumeCachedSession(const QString &peerName);
+    void storeSessionInCache(SSL_SESSION *session);
+
     std::shared_ptr<QSslContext> sslContextPointer;
     SSL *ssl = nullptr; // TLSTODO: RAII.
 
@@ -109,6 +128,15 @@ private:
     BIO *readBio = nullptr;
     BIO *writeBio = nullptr;
 
+    quint64 socketBytesReported = 0;
+    bool socketWriteBio = false;
+
+    QPointer<QSslSessionCache> sessionCache;
+    QString sessionCachePeerName;
+    QByteArray sessionCacheKey;
+    quint16 sessionCachePort = 0;
+    bool sessionCacheConsulted = false;
+
     QList<QOcspResponse> ocspResponses;
 
     // This description will go to setErrorAndEmit(SslHandshakeError, ocspErrorDescription)
@@ -0,0 +1,355 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QTest>
+#include <QScopeGuard>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QThread>
+#include <QThreadPool>
+
+#include <QtCore/private/qrandomaccessasyncfile_p.h>
+
+class tst_QRandomAccessAsyncFile : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanup();
+
+    void openError();
+    void readWrite_data();
+    void readWrite();
+    void readPastEnd_data();
+    void readPastEnd();
+    void manyReads_data();
+    void manyReads();
+    void closeWithPendingOperations_data();
+    void closeWithPendingOperations();
+    void closeFromGlobalThreadPool_data();
+    void closeFromGlobalThreadPool();
+    void sharedBetweenObjects();
+    void moveToThread_data();
+    void moveToThread();
+    void rejectsWrongMode();
+
+private:
+    QString createFile(const QByteArray &contents);
+
+    QTemporaryDir dir;
+    int fileCounter = 0;
+};
+
+void tst_QRandomAccessAsyncFile::initTestCase()
+{
+    QVERIFY2(dir.isValid(), qPrintable(dir.errorString()));
+}
+
+void tst_QRandomAccessAsyncFile::cleanup()
+{
+    qunsetenv("QT_NO_IO_URING");
+}
+
+QString tst_QRandomAccessAsyncFile::createFile(const QByteArray &contents)
+{
+    const QString fileName = dir.filePath(QString::number(++fileCounter));
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly) || file.write(contents) != contents.size())
+        return QString();
+    return fileName;
+}
+
+void tst_QRandomAccessAsyncFile::openError()
+{
+    QRandomAccessAsyncFile file;
+    QVERIFY(!file.open(dir.filePath("does-not-exist"), QIODevice::ReadOnly));
+    QVERIFY(!file.isOpen());
+    QVERIFY(!file.errorString().isEmpty());
+    QCOMPARE(file.read(0, 10), quint64(0));
+}
+
+void tst_QRandomAccessAsyncFile::readWrite_data()
+{
+    QTest::addColumn<bool>("threadPool");
+    QTest::newRow("default") << false;
+    QTest::newRow("threadpool") << true;
+}
+
+void tst_QRandomAccessAsyncFile::readWrite()
+{
+    QFETCH(bool, threadPool);
+    if (threadPool)
+        qputenv("QT_NO_IO_URING", "1");
+
+    const QString fileName = createFile(QByteArray());
+    QVERIFY(!fileName.isEmpty());
+
+    QRandomAccessAsyncFile file;
+    QVERIFY2(file.open(fileName, QIODevice::ReadWrite), qPrintable(file.errorString()));
+    if (threadPool)
+        QCOMPARE(file.backend(), QRandomAccessAsyncFile::Backend::ThreadPool);
+
+    QSignalSpy writeSpy(&file, &QRandomAccessAsyncFile::bytesWritten);
+    QSignalSpy readSpy(&file, &QRandomAccessAsyncFile::readyRead);
+    QSignalSpy errorSpy(&file, &QRandomAccessAsyncFile::errorOccurred);
+
+    const quint64 first = file.write(0, "Hello, ");
+    const quint64 second = file.write(7, "World");
+    QVERIFY(first != 0);
+    QVERIFY(second != first);
+    QCOMPARE(file.pendingOperations(), 2);
+
+    QTRY_COMPARE(writeSpy.size(), 2);
+    QCOMPARE(file.pendingOperations(), 0);
+    qint64 written = 0;
+    for (const QList<QVariant> &args : std::as_const(writeSpy))
+        written += args.at(1).toLongLong();
+    QCOMPARE(written, 12);
+    QCOMPARE(file.size(), 12);
+
+    const quint64 id = file.read(0, 100);
+    QTRY_COMPARE(readSpy.size(), 1);
+    QCOMPARE(readSpy.at(0).at(0).toULongLong(), id);
+    QCOMPARE(readSpy.at(0).at(1).toByteArray(), "Hello, World");
+    QCOMPARE(errorSpy.size(), 0);
+}
+
+void tst_QRandomAccessAsyncFile::readPastEnd_data()
+{
+    readWrite_data();
+}
+
+void tst_QRandomAccessAsyncFile::readPastEnd()
+{
+    QFETCH(bool, threadPool);
+    if (threadPool)
+        qputenv("QT_NO_IO_URING", "1");
+
+    const QString fileName = createFile("abc");
+    QVERIFY(!fileName.isEmpty());
+
+    QRandomAccessAsyncFile file;
+    QVERIFY(file.open(fileName, QIODevice::ReadOnly));
+    QSignalSpy readSpy(&file, &QRandomAccessAsyncFile::readyRead);
+
+    file.read(2, 10);
+    file.read(10, 10);
+    file.waitForFinished();
+    QCOMPARE(readSpy.size(), 2);
+
+    QList<QByteArray> results = { readSpy.at(0).at(1).toByteArray(),
+                                  readSpy.at(1).at(1).toByteArray() };
+    std::sort(results.begin(), results.end());
+    QCOMPARE(results.at(0), QByteArray());
+    QCOMPARE(results.at(1), "c");
+}
+
+void tst_QRandomAccessAsyncFile::manyReads_data()
+{
+    readWrite_data();
+}
+
+void tst_QRandomAccessAsyncFile::manyReads()
+{
+    QFETCH(bool, threadPool);
+    if (threadPool)
+        qputenv("QT_NO_IO_URING", "1");
+
+    // more operations than fit in the submission queue at once
+    constexpr int BlockSize = 64;
+    constexpr int Blocks = 1000;
+    QByteArray contents;
+    for (int i = 0; i < Blocks; ++i)
+        contents += QByteArray(BlockSize, char('a' + i % 26));
+    const QString fileName = createFile(contents);
+    QVERIFY(!fileName.isEmpty());
+
+    QRandomAccessAsyncFile file;
+    QVERIFY(file.open(fileName, QIODevice::ReadOnly));
+
+    QHash<quint64, int> blockForId;
+    int verified = 0;
+    connect(&file, &QRandomAccessAsyncFile::readyRead, this,
+            [&](quint64 id, const QByteArray &data) {
+        const int block = blockForId.value(id, -1);
+        if (block >= 0 && data == QByteArray(BlockSize, char('a' + block % 26)))
+            ++verified;
+    });
+
+    for (int i = 0; i < Blocks; ++i)
+        blockForId.insert(file.read(qint64(i) * BlockSize, BlockSize), i);
+    QCOMPARE(blockForId.size(), Blocks);
+
+    QTRY_COMPARE(verified, Blocks);
+    QCOMPARE(file.pendingOperations(), 0);
+}
+
+void tst_QRandomAccessAsyncFile::closeWithPendingOperations_data()
+{
+    readWrite_data();
+}
+
+void tst_QRandomAccessAsyncFile::closeWithPendingOperations()
+{
+    QFETCH(bool, threadPool);
+    if (threadPool)
+        qputenv("QT_NO_IO_URING", "1");
+
+    const QString fileName = createFile(QByteArray(4096, 'x'));
+    QVERIFY(!fileName.isEmpty());
+
+    QRandomAccessAsyncFile file;
+    QVERIFY(file.open(fileName, QIODevice::ReadOnly));
+    QSignalSpy readSpy(&file, &QRandomAccessAsyncFile::readyRead);
+
+    for (int i = 0; i < 16; ++i)
+        file.read(i * 256, 256);
+    file.close();
+    QVERIFY(!file.isOpen());
+    QCOMPARE(file.pendingOperations(), 0);
+
+    QCoreApplication::processEvents();
+    QCOMPARE(readSpy.size(), 0);
+}
+
+void tst_QRandomAccessAsyncFile::closeFromGlobalThreadPool_data()
+{
+    readWrite_data();
+}
+
+void tst_QRandomAccessAsyncFile::closeFromGlobalThreadPool()
+{
+    QFETCH(bool, threadPool);
+    if (threadPool)
+        qputenv("QT_NO_IO_URING", "1");
+
+    const QString fileName = createFile(QByteArray(4096, 'x'));
+    QVERIFY(!fileName.isEmpty());
+
+    // close() must not wait for jobs that can only run once it returns
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int maxThreadCount = pool->maxThreadCount();
+    const auto restoreMaxThreadCount = qScopeGuard([&] {
+        pool->setMaxThreadCount(maxThreadCount);
+    });
+    pool->setMaxThreadCount(1);
+
+    QAtomicInt result = -1;
+    pool->start([&] {
+        QRandomAccessAsyncFile file;
+        if (!file.open(fileName, QIODevice::ReadOnly)) {
+            result = 0;
+            return;
+        }
+        for (int i = 0; i < 16; ++i)
+            file.read(i * 256, 256);
+        file.close();
+        result = file.pendingOperations() == 0 ? 1 : 0;
+    });
+    QVERIFY(pool->waitForDone(10000));
+    QCOMPARE(result.loadRelaxed(), 1);
+}
+
+void tst_QRandomAccessAsyncFile::sharedBetweenObjects()
+{
+    const QString fileName = createFile("abcdef");
+    QVERIFY(!fileName.isEmpty());
+
+    QRandomAccessAsyncFile first;
+    QVERIFY(first.open(fileName, QIODevice::ReadOnly));
+    QSignalSpy firstSpy(&first, &QRandomAccessAsyncFile::readyRead);
+    auto second = std::make_unique<QRandomAccessAsyncFile>();
+    QVERIFY(second->open(fileName, QIODevice::ReadOnly));
+    QCOMPARE(second->backend(), first.backend());
+
+    // closing one object leaves the operations of the other alone
+    first.read(0, 3);
+    second->read(3, 3);
+    second.reset();
+    first.read(3, 3);
+
+    QTRY_COMPARE(firstSpy.size(), 2);
+    QList<QByteArray> results = { firstSpy.at(0).at(1).toByteArray(),
+                                  firstSpy.at(1).at(1).toByteArray() };
+    std::sort(results.begin(), results.end());
+    QCOMPARE(results.at(0), "abc");
+    QCOMPARE(results.at(1), "def");
+    QCOMPARE(first.pendingOperations(), 0);
+}
+
+void tst_QRandomAccessAsyncFile::moveToThread_data()
+{
+    readWrite_data();
+}
+
+void tst_QRandomAccessAsyncFile::moveToThread()
+{
+    QFETCH(bool, threadPool);
+    if (threadPool)
+        qputenv("QT_NO_IO_URING", "1");
+
+    const QString fileName = createFile("abcdef");
+    QVERIFY(!fileName.isEmpty());
+
+    auto file = std::make_unique<QRandomAccessAsyncFile>();
+    QVERIFY(file->open(fileName, QIODevice::ReadOnly));
+    const QRandomAccessAsyncFile::Backend backend = file->backend();
+
+    QList<QByteArray> results;
+    QList<QThread *> threads;
+    QMutex mutex;
+    connect(file.get(), &QRandomAccessAsyncFile::readyRead, file.get(),
+            [&](quint64, const QByteArray &data) {
+        QMutexLocker locker(&mutex);
+        results.append(data);
+        threads.append(QThread::currentThread());
+    }, Qt::DirectConnection);
+
+    // the operations in flight complete before the object moves
+    for (int i = 0; i < 8; ++i)
+        file->read(0, 3);
+
+    QThread thread;
+    thread.start();
+    const auto cleanup = qScopeGuard([&] {
+        if (file) {
+            QMetaObject::invokeMethod(file.get(), [&] { file.reset(); },
+                                      Qt::BlockingQueuedConnection);
+        }
+        thread.quit();
+        thread.wait();
+    });
+    file->moveToThread(&thread);
+
+    QMetaObject::invokeMethod(file.get(), [&] { file->read(3, 3); });
+    QTRY_VERIFY([&] { QMutexLocker locker(&mutex); return results.size() == 9; }());
+
+    QMutexLocker locker(&mutex);
+    for (int i = 0; i < 8; ++i) {
+        QCOMPARE(results.at(i), "abc");
+        QCOMPARE(threads.at(i), QThread::currentThread());
+    }
+    QCOMPARE(results.at(8), "def");
+    QCOMPARE(threads.at(8), &thread);
+    locker.unlock();
+
+    QMetaObject::invokeMethod(file.get(), [&] {
+        QCOMPARE(file->backend(), backend);
+        file.reset();
+    }, Qt::BlockingQueuedConnection);
+}
+
+void tst_QRandomAccessAsyncFile::rejectsWrongMode()
+{
+    const QString fileName = createFile("abc");
+    QVERIFY(!fileName.isEmpty());
+
+    QRandomAccessAsyncFile file;
+    QVERIFY(file.open(fileName, QIODevice::ReadOnly));
+    QCOMPARE(file.write(0, "x"), quint64(0));
+    QCOMPARE(file.read(-1, 1), quint64(0));
+}
+
+QTEST_MAIN(tst_QRandomAccessAsyncFile)
+#include "tst_qrandomaccessasyncfile.moc"
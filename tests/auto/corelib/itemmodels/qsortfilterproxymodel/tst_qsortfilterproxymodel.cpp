@@ -6,12 +6,16 @@
 
 #include <QDebug>
 #include <QComboBox>
+#include <QScopeGuard>
+#include <QSemaphore>
 #include <QSortFilterProxyModel>
 #include <QStandardItem>
 #include <QStringListModel>
 #include <QTableView>
 #include <QTreeView>
 #include <QTest>
+#include <QThread>
+#include <QThreadPool>
 #include <QStack>
 #include <QSignalSpy>
 #include <QAbstractItemModelTester>
@@ -5365,6 +5369,14 @@ void tst_QSortFilterProxyModel::autoAcceptChildRowsBinding()
                                                                            "autoAcceptChildRows");
 }
 
+void tst_QSortFilterProxyModel::parallelSortFilterEnabledBinding()
+{
+    QSortFilterProxyModel proxyModel;
+    QCOMPARE(proxyModel.isParallelSortFilterEnabled(), false);
+    QTestPrivate::testReadWritePropertyBasics<QSortFilterProxyModel, bool>(
+            proxyModel, true, false, "parallelSortFilterEnabled");
+}
+
 void tst_QSortFilterProxyModel::filterCaseSensitivityBinding()
 {
     QSortFilterProxyModel proxyModel;
@@ -5556,5 +5568,82 @@ void tst_QSortFilterProxyModel::filterChangeEmitsModelChangedSignals()
     QCOMPARE(rowsRemovedSpy.count(), 1);
 }
 
+// Filters like QSortFilterProxyModel, but has the first row filtered on the
+// thread that owns the proxy wait until another thread has filtered a row.
+class ThreadCheckingProxyModel : public QSortFilterProxyModel
+{
+public:
+    bool filterAcceptsRow(int source_row, const QModelIndex &source_parent) const override
+    {
+        if (QThread::currentThread() != thread())
+            otherThreadFiltered.release();
+        else if (!waited.fetchAndStoreRelaxed(true))
+            otherThreadEntered = otherThreadFiltered.tryAcquire(1, 10000);
+        return QSortFilterProxyModel::filterAcceptsRow(source_row, source_parent);
+    }
+
+    mutable QSemaphore otherThreadFiltered;
+    mutable QAtomicInteger<bool> waited = false;
+    mutable bool otherThreadEntered = false;
+};
+
+void tst_QSortFilterProxyModel::parallelSortFilter()
+{
+    // the proxy only uses other threads if the pool can run more than one
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int maxThreadCount = pool->maxThreadCount();
+    const auto restoreMaxThreadCount = qScopeGuard([&] {
+        pool->setMaxThreadCount(maxThreadCount);
+    });
+    pool->setMaxThreadCount(4);
+
+    // large enough to be processed in parallel
+    QStringList list;
+    for (int i = 0; i < 100000; ++i)
+        list << QString::number((i * 7919) % 100000 / 3);
+    QStringListModel model(list);
+
+    QSortFilterProxyModel sequential;
+    sequential.setSourceModel(&model);
+    ThreadCheckingProxyModel parallel;
+    parallel.setParallelSortFilterEnabled(true);
+    parallel.setSourceModel(&model);
+
+    const auto compareProxies = [&] {
+        QCOMPARE(parallel.rowCount(), sequential.rowCount());
+        for (int row = 0; row < sequential.rowCount(); ++row) {
+            // the sort is stable, so equal strings keep the order of the source
+            QCOMPARE(parallel.mapToSource(parallel.index(row, 0)),
+                     sequential.mapToSource(sequential.index(row, 0)));
+        }
+    };
+
+    sequential.setFilterRegularExpression(QStringLiteral("[1-3]$"));
+    parallel.setFilterRegularExpression(QStringLiteral("[1-3]$"));
+    compareProxies();
+    if (QTest::currentTestFailed())
+        return;
+    // the mapping is built lazily, so only now has the filter run
+    QVERIFY(parallel.otherThreadEntered);
+
+    QSignalSpy layoutChangedSpy(&parallel, &QSortFilterProxyModel::layoutChanged);
+    sequential.sort(0);
+    parallel.sort(0);
+    QCOMPARE(layoutChangedSpy.size(), 1);
+    compareProxies();
+    if (QTest::currentTestFailed())
+        return;
+
+    sequential.sort(0, Qt::DescendingOrder);
+    parallel.sort(0, Qt::DescendingOrder);
+    compareProxies();
+    if (QTest::currentTestFailed())
+        return;
+
+    sequential.setFilterRegularExpression(QStringLiteral("^[4-7]"));
+    parallel.setFilterRegularExpression(QStringLiteral("^[4-7]"));
+    compareProxies();
+}
+
 QTEST_MAIN(tst_QSortFilterProxyModel)
 #include "tst_qsortfilterproxymodel.moc"
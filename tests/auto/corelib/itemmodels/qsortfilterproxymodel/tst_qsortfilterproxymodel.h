@@ -150,10 +150,12 @@ private slots:
     void filterRoleBinding();
     void recursiveFilteringEnabledBinding();
     void autoAcceptChildRowsBinding();
+    void parallelSortFilterEnabledBinding();
     void filterCaseSensitivityBinding();
     void filterRegularExpressionBinding();
 
     void filterChangeEmitsModelChangedSignals();
+    void parallelSortFilter();
 
 protected:
     void buildHierarchy(const QStringList &data, QAbstractItemModel *model);
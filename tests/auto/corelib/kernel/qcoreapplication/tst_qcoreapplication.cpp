@@ -511,6 +511,83 @@ void tst_QCoreApplication::deliverInDefinedOrder()
     QObject::connect(&obj, SIGNAL(done()), &app, SLOT(quit()));
     app.exec();
 }
+
+void tst_QCoreApplication::queuedCallsFromManyThreads()
+{
+    int argc = 1;
+    char *argv[] = { const_cast<char*>(QTest::currentAppName()) };
+    TestApplication app(argc, argv);
+
+    constexpr int ThreadCount = 4;
+    constexpr int CallsPerThread = 2000;
+
+    // queued calls bypass the posted event list's mutex; they must still
+    // arrive in posting order per thread, and interleave correctly with
+    // events that go through the list directly
+    class Receiver : public QObject
+    {
+    public:
+        int lastCall[ThreadCount] = {};
+        int userEvents[ThreadCount] = {};
+        int received = 0;
+        bool ordered = true;
+
+        void call(int thread, int n)
+        {
+            ordered = ordered && n == lastCall[thread] + 1;
+            lastCall[thread] = n;
+            ++received;
+        }
+
+        bool event(QEvent *e) override
+        {
+            const int thread = e->type() - QEvent::User;
+            if (thread >= 0 && thread < ThreadCount) {
+                // posted right after every hundredth call
+                ordered = ordered && lastCall[thread] == (userEvents[thread] + 1) * 100;
+                ++userEvents[thread];
+                return true;
+            }
+            return QObject::event(e);
+        }
+    } receiver;
+
+    QSemaphore start;
+    QList<QThread *> threads;
+    for (int t = 0; t < ThreadCount; ++t) {
+        threads << QThread::create([&, t] {
+            start.acquire();
+            for (int n = 1; n <= CallsPerThread; ++n) {
+                QMetaObject::invokeMethod(&receiver, [&receiver, t, n] { receiver.call(t, n); },
+                                          Qt::QueuedConnection);
+                if (n % 100 == 0) {
+                    QCoreApplication::postEvent(&receiver,
+                                                new QEvent(QEvent::Type(QEvent::User + t)));
+                }
+            }
+        });
+        threads.last()->start();
+    }
+    start.release(ThreadCount);
+
+    QTRY_COMPARE_WITH_TIMEOUT(receiver.received, ThreadCount * CallsPerThread, 60s);
+    for (QThread *thread : std::as_const(threads)) {
+        QVERIFY(thread->wait());
+        delete thread;
+    }
+    QCoreApplication::sendPostedEvents();
+    QVERIFY(receiver.ordered);
+    for (int t = 0; t < ThreadCount; ++t)
+        QCOMPARE(receiver.userEvents[t], CallsPerThread / 100);
+
+    // calls posted without the mutex are removed like any other event
+    for (int n = 1; n <= 10; ++n)
+        QMetaObject::invokeMethod(&receiver, [&receiver] { ++receiver.received; },
+                                  Qt::QueuedConnection);
+    QCoreApplication::removePostedEvents(&receiver, QEvent::MetaCall);
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(receiver.received, ThreadCount * CallsPerThread);
+}
 #endif // QT_CONFIG(thread)
 
 void tst_QCoreApplication::applicationPid()
@@ -551,10 +628,15 @@ void tst_QCoreApplication::globalPostedEventsCount()
     QCoreApplication::postEvent(&x, new QEvent(QEvent::User));
     QCOMPARE(qGlobalPostedEventsCount(), qsizetype(5));
 
+    // queued calls are posted without locking the list, but count as well
+    QMetaObject::invokeMethod(&x, [] {}, Qt::QueuedConnection);
+    QMetaObject::invokeMethod(&x, [] {}, Qt::QueuedConnection);
+    QCOMPARE(qGlobalPostedEventsCount(), qsizetype(7));
+
     QCoreApplication::sendPostedEvents();
     QCOMPARE(qGlobalPostedEventsCount(), qsizetype(0));
 
-    const QList<qsizetype> expected = {4, 3, 2, 1, 0};
+    const QList<qsizetype> expected = {6, 5, 4, 3, 2};
     QCOMPARE(x.globalPostedEventsCount, expected);
 }
 #endif // QT_BUILD_INTERNAL
@@ -20,6 +20,7 @@ private slots:
     void removePostedEvents();
 #if QT_CONFIG(thread)
     void deliverInDefinedOrder();
+    void queuedCallsFromManyThreads();
 #endif
     void applicationPid();
 #ifdef QT_BUILD_INTERNAL
@@ -62,6 +62,8 @@ private slots:
     void connectReferenceToIncompleteTypes();
     void connectAutoQueuedIncomplete();
     void emitInDefinedOrder();
+    void queuedCallsInDefinedOrder();
+    void queuedCallsRaceWithRemovePostedEvents();
     void customTypes();
     void streamCustomTypes();
     void metamethod();
@@ -156,6 +158,10 @@ private slots:
     void declarativeData();
     void asyncCallbackHelper();
     void disconnectQueuedConnection_pendingEventsAreDelivered();
+    void batchedQueuedConnection();
+    void coalescedQueuedConnection();
+    void batchedQueuedConnectionFromOtherThread();
+    void batchedQueuedConnectionReceiverDeleted();
 };
 
 struct QObjectCreatedOnShutdown
@@ -1492,6 +1498,58 @@ void tst_QObject::emitInDefinedOrder()
     QVERIFY(!psender3);
 }
 
+void tst_QObject::queuedCallsInDefinedOrder()
+{
+    // The queued calls of an emission are posted before any slot is invoked
+    // directly, so they stay ahead of the events that such a slot posts.
+    SenderObject sender;
+    QObject receiver;
+    QList<int> calls;
+    connect(&sender, &SenderObject::signal1, &receiver, [&] { calls << 1; },
+            Qt::QueuedConnection);
+    connect(&sender, &SenderObject::signal1, &receiver, [&] { calls << 2; },
+            Qt::QueuedConnection);
+    connect(&sender, &SenderObject::signal1, &receiver, [&] {
+        QMetaObject::invokeMethod(&receiver, [&] { calls << 3; }, Qt::QueuedConnection);
+    }, Qt::DirectConnection);
+    connect(&sender, &SenderObject::signal1, &receiver, [&] { calls << 4; },
+            Qt::QueuedConnection);
+
+    sender.emitSignal1();
+    QVERIFY(calls.isEmpty());
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(calls, QList<int>({ 1, 2, 3, 4 }));
+}
+
+void tst_QObject::queuedCallsRaceWithRemovePostedEvents()
+{
+    // removePostedEvents() called from another thread waits for the
+    // emitting thread to finish posting a batch of queued calls, and must be
+    // woken up when it has.
+    QAtomicInt done = false;
+    SenderObject sender;
+    QObject receivers[10];
+    for (QObject &receiver : receivers)
+        connect(&sender, &SenderObject::signal1, &receiver, [] {}, Qt::QueuedConnection);
+
+    std::unique_ptr<QThread> thread(QThread::create([&] {
+        for (int i = 0; i < 100000; ++i) {
+            sender.emitSignal1();
+            if (i % 100 == 0)
+                QCoreApplication::sendPostedEvents();
+        }
+        done.storeRelease(true);
+    }));
+    sender.moveToThread(thread.get());
+    for (QObject &receiver : receivers)
+        receiver.moveToThread(thread.get());
+
+    thread->start();
+    for (int i = 0; !done.loadAcquire(); ++i)
+        QCoreApplication::removePostedEvents(&receivers[i % std::size(receivers)], QEvent::MetaCall);
+    QVERIFY(thread->wait(30000));
+}
+
 static int instanceCount = 0;
 
 struct CheckInstanceCount
@@ -8966,5 +9024,135 @@ void tst_QObject::disconnectQueuedConnection_pendingEventsAreDelivered()
     QTRY_COMPARE(receiver.count_slot1, 1);
 }
 
+static int postedMetaCalls(EventSpy &spy)
+{
+    const EventSpy::EventList events = spy.eventList();
+    return int(std::count_if(events.cbegin(), events.cend(), [](const auto &event) {
+        return event.second == QEvent::MetaCall;
+    }));
+}
+
+void tst_QObject::batchedQueuedConnection()
+{
+    SenderObject sender;
+    QObject receiver;
+    EventSpy spy;
+    receiver.installEventFilter(&spy);
+
+    QList<int> values;
+    connect(&sender, &SenderObject::signal7, &receiver, [&](int value, const QString &text) {
+        QCOMPARE(text, QString::number(value));
+        values << value;
+    }, Qt::BatchedQueuedConnection);
+    for (int i = 0; i < 10; ++i)
+        emit sender.signal7(i, QString::number(i));
+    QVERIFY(values.isEmpty());
+
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(values, QList<int>({ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+    QCOMPARE(postedMetaCalls(spy), 1);
+
+    // emissions after the delivery post a new event
+    emit sender.signal7(10, QString::number(10));
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(values.size(), 11);
+    QCOMPARE(values.last(), 10);
+    QCOMPARE(postedMetaCalls(spy), 2);
+
+    // string-based connections can be batched too
+    ReceiverObject stringReceiver;
+    stringReceiver.reset();
+    QVERIFY(connect(&sender, SIGNAL(signal1()), &stringReceiver, SLOT(slot1()),
+                    Qt::BatchedQueuedConnection));
+    sender.emitSignal1();
+    sender.emitSignal1();
+    QCOMPARE(stringReceiver.count_slot1, 0);
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(stringReceiver.count_slot1, 2);
+}
+
+void tst_QObject::coalescedQueuedConnection()
+{
+    SenderObject sender;
+    QObject receiver;
+    EventSpy spy;
+    receiver.installEventFilter(&spy);
+
+    QList<int> values;
+    connect(&sender, &SenderObject::signal7, &receiver, [&](int value, const QString &text) {
+        QCOMPARE(text, QString::number(value));
+        values << value;
+    }, Qt::CoalescedQueuedConnection);
+    for (int i = 0; i < 10; ++i)
+        emit sender.signal7(i, QString::number(i));
+    QVERIFY(values.isEmpty());
+
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(values, QList<int>({ 9 }));
+    QCOMPARE(postedMetaCalls(spy), 1);
+
+    // a single-shot connection is activated once
+    int singleShotCalls = 0;
+    connect(&sender, &SenderObject::signal1, &receiver, [&] { ++singleShotCalls; },
+            static_cast<Qt::ConnectionType>(Qt::CoalescedQueuedConnection
+                                            | Qt::SingleShotConnection));
+    sender.emitSignal1();
+    sender.emitSignal1();
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(singleShotCalls, 1);
+}
+
+void tst_QObject::batchedQueuedConnectionFromOtherThread()
+{
+    constexpr int Emissions = 1000;
+    SenderObject sender;
+    QObject batchedReceiver;
+    QObject coalescedReceiver;
+    QList<int> batched;
+    QList<int> coalesced;
+    connect(&sender, &SenderObject::signal7, &batchedReceiver,
+            [&](int value) { batched << value; }, Qt::BatchedQueuedConnection);
+    connect(&sender, &SenderObject::signal7, &coalescedReceiver,
+            [&](int value) { coalesced << value; }, Qt::CoalescedQueuedConnection);
+
+    QScopedPointer<QThread> thread(QThread::create([&sender] {
+        for (int i = 0; i < Emissions; ++i)
+            emit sender.signal7(i, QString());
+    }));
+    thread->start();
+    QVERIFY(thread->wait());
+
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(batched.size(), Emissions);
+    for (int i = 0; i < Emissions; ++i)
+        QCOMPARE(batched.at(i), i);
+    QCOMPARE(coalesced, QList<int>({ Emissions - 1 }));
+}
+
+void tst_QObject::batchedQueuedConnectionReceiverDeleted()
+{
+    SenderObject sender;
+    auto receiver = new QObject;
+    int calls = 0;
+    connect(&sender, &SenderObject::signal1, receiver, [&] {
+        ++calls;
+        delete receiver;
+    }, Qt::BatchedQueuedConnection);
+    sender.emitSignal1();
+    sender.emitSignal1();
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(calls, 1);
+
+    // pending calls are dropped with the receiver
+    receiver = new QObject;
+    connect(&sender, &SenderObject::signal1, receiver, [&] { ++calls; },
+            Qt::BatchedQueuedConnection);
+    sender.emitSignal1();
+    delete receiver;
+    sender.emitSignal1();
+    QCoreApplication::sendPostedEvents();
+    QCOMPARE(calls, 1);
+}
+
 QTEST_MAIN(tst_QObject)
 #include "tst_qobject.moc"
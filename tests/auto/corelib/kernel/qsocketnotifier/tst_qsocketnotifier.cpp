@@ -16,6 +16,7 @@
 #ifdef Q_OS_UNIX
 #include <private/qnet_unix_p.h>
 #include <sys/select.h>
+#include <sys/wait.h>
 #endif
 #include <limits>
 
@@ -35,6 +36,10 @@ private slots:
     void mixingWithTimers();
 #ifdef Q_OS_UNIX
     void posixSockets();
+    void levelTriggered();
+    void closedDescriptorReused();
+    void closedDescriptorReported();
+    void forkedChild();
 #endif
     void asyncMultipleDatagram();
     void activationReason_data();
@@ -337,6 +342,118 @@ void tst_QSocketNotifier::posixSockets()
     }
     qt_safe_close(posixSocket);
 }
+
+void tst_QSocketNotifier::levelTriggered()
+{
+    int fds[2];
+    QCOMPARE(qt_safe_pipe(fds, O_NONBLOCK), 0);
+
+    QSocketNotifier notifier(fds[0], QSocketNotifier::Read);
+    QSignalSpy spy(&notifier, &QSocketNotifier::activated);
+    QCOMPARE(qt_safe_write(fds[1], "x", 1), 1);
+
+    // the data is never read, so the notifier keeps firing
+    QTRY_COMPARE_GE(spy.size(), 3);
+
+    notifier.setEnabled(false);
+    qt_safe_close(fds[0]);
+    qt_safe_close(fds[1]);
+}
+
+void tst_QSocketNotifier::closedDescriptorReused()
+{
+    int first[2];
+    QCOMPARE(qt_safe_pipe(first, O_NONBLOCK), 0);
+    const int fd = first[0];
+    const int duplicate = qt_safe_dup(fd);
+    QVERIFY(duplicate >= 0);
+
+    {
+        // Close the descriptor before the notifier is disabled. The
+        // duplicate keeps the pipe open, and with it any registration the
+        // event dispatcher made for the descriptor.
+        QSocketNotifier notifier(fd, QSocketNotifier::Read);
+        qt_safe_close(fd);
+    }
+    QCOMPARE(qt_safe_write(first[1], "x", 1), 1);
+
+    // reuse the descriptor for the read end of an empty pipe
+    int second[2];
+    QCOMPARE(qt_safe_pipe(second, O_NONBLOCK), 0);
+    if (second[0] != fd) {
+        QVERIFY(qt_safe_dup2(second[0], fd) != -1);
+        qt_safe_close(second[0]);
+    }
+
+    QSocketNotifier notifier(fd, QSocketNotifier::Read);
+    QSignalSpy spy(&notifier, &QSocketNotifier::activated);
+    QTest::qWait(100);
+    QCOMPARE(spy.size(), 0);
+
+    QCOMPARE(qt_safe_write(second[1], "y", 1), 1);
+    QTRY_COMPARE_GE(spy.size(), 1);
+    char c;
+    QCOMPARE(qt_safe_read(fd, &c, 1), 1);
+    QCOMPARE(c, 'y');
+
+    notifier.setEnabled(false);
+    qt_safe_close(fd);
+    qt_safe_close(second[1]);
+    qt_safe_close(duplicate);
+    qt_safe_close(first[1]);
+}
+
+void tst_QSocketNotifier::closedDescriptorReported()
+{
+    int fds[2];
+    QCOMPARE(qt_safe_pipe(fds, O_NONBLOCK), 0);
+    const int duplicate = qt_safe_dup(fds[0]);
+    QVERIFY(duplicate >= 0);
+
+    // The duplicate keeps the pipe open, so that it can become readable
+    // after the descriptor the notifier watches has been closed.
+    QSocketNotifier notifier(fds[0], QSocketNotifier::Read);
+    QSignalSpy spy(&notifier, &QSocketNotifier::activated);
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("QSocketNotifier: Invalid socket \\d+"));
+    qt_safe_close(fds[0]);
+    QCOMPARE(qt_safe_write(fds[1], "x", 1), 1);
+
+    QTRY_VERIFY(!notifier.isEnabled());
+    QCOMPARE(spy.size(), 0);
+
+    qt_safe_close(duplicate);
+    qt_safe_close(fds[1]);
+}
+
+void tst_QSocketNotifier::forkedChild()
+{
+    int fds[2];
+    QCOMPARE(qt_safe_pipe(fds, O_NONBLOCK), 0);
+
+    QSocketNotifier notifier(fds[0], QSocketNotifier::Read);
+    QSignalSpy spy(&notifier, &QSocketNotifier::activated);
+    QCoreApplication::processEvents();
+
+    // The child disables the notifier it inherited, which must not affect
+    // the parent.
+    const pid_t pid = fork();
+    QVERIFY(pid != -1);
+    if (pid == 0) {
+        notifier.setEnabled(false);
+        QCoreApplication::processEvents();
+        _exit(0);
+    }
+    int status;
+    QCOMPARE(qt_safe_waitpid(pid, &status, 0), pid);
+    QVERIFY(WIFEXITED(status));
+
+    QCOMPARE(qt_safe_write(fds[1], "x", 1), 1);
+    QTRY_COMPARE_GE(spy.size(), 1);
+
+    notifier.setEnabled(false);
+    qt_safe_close(fds[0]);
+    qt_safe_close(fds[1]);
+}
 #endif
 
 void tst_QSocketNotifier::async_readDatagramSlot()
@@ -0,0 +1,415 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QTest>
+#include <QBuffer>
+#include <QJsonStreamReader>
+
+using namespace Qt::StringLiterals;
+
+class tst_QJsonStreamReader : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void tokens_data();
+    void tokens();
+    void incremental_data() { tokens_data(); }
+    void incremental();
+    void fromDevice_data() { tokens_data(); }
+    void fromDevice();
+    void errors_data();
+    void errors();
+    void numbers_data();
+    void numbers();
+    void nameEquals();
+    void skipCurrentElement();
+    void skipIncremental();
+    void largeDevice();
+    void sequentialDevice_data();
+    void sequentialDevice();
+    void finishInput();
+};
+
+// Describes every token the reader produces, e.g. "{ a=N(1) }"
+static QString dump(QJsonStreamReader &reader, bool *complete = nullptr)
+{
+    QStringList tokens;
+    for (;;) {
+        const QJsonStreamReader::TokenType type = reader.readNext();
+        if (type == QJsonStreamReader::NoToken || type == QJsonStreamReader::Invalid)
+            break;
+        QString token = reader.hasName() ? reader.name() + u'=' : QString();
+        switch (type) {
+        case QJsonStreamReader::StartArray: token += u'['; break;
+        case QJsonStreamReader::EndArray: token += u']'; break;
+        case QJsonStreamReader::StartObject: token += u'{'; break;
+        case QJsonStreamReader::EndObject: token += u'}'; break;
+        case QJsonStreamReader::String: token += "S("_L1 + reader.text() + u')'; break;
+        case QJsonStreamReader::Number: token += "N("_L1 + reader.text() + u')'; break;
+        case QJsonStreamReader::Bool: token += reader.toBool() ? "true"_L1 : "false"_L1; break;
+        case QJsonStreamReader::Null: token += "null"_L1; break;
+        default: break;
+        }
+        tokens << token;
+    }
+    if (complete)
+        *complete = reader.tokenType() == QJsonStreamReader::NoToken;
+    return tokens.join(u' ');
+}
+
+void tst_QJsonStreamReader::tokens_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<QString>("expected");
+
+    QTest::newRow("empty") << QByteArray() << QString();
+    QTest::newRow("whitespace") << QByteArray(" \n\t\r ") << QString();
+    QTest::newRow("true") << QByteArray("true") << u"true"_s;
+    QTest::newRow("number") << QByteArray("-12.5e3") << u"N(-12.5e3)"_s;
+    QTest::newRow("string") << QByteArray("\"hello\"") << u"S(hello)"_s;
+    QTest::newRow("empty-array") << QByteArray("[]") << u"[ ]"_s;
+    QTest::newRow("empty-object") << QByteArray(" { } ") << u"{ }"_s;
+    QTest::newRow("array") << QByteArray("[1, \"two\", false, null, [], {}]")
+                           << u"[ N(1) S(two) false null [ ] { } ]"_s;
+    QTest::newRow("object") << QByteArray("{\"a\": 1, \"b\": [true], \"c\": {\"d\": null}}")
+                            << u"{ a=N(1) b=[ true ] c={ d=null } }"_s;
+    QTest::newRow("escapes") << QByteArray(R"(["a\"b\\c\/d\b\f\n\r\t", "é😀"])")
+                             << u"[ S(a\"b\\c/d\b\f\n\r\t) S(é\U0001F600) ]"_s;
+    QTest::newRow("surrogates") << QByteArray(R"(["\u00e9\ud83d\ude00"])")
+                                << u"[ S(é\U0001F600) ]"_s;
+    QTest::newRow("escaped-key") << QByteArray(R"({"k\u0065y": 0})") << u"{ key=N(0) }"_s;
+    QTest::newRow("utf8") << QByteArray("[\"\xc3\xa9t\xc3\xa9\"]") << u"[ S(été) ]"_s;
+    QTest::newRow("ndjson") << QByteArray("{\"n\":1}\n{\"n\":2}\n[3]\n")
+                            << u"{ n=N(1) } { n=N(2) } [ N(3) ]"_s;
+}
+
+void tst_QJsonStreamReader::tokens()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QString, expected);
+
+    QJsonStreamReader reader(json);
+    bool complete = false;
+    QCOMPARE(dump(reader, &complete), expected);
+    QVERIFY2(complete, qPrintable(reader.errorString()));
+    QCOMPARE(reader.error(), QJsonStreamReader::NoError);
+    QVERIFY(reader.atEnd());
+}
+
+void tst_QJsonStreamReader::incremental()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QString, expected);
+
+    // feed one byte at a time; every token must come out exactly once
+    QJsonStreamReader reader;
+    QStringList tokens;
+    for (char c : std::as_const(json)) {
+        reader.addData(QByteArrayView(&c, 1));
+        const QString part = dump(reader);
+        if (!part.isEmpty())
+            tokens << part;
+        QVERIFY(reader.error() != QJsonStreamReader::NotWellFormedError);
+    }
+    // a top-level number only ends with the next character
+    reader.addData("\n");
+    const QString rest = dump(reader);
+    if (!rest.isEmpty())
+        tokens << rest;
+    QCOMPARE(tokens.join(u' '), expected);
+}
+
+void tst_QJsonStreamReader::fromDevice()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QString, expected);
+
+    QBuffer buffer(&json);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QJsonStreamReader reader(&buffer);
+    bool complete = false;
+    QCOMPARE(dump(reader, &complete), expected);
+    QVERIFY2(complete, qPrintable(reader.errorString()));
+}
+
+void tst_QJsonStreamReader::errors_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<QJsonParseError::ParseError>("error");
+    QTest::addColumn<QString>("tokensBefore");
+
+    QTest::newRow("bad-value") << QByteArray("[x]") << QJsonParseError::IllegalValue << u"["_s;
+    QTest::newRow("bad-literal") << QByteArray("[tru]") << QJsonParseError::IllegalValue << u"["_s;
+    QTest::newRow("literal-garbage") << QByteArray("[truex]") << QJsonParseError::IllegalValue
+                                     << u"["_s;
+    QTest::newRow("leading-zero") << QByteArray("[01]") << QJsonParseError::IllegalNumber << u"["_s;
+    QTest::newRow("bare-minus") << QByteArray("[-]") << QJsonParseError::IllegalNumber << u"["_s;
+    QTest::newRow("bad-fraction") << QByteArray("[1.]") << QJsonParseError::IllegalNumber << u"["_s;
+    QTest::newRow("missing-comma") << QByteArray("[1 2]") << QJsonParseError::UnterminatedArray
+                                   << u"[ N(1)"_s;
+    QTest::newRow("trailing-comma") << QByteArray("[1,]") << QJsonParseError::IllegalValue
+                                    << u"[ N(1)"_s;
+    QTest::newRow("object-trailing-comma") << QByteArray("{\"a\":1,}")
+                                           << QJsonParseError::MissingObject << u"{ a=N(1)"_s;
+    QTest::newRow("missing-colon") << QByteArray("{\"a\" 1}") << QJsonParseError::MissingNameSeparator
+                                   << u"{"_s;
+    QTest::newRow("non-string-key") << QByteArray("{1:2}") << QJsonParseError::IllegalValue << u"{"_s;
+    QTest::newRow("mismatched") << QByteArray("[1}") << QJsonParseError::UnterminatedArray
+                                << u"[ N(1)"_s;
+    QTest::newRow("bad-escape") << QByteArray(R"(["\x"])") << QJsonParseError::IllegalEscapeSequence
+                                << u"["_s;
+    QTest::newRow("bad-unicode-escape") << QByteArray(R"(["\u12g4"])")
+                                        << QJsonParseError::IllegalEscapeSequence << u"["_s;
+    QTest::newRow("bad-utf8") << QByteArray("[\"\xff\"]") << QJsonParseError::IllegalUTF8String
+                              << u"["_s;
+    QTest::newRow("deep") << QByteArray(2000, '[') << QJsonParseError::DeepNesting
+                          << QStringList(1024, u"["_s).join(u' ');
+}
+
+void tst_QJsonStreamReader::errors()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QJsonParseError::ParseError, error);
+    QFETCH(QString, tokensBefore);
+
+    QJsonStreamReader reader(json);
+    QCOMPARE(dump(reader), tokensBefore);
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::Invalid);
+    QCOMPARE(reader.error(), QJsonStreamReader::NotWellFormedError);
+    QCOMPARE(reader.parseError(), error);
+    QVERIFY(!reader.errorString().isEmpty());
+    QVERIFY(reader.offset() >= 0 && reader.offset() <= json.size());
+    QVERIFY(reader.atEnd());
+
+    // errors are fatal
+    reader.addData("[]");
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Invalid);
+}
+
+void tst_QJsonStreamReader::numbers_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<double>("value");
+    QTest::addColumn<qint64>("integer");
+
+    QTest::newRow("zero") << QByteArray("0") << 0.0 << qint64(0);
+    QTest::newRow("negative") << QByteArray("-42") << -42.0 << qint64(-42);
+    QTest::newRow("fraction") << QByteArray("1.5") << 1.5 << qint64(-1);
+    QTest::newRow("exponent") << QByteArray("2e3") << 2000.0 << qint64(2000);
+    QTest::newRow("max") << QByteArray("9223372036854775807") << 9223372036854775807.0
+                         << std::numeric_limits<qint64>::max();
+    QTest::newRow("huge") << QByteArray("1e300") << 1e300 << qint64(-1);
+}
+
+void tst_QJsonStreamReader::numbers()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(double, value);
+    QFETCH(qint64, integer);
+
+    QJsonStreamReader reader(json);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QCOMPARE(reader.toDouble(), value);
+    QCOMPARE(reader.toInteger(-1), integer);
+    QCOMPARE(reader.rawToken(), json);
+}
+
+void tst_QJsonStreamReader::nameEquals()
+{
+    QJsonStreamReader reader(R"({"plain": 1, "esc\u0061ped": 2, "\u00e9": 3})"_ba);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartObject);
+    QVERIFY(!reader.hasName());
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QVERIFY(reader.nameEquals("plain"));
+    QVERIFY(!reader.nameEquals("plai"));
+    QVERIFY(!reader.nameEquals("plainer"));
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QVERIFY(reader.nameEquals("escaped"));
+    QCOMPARE(reader.rawToken(), "2");
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QVERIFY(reader.nameEquals(u8"é"));
+    QCOMPARE(reader.name(), u"é"_s);
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndObject);
+    QVERIFY(!reader.nameEquals("plain"));
+}
+
+void tst_QJsonStreamReader::skipCurrentElement()
+{
+    const QByteArray json = R"({"skip": {"a": ["]", "}", "\"]"], "b": {"c": [[], {}]}},)"
+                            R"( "keep": 1, "list": [1, 2, 3], "last": true})"_ba;
+    QJsonStreamReader reader(json);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartObject);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartObject);
+    QVERIFY(reader.nameEquals("skip"));
+    QCOMPARE(reader.depth(), 2);
+    QVERIFY(reader.skipCurrentElement());
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::EndObject);
+    QCOMPARE(reader.depth(), 1);
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QVERIFY(reader.nameEquals("keep"));
+    QVERIFY(reader.skipCurrentElement());   // no-op for scalars
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::Number);
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+    QVERIFY(reader.skipCurrentElement());
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::EndArray);
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Bool);
+    QVERIFY(reader.nameEquals("last"));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndObject);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::NoToken);
+    QCOMPARE(reader.error(), QJsonStreamReader::NoError);
+}
+
+void tst_QJsonStreamReader::skipIncremental()
+{
+    const QByteArray json = R"([{"x": ["[", {"y": "\\"}]}, 7])"_ba;
+    QJsonStreamReader reader;
+    reader.addData(json.first(2));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartObject);
+
+    qsizetype fed = 2;
+    bool skipped = reader.skipCurrentElement();
+    while (!skipped) {
+        QCOMPARE(reader.error(), QJsonStreamReader::PrematureEndOfDocumentError);
+        QVERIFY(fed < json.size());
+        reader.addData(json.sliced(fed++, 1));
+        skipped = reader.skipCurrentElement();
+    }
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::EndObject);
+
+    reader.addData(json.sliced(fed));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QCOMPARE(reader.toInteger(), 7);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndArray);
+}
+
+void tst_QJsonStreamReader::largeDevice()
+{
+    // many records, each with a string larger than the reader's read chunk
+    QByteArray json;
+    const QByteArray big(40000, 'x');
+    for (int i = 0; i < 50; ++i)
+        json += "{\"id\": " + QByteArray::number(i) + ", \"payload\": \"" + big + "\"}\n";
+
+    QBuffer buffer(&json);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QJsonStreamReader reader(&buffer);
+    int records = 0;
+    while (reader.readNext() == QJsonStreamReader::StartObject) {
+        QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+        QCOMPARE(reader.toInteger(), records);
+        QCOMPARE(reader.readNext(), QJsonStreamReader::String);
+        QVERIFY(reader.nameEquals("payload"));
+        QCOMPARE(reader.rawToken().size(), big.size());
+        QCOMPARE(reader.readNext(), QJsonStreamReader::EndObject);
+        ++records;
+    }
+    QCOMPARE(reader.error(), QJsonStreamReader::NoError);
+    QCOMPARE(records, 50);
+}
+
+// A device that behaves like a socket: sequential, and once closed by the
+// peer, read() returns -1 after the remaining data has been read
+class SequentialDevice : public QIODevice
+{
+public:
+    explicit SequentialDevice(const QByteArray &data) : data(data) {}
+    bool isSequential() const override { return true; }
+    qint64 bytesAvailable() const override
+    {
+        return data.size() - offset + QIODevice::bytesAvailable();
+    }
+    bool peerClosed = false;
+
+protected:
+    qint64 readData(char *buffer, qint64 maxSize) override
+    {
+        const qint64 n = qMin(maxSize, qint64(data.size() - offset));
+        memcpy(buffer, data.constData() + offset, size_t(n));
+        offset += n;
+        return n == 0 && maxSize && peerClosed ? -1 : n;
+    }
+    qint64 writeData(const char *, qint64) override { return -1; }
+
+private:
+    QByteArray data;
+    qsizetype offset = 0;
+};
+
+void tst_QJsonStreamReader::sequentialDevice_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<QString>("expected");
+
+    QTest::newRow("number") << "42"_ba << u"N(42)"_s;
+    QTest::newRow("literal") << "true"_ba << u"true"_s;
+    QTest::newRow("values") << "1 2\n3"_ba << u"N(1) N(2) N(3)"_s;
+    QTest::newRow("array") << "[1]"_ba << u"[ N(1) ]"_s;
+}
+
+void tst_QJsonStreamReader::sequentialDevice()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QString, expected);
+
+    SequentialDevice device(json);
+    QVERIFY(device.open(QIODevice::ReadOnly));
+    QJsonStreamReader reader(&device);
+
+    // the peer may still send more digits
+    bool complete = false;
+    QString tokens = dump(reader, &complete);
+    if (!complete) {
+        QCOMPARE(reader.error(), QJsonStreamReader::PrematureEndOfDocumentError);
+        device.peerClosed = true;
+        const QString rest = dump(reader, &complete);
+        if (!rest.isEmpty())
+            tokens += (tokens.isEmpty() ? u""_s : u" "_s) + rest;
+    }
+    QCOMPARE(tokens, expected);
+    QVERIFY2(complete, qPrintable(reader.errorString()));
+    QVERIFY(reader.atEnd());
+}
+
+void tst_QJsonStreamReader::finishInput()
+{
+    QJsonStreamReader reader;
+    reader.addData("1 2");
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Invalid);
+    QCOMPARE(reader.error(), QJsonStreamReader::PrematureEndOfDocumentError);
+    reader.finishInput();
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QCOMPARE(reader.toInteger(), 2);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::NoToken);
+    QVERIFY(reader.atEnd());
+
+    // a device that has no more data now but cannot tell whether more follows
+    SequentialDevice device("[1] null");
+    QVERIFY(device.open(QIODevice::ReadOnly));
+    reader.setDevice(&device);
+    QCOMPARE(dump(reader), u"[ N(1) ]"_s);
+    QCOMPARE(reader.error(), QJsonStreamReader::PrematureEndOfDocumentError);
+    reader.finishInput();
+    bool complete = false;
+    QCOMPARE(dump(reader, &complete), u"null"_s);
+    QVERIFY(complete);
+
+    // unfinished values stay errors
+    reader.clear();
+    reader.addData("[1");
+    reader.finishInput();
+    QCOMPARE(dump(reader), u"["_s);
+    QCOMPARE(reader.error(), QJsonStreamReader::PrematureEndOfDocumentError);
+}
+
+QTEST_APPLESS_MAIN(tst_QJsonStreamReader)
+#include "tst_qjsonstreamreader.moc"
@@ -0,0 +1,223 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QTest>
+#include <private/qcomparisontesthelper_p.h>
+
+#include <qanystringview.h>
+#include <qhash.h>
+#include <qsmallstring.h>
+#include <qstring.h>
+
+#include <utility>
+
+using namespace Qt::StringLiterals;
+
+class tst_QSmallString : public QObject
+{
+    Q_OBJECT
+private slots:
+    void defaultConstructed();
+    void construct_data();
+    void construct();
+    void copyAndMove_data() { construct_data(); }
+    void copyAndMove();
+    void swap();
+    void append();
+    void appendToItself();
+    void clear();
+    void compare();
+    void views();
+    void hash();
+};
+
+static bool isStoredInline(const QSmallString &s)
+{
+    const auto begin = reinterpret_cast<const char *>(&s);
+    const auto data = reinterpret_cast<const char *>(s.constData());
+    return data >= begin && data < begin + sizeof(s);
+}
+
+void tst_QSmallString::defaultConstructed()
+{
+    QSmallString s;
+    QVERIFY(s.isEmpty());
+    QCOMPARE(s.size(), 0);
+    QCOMPARE(s.utf16()[0], u'\0');
+    QCOMPARE(s.begin(), s.end());
+    QVERIFY(s.toString().isEmpty());
+    QVERIFY(isStoredInline(s));
+}
+
+void tst_QSmallString::construct_data()
+{
+    QTest::addColumn<QString>("string");
+
+    QTest::newRow("empty") << QString();
+    QTest::newRow("short") << u"id"_s;
+    QTest::newRow("full") << QString(QSmallString::InlineCapacity, u'f');
+    QTest::newRow("long") << QString(QSmallString::InlineCapacity + 1, u'l');
+    QTest::newRow("longer") << QString(1000, u'x');
+    // sets bits of QString's size that a 32-bit inline string uses for its size
+    QTest::newRow("huge") << QString(70000, u'h');
+}
+
+void tst_QSmallString::construct()
+{
+    QFETCH(QString, string);
+    const bool fits = string.size() <= QSmallString::InlineCapacity;
+
+    const QSmallString fromView(QStringView{string});
+    const QSmallString fromString(string);
+    QString moved = string;
+    const QSmallString fromRvalue(std::move(moved));
+    const QByteArray latin1 = string.toLatin1();
+    const QSmallString fromLatin1(QLatin1StringView{latin1});
+
+    for (const QSmallString *s : { &fromView, &fromString, &fromRvalue, &fromLatin1 }) {
+        QCOMPARE(s->size(), string.size());
+        QCOMPARE(s->toString(), string);
+        QCOMPARE(s->view(), string);
+        QCOMPARE(s->utf16()[s->size()], u'\0');
+        QCOMPARE(isStoredInline(*s), fits);
+    }
+
+    // long strings share the data of the QString
+    if (!fits)
+        QCOMPARE(fromString.constData(), string.constData());
+}
+
+void tst_QSmallString::copyAndMove()
+{
+    QFETCH(QString, string);
+
+    const QSmallString original(string);
+    QSmallString copy = original;
+    QCOMPARE(copy, original);
+    QCOMPARE(copy.toString(), string);
+
+    QSmallString moved = std::move(copy);
+    QCOMPARE(moved, original);
+
+    QSmallString assigned(u"something else"_s);
+    assigned = original;
+    QCOMPARE(assigned, original);
+    assigned = u"x"_s;
+    QCOMPARE(assigned, u"x"_s);
+    assigned = std::move(moved);
+    QCOMPARE(assigned, original);
+    assigned = QStringView(u"view");
+    QCOMPARE(assigned, u"view"_s);
+}
+
+void tst_QSmallString::swap()
+{
+    const QString longString(100, u'l');
+    QSmallString a(u"short"_s);
+    QSmallString b(longString);
+    QSmallString c(u"tiny"_s);
+
+    a.swap(b);
+    QCOMPARE(a, longString);
+    QCOMPARE(b, u"short"_s);
+    QVERIFY(isStoredInline(b));
+
+    b.swap(c);
+    QCOMPARE(b, u"tiny"_s);
+    QCOMPARE(c, u"short"_s);
+
+    a.swap(c);
+    QCOMPARE(a, u"short"_s);
+    QCOMPARE(c, longString);
+    QVERIFY(isStoredInline(a));
+}
+
+void tst_QSmallString::append()
+{
+    QSmallString s;
+    s.append(u"he");
+    s += u'l';
+    QCOMPARE(s, u"hel"_s);
+    QVERIFY(isStoredInline(s));
+
+    const QString text = u"hello world! and more"_s;
+    s += QStringView(text).sliced(3, QSmallString::InlineCapacity - 3);
+    QCOMPARE(s, text.first(QSmallString::InlineCapacity));
+    QCOMPARE(s.size(), QSmallString::InlineCapacity);
+    QVERIFY(isStoredInline(s));
+
+    s.append(text.at(QSmallString::InlineCapacity));
+    QCOMPARE(s, text.first(QSmallString::InlineCapacity + 1));
+    QVERIFY(!isStoredInline(s));
+    s.append(QStringView(text).sliced(QSmallString::InlineCapacity + 1));
+    QCOMPARE(s, text);
+    s.append(QStringView());
+    QCOMPARE(s.size(), 21);
+}
+
+void tst_QSmallString::appendToItself()
+{
+    QSmallString s(u"abc"_s);
+    s.append(s.view());
+    QCOMPARE(s, u"abcabc"_s);
+    s.append(s.view());
+    QCOMPARE(s, u"abcabcabcabc"_s);
+    s.append(s.view());
+    QCOMPARE(s.toString(), QString(u"abc"_s).repeated(8));
+}
+
+void tst_QSmallString::clear()
+{
+    QSmallString s(QString(50, u'x'));
+    s.clear();
+    QVERIFY(s.isEmpty());
+    QVERIFY(isStoredInline(s));
+    s.append(u"again");
+    QCOMPARE(s, u"again"_s);
+}
+
+void tst_QSmallString::compare()
+{
+    const QSmallString a(u"apple"_s);
+    const QSmallString b(u"banana"_s);
+    const QSmallString longB(u"banana and more bananas"_s);
+
+    QT_TEST_ALL_COMPARISON_OPS(a, b, Qt::strong_ordering::less);
+    QT_TEST_ALL_COMPARISON_OPS(b, longB, Qt::strong_ordering::less);
+    QT_TEST_ALL_COMPARISON_OPS(a, QSmallString(u"apple"_s), Qt::strong_ordering::equal);
+    QT_TEST_ALL_COMPARISON_OPS(a, u"apple"_s, Qt::strong_ordering::equal);
+    QT_TEST_ALL_COMPARISON_OPS(a, QStringView(u"apricot"), Qt::strong_ordering::less);
+    QT_TEST_ALL_COMPARISON_OPS(b, "apple"_L1, Qt::strong_ordering::greater);
+    QVERIFY(u"apple"_s == a);
+    QVERIFY(a == u"apple");
+}
+
+static qsizetype sizeOfAny(QAnyStringView s) { return s.size(); }
+static qsizetype sizeOfView(QStringView s) { return s.size(); }
+
+void tst_QSmallString::views()
+{
+    const QSmallString s(u"identifier"_s);
+    QCOMPARE(sizeOfView(s), 10);
+    QCOMPARE(sizeOfAny(s), 10);
+    QCOMPARE(QStringView(s).indexOf(u'f'), 6);
+    QCOMPARE(QAnyStringView(s), u"identifier"_s);
+    QCOMPARE(s.at(0), u'i');
+    QCOMPARE(s[9], u'r');
+}
+
+void tst_QSmallString::hash()
+{
+    const QString longString(30, u'h');
+    QCOMPARE(qHash(QSmallString(u"key"_s), 42), qHash(u"key"_s, 42));
+    QCOMPARE(qHash(QSmallString(longString), 42), qHash(longString, 42));
+
+    QHash<QSmallString, int> hash;
+    hash.insert(QSmallString(u"one"_s), 1);
+    hash.insert(QSmallString(longString), 2);
+    QCOMPARE(hash.value(QSmallString(u"one"_s)), 1);
+    QCOMPARE(hash.value(QSmallString(longString)), 2);
+}
+
+QTEST_APPLESS_MAIN(tst_QSmallString)
+#include "tst_qsmallstring.moc"
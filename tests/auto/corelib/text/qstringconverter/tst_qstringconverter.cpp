@@ -167,6 +167,8 @@ private slots:
 #endif
 
     void flagF7808080() const;
+    void utf8LongText_data();
+    void utf8LongText();
 
     void utf8Codec_data();
     void utf8Codec();
@@ -794,6 +796,78 @@ void tst_QStringConverter::flagF7808080() const
     QCOMPARE(decoder(input), QString(input.size(), QChar(0)));
 }
 
+void tst_QStringConverter::utf8LongText_data()
+{
+    QTest::addColumn<QString>("utf16");
+    QTest::addColumn<QByteArray>("utf8");
+
+    auto addRow = [](const char *name, QUtf8StringView utf8, QStringView utf16) {
+        // long enough for the vectorized code paths
+        QTest::newRow(name) << utf16.toString().repeated(3)
+                            << QByteArray(utf8.data(), utf8.size()).repeated(3);
+    };
+#define ROW(name, string)       addRow(name, u8"" string, u"" string)
+    ROW("latin1", "Hyvää päivää, käyhän että tuon kannettavani saunaan? ");
+    ROW("greek", "Ξεσκεπάζω την ψυχοφθόρα βδελυγμία. ");
+    ROW("cyrillic", "Съешь же ещё этих мягких французских булок, да выпей чаю. ");
+    ROW("hebrew", "דג סקרן שט בים מאוכזב ולפתע מצא חברה. ");
+    ROW("chinese", "我能吞下玻璃而不伤身体。");
+    ROW("japanese", "私はガラスを食べられます。それは私を傷つけません。");
+    ROW("korean", "나는 유리를 먹을 수 있어요. 그래도 아프지 않아요. ");
+    ROW("mixed", "Qt 6 — ✓ données, данные, 数据 und Daten. ");
+    ROW("mixed-emoji", "😂, 😃, 🧘🏻‍♂️, 🌍, 🌦️, 数据 данные 🍞, 🚗, 📞, 🎉, ❤️, 🏁 ");
+    ROW("supplementary", "\U00010203\U0001f000𝄞\U0010fffd");
+#undef ROW
+}
+
+void tst_QStringConverter::utf8LongText()
+{
+    QFETCH(QString, utf16);
+    QFETCH(QByteArray, utf8);
+
+    QCOMPARE(QString::fromUtf8(utf8), utf16);
+    QCOMPARE(utf16.toUtf8(), utf8);
+
+    QStringDecoder decoder(QStringConverter::Utf8);
+    QCOMPARE(QString(decoder(utf8)), utf16);
+    QVERIFY(!decoder.hasError());
+    QStringEncoder encoder(QStringConverter::Utf8);
+    QCOMPARE(QByteArray(encoder(utf16)), utf8);
+
+    // Invalid input anywhere in the text must be treated exactly as if it
+    // were decoded on its own. Every sequence is followed by an ASCII
+    // character so that it is terminated the same way in both cases.
+    static const char *const invalidSequences[] = {
+        "\x80", "\xbf\x80", "\xc0\xaf", "\xc1\xbf", "\xc2", "\xdf\xdf",
+        "\xe0\x80\xaf", "\xe0\x9f\xbf", "\xe4\xb8", "\xe4\xb8\xe4\xb8\xad",
+        "\xed\xa0\x80", "\xed\xbf\xbf", "\xf0\x80\x80\xaf", "\xf0\x9f\x98",
+        "\xf4\x90\x80\x80", "\xf5\x80\x80\x80", "\xfe", "\xff",
+    };
+    for (qsizetype i = 0; i < utf16.size() / 2; ++i) {
+        if (utf16.at(i).isLowSurrogate())
+            continue;
+        const QString head = utf16.first(i);
+        const QString tail = utf16.sliced(i);
+        const QByteArray headUtf8 = head.toUtf8();
+        const QByteArray tailUtf8 = tail.toUtf8();
+        QCOMPARE(headUtf8 + tailUtf8, utf8);
+
+        for (const char *sequence : invalidSequences) {
+            const QByteArray invalid = QByteArray(sequence) + 'x';
+            QCOMPARE(QString::fromUtf8(headUtf8 + invalid + tailUtf8),
+                     head + QString::fromUtf8(invalid) + tail);
+        }
+
+        // unpaired surrogates
+        const QByteArray replacement = "\xef\xbf\xbd";
+        QStringEncoder encoder(QStringConverter::Utf8);
+        QCOMPARE(QByteArray(encoder(head + QChar(0xd800) + u'x' + tail)),
+                 headUtf8 + replacement + 'x' + tailUtf8);
+        QCOMPARE(QByteArray(encoder(head + QChar(0xdc00) + tail)),
+                 headUtf8 + replacement + tailUtf8);
+    }
+}
+
 static QString fromInvalidUtf8Sequence(const QByteArray &ba)
 {
     return QString().fill(QChar::ReplacementCharacter, ba.size());
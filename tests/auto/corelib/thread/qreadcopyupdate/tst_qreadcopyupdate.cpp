@@ -0,0 +1,176 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QTest>
+
+#include <qhash.h>
+#include <qlist.h>
+#include <qreadcopyupdate.h>
+#include <qstring.h>
+#include <qthread.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class tst_QReadCopyUpdate : public QObject
+{
+    Q_OBJECT
+private slots:
+    void defaultConstructed();
+    void constructWithValue();
+    void store();
+    void update();
+    void snapshotOutlivesStore();
+    void nestedSnapshots();
+    void reclamation();
+    void concurrentReadersAndWriters();
+};
+
+struct Counted
+{
+    static std::atomic<int> alive;
+
+    Counted(int v = 0) : value(v) { ++alive; }
+    Counted(const Counted &other) : value(other.value) { ++alive; }
+    ~Counted() { --alive; }
+    Counted &operator=(const Counted &other) = default;
+
+    int value;
+};
+
+std::atomic<int> Counted::alive = 0;
+
+void tst_QReadCopyUpdate::defaultConstructed()
+{
+    QReadCopyUpdate<int> rcu;
+    QCOMPARE(rcu.load(), 0);
+    QCOMPARE(*rcu.read(), 0);
+
+    QReadCopyUpdate<QString> string;
+    QVERIFY(string.read()->isNull());
+}
+
+void tst_QReadCopyUpdate::constructWithValue()
+{
+    QReadCopyUpdate<QString> rcu(QStringLiteral("hello"));
+    QCOMPARE(rcu.load(), QStringLiteral("hello"));
+    QCOMPARE(rcu.read()->size(), 5);
+
+    auto list = QList<int>{ 1, 2, 3 };
+    QReadCopyUpdate<QList<int>> moved(std::move(list));
+    QCOMPARE(moved.load(), QList<int>({ 1, 2, 3 }));
+}
+
+void tst_QReadCopyUpdate::store()
+{
+    QReadCopyUpdate<QString> rcu;
+    rcu.store(QStringLiteral("a"));
+    QCOMPARE(rcu.load(), QStringLiteral("a"));
+
+    const QString b = QStringLiteral("b");
+    rcu.store(b);
+    QCOMPARE(rcu.load(), b);
+}
+
+void tst_QReadCopyUpdate::update()
+{
+    QReadCopyUpdate<QHash<int, int>> rcu;
+    for (int i = 0; i < 10; ++i)
+        rcu.update([i](QHash<int, int> &hash) { hash.insert(i, i * i); });
+
+    const auto snapshot = rcu.read();
+    QCOMPARE(snapshot->size(), 10);
+    QCOMPARE(snapshot->value(9), 81);
+}
+
+void tst_QReadCopyUpdate::snapshotOutlivesStore()
+{
+    QReadCopyUpdate<QString> rcu(QStringLiteral("old"));
+    const auto snapshot = rcu.read();
+    const QString *old = snapshot.get();
+
+    rcu.store(QStringLiteral("new"));
+    rcu.update([](QString &s) { s.append(QLatin1String("er")); });
+
+    // the snapshot still sees the value it was taken from
+    QCOMPARE(snapshot.get(), old);
+    QCOMPARE(*snapshot, QStringLiteral("old"));
+    QCOMPARE(rcu.load(), QStringLiteral("newer"));
+}
+
+void tst_QReadCopyUpdate::nestedSnapshots()
+{
+    QReadCopyUpdate<int> a(1);
+    QReadCopyUpdate<int> b(2);
+    const auto outer = a.read();
+    {
+        const auto inner = b.read();
+        QCOMPARE(*outer + *inner, 3);
+    }
+    a.store(10);
+    QCOMPARE(*outer, 1);
+    QCOMPARE(*a.read(), 10);
+}
+
+void tst_QReadCopyUpdate::reclamation()
+{
+    const int aliveBefore = Counted::alive;
+    {
+        QReadCopyUpdate<Counted> rcu;
+        for (int i = 0; i < 10000; ++i)
+            rcu.update([i](Counted &c) { c.value = i; });
+        QCOMPARE(rcu.read()->value, 9999);
+
+        // replaced values must not pile up
+        QCOMPARE_LT(Counted::alive - aliveBefore, 1000);
+    }
+}
+
+void tst_QReadCopyUpdate::concurrentReadersAndWriters()
+{
+    // Writers keep both halves of the pair equal; readers must never see a
+    // torn or deleted value.
+    struct Pair
+    {
+        std::vector<int> first;
+        std::vector<int> second;
+    };
+    QReadCopyUpdate<Pair> rcu;
+    std::atomic<bool> done = false;
+    std::atomic<int> failures = 0;
+
+    std::vector<std::unique_ptr<QThread>> threads;
+    for (int r = 0; r < 4; ++r) {
+        threads.emplace_back(QThread::create([&] {
+            while (!done.load(std::memory_order_relaxed)) {
+                const auto snapshot = rcu.read();
+                if (snapshot->first != snapshot->second)
+                    ++failures;
+            }
+        }));
+    }
+    for (int w = 0; w < 2; ++w) {
+        threads.emplace_back(QThread::create([&] {
+            for (int i = 0; i < 2000; ++i) {
+                rcu.update([i](Pair &p) {
+                    p.first.push_back(i);
+                    p.second.push_back(i);
+                });
+            }
+        }));
+    }
+    for (auto &t : threads)
+        t->start();
+    for (size_t i = 4; i < threads.size(); ++i)
+        QVERIFY(threads[i]->wait());
+    done = true;
+    for (size_t i = 0; i < 4; ++i)
+        QVERIFY(threads[i]->wait());
+
+    QCOMPARE(failures.load(), 0);
+    QCOMPARE(rcu.read()->first.size(), 4000u);
+}
+
+QTEST_APPLESS_MAIN(tst_QReadCopyUpdate)
+#include "tst_qreadcopyupdate.moc"
@@ -76,6 +76,9 @@ private slots:
     void tryStartCount();
     void priorityStart_data();
     void priorityStart();
+    void localQueueOrder();
+    void localQueuePriority();
+    void localQueueReleaseThread();
     void waitForDone();
     void clear();
     void clearWithAutoDelete();
@@ -1046,6 +1049,99 @@ void tst_QThreadPool::priorityStart()
     QCOMPARE(firstStarted.loadRelaxed(), expected);
 }
 
+void tst_QThreadPool::localQueueOrder()
+{
+    constexpr int Count = 1000;
+    QSemaphore sem;
+    QMutex mutex;
+    QList<int> order;
+    TestThreadPool threadPool;
+    threadPool.setMaxThreadCount(1);
+
+    // the only thread takes the runnables in batches
+    threadPool.start([&sem] { sem.acquire(); });
+    for (int i = 0; i < Count; ++i) {
+        threadPool.start([&mutex, &order, i] {
+            QMutexLocker locker(&mutex);
+            order.append(i);
+        });
+    }
+    sem.release();
+    WAIT_FOR_DONE(threadPool);
+
+    QCOMPARE(order.size(), Count);
+    for (int i = 0; i < Count; ++i)
+        QCOMPARE(order.at(i), i);
+}
+
+void tst_QThreadPool::localQueuePriority()
+{
+    constexpr int Count = 100;
+    constexpr int Urgent = -1;
+    QSemaphore started;
+    QSemaphore proceed;
+    QMutex mutex;
+    QList<int> order;
+    TestThreadPool threadPool;
+    threadPool.setMaxThreadCount(1);
+
+    // hold the thread back until all runnables are queued
+    threadPool.start([&proceed] { proceed.acquire(); });
+    for (int i = 0; i < Count; ++i) {
+        threadPool.start([&, i] {
+            if (i == 0) {
+                // the rest of the batch is in the local queue by now
+                started.release();
+                proceed.acquire();
+            }
+            QMutexLocker locker(&mutex);
+            order.append(i);
+        });
+    }
+    proceed.release();
+    QVERIFY(started.tryAcquire(1, 10s));
+
+    // runs before what is left of the batch
+    threadPool.start([&] {
+        QMutexLocker locker(&mutex);
+        order.append(Urgent);
+    }, 1);
+    proceed.release();
+    WAIT_FOR_DONE(threadPool);
+
+    QCOMPARE(order.size(), Count + 1);
+    QCOMPARE(order.at(0), 0);
+    QCOMPARE(order.at(1), Urgent);
+    for (int i = 1; i < Count; ++i)
+        QCOMPARE(order.at(i + 1), i);
+}
+
+void tst_QThreadPool::localQueueReleaseThread()
+{
+    // A runnable that releases its thread to wait for the runnables queued
+    // after it must not deadlock, even though its own thread took those into
+    // its local queue.
+    QSemaphore proceed;
+    QSemaphore done;
+    QAtomicInt waited = false;
+    TestThreadPool threadPool;
+    threadPool.setMaxThreadCount(1);
+
+    // hold the thread back until all runnables are queued
+    threadPool.start([&proceed] { proceed.acquire(); });
+    threadPool.start([&] {
+        threadPool.releaseThread();
+        waited.storeRelaxed(done.tryAcquire(3, 10s));
+        threadPool.reserveThread();
+    });
+    for (int i = 0; i < 3; ++i)
+        threadPool.start([&done] { done.release(); });
+    proceed.release();
+    WAIT_FOR_DONE(threadPool);
+
+    QVERIFY(waited.loadRelaxed());
+}
+
 void tst_QThreadPool::waitForDone()
 {
     QElapsedTimer total, pass;
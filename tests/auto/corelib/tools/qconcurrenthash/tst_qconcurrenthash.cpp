@@ -0,0 +1,276 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QTest>
+
+#include <qconcurrenthash.h>
+#include <qstring.h>
+#include <qthread.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class tst_QConcurrentHash : public QObject
+{
+    Q_OBJECT
+private slots:
+    void empty();
+    void insert();
+    void tryInsert();
+    void remove();
+    void clear();
+    void reserve();
+    void growth();
+    void stringKeys();
+    void movedValues();
+    void reclamation();
+    void concurrentReadersAndWriters();
+    void concurrentInsertSameKeys();
+};
+
+struct Counted
+{
+    static std::atomic<int> alive;
+
+    Counted(int v = 0) : value(v) { ++alive; }
+    Counted(const Counted &other) : value(other.value) { ++alive; }
+    ~Counted() { --alive; }
+    Counted &operator=(const Counted &other) = default;
+
+    int value;
+};
+
+std::atomic<int> Counted::alive = 0;
+
+void tst_QConcurrentHash::empty()
+{
+    QConcurrentHash<int, int> hash;
+    QCOMPARE(hash.size(), 0);
+    QCOMPARE(hash.count(), 0);
+    QVERIFY(hash.isEmpty());
+    QVERIFY(!hash.contains(0));
+    QCOMPARE(hash.value(0), 0);
+    QCOMPARE(hash.value(0, 42), 42);
+    QVERIFY(!hash.remove(0));
+}
+
+void tst_QConcurrentHash::insert()
+{
+    QConcurrentHash<int, int> hash;
+    hash.insert(1, 10);
+    hash.insert(2, 20);
+    QCOMPARE(hash.size(), 2);
+    QVERIFY(!hash.isEmpty());
+    QVERIFY(hash.contains(1));
+    QVERIFY(hash.contains(2));
+    QVERIFY(!hash.contains(3));
+    QCOMPARE(hash.value(1), 10);
+    QCOMPARE(hash.value(2), 20);
+
+    // replaces the value
+    hash.insert(1, 11);
+    QCOMPARE(hash.size(), 2);
+    QCOMPARE(hash.value(1), 11);
+    QCOMPARE(hash.value(2), 20);
+}
+
+void tst_QConcurrentHash::tryInsert()
+{
+    QConcurrentHash<int, int> hash;
+    QVERIFY(hash.tryInsert(1, 10));
+    QVERIFY(!hash.tryInsert(1, 11));
+    QCOMPARE(hash.size(), 1);
+    QCOMPARE(hash.value(1), 10);
+
+    QVERIFY(hash.remove(1));
+    QVERIFY(hash.tryInsert(1, 12));
+    QCOMPARE(hash.value(1), 12);
+}
+
+void tst_QConcurrentHash::remove()
+{
+    QConcurrentHash<int, int> hash;
+    for (int i = 0; i < 100; ++i)
+        hash.insert(i, i * 2);
+    QCOMPARE(hash.size(), 100);
+
+    for (int i = 0; i < 100; i += 2)
+        QVERIFY(hash.remove(i));
+    QCOMPARE(hash.size(), 50);
+    for (int i = 0; i < 100; ++i) {
+        QCOMPARE(hash.contains(i), i % 2 == 1);
+        QCOMPARE(hash.value(i, -1), i % 2 ? i * 2 : -1);
+    }
+    QVERIFY(!hash.remove(0));
+    QCOMPARE(hash.size(), 50);
+}
+
+void tst_QConcurrentHash::clear()
+{
+    QConcurrentHash<int, int> hash;
+    for (int i = 0; i < 1000; ++i)
+        hash.insert(i, i);
+    hash.clear();
+    QCOMPARE(hash.size(), 0);
+    QVERIFY(hash.isEmpty());
+    QVERIFY(!hash.contains(0));
+    QVERIFY(!hash.contains(999));
+
+    hash.insert(5, 5);
+    QCOMPARE(hash.size(), 1);
+    QCOMPARE(hash.value(5), 5);
+}
+
+void tst_QConcurrentHash::reserve()
+{
+    QConcurrentHash<int, int> hash(1000);
+    for (int i = 0; i < 1000; ++i)
+        hash.insert(i, i);
+    hash.reserve(10000);
+    hash.reserve(10);
+    QCOMPARE(hash.size(), 1000);
+    for (int i = 0; i < 1000; ++i)
+        QCOMPARE(hash.value(i, -1), i);
+}
+
+void tst_QConcurrentHash::growth()
+{
+    const int N = 100000;
+    QConcurrentHash<int, int> hash;
+    for (int i = 0; i < N; ++i)
+        hash.insert(i, -i);
+    QCOMPARE(hash.size(), N);
+    for (int i = 0; i < N; ++i)
+        QCOMPARE(hash.value(i, 1), -i);
+    QVERIFY(!hash.contains(N));
+    QVERIFY(!hash.contains(-1));
+}
+
+void tst_QConcurrentHash::stringKeys()
+{
+    QConcurrentHash<QString, QString> hash;
+    for (int i = 0; i < 1000; ++i)
+        hash.insert(QString::number(i), QString::number(i * 3));
+    QCOMPARE(hash.size(), 1000);
+    QCOMPARE(hash.value(QStringLiteral("42")), QStringLiteral("126"));
+    QVERIFY(!hash.contains(QStringLiteral("1000")));
+    QVERIFY(hash.remove(QStringLiteral("42")));
+    QCOMPARE(hash.value(QStringLiteral("42"), QStringLiteral("none")), QStringLiteral("none"));
+}
+
+void tst_QConcurrentHash::movedValues()
+{
+    // values can be moved in, but are copied out
+    QConcurrentHash<int, std::shared_ptr<int>> hash;
+    auto p = std::make_shared<int>(7);
+    hash.insert(1, std::move(p));
+    QVERIFY(!p);
+    QCOMPARE(*hash.value(1), 7);
+    QCOMPARE(hash.value(1).use_count(), 2);
+    QVERIFY(!hash.value(2));
+}
+
+void tst_QConcurrentHash::reclamation()
+{
+    const int aliveBefore = Counted::alive;
+    {
+        QConcurrentHash<int, Counted> hash;
+        for (int i = 0; i < 64; ++i)
+            hash.insert(i, Counted(i));
+
+        // replaced and removed values must not pile up
+        for (int round = 0; round < 1000; ++round) {
+            for (int i = 0; i < 64; ++i)
+                hash.insert(i, Counted(round));
+        }
+        QCOMPARE(hash.value(63).value, 999);
+        QCOMPARE_LT(Counted::alive - aliveBefore, 64 * 10);
+
+        for (int i = 0; i < 64; ++i)
+            QVERIFY(hash.remove(i));
+        QVERIFY(hash.isEmpty());
+    }
+}
+
+void tst_QConcurrentHash::concurrentReadersAndWriters()
+{
+    // Writers keep every key's value equal to a multiple of the key; readers
+    // must never see anything else, while the table grows under them.
+    const int NKeys = 20000;
+    const int NReaders = 4;
+    const int NWriters = 2;
+    QConcurrentHash<int, int> hash;
+    std::atomic<bool> done = false;
+    std::atomic<int> failures = 0;
+
+    std::vector<std::unique_ptr<QThread>> threads;
+    for (int r = 0; r < NReaders; ++r) {
+        threads.emplace_back(QThread::create([&, r] {
+            int i = r;
+            while (!done.load(std::memory_order_relaxed)) {
+                const int key = i++ % NKeys + 1;
+                const int v = hash.value(key, 0);
+                if (v % key != 0)
+                    ++failures;
+            }
+        }));
+    }
+    for (int w = 0; w < NWriters; ++w) {
+        threads.emplace_back(QThread::create([&, w] {
+            for (int round = 1; round <= 3; ++round) {
+                for (int key = 1 + w; key <= NKeys; key += NWriters) {
+                    if (round == 2 && key % 3 == 0)
+                        hash.remove(key);
+                    else
+                        hash.insert(key, key * round);
+                }
+            }
+        }));
+    }
+    for (auto &t : threads)
+        t->start();
+    for (int i = NReaders; i < NReaders + NWriters; ++i)
+        QVERIFY(threads[i]->wait());
+    done = true;
+    for (int i = 0; i < NReaders; ++i)
+        QVERIFY(threads[i]->wait());
+
+    QCOMPARE(failures.load(), 0);
+    QCOMPARE(hash.size(), NKeys);
+    for (int key = 1; key <= NKeys; ++key)
+        QCOMPARE(hash.value(key), key * 3);
+}
+
+void tst_QConcurrentHash::concurrentInsertSameKeys()
+{
+    const int NKeys = 5000;
+    const int NThreads = 4;
+    QConcurrentHash<int, int> hash;
+    std::atomic<int> inserted = 0;
+
+    std::vector<std::unique_ptr<QThread>> threads;
+    for (int t = 0; t < NThreads; ++t) {
+        threads.emplace_back(QThread::create([&, t] {
+            for (int key = 0; key < NKeys; ++key) {
+                if (hash.tryInsert(key, t))
+                    ++inserted;
+            }
+        }));
+    }
+    for (auto &t : threads)
+        t->start();
+    for (auto &t : threads)
+        QVERIFY(t->wait());
+
+    // every key was inserted by exactly one thread
+    QCOMPARE(inserted.load(), NKeys);
+    QCOMPARE(hash.size(), NKeys);
+    for (int key = 0; key < NKeys; ++key) {
+        const int v = hash.value(key, -1);
+        QVERIFY(v >= 0 && v < NThreads);
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_QConcurrentHash)
+#include "tst_qconcurrenthash.moc"
@@ -83,6 +83,7 @@ private slots:
     void emplace();
 
     void badHashFunction();
+    void clusteredHashes();
     void hashOfHash();
 
     void stdHash();
@@ -2857,6 +2858,52 @@ void tst_QHash::badHashFunction()
 
 }
 
+struct ClusteredKey {
+    int k;
+    ClusteredKey(int i) : k(i) {}
+    bool operator==(const ClusteredKey &other) const
+    {
+        return k == other.k;
+    }
+};
+
+size_t qHash(ClusteredKey key, size_t seed)
+{
+    // the last few buckets of the table, so that the keys form one run of
+    // used buckets that wraps around; there are only 7 * 37 different
+    // hashes, so lookups also have to compare keys with equal hashes
+    constexpr int TopShift = std::numeric_limits<size_t>::digits - 8;
+    return ((size_t(key.k % 37) << TopShift) | ((~size_t(0) >> 8) - size_t(key.k % 7))) ^ seed;
+}
+
+void tst_QHash::clusteredHashes()
+{
+    QHashSeed::setDeterministicGlobalSeed();
+    auto resetSeed = qScopeGuard([&]() {
+        QHashSeed::resetRandomGlobalSeed();
+    });
+
+    QHash<ClusteredKey, int> hash;
+    for (int i = 0; i < 1000; ++i)
+        hash.insert(i, i);
+    for (int i = 0; i < 1000; ++i)
+        QCOMPARE(hash.value(i, -1), i);
+    for (int i = 1000; i < 1100; ++i)
+        QVERIFY(!hash.contains(i));
+
+    // erasing moves the following entries back, within and across Spans
+    for (int i = 0; i < 1000; i += 3)
+        QVERIFY(hash.remove(i));
+    QCOMPARE(hash.size(), 666);
+    for (int i = 0; i < 1000; ++i)
+        QCOMPARE(hash.value(i, -1), i % 3 ? i : -1);
+
+    int count = 0;
+    for (auto it = hash.cbegin(); it != hash.cend(); ++it, ++count)
+        QCOMPARE(it.value(), it.key().k);
+    QCOMPARE(count, hash.size());
+}
+
 void tst_QHash::hashOfHash()
 {
     QHash<int, int> hash;
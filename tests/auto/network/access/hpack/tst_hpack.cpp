@@ -46,6 +46,11 @@ private Q_SLOTS:
     void hpackDecodeResponse_data();
     void hpackDecodeResponse();
 
+    void huffmanRoundTrip();
+    void huffmanErrors();
+    void preEncodedHeaders_data();
+    void preEncodedHeaders();
+
     // TODO: more-more-more tests needed!
 
 private:
@@ -800,6 +805,129 @@ void tst_Hpack::hpackDecodeResponse()
     }
 }
 
+void tst_Hpack::huffmanRoundTrip()
+{
+    // C.4.1 First Request, the ':authority' value:
+    {
+        std::vector<uchar> buffer;
+        BitOStream out(buffer);
+        out.write("www.example.com", true);
+        const uchar expected[] = {0x8c, 0xf1, 0xe3, 0xc2, 0xe5, 0xf2, 0x3a,
+                                  0x6b, 0xa0, 0xab, 0x90, 0xf4, 0xff};
+        QCOMPARE(out.byteLength(), quint64(sizeof expected));
+        QVERIFY(std::equal(out.begin(), out.end(), expected));
+
+        BitIStream in(out.begin(), out.end());
+        QByteArray decoded;
+        QVERIFY(in.read(&decoded));
+        QCOMPARE(decoded, QByteArray("www.example.com"));
+        QVERIFY(!in.hasMoreBits());
+    }
+
+    // Every octet value, in strings of all lengths
+    // (and so of all possible amounts of padding):
+    QByteArray all(256, Qt::Uninitialized);
+    for (int i = 0; i < 256; ++i)
+        all[i] = char(i);
+
+    std::vector<uchar> buffer;
+    BitOStream out(buffer);
+    for (qsizetype len = 0; len <= all.size(); ++len)
+        out.write(QByteArrayView(all).sliced(all.size() - len), true);
+
+    BitIStream in(out.begin(), out.end());
+    for (qsizetype len = 0; len <= all.size(); ++len) {
+        QByteArray decoded;
+        QVERIFY(in.read(&decoded));
+        QCOMPARE(in.error(), StreamError::NoError);
+        QCOMPARE(decoded, all.sliced(all.size() - len));
+    }
+    QVERIFY(!in.hasMoreBits());
+}
+
+void tst_Hpack::huffmanErrors()
+{
+    {
+        // 'a' (00011), padded with zeroes instead of the EOS prefix.
+        const uchar bytes[] = {0x81, 0x18};
+        BitIStream in(bytes, bytes + sizeof bytes);
+        QByteArray val;
+        QVERIFY(!in.read(&val));
+        QCOMPARE(in.error(), StreamError::CompressionError);
+    }
+    {
+        // 'a', followed by 11 bits of padding - longer than 7 bits.
+        const uchar bytes[] = {0x82, 0x1f, 0xff};
+        BitIStream in(bytes, bytes + sizeof bytes);
+        QByteArray val;
+        QVERIFY(!in.read(&val));
+        QCOMPARE(in.error(), StreamError::CompressionError);
+    }
+    {
+        // The EOS symbol (30 bits of 1) must not appear in a string.
+        const uchar bytes[] = {0x84, 0xff, 0xff, 0xff, 0xff};
+        BitIStream in(bytes, bytes + sizeof bytes);
+        QByteArray val;
+        QVERIFY(!in.read(&val));
+        QCOMPARE(in.error(), StreamError::CompressionError);
+    }
+}
+
+void tst_Hpack::preEncodedHeaders_data()
+{
+    hpackEncodeRequest_data();
+}
+
+void tst_Hpack::preEncodedHeaders()
+{
+    QFETCH(bool, compression);
+
+    {
+        QTest::ignoreMessage(QtCriticalMsg, "pseudo-header \":path\" cannot be pre-encoded");
+        const HttpHeader invalid = {{":path", "/"}};
+        QVERIFY(!PreEncodedHeaders::encode(invalid, compression));
+    }
+
+    const HttpHeader common = {{"accept-encoding", "gzip, deflate"}, // static, indexed
+                               {"accept", "*/*"},                    // static name
+                               {"x-common-field", "common value"}};  // literal
+    const auto preEncoded = PreEncodedHeaders::encode(common, compression);
+    QVERIFY(preEncoded);
+    QVERIFY(!preEncoded->isEmpty());
+    QVERIFY(preEncoded->header() == common);
+
+    const HttpHeader request = {{":method", "GET"},
+                                {":scheme", "https"},
+                                {":authority", "www.example.com"},
+                                {":path", "/index.html"},
+                                {"custom-key", "custom-value"}};
+
+    // Encoding the request alone gives the dynamic table size to expect:
+    Encoder reference(4096, compression);
+    {
+        std::vector<uchar> buffer;
+        BitOStream out(buffer);
+        QVERIFY(reference.encodeRequest(out, request));
+    }
+
+    Encoder encoder(4096, compression);
+    Decoder decoder(4096);
+    for (int i = 0; i < 2; ++i) {
+        std::vector<uchar> buffer;
+        BitOStream out(buffer);
+        QVERIFY(encoder.encodeRequest(out, request, *preEncoded));
+
+        BitIStream in(out.begin(), out.end());
+        QVERIFY(decoder.decodeHeaderFields(in));
+        HttpHeader expected = request;
+        expected.insert(expected.end(), common.begin(), common.end());
+        QVERIFY(decoder.decodedHeader() == expected);
+        // Only the request's own fields are added to the dynamic table:
+        QCOMPARE(decoder.dynamicTableSize(), encoder.dynamicTableSize());
+        QCOMPARE(encoder.dynamicTableSize(), reference.dynamicTableSize());
+    }
+}
+
 QTEST_MAIN(tst_Hpack)
 
 #include "tst_hpack.moc"
@@ -27,6 +27,7 @@
 #include <QtCore/qurl.h>
 #include <QtCore/qset.h>
 
+#include <algorithm>
 #include <cstdlib>
 #include <memory>
 #include <string>
@@ -79,6 +80,7 @@ private slots:
     void multipleRequests();
     void flowControlClientSide();
     void flowControlServerSide();
+    void flowControlReadBufferSize();
     void pushPromise();
     void goaway_data();
     void goaway();
@@ -513,6 +515,72 @@ void tst_Http2::flowControlServerSide()
     QVERIFY(serverGotSettingsACK);
 }
 
+void tst_Http2::flowControlReadBufferSize()
+{
+    // A reply with a limited read buffer, that nobody reads from, must
+    // stop extending its stream's receive window, so that the server has
+    // to pause instead of filling our memory.
+    using namespace Http2;
+
+    clearHTTP2State();
+
+    serverPort = 0;
+    nRequests = 1;
+
+    QHttp2Configuration params;
+    params.setSessionReceiveWindowSize(Http2::defaultSessionWindowSize * 100);
+    params.setStreamReceiveWindowSize(Http2::defaultSessionWindowSize);
+
+    ServerPtr srv(newServer(defaultServerSettings, defaultConnectionType(),
+                            qt_H2ConfigurationToSettings(params)));
+    const QByteArray body(int(Http2::defaultSessionWindowSize * 20), 'x');
+    srv->setResponseBody(body);
+    QMetaObject::invokeMethod(srv.data(), "startServer", Qt::QueuedConnection);
+    runEventLoop();
+    QVERIFY(serverPort != 0);
+
+    auto url = requestUrl(defaultConnectionType());
+    url.setPath(QString("/stream1.html"));
+
+    QNetworkRequest request(url);
+    request.setAttribute(QNetworkRequest::Http2CleartextAllowedAttribute, true);
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, QVariant(true));
+    request.setHttp2Configuration(params);
+
+    const QSignalSpy windowUpdateSpy(srv.data(), &Http2Server::windowUpdate);
+    const auto streamWindowUpdates = [&windowUpdateSpy] {
+        return std::count_if(windowUpdateSpy.cbegin(), windowUpdateSpy.cend(),
+                             [](const QList<QVariant> &args) {
+                                 return args.at(0).toUInt() != Http2::connectionStreamID;
+                             });
+    };
+
+    QNetworkReply *reply = manager->get(request);
+    reply->ignoreSslErrors();
+    reply->setReadBufferSize(16 * 1024);
+    connect(reply, &QNetworkReply::finished, this, &tst_Http2::replyFinished);
+
+    QTRY_VERIFY(reply->bytesAvailable() > 0);
+    // Give the server the time to send whatever its window allows. Without
+    // throttling it would get about 40 stream WINDOW_UPDATEs to finish the body.
+    QTest::qWait(200);
+    QVERIFY(!reply->isFinished());
+    QCOMPARE_LE(streamWindowUpdates(), 1);
+
+    QByteArray received = reply->readAll();
+    connect(reply, &QNetworkReply::readyRead, this, [&received, reply] {
+        received += reply->readAll();
+    });
+
+    runEventLoop();
+    STOP_ON_FAILURE
+
+    QCOMPARE(nRequests, 0);
+    received += reply->readAll();
+    QCOMPARE(received.size(), body.size());
+    QCOMPARE_GT(streamWindowUpdates(), 1);
+}
+
 void tst_Http2::pushPromise()
 {
     // We will first send some request, the server should reply and also emulate
@@ -30,6 +30,9 @@ private slots:
     void testDataFrameAfterRSTOutgoing();
     void connectToServer();
     void WINDOW_UPDATE();
+    void sendDATASharesSessionWindow_data();
+    void sendDATASharesSessionWindow();
+    void adaptiveReceiveWindow();
     void testCONTINUATIONFrame();
 
 private:
@@ -731,6 +734,128 @@ void sendCONTINUATIONFrame(HPack::Encoder &encoder,
 
 }
 
+void tst_QHttp2Connection::sendDATASharesSessionWindow_data()
+{
+    QTest::addColumn<quint8>("firstPriority");
+    QTest::addColumn<quint8>("secondPriority");
+
+    QTest::newRow("equal") << quint8(127) << quint8(127);
+    QTest::newRow("weighted") << quint8(0) << quint8(255);
+}
+
+void tst_QHttp2Connection::sendDATASharesSessionWindow()
+{
+    QFETCH(const quint8, firstPriority);
+    QFETCH(const quint8, secondPriority);
+    constexpr qsizetype UploadSize = 1024 * 1024;
+
+    auto [client, server] = makeFakeConnectedSockets();
+    auto connection = makeHttp2Connection(client.get(), {}, Client);
+
+    // Only the session window limits the upload:
+    QHttp2Configuration config;
+    config.setStreamReceiveWindowSize(2 * UploadSize);
+    auto serverConnection = makeHttp2Connection(server.get(), config, Server);
+
+    QVERIFY(waitForSettingsExchange(connection, serverConnection));
+
+    QHash<quint32, qsizetype> receivedBytes;
+    QList<quint32> finishedStreams;
+    QHash<quint32, qsizetype> receivedWhenFirstFinished;
+    connect(serverConnection, &QHttp2Connection::newIncomingStream, this,
+            [&](QHttp2Stream *stream) {
+                connect(stream, &QHttp2Stream::dataReceived, this,
+                        [&, stream](const QByteArray &data, bool endStream) {
+                            receivedBytes[stream->streamID()] += data.size();
+                            if (!endStream)
+                                return;
+                            if (finishedStreams.isEmpty())
+                                receivedWhenFirstFinished = receivedBytes;
+                            finishedStreams.append(stream->streamID());
+                        });
+            });
+
+    HPack::HttpHeader headers = getRequiredHeaders();
+    headers[1].value = "POST";
+    const QByteArray uploadedData(UploadSize, 'a');
+    QHttp2Stream *firstStream = connection->createStream().unwrap();
+    QVERIFY(firstStream->sendHEADERS(headers, false, firstPriority));
+    QCOMPARE(firstStream->priority(), firstPriority);
+    // The first stream uses up the initial session window:
+    QVERIFY(firstStream->sendDATA(uploadedData, true));
+    QVERIFY(firstStream->isUploadBlocked());
+    QHttp2Stream *secondStream = connection->createStream().unwrap();
+    QVERIFY(secondStream->sendHEADERS(headers, false, secondPriority));
+    QVERIFY(secondStream->sendDATA(uploadedData, true));
+
+    QTRY_COMPARE(finishedStreams.size(), 2);
+    QCOMPARE(receivedBytes.value(firstStream->streamID()), UploadSize);
+    QCOMPARE(receivedBytes.value(secondStream->streamID()), UploadSize);
+
+    // The streams share the window updates in proportion to their priority:
+    if (firstPriority == secondPriority) {
+        QCOMPARE(finishedStreams.front(), firstStream->streamID());
+        QCOMPARE_GT(receivedWhenFirstFinished.value(secondStream->streamID()), UploadSize / 2);
+    } else {
+        QCOMPARE(finishedStreams.front(), secondStream->streamID());
+        QCOMPARE_LT(receivedWhenFirstFinished.value(firstStream->streamID()), UploadSize / 4);
+    }
+}
+
+void tst_QHttp2Connection::adaptiveReceiveWindow()
+{
+    constexpr qsizetype DownloadSize = 4 * 1024 * 1024;
+
+    QHttp2Configuration config;
+    QVERIFY(!config.adaptiveReceiveWindowEnabled());
+    config.setAdaptiveReceiveWindowEnabled(true);
+    QVERIFY(config.adaptiveReceiveWindowEnabled());
+    QCOMPARE_NE(config, QHttp2Configuration());
+
+    auto [client, server] = makeFakeConnectedSockets();
+    auto connection = makeHttp2Connection(client.get(), config, Client);
+    auto serverConnection = makeHttp2Connection(server.get(), {}, Server);
+
+    QVERIFY(waitForSettingsExchange(connection, serverConnection));
+
+    QSignalSpy newIncomingStreamSpy{ serverConnection, &QHttp2Connection::newIncomingStream };
+    QSignalSpy clientPingSpy{ connection, &QHttp2Connection::pingFrameRecived };
+
+    QHttp2Stream *clientStream = connection->createStream().unwrap();
+    QSignalSpy clientDataReceivedSpy{ clientStream, &QHttp2Stream::dataReceived };
+    QVERIFY(clientStream->sendHEADERS(getRequiredHeaders(), true));
+
+    QVERIFY(newIncomingStreamSpy.wait());
+    auto *serverStream = newIncomingStreamSpy.front().front().value<QHttp2Stream *>();
+    QVERIFY(serverStream);
+
+    QByteArray downloadedData(DownloadSize, Qt::Uninitialized);
+    for (qsizetype i = 0; i < DownloadSize; ++i)
+        downloadedData[i] = char(i % 251);
+    QVERIFY(serverStream->sendHEADERS({ { ":status", "200" } }, false));
+    QVERIFY(serverStream->sendDATA(downloadedData, true));
+
+    QByteArray clientReceivedData;
+    bool streamEnd = false;
+    while (!streamEnd) {
+        QVERIFY(clientDataReceivedSpy.wait());
+        for (const QList<QVariant> &emission : std::as_const(clientDataReceivedSpy)) {
+            clientReceivedData += emission.front().value<QByteArray>();
+            streamEnd = emission.back().value<bool>();
+        }
+        clientDataReceivedSpy.clear();
+    }
+    QCOMPARE(clientReceivedData, downloadedData);
+    QCOMPARE(clientStream->state(), QHttp2Stream::State::Closed);
+
+    // The PING measuring the round trip time is not reported
+    QCOMPARE(clientPingSpy.size(), 0);
+    QVERIFY(connection->sendPing());
+    QTRY_COMPARE(clientPingSpy.size(), 1);
+    QCOMPARE(clientPingSpy.front().front().value<QHttp2Connection::PingState>(),
+             QHttp2Connection::PingState::PongSignatureIdentical);
+}
+
 void tst_QHttp2Connection::testCONTINUATIONFrame()
 {
     static const HPack::HttpHeader headers = HPack::HttpHeader {
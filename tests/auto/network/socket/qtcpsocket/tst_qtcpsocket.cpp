@@ -38,6 +38,7 @@
 #ifndef QT_NO_SSL
 #include <QSslSocket>
 #endif
+#include <QTemporaryFile>
 #include <QTextStream>
 #include <QThread>
 #include <QElapsedTimer>
@@ -173,6 +174,7 @@ private slots:
 
     void setSocketOption();
     void clientSendDataOnDelayedDisconnect();
+    void sendFile();
     void serverDisconnectWithBuffered();
     void socketDiscardDataInWriteMode();
     void writeOnReadBufferOverflow();
@@ -3087,6 +3089,58 @@ void tst_QTcpSocket::clientSendDataOnDelayedDisconnect()
     delete socket;
 }
 
+void tst_QTcpSocket::sendFile()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+
+    QByteArray contents;
+    for (int i = 0; i < 300000; ++i)
+        contents += char('a' + i % 26);
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(contents), contents.size());
+    QVERIFY(file.flush());
+    const qint64 filePos = file.pos();
+
+    QTcpServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+    std::unique_ptr<QTcpSocket> socket(newSocket());
+    socket->connectToHost(server.serverAddress(), server.serverPort());
+    QVERIFY(socket->waitForConnected(5000));
+    QVERIFY(server.waitForNewConnection(5000));
+    std::unique_ptr<QTcpSocket> peer(server.nextPendingConnection());
+    QVERIFY(peer);
+
+    QByteArray received;
+    connect(peer.get(), &QIODevice::readyRead, this, [&] { received += peer->readAll(); });
+    qint64 bytesWritten = 0;
+    connect(socket.get(), &QIODevice::bytesWritten, this, [&](qint64 bytes) {
+        bytesWritten += bytes;
+    });
+
+    // file contents must be ordered with respect to regular writes
+    QCOMPARE(socket->write("head"), 4);
+    QVERIFY(socket->sendFile(&file, 10, 50000));
+    QCOMPARE(socket->write("tail"), 4);
+    QVERIFY(socket->sendFile(&file));
+    QCOMPARE(file.pos(), filePos);
+
+    const QByteArray expected = "head" + contents.mid(10, 50000) + "tail" + contents;
+    QCOMPARE(socket->bytesToWrite(), expected.size());
+
+    QTRY_COMPARE_WITH_TIMEOUT(received.size(), expected.size(), 10000);
+    QCOMPARE(received, expected);
+    QCOMPARE(bytesWritten, expected.size());
+    QCOMPARE(socket->bytesToWrite(), 0);
+
+    QTest::ignoreMessage(QtWarningMsg,
+                         "QAbstractSocket::sendFile: File is not readable or offset is invalid");
+    QVERIFY(!socket->sendFile(nullptr));
+    QVERIFY(!socket->sendFile(&file, contents.size() + 1));
+}
+
 // Test buffered socket being properly closed on remote disconnect
 void tst_QTcpSocket::serverDisconnectWithBuffered()
 {
@@ -22,6 +22,7 @@
 #include <qhostinfo.h>
 #include <qtcpsocket.h>
 #include <qmap.h>
+#include <qdeadlinetimer.h>
 #include <qelapsedtimer.h>
 #include <qnetworkdatagram.h>
 #include <QNetworkProxy>
@@ -75,6 +76,9 @@ private slots:
     void bindAndConnectToHost();
     void pendingDatagramSize();
     void writeDatagram();
+    void batchedDatagrams_data();
+    void batchedDatagrams();
+    void batchedDatagramsMixedProtocols();
     void performance();
     void bindMode();
     void writeDatagramToNonExistingPeer_data();
@@ -122,6 +126,7 @@ private:
 
     bool m_skipUnsupportedIPv6Tests;
     bool m_workaroundLinuxKernelBug;
+    bool m_haveTestServer = true;
     QList<QHostAddress> allAddresses;
     QHostAddress multicastGroup4, multicastGroup6;
     QList<QHostAddress> linklocalMulticastGroups;
@@ -233,8 +238,8 @@ void tst_QUdpSocket::initTestCase()
      QVERIFY(QtNetworkSettings::verifyConnection(QtNetworkSettings::socksProxyServerName(), 1080));
      QVERIFY(QtNetworkSettings::verifyConnection(QtNetworkSettings::echoServerName(), 7));
 #else
-    if (!QtNetworkSettings::verifyTestNetworkSettings())
-        QSKIP("No network test server available");
+    // tests that only talk to localhost still run, see init()
+    m_haveTestServer = QtNetworkSettings::verifyTestNetworkSettings();
 #endif
     allAddresses = QNetworkInterface::allAddresses();
     m_skipUnsupportedIPv6Tests = shouldSkipIpv6TestsForBrokenSetsockopt();
@@ -279,6 +284,16 @@ void tst_QUdpSocket::initTestCase()
 
 void tst_QUdpSocket::init()
 {
+    static const QByteArrayView localTests[] = {
+        "batchedDatagrams",
+        "batchedDatagramsMixedProtocols",
+    };
+    if (!m_haveTestServer
+        && std::find(std::begin(localTests), std::end(localTests),
+                     QTest::currentTestFunction()) == std::end(localTests)) {
+        QSKIP("No network test server available");
+    }
+
     QFETCH_GLOBAL(bool, setProxy);
     if (setProxy) {
 #if QT_CONFIG(socks5)
@@ -887,6 +902,103 @@ void tst_QUdpSocket::writeDatagram()
     }
 }
 
+void tst_QUdpSocket::batchedDatagrams_data()
+{
+    QTest::addColumn<qint64>("maxSize");
+    QTest::addColumn<qsizetype>("largeSize");
+    QTest::newRow("unlimited") << qint64(-1) << qsizetype(0);
+    QTest::newRow("limited") << qint64(16) << qsizetype(0);
+    QTest::newRow("unlimited-large") << qint64(-1) << qsizetype(60000);
+    QTest::newRow("limited-large") << qint64(30000) << qsizetype(60000);
+}
+
+void tst_QUdpSocket::batchedDatagrams()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+    QFETCH(qint64, maxSize);
+    QFETCH(qsizetype, largeSize);
+
+    QUdpSocket sender, receiver;
+    QVERIFY(receiver.bind(QHostAddress(QHostAddress::LocalHost), 0));
+    QVERIFY(sender.bind(QHostAddress(QHostAddress::LocalHost), 0));
+    if (largeSize)
+        receiver.setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, 1024 * 1024);
+
+    // more than fit into a single system call; a large datagram among small
+    // ones must neither be cut short nor affect its neighbours
+    constexpr int Count = 100;
+    QList<QNetworkDatagram> datagrams;
+    for (int i = 0; i < Count; ++i) {
+        const QByteArray data = largeSize && i == Count / 2
+                ? QByteArray(largeSize, 'x')
+                : QByteArray::number(i).repeated(i % 7 + 1);
+        QNetworkDatagram datagram(data, receiver.localAddress(), receiver.localPort());
+        if (i % 10 == 0)
+            datagram.setHopLimit(42);
+        datagrams.append(datagram);
+    }
+    QSignalSpy bytesWrittenSpy(&sender, &QIODevice::bytesWritten);
+    QCOMPARE(sender.writeDatagrams(datagrams), Count);
+    QCOMPARE(bytesWrittenSpy.size(), 1);
+
+    QList<QNetworkDatagram> received;
+    QDeadlineTimer deadline(5000);
+    while (received.size() < Count && !deadline.hasExpired()) {
+        if (!receiver.hasPendingDatagrams() && !receiver.waitForReadyRead(100))
+            continue;
+        received += receiver.receiveDatagrams(Count - received.size(), maxSize);
+    }
+    QCOMPARE(received.size(), Count);
+    QVERIFY(receiver.receiveDatagrams(10).isEmpty());
+
+    qint64 totalBytes = 0;
+    for (int i = 0; i < Count; ++i) {
+        const QByteArray expected = datagrams.at(i).data();
+        totalBytes += expected.size();
+        const QByteArray data = received.at(i).data();
+        QCOMPARE(data, maxSize < 0 ? expected : expected.left(maxSize));
+        // short datagrams don't hold on to a buffer of the largest size
+        // that could have been received
+        const qint64 slotSize = maxSize < 0 ? 65536 : maxSize;
+        if (largeSize && data.size() < slotSize)
+            QCOMPARE_LT(data.capacity(), slotSize);
+        QCOMPARE(received.at(i).senderAddress(), sender.localAddress());
+        QCOMPARE(received.at(i).senderPort(), int(sender.localPort()));
+        QCOMPARE(received.at(i).destinationPort(), int(receiver.localPort()));
+    }
+    QCOMPARE(bytesWrittenSpy.at(0).at(0).toLongLong(), totalBytes);
+    if (received.at(0).hopLimit() != -1)
+        QCOMPARE(received.at(0).hopLimit(), 42);
+}
+
+void tst_QUdpSocket::batchedDatagramsMixedProtocols()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+
+    QUdpSocket sender, receiver;
+    QVERIFY(receiver.bind(QHostAddress(QHostAddress::LocalHost), 0));
+    QVERIFY(sender.bind(QHostAddress(QHostAddress::LocalHost), 0));
+
+    const QList<QNetworkDatagram> datagrams = {
+        QNetworkDatagram("first", receiver.localAddress(), receiver.localPort()),
+        QNetworkDatagram("second", QHostAddress::LocalHostIPv6, receiver.localPort()),
+        QNetworkDatagram("third", receiver.localAddress(), receiver.localPort()),
+    };
+    // an IPv4 socket stops at the first IPv6 destination
+    QCOMPARE(sender.writeDatagrams(datagrams), 1);
+    QCOMPARE(sender.error(), QAbstractSocket::UnsupportedSocketOperationError);
+    QCOMPARE(sender.writeDatagrams(QSpan(datagrams).subspan(1)), -1);
+
+    QVERIFY(receiver.waitForReadyRead(5000));
+    const QList<QNetworkDatagram> received = receiver.receiveDatagrams(10);
+    QCOMPARE(received.size(), 1);
+    QCOMPARE(received.at(0).data(), "first");
+}
+
 void tst_QUdpSocket::performance()
 {
     QByteArray arr(8192, '@');
@@ -0,0 +1,234 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QTest>
+#include <QRegularExpression>
+#include <QTemporaryDir>
+
+#include <QtNetwork/QSslConfiguration>
+#include <QtNetwork/QSslKey>
+#include <QtNetwork/QSslServer>
+#include <QtNetwork/QSslSessionCache>
+#include <QtNetwork/QSslSocket>
+
+using namespace Qt::StringLiterals;
+
+class tst_QSslSessionCache : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void defaults();
+    void insertAndLookup();
+    void expiry();
+    void leastRecentlyUsedEviction();
+    void persistence();
+    void configuration();
+    void handshakeUsesCache_data();
+    void handshakeUsesCache();
+};
+
+void tst_QSslSessionCache::defaults()
+{
+    QSslSessionCache cache;
+    QCOMPARE(cache.maximumCacheSize(), 1024 * 1024);
+    QCOMPARE(cache.cacheSize(), 0);
+    QVERIFY(cache.storageFileName().isEmpty());
+    QVERIFY(!cache.save());
+    QCOMPARE(cache.lookupCount(), 0);
+    QCOMPARE(cache.hitCount(), 0);
+    QCOMPARE(cache.resumedCount(), 0);
+    QCOMPARE(cache.resumptionRate(), 0.0);
+}
+
+void tst_QSslSessionCache::insertAndLookup()
+{
+    QSslSessionCache cache;
+    const QByteArray key = "config"_ba;
+    cache.insert(u"example.com"_s, 443, key, "session"_ba, 0);
+    QVERIFY(cache.cacheSize() > 0);
+    QCOMPARE(cache.session(u"example.com"_s, 443, key), "session"_ba);
+    QVERIFY(cache.session(u"example.com"_s, 8443, key).isEmpty());
+    QVERIFY(cache.session(u"example.org"_s, 443, key).isEmpty());
+    QVERIFY(cache.session(u"example.com"_s, 443, "other"_ba).isEmpty());
+
+    cache.insert(u"example.com"_s, 443, key, "newer session"_ba, 0);
+    QCOMPARE(cache.session(u"example.com"_s, 443, key), "newer session"_ba);
+
+    // Empty sessions are not stored
+    cache.insert(u"example.org"_s, 443, key, QByteArray(), 0);
+    QVERIFY(cache.session(u"example.org"_s, 443, key).isEmpty());
+
+    QVERIFY(cache.remove(u"example.com"_s, 443, key));
+    QVERIFY(!cache.remove(u"example.com"_s, 443, key));
+    QVERIFY(cache.session(u"example.com"_s, 443, key).isEmpty());
+    QCOMPARE(cache.cacheSize(), 0);
+
+    cache.insert(u"a"_s, 1, key, "a"_ba, 0);
+    cache.insert(u"b"_s, 1, key, "b"_ba, 0);
+    cache.clear();
+    QCOMPARE(cache.cacheSize(), 0);
+    QVERIFY(cache.session(u"a"_s, 1, key).isEmpty());
+
+    // Direct lookups do not count as handshakes
+    QCOMPARE(cache.lookupCount(), 0);
+}
+
+void tst_QSslSessionCache::expiry()
+{
+    QSslSessionCache cache;
+    cache.insert(u"short"_s, 443, "key"_ba, "session"_ba, 1);
+    cache.insert(u"long"_s, 443, "key"_ba, "session"_ba, 3600);
+    QCOMPARE(cache.session(u"short"_s, 443, "key"_ba), "session"_ba);
+    QTest::qSleep(1100);
+    QVERIFY(cache.session(u"short"_s, 443, "key"_ba).isEmpty());
+    QCOMPARE(cache.session(u"long"_s, 443, "key"_ba), "session"_ba);
+}
+
+void tst_QSslSessionCache::leastRecentlyUsedEviction()
+{
+    QSslSessionCache cache;
+    const QByteArray session(100, 's');
+    cache.insert(u"a"_s, 443, "key"_ba, session, 0);
+    const qint64 entrySize = cache.cacheSize();
+    cache.setMaximumCacheSize(3 * entrySize);
+    cache.insert(u"b"_s, 443, "key"_ba, session, 0);
+    cache.insert(u"c"_s, 443, "key"_ba, session, 0);
+    QCOMPARE(cache.cacheSize(), 3 * entrySize);
+
+    // Touch "a", so that "b" is the least recently used one
+    QVERIFY(!cache.session(u"a"_s, 443, "key"_ba).isEmpty());
+    cache.insert(u"d"_s, 443, "key"_ba, session, 0);
+    QCOMPARE(cache.cacheSize(), 3 * entrySize);
+    QVERIFY(cache.session(u"b"_s, 443, "key"_ba).isEmpty());
+    QVERIFY(!cache.session(u"a"_s, 443, "key"_ba).isEmpty());
+    QVERIFY(!cache.session(u"c"_s, 443, "key"_ba).isEmpty());
+    QVERIFY(!cache.session(u"d"_s, 443, "key"_ba).isEmpty());
+
+    cache.setMaximumCacheSize(entrySize);
+    QCOMPARE(cache.cacheSize(), entrySize);
+}
+
+void tst_QSslSessionCache::persistence()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.filePath(u"sessions"_s);
+
+    {
+        QSslSessionCache cache;
+        cache.setStorageFileName(fileName);
+        QCOMPARE(cache.storageFileName(), fileName);
+        cache.insert(u"example.com"_s, 443, "key"_ba, "session"_ba, 3600);
+        cache.insert(u"example.org"_s, 8443, "key"_ba, "other session"_ba, 0);
+        QVERIFY(cache.save());
+        QCOMPARE(QFile::permissions(fileName) & (QFile::ReadOther | QFile::WriteOther
+                                                 | QFile::ReadGroup | QFile::WriteGroup),
+                 QFile::Permissions());
+        cache.insert(u"example.net"_s, 443, "key"_ba, "saved on destruction"_ba, 0);
+    }
+
+    QSslSessionCache cache;
+    cache.setStorageFileName(fileName);
+    QCOMPARE(cache.session(u"example.com"_s, 443, "key"_ba), "session"_ba);
+    QCOMPARE(cache.session(u"example.org"_s, 8443, "key"_ba), "other session"_ba);
+    QCOMPARE(cache.session(u"example.net"_s, 443, "key"_ba), "saved on destruction"_ba);
+
+    // A corrupt file is ignored
+    QFile file(dir.filePath(u"garbage"_s));
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write("not a session cache");
+    file.close();
+    QSslSessionCache other;
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression(u"Could not read TLS sessions"_s));
+    other.setStorageFileName(file.fileName());
+    QCOMPARE(other.cacheSize(), 0);
+}
+
+void tst_QSslSessionCache::configuration()
+{
+    QSslConfiguration configuration;
+    QVERIFY(!configuration.sessionCache());
+    QVERIFY(configuration.isNull());
+
+    auto cache = std::make_unique<QSslSessionCache>();
+    configuration.setSessionCache(cache.get());
+    QCOMPARE(configuration.sessionCache(), cache.get());
+    QVERIFY(!configuration.isNull());
+    QVERIFY(configuration != QSslConfiguration());
+
+    QSslSocket socket;
+    socket.setSslConfiguration(configuration);
+    QCOMPARE(socket.sslConfiguration().sessionCache(), cache.get());
+
+    cache.reset();
+    QVERIFY(!configuration.sessionCache());
+}
+
+void tst_QSslSessionCache::handshakeUsesCache_data()
+{
+    QTest::addColumn<QSsl::SslProtocol>("protocol");
+
+    QTest::newRow("TLS 1.2") << QSsl::TlsV1_2;
+    QTest::newRow("TLS 1.3") << QSsl::TlsV1_3;
+}
+
+void tst_QSslSessionCache::handshakeUsesCache()
+{
+    if (!QSslSocket::supportsSsl() || QSslSocket::activeBackend() != "openssl"_L1)
+        QSKIP("Session caching is implemented by the OpenSSL backend only");
+
+    QFETCH(QSsl::SslProtocol, protocol);
+
+    QFile keyFile(QFINDTESTDATA("../qsslsocket/certs/selfsigned-server.key"));
+    QVERIFY(keyFile.open(QIODevice::ReadOnly));
+    QSslConfiguration serverConfiguration = QSslConfiguration::defaultConfiguration();
+    serverConfiguration.setPrivateKey(QSslKey(keyFile.readAll(), QSsl::Rsa));
+    const auto certificates =
+            QSslCertificate::fromPath(
+                    QFINDTESTDATA("../qsslsocket/certs/selfsigned-server.crt"));
+    QCOMPARE(certificates.size(), 1);
+    serverConfiguration.setLocalCertificate(certificates.first());
+    serverConfiguration.setProtocol(protocol);
+
+    QSslServer server;
+    server.setSslConfiguration(serverConfiguration);
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    QSslSessionCache cache;
+    QSslConfiguration clientConfiguration = QSslConfiguration::defaultConfiguration();
+    clientConfiguration.setPeerVerifyMode(QSslSocket::VerifyNone);
+    clientConfiguration.setProtocol(protocol);
+    clientConfiguration.setSessionCache(&cache);
+
+    for (int i = 0; i < 2; ++i) {
+        QSslSocket client;
+        client.setSslConfiguration(clientConfiguration);
+        client.connectToHostEncrypted(u"localhost"_s, server.serverPort());
+        QTRY_VERIFY(client.isEncrypted());
+        // With TLS 1.3 the server sends its session tickets after the handshake
+        QTRY_VERIFY(cache.cacheSize() > 0);
+        QCOMPARE(cache.lookupCount(), i + 1);
+        QCOMPARE(cache.hitCount(), i);
+        QVERIFY(cache.resumedCount() <= cache.hitCount());
+        while (QTcpSocket *socket = server.nextPendingConnection())
+            socket->deleteLater();
+    }
+
+    // Sockets with a different configuration do not get the cached session
+    clientConfiguration.setPeerVerifyDepth(3);
+    QSslSocket client;
+    client.setSslConfiguration(clientConfiguration);
+    client.connectToHostEncrypted(u"localhost"_s, server.serverPort());
+    QTRY_VERIFY(client.isEncrypted());
+    QCOMPARE(cache.lookupCount(), 3);
+    QCOMPARE(cache.hitCount(), 1);
+
+    cache.resetStatistics();
+    QCOMPARE(cache.lookupCount(), 0);
+    QCOMPARE(cache.hitCount(), 0);
+    QCOMPARE(cache.resumedCount(), 0);
+}
+
+QTEST_MAIN(tst_QSslSessionCache)
+#include "tst_qsslsessioncache.moc"
@@ -9,6 +9,7 @@
 #include <QtCore/qelapsedtimer.h>
 #include <QtCore/qrandom.h>
 #include <QtCore/qscopeguard.h>
+#include <QtCore/qtemporaryfile.h>
 #include <QtNetwork/qhostaddress.h>
 #include <QtNetwork/qhostinfo.h>
 #include <QtNetwork/qnetworkproxy.h>
@@ -32,6 +33,12 @@
 #include "private/qiodevice_p.h" // for QIODEVICE_BUFFERSIZE
 
 #include "../../../network-settings.h"
+
+#ifdef Q_OS_UNIX
+#include <signal.h>
+#include <sys/socket.h>
+#endif
+
 #include "../shared/tlshelpers.h"
 
 #if QT_CONFIG(openssl)
@@ -253,6 +260,18 @@ private slots:
     void selfSignedCertificates();
     void pskHandshake_data();
     void pskHandshake();
+    void kernelTlsRoundTrip_data();
+    void kernelTlsRoundTrip();
+    void kernelTlsWaitForBytesWritten_data();
+    void kernelTlsWaitForBytesWritten();
+    void kernelTlsDisconnectWithPendingData_data();
+    void kernelTlsDisconnectWithPendingData();
+    void kernelTlsSendFile_data();
+    void kernelTlsSendFile();
+    void kernelTlsMoveToThread_data();
+    void kernelTlsMoveToThread();
+    void kernelTlsWriteAfterShutdown_data();
+    void kernelTlsWriteAfterShutdown();
 #endif // openssl
 
     void setEmptyDefaultConfiguration(); // this test should be last
@@ -5095,6 +5114,342 @@ void tst_QSslSocket::pskHandshake()
     }
 }
 
+// QSsl::SslOptionEnableKernelTls is only a hint: the kernel may lack TLS
+// support or refuse the negotiated cipher, in which case records are
+// encrypted in user space. The tests below must pass either way.
+static void addKernelTlsRows()
+{
+    QTest::addColumn<QSsl::SslProtocol>("protocol");
+    QTest::addColumn<QString>("cipherName");
+
+    QTest::newRow("TlsV1_3") << QSsl::TlsV1_3OrLater << QString();
+    QTest::newRow("TlsV1_2-AES-GCM") << QSsl::TlsV1_2
+                                     << QStringLiteral("ECDHE-RSA-AES128-GCM-SHA256");
+    // The kernel does not offload CBC ciphers, so this always falls back.
+    QTest::newRow("TlsV1_2-AES-CBC") << QSsl::TlsV1_2 << QStringLiteral("ECDHE-RSA-AES128-SHA");
+}
+
+static QByteArray kernelTlsPayload(qsizetype size)
+{
+    QByteArray data(size, Qt::Uninitialized);
+    QRandomGenerator::global()->fillRange(reinterpret_cast<quint32 *>(data.data()),
+                                          data.size() / qsizetype(sizeof(quint32)));
+    return data;
+}
+
+// Connects client to server with kernel TLS requested on both ends.
+static void kernelTlsConnect(SslServer &server, QSslSocket &client)
+{
+    QFETCH(const QSsl::SslProtocol, protocol);
+    QFETCH(const QString, cipherName);
+
+    QList<QSslCipher> ciphers;
+    if (!cipherName.isEmpty()) {
+        const QSslCipher cipher(cipherName);
+        if (cipher.isNull())
+            QSKIP("The current backend doesn't support the requested cipher");
+        ciphers = {cipher};
+    }
+
+    // The plain socket's own notifier must be used to wait for the descriptor.
+    QTest::failOnWarning(QRegularExpression("Multiple socket notifiers"));
+    QTest::failOnWarning(QRegularExpression("QSocketNotifier: .* from another thread"));
+
+    server.protocol = protocol;
+    server.ciphers = ciphers;
+    server.config.setSslOption(QSsl::SslOptionEnableKernelTls, true);
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    QSslConfiguration config = client.sslConfiguration();
+    config.setProtocol(protocol);
+    if (!ciphers.isEmpty())
+        config.setCiphers(ciphers);
+    config.setPeerVerifyMode(QSslSocket::VerifyNone);
+    config.setSslOption(QSsl::SslOptionEnableKernelTls, true);
+    client.setSslConfiguration(config);
+
+    client.connectToHostEncrypted(QHostAddress(QHostAddress::LocalHost).toString(),
+                                  server.serverPort());
+    QTRY_VERIFY(client.isEncrypted());
+    QTRY_VERIFY(server.socket && server.socket->isEncrypted());
+    QCOMPARE(client.sslConfiguration().testSslOption(QSsl::SslOptionEnableKernelTls), true);
+}
+
+void tst_QSslSocket::kernelTlsRoundTrip_data()
+{
+    addKernelTlsRows();
+}
+
+void tst_QSslSocket::kernelTlsRoundTrip()
+{
+    if (!isTestingOpenSsl)
+        QSKIP("Kernel TLS is only supported by the OpenSSL backend");
+
+    QFETCH_GLOBAL(const bool, setProxy);
+    if (setProxy) // Kernel TLS is not used through a proxy.
+        return;
+
+    SslServer server(testDataDir + "certs/selfsigned-server.key",
+                     testDataDir + "certs/selfsigned-server.crt");
+    QSslSocket client;
+    kernelTlsConnect(server, client);
+    if (QTest::currentTestFailed() || QTest::currentTestResolved())
+        return;
+
+    QSslSocket *serverSocket = server.socket;
+    QByteArray clientReceived;
+    QByteArray serverReceived;
+    connect(&client, &QIODevice::readyRead, this, [&] { clientReceived += client.readAll(); });
+    connect(serverSocket, &QIODevice::readyRead, this,
+            [&] { serverReceived += serverSocket->readAll(); });
+
+    // Small writes first, then enough to fill the socket buffers in both
+    // directions at once.
+    const QByteArray toServer = "hello" + kernelTlsPayload(1024 * 1024);
+    const QByteArray toClient = "world" + kernelTlsPayload(1024 * 1024);
+    QCOMPARE(client.write(toServer.first(5)), 5);
+    QCOMPARE(serverSocket->write(toClient.first(5)), 5);
+    QTRY_COMPARE(serverReceived, toServer.first(5));
+    QTRY_COMPARE(clientReceived, toClient.first(5));
+
+    QCOMPARE(client.write(toServer.sliced(5)), toServer.size() - 5);
+    QCOMPARE(serverSocket->write(toClient.sliced(5)), toClient.size() - 5);
+    QTRY_COMPARE_WITH_TIMEOUT(serverReceived.size(), toServer.size(), 20s);
+    QTRY_COMPARE_WITH_TIMEOUT(clientReceived.size(), toClient.size(), 20s);
+    QCOMPARE(serverReceived, toServer);
+    QCOMPARE(clientReceived, toClient);
+    QCOMPARE(client.bytesToWrite(), 0);
+    QCOMPARE(serverSocket->bytesToWrite(), 0);
+}
+
+void tst_QSslSocket::kernelTlsWaitForBytesWritten_data()
+{
+    addKernelTlsRows();
+}
+
+void tst_QSslSocket::kernelTlsWaitForBytesWritten()
+{
+    if (!isTestingOpenSsl)
+        QSKIP("Kernel TLS is only supported by the OpenSSL backend");
+
+    QFETCH_GLOBAL(const bool, setProxy);
+    if (setProxy) // Kernel TLS is not used through a proxy.
+        return;
+
+    SslServer server(testDataDir + "certs/selfsigned-server.key",
+                     testDataDir + "certs/selfsigned-server.crt");
+    QSslSocket client;
+    kernelTlsConnect(server, client);
+    if (QTest::currentTestFailed() || QTest::currentTestResolved())
+        return;
+
+    QSslSocket *serverSocket = server.socket;
+    QByteArray received;
+    connect(serverSocket, &QIODevice::readyRead, this,
+            [&] { received += serverSocket->readAll(); });
+    qint64 written = 0;
+    connect(&client, &QIODevice::bytesWritten, this, [&](qint64 bytes) { written += bytes; });
+
+    // Nothing is pending yet, so there is nothing to wait for.
+    QVERIFY(!client.waitForBytesWritten(0));
+
+    // Small enough to fit into the socket buffers, since the server cannot
+    // read while we block.
+    const QByteArray payload = kernelTlsPayload(64 * 1024);
+    QCOMPARE(client.write(payload), payload.size());
+    QCOMPARE(client.bytesToWrite(), payload.size());
+    while (client.bytesToWrite() > 0)
+        QVERIFY(client.waitForBytesWritten(5000));
+    QCOMPARE(written, payload.size());
+
+    QTRY_COMPARE(received.size(), payload.size());
+    QCOMPARE(received, payload);
+}
+
+void tst_QSslSocket::kernelTlsDisconnectWithPendingData_data()
+{
+    addKernelTlsRows();
+}
+
+void tst_QSslSocket::kernelTlsDisconnectWithPendingData()
+{
+    if (!isTestingOpenSsl)
+        QSKIP("Kernel TLS is only supported by the OpenSSL backend");
+
+    QFETCH_GLOBAL(const bool, setProxy);
+    if (setProxy) // Kernel TLS is not used through a proxy.
+        return;
+
+    SslServer server(testDataDir + "certs/selfsigned-server.key",
+                     testDataDir + "certs/selfsigned-server.crt");
+    QSslSocket client;
+    kernelTlsConnect(server, client);
+    if (QTest::currentTestFailed() || QTest::currentTestResolved())
+        return;
+
+    QSslSocket *serverSocket = server.socket;
+    QByteArray received;
+    connect(serverSocket, &QIODevice::readyRead, this,
+            [&] { received += serverSocket->readAll(); });
+    QSignalSpy clientDisconnected(&client, &QAbstractSocket::disconnected);
+    QSignalSpy serverDisconnected(serverSocket, &QAbstractSocket::disconnected);
+
+    // More than the socket buffers hold, so that the disconnect has to wait
+    // for the data to drain.
+    const QByteArray payload = kernelTlsPayload(8 * 1024 * 1024);
+    QCOMPARE(client.write(payload), payload.size());
+    client.disconnectFromHost();
+    QVERIFY(client.state() == QAbstractSocket::ClosingState
+            || client.state() == QAbstractSocket::UnconnectedState);
+
+    QTRY_COMPARE_WITH_TIMEOUT(clientDisconnected.size(), 1, 20s);
+    QCOMPARE(client.state(), QAbstractSocket::UnconnectedState);
+    QCOMPARE(client.bytesToWrite(), 0);
+    QTRY_COMPARE(serverDisconnected.size(), 1);
+    received += serverSocket->readAll();
+    QCOMPARE(received.size(), payload.size());
+    QCOMPARE(received, payload);
+}
+
+void tst_QSslSocket::kernelTlsSendFile_data()
+{
+    addKernelTlsRows();
+}
+
+void tst_QSslSocket::kernelTlsSendFile()
+{
+    if (!isTestingOpenSsl)
+        QSKIP("Kernel TLS is only supported by the OpenSSL backend");
+
+    QFETCH_GLOBAL(const bool, setProxy);
+    if (setProxy) // Kernel TLS is not used through a proxy.
+        return;
+
+    SslServer server(testDataDir + "certs/selfsigned-server.key",
+                     testDataDir + "certs/selfsigned-server.crt");
+    QSslSocket client;
+    kernelTlsConnect(server, client);
+    if (QTest::currentTestFailed() || QTest::currentTestResolved())
+        return;
+
+    QSslSocket *serverSocket = server.socket;
+    QByteArray received;
+    connect(serverSocket, &QIODevice::readyRead, this,
+            [&] { received += serverSocket->readAll(); });
+
+    const QByteArray contents = kernelTlsPayload(2 * 1024 * 1024);
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(contents), contents.size());
+    QVERIFY(file.flush());
+    QVERIFY(file.seek(0));
+
+    // Whether the file goes through SSL_sendfile() or is read and encrypted
+    // in user space, it must arrive in order with the surrounding writes.
+    QCOMPARE(client.write("header"), 6);
+    QVERIFY(client.sendFile(&file, 1024, 1024 * 1024));
+    QVERIFY(client.sendFile(&file));
+    QCOMPARE(client.write("trailer"), 7);
+    QCOMPARE(file.pos(), 0);
+
+    const QByteArray expected = "header" + contents.sliced(1024, 1024 * 1024) + contents
+                                + "trailer";
+    QTRY_COMPARE_WITH_TIMEOUT(received.size(), expected.size(), 20s);
+    QCOMPARE(received, expected);
+    QTRY_COMPARE(client.bytesToWrite(), 0);
+}
+
+void tst_QSslSocket::kernelTlsMoveToThread_data()
+{
+    addKernelTlsRows();
+}
+
+void tst_QSslSocket::kernelTlsMoveToThread()
+{
+    if (!isTestingOpenSsl)
+        QSKIP("Kernel TLS is only supported by the OpenSSL backend");
+
+    QFETCH_GLOBAL(const bool, setProxy);
+    if (setProxy) // Kernel TLS is not used through a proxy.
+        return;
+
+    SslServer server(testDataDir + "certs/selfsigned-server.key",
+                     testDataDir + "certs/selfsigned-server.crt");
+    auto client = std::make_unique<QSslSocket>();
+    kernelTlsConnect(server, *client);
+    if (QTest::currentTestFailed() || QTest::currentTestResolved())
+        return;
+
+    QSslSocket *serverSocket = server.socket;
+    QByteArray received;
+    connect(serverSocket, &QIODevice::readyRead, this,
+            [&] { received += serverSocket->readAll(); });
+
+    QThread thread;
+    thread.start();
+    auto cleanup = qScopeGuard([&] {
+        QMetaObject::invokeMethod(client.get(), [&] { client.reset(); },
+                                  Qt::BlockingQueuedConnection);
+        thread.quit();
+        thread.wait();
+    });
+    client->moveToThread(&thread);
+
+    // More than fits into the socket buffers, so that the client has to
+    // wait for its descriptor to become writable in the new thread.
+    const QByteArray payload = kernelTlsPayload(4 * 1024 * 1024);
+    QMetaObject::invokeMethod(client.get(), [&] { client->write(payload); });
+    QTRY_COMPARE_WITH_TIMEOUT(received.size(), payload.size(), 20s);
+    QCOMPARE(received, payload);
+}
+
+void tst_QSslSocket::kernelTlsWriteAfterShutdown_data()
+{
+    addKernelTlsRows();
+}
+
+void tst_QSslSocket::kernelTlsWriteAfterShutdown()
+{
+#ifndef Q_OS_UNIX
+    QSKIP("SIGPIPE is specific to Unix");
+#else
+    if (!isTestingOpenSsl)
+        QSKIP("Kernel TLS is only supported by the OpenSSL backend");
+
+    QFETCH_GLOBAL(const bool, setProxy);
+    if (setProxy) // Kernel TLS is not used through a proxy.
+        return;
+
+    // Writing to the socket must not raise SIGPIPE, without changing how
+    // the process handles it.
+    struct sigaction previousAction = {};
+    struct sigaction defaultAction = {};
+    defaultAction.sa_handler = SIG_DFL;
+    QCOMPARE(::sigaction(SIGPIPE, &defaultAction, &previousAction), 0);
+    const auto restoreAction = qScopeGuard([&] {
+        ::sigaction(SIGPIPE, &previousAction, nullptr);
+    });
+
+    SslServer server(testDataDir + "certs/selfsigned-server.key",
+                     testDataDir + "certs/selfsigned-server.crt");
+    QSslSocket client;
+    kernelTlsConnect(server, client);
+    if (QTest::currentTestFailed() || QTest::currentTestResolved())
+        return;
+
+    // The next write to the descriptor fails with EPIPE.
+    QCOMPARE(::shutdown(int(client.socketDescriptor()), SHUT_WR), 0);
+    QCOMPARE(client.write("lost"), 4);
+    client.flush();
+    QTRY_VERIFY(client.error() != QAbstractSocket::UnknownSocketError
+                || client.state() == QAbstractSocket::UnconnectedState);
+
+    struct sigaction currentAction = {};
+    QCOMPARE(::sigaction(SIGPIPE, nullptr, &currentAction), 0);
+    QVERIFY(currentAction.sa_handler == SIG_DFL);
+#endif
+}
+
 #endif // QT_CONFIG(openssl)
 #endif // QT_CONFIG(ssl)
 
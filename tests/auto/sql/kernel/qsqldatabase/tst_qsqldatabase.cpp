@@ -3,6 +3,7 @@
 
 
 #include <QTest>
+#include <QScopeGuard>
 #include <QSignalSpy>
 
 #include <qsqldatabase.h>
@@ -176,6 +177,9 @@ private slots:
     void sqlite_check_json1_data() { generic_data("QSQLITE"); }
     void sqlite_check_json1();
 
+    void statementCache_data() { generic_data(); }
+    void statementCache();
+
 private:
     void createTestTables(const QSqlDatabase &db);
     void dropTestTables(const QSqlDatabase &db);
@@ -2218,6 +2222,91 @@ void tst_QSqlDatabase::sqlite_enableRegexp()
     QFAIL_SQL(q, next());
 }
 
+void tst_QSqlDatabase::statementCache()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+    QString option;
+    switch (tst_Databases::getDatabaseType(db)) {
+    case QSqlDriver::SQLite:
+        option = "QSQLITE_STATEMENT_CACHE_SIZE=2";
+        break;
+    case QSqlDriver::PostgreSQL:
+        option = "QPSQL_STATEMENT_CACHE_SIZE=2";
+        break;
+    default:
+        QSKIP("The statement cache is only implemented by QSQLITE and QPSQL");
+    }
+
+    const QString connectOptions = db.connectOptions();
+    db.close();
+    db.setConnectOptions(option);
+    QVERIFY_SQL(db, open());
+    const auto restoreOptions = qScopeGuard([&] {
+        db.close();
+        db.setConnectOptions(connectOptions);
+        db.open();
+    });
+    TableScope ts(db, "statement_cache", __FILE__);
+
+    QSqlQuery q(db);
+    QVERIFY_SQL(q, exec("CREATE TABLE " + ts.tableName() + "(id INT)"));
+
+    const QSqlDriver *driver = db.driver();
+    const qint64 hits = driver->property("statementCacheHits").toLongLong();
+    const qint64 misses = driver->property("statementCacheMisses").toLongLong();
+    const auto hitCount = [&] {
+        return driver->property("statementCacheHits").toLongLong() - hits;
+    };
+    const auto missCount = [&] {
+        return driver->property("statementCacheMisses").toLongLong() - misses;
+    };
+
+    // short-lived queries reuse the statement
+    const QString insert = "INSERT INTO " + ts.tableName() + " VALUES (?)";
+    for (int i = 0; i < 5; ++i) {
+        QSqlQuery query(db);
+        QVERIFY_SQL(query, prepare(insert));
+        query.addBindValue(i);
+        QVERIFY_SQL(query, exec());
+    }
+    QCOMPARE(hitCount(), 4);
+    QCOMPARE(missCount(), 1);
+
+    // a reused statement starts without results or bound values
+    const QString select = "SELECT id FROM " + ts.tableName() + " WHERE id >= ? ORDER BY id";
+    for (int i = 0; i < 3; ++i) {
+        QSqlQuery query(db);
+        QVERIFY_SQL(query, prepare(select));
+        query.addBindValue(i);
+        QVERIFY_SQL(query, exec());
+        for (int expected = i; expected < 5; ++expected) {
+            QVERIFY_SQL(query, next());
+            QCOMPARE(query.value(0).toInt(), expected);
+        }
+        QVERIFY(!query.next());
+    }
+    QCOMPARE(hitCount(), 6);
+    QCOMPARE(missCount(), 2);
+
+    // a statement in use is not shared
+    QSqlQuery q1(db);
+    QSqlQuery q2(db);
+    QVERIFY_SQL(q1, prepare(select));
+    QVERIFY_SQL(q2, prepare(select));
+    QCOMPARE(hitCount(), 7);
+    QCOMPARE(missCount(), 3);
+    q1.addBindValue(3);
+    q2.addBindValue(4);
+    QVERIFY_SQL(q1, exec());
+    QVERIFY_SQL(q2, exec());
+    QVERIFY_SQL(q1, next());
+    QVERIFY_SQL(q2, next());
+    QCOMPARE(q1.value(0).toInt(), 3);
+    QCOMPARE(q2.value(0).toInt(), 4);
+}
+
 void tst_QSqlDatabase::sqlite_openError()
 {
     // see QTBUG-70506
@@ -145,6 +145,8 @@ private slots:
     void psql_bindWithDoubleColonCastOperator();
     void psql_specialFloatValues_data() { generic_data("QPSQL"); }
     void psql_specialFloatValues();
+    void psql_batchExecLarge_data() { generic_data("QPSQL"); }
+    void psql_batchExecLarge();
     void queryOnInvalidDatabase_data() { generic_data(); }
     void queryOnInvalidDatabase();
     void createQueryOnClosedDatabase_data() { generic_data(); }
@@ -2865,6 +2867,110 @@ void tst_QSqlQuery::psql_bindWithDoubleColonCastOperator()
     QCOMPARE(q.executedQuery(), expected);
 }
 
+void tst_QSqlQuery::psql_batchExecLarge()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+
+    TableScope ts(db, "batchexec_large", __FILE__);
+    QSqlQuery q(db);
+    QVERIFY_SQL(q, exec(QLatin1String("create table %1 (id int primary key, name varchar(20))")
+                        .arg(ts.tableName())));
+
+    // more rows than are sent to the server in one go
+    constexpr int RowCount = 1000;
+    QVariantList ids;
+    QVariantList names;
+    for (int i = 0; i < RowCount; ++i) {
+        ids << i;
+        names << QString("name%1").arg(i);
+    }
+    const QString insert = QLatin1String("insert into %1 values (?, ?)").arg(ts.tableName());
+    QVERIFY_SQL(q, prepare(insert));
+    q.addBindValue(ids);
+    q.addBindValue(names);
+    QVERIFY_SQL(q, execBatch());
+
+    QVERIFY_SQL(q, exec(QLatin1String("select count(*), sum(id), max(name) from %1")
+                        .arg(ts.tableName())));
+    QVERIFY_SQL(q, next());
+    QCOMPARE(q.value(0).toInt(), RowCount);
+    QCOMPARE(q.value(1).toInt(), RowCount * (RowCount - 1) / 2);
+    QCOMPARE(q.value(2).toString(), u"name999");
+
+    // a failing row fails the batch, and the connection stays usable
+    QVERIFY_SQL(q, prepare(insert));
+    q.addBindValue(QVariantList{ RowCount, 0, RowCount + 1 });
+    q.addBindValue(QVariantList{ "new", "duplicate", "new" });
+    QVERIFY(!q.execBatch());
+    QVERIFY(q.lastError().isValid());
+    QCOMPARE(q.lastError().type(), QSqlError::StatementError);
+
+    QVERIFY_SQL(q, exec(QLatin1String("select count(*) from %1 where name = 'duplicate'")
+                        .arg(ts.tableName())));
+    QVERIFY_SQL(q, next());
+    QCOMPARE(q.value(0).toInt(), 0);
+
+    // Outside a transaction, the batch is one implicit transaction: a
+    // failing row leaves none of its rows committed. The failing row comes
+    // after enough rows to fill the socket buffers.
+    constexpr int BatchSize = 20000;
+    constexpr int FailingRow = BatchSize - 10;
+    ids.clear();
+    names.clear();
+    for (int i = 0; i < BatchSize; ++i) {
+        ids << (i == FailingRow ? 0 : RowCount + i);
+        names << QString("group%1").arg(i);
+    }
+    QVERIFY_SQL(q, prepare(insert));
+    q.addBindValue(ids);
+    q.addBindValue(names);
+    QVERIFY(!q.execBatch());
+    QCOMPARE(q.lastError().type(), QSqlError::StatementError);
+
+    QVERIFY_SQL(q, exec(QLatin1String("select count(*), max(id) from %1 where id >= %2")
+                        .arg(ts.tableName()).arg(RowCount)));
+    QVERIFY_SQL(q, next());
+    if (q.value(0).toInt() == FailingRow) {
+        // built against libpq < 14, which executes the rows one by one
+        QCOMPARE(q.value(1).toInt(), RowCount + FailingRow - 1);
+    } else {
+        QCOMPARE(q.value(0).toInt(), 0);
+    }
+
+    // inside a transaction, the failing row aborts the whole batch
+    QVERIFY_SQL(q, exec(QLatin1String("delete from %1 where id >= %2")
+                        .arg(ts.tableName()).arg(RowCount)));
+    QVERIFY(db.transaction());
+    QVERIFY_SQL(q, prepare(insert));
+    q.addBindValue(ids);
+    q.addBindValue(names);
+    QVERIFY(!q.execBatch());
+    QVERIFY(db.rollback());
+    QVERIFY_SQL(q, exec(QLatin1String("select count(*) from %1 where id >= %2")
+                        .arg(ts.tableName()).arg(RowCount)));
+    QVERIFY_SQL(q, next());
+    QCOMPARE(q.value(0).toInt(), 0);
+
+    // results larger than the socket buffers don't stall the batch
+    constexpr int ResultSize = 10000;
+    QVERIFY_SQL(q, prepare("select repeat(?, 10000)"));
+    q.addBindValue(QVariantList(2000, QString("x")));
+    QVERIFY_SQL(q, execBatch());
+    QVERIFY_SQL(q, next());
+    QCOMPARE(q.value(0).toString().size(), ResultSize);
+
+    // the batch is the query's current result
+    QVERIFY_SQL(q, prepare(insert));
+    q.addBindValue(QVariantList{ 2 * RowCount });
+    q.addBindValue(QVariantList{ "last" });
+    QVERIFY_SQL(q, execBatch());
+    QVERIFY(q.isActive());
+    QVERIFY(!q.lastError().isValid());
+    QCOMPARE(q.numRowsAffected(), 1);
+}
+
 void tst_QSqlQuery::psql_specialFloatValues()
 {
     if (!std::numeric_limits<float>::has_quiet_NaN)
@@ -32,6 +32,10 @@ private slots:
     void clearFilter_data();
     void clearFilter();
     void setSourceModel();
+    void filter_data();
+    void filter();
+    void sort_data();
+    void sort();
 
 private:
     QStringList m_numberList; ///< Cache the strings for efficiency.
@@ -107,6 +111,63 @@ void tst_QSortFilterProxyModel::setSourceModel()
     }
 }
 
+void tst_QSortFilterProxyModel::filter_data()
+{
+    QTest::addColumn<int>("itemCount");
+    QTest::addColumn<bool>("parallel");
+
+    for (int millionItemCount : { 1, 2, 4 }) {
+        const auto itemCount = millionItemCount * 1000 * 1000;
+        QTest::addRow("%dM", millionItemCount) << itemCount << false;
+        QTest::addRow("%dM, parallel", millionItemCount) << itemCount << true;
+    }
+}
+
+void tst_QSortFilterProxyModel::filter()
+{
+    QFETCH(const int, itemCount);
+    QFETCH(const bool, parallel);
+    resizeNumberList(m_numberList, itemCount);
+    QStringListModel model(std::as_const(m_numberList));
+
+    QSortFilterProxyModel proxy;
+    proxy.setParallelSortFilterEnabled(parallel);
+    proxy.setFilterRegularExpression(QStringLiteral("^[1-4].*7$"));
+
+    // measures the evaluation of the filter for all rows, without the
+    // cost of removing the rejected ones from an existing mapping
+    QBENCHMARK_ONCE {
+        proxy.setSourceModel(&model);
+        QVERIFY(proxy.rowCount() > 0);
+    }
+    QVERIFY(proxy.rowCount() < itemCount);
+}
+
+void tst_QSortFilterProxyModel::sort_data()
+{
+    filter_data();
+}
+
+void tst_QSortFilterProxyModel::sort()
+{
+    QFETCH(const int, itemCount);
+    QFETCH(const bool, parallel);
+    resizeNumberList(m_numberList, itemCount);
+    QStringListModel model(std::as_const(m_numberList));
+
+    QSortFilterProxyModel proxy;
+    proxy.setParallelSortFilterEnabled(parallel);
+    proxy.setSourceModel(&model);
+    QCOMPARE(proxy.rowCount(), itemCount);
+
+    // the numbers are sorted as strings, which reorders them
+    QBENCHMARK_ONCE {
+        proxy.sort(0);
+    }
+    QCOMPARE(proxy.index(0, 0).data().toString(), QStringLiteral("1"));
+    QCOMPARE(proxy.index(1, 0).data().toString(), QStringLiteral("10"));
+}
+
 QTEST_MAIN(tst_QSortFilterProxyModel)
 
 #include "tst_bench_qsortfilterproxymodel.moc"
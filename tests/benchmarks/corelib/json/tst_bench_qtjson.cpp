@@ -4,7 +4,9 @@
 #include <QTest>
 #include <QVariantMap>
 #include <qjsondocument.h>
+#include <qjsonarray.h>
 #include <qjsonobject.h>
+#include <qjsonstreamreader.h>
 
 class BenchmarkQtJson: public QObject
 {
@@ -21,6 +23,12 @@ private Q_SLOTS:
     void parseNumbers();
     void parseJson();
     void parseJsonToVariant();
+    void parseStrings_data();
+    void parseStrings();
+    void streamJson();
+    void ndjsonDocument();
+    void ndjsonStreamReader();
+    void ndjsonStreamReaderSkip();
 
     void jsonObjectInsert();
     void variantMapInsert();
@@ -93,6 +101,118 @@ void BenchmarkQtJson::parseJsonToVariant()
     }
 }
 
+void BenchmarkQtJson::parseStrings_data()
+{
+    QTest::addColumn<QByteArray>("json");
+
+    QJsonArray records;
+    for (int i = 0; i < 1000; ++i) {
+        records.append(QJsonObject{
+            { "name", QString("record number %1").arg(i) },
+            { "description", QString(200, u'x') + " lorem ipsum dolor sit amet" },
+            { "quoted", "a \"quoted\" word and a\\backslash in a longer sentence" },
+            { "unicode", QString::fromUtf8("gr\xc3\xbc\xc3\x9f Gott, \xe4\xbd\xa0\xe5\xa5\xbd") },
+            { "values", QJsonArray{ i, i * 2, i * 3 } },
+        });
+    }
+    const QJsonDocument doc(records);
+    QTest::newRow("compact") << doc.toJson(QJsonDocument::Compact);
+    QTest::newRow("indented") << doc.toJson(QJsonDocument::Indented);
+}
+
+void BenchmarkQtJson::parseStrings()
+{
+    QFETCH(QByteArray, json);
+
+    QBENCHMARK {
+        QJsonDocument doc = QJsonDocument::fromJson(json);
+        QCOMPARE(doc.array().size(), 1000);
+    }
+}
+
+void BenchmarkQtJson::streamJson()
+{
+    QString testFile = QFINDTESTDATA("test.json");
+    QVERIFY2(!testFile.isEmpty(), "cannot find test file test.json!");
+    QFile file(testFile);
+    file.open(QFile::ReadOnly);
+    QByteArray testJson = file.readAll();
+
+    QBENCHMARK {
+        QJsonStreamReader reader(testJson);
+        while (!reader.atEnd())
+            reader.readNext();
+    }
+}
+
+static QByteArray ndjsonData()
+{
+    QByteArray data;
+    for (int i = 0; i < 10000; ++i) {
+        data += "{\"id\": " + QByteArray::number(i)
+                + ", \"path\": \"/api/items/" + QByteArray::number(i % 97)
+                + "\", \"status\": " + (i % 13 ? "200" : "404")
+                + ", \"tags\": [\"alpha\", \"beta\", \"gamma\"]"
+                + ", \"timing\": {\"dns\": 1.25, \"connect\": 12.5, \"total\": 40.125}"
+                + ", \"agent\": \"Mozilla/5.0 (X11; Linux x86_64) benchmark\"}\n";
+    }
+    return data;
+}
+
+void BenchmarkQtJson::ndjsonDocument()
+{
+    QList<QByteArray> lines = ndjsonData().split('\n');
+    lines.removeLast();
+
+    QBENCHMARK {
+        qint64 errors = 0;
+        for (const QByteArray &line : std::as_const(lines)) {
+            const QJsonObject record = QJsonDocument::fromJson(line).object();
+            if (record.value("status").toInteger() != 200)
+                ++errors;
+        }
+        QCOMPARE(errors, 770);
+    }
+}
+
+void BenchmarkQtJson::ndjsonStreamReader()
+{
+    const QByteArray data = ndjsonData();
+
+    QBENCHMARK {
+        qint64 errors = 0;
+        QJsonStreamReader reader(data);
+        while (!reader.atEnd()) {
+            if (reader.readNext() == QJsonStreamReader::Number && reader.nameEquals("status")
+                && reader.toInteger() != 200) {
+                ++errors;
+            }
+        }
+        QCOMPARE(errors, 770);
+    }
+}
+
+void BenchmarkQtJson::ndjsonStreamReaderSkip()
+{
+    const QByteArray data = ndjsonData();
+
+    QBENCHMARK {
+        qint64 errors = 0;
+        QJsonStreamReader reader(data);
+        while (reader.readNext() == QJsonStreamReader::StartObject) {
+            while (reader.readNext() != QJsonStreamReader::EndObject && !reader.hasError()) {
+                if (reader.nameEquals("status")) {
+                    if (reader.toInteger() != 200)
+                        ++errors;
+                } else {
+                    reader.skipCurrentElement();
+                }
+            }
+        }
+        QCOMPARE(errors, 770);
+    }
+}
+
 void BenchmarkQtJson::jsonObjectInsert()
 {
     QJsonObject object;
@@ -5,6 +5,15 @@
 #include <qtest.h>
 #include <qtesteventloop.h>
 
+#include <memory>
+#include <thread>
+#include <vector>
+
+#ifdef Q_OS_UNIX
+#  include <sys/resource.h>
+#  include <unistd.h>
+#endif
+
 class PingPong : public QObject
 {
 public:
@@ -58,6 +67,14 @@ int EventTester::foo(int bar)
     return bar + 1;
 }
 
+class Producer : public QObject
+{
+    Q_OBJECT
+
+signals:
+    void progress(int value);
+};
+
 class EventsBench : public QObject
 {
     Q_OBJECT
@@ -71,6 +88,12 @@ private slots:
     void sendEvent();
     void postEvent_data();
     void postEvent();
+    void crossThreadPost_data();
+    void crossThreadPost();
+    void crossThreadSignals_data();
+    void crossThreadSignals();
+    void socketNotifiers_data();
+    void socketNotifiers();
 };
 
 void EventsBench::initTestCase()
@@ -145,6 +168,139 @@ void EventsBench::postEvent()
     }
 }
 
+void EventsBench::crossThreadPost_data()
+{
+    QTest::addColumn<int>("producers");
+    for (int producers : { 1, 4, 8 })
+        QTest::addRow("%d", producers) << producers;
+}
+
+void EventsBench::crossThreadPost()
+{
+    QFETCH(int, producers);
+    constexpr int CallsPerProducer = 10000;
+    const int total = producers * CallsPerProducer;
+
+    QObject receiver;
+    int received = 0;
+
+    QBENCHMARK {
+        received = 0;
+        std::vector<std::thread> threads;
+        threads.reserve(producers);
+        for (int i = 0; i < producers; ++i) {
+            threads.emplace_back([&receiver, &received, total] {
+                for (int n = 0; n < CallsPerProducer; ++n) {
+                    QMetaObject::invokeMethod(&receiver, [&received, total] {
+                        if (++received == total)
+                            QTestEventLoop::instance().exitLoop();
+                    }, Qt::QueuedConnection);
+                }
+            });
+        }
+        QTestEventLoop::instance().enterLoop(60);
+        for (std::thread &t : threads)
+            t.join();
+        QVERIFY(!QTestEventLoop::instance().timeout());
+    }
+    QCOMPARE(received, total);
+}
+
+void EventsBench::crossThreadSignals_data()
+{
+    QTest::addColumn<Qt::ConnectionType>("type");
+    QTest::newRow("queued") << Qt::QueuedConnection;
+    QTest::newRow("batched") << Qt::BatchedQueuedConnection;
+    QTest::newRow("coalesced") << Qt::CoalescedQueuedConnection;
+}
+
+void EventsBench::crossThreadSignals()
+{
+    QFETCH(Qt::ConnectionType, type);
+    constexpr int Emissions = 10000;
+
+    Producer producer;
+    QObject receiver;
+    connect(&producer, &Producer::progress, &receiver, [](int value) {
+        if (value == Emissions - 1)
+            QTestEventLoop::instance().exitLoop();
+    }, type);
+
+    QBENCHMARK {
+        std::thread thread([&producer] {
+            for (int i = 0; i < Emissions; ++i)
+                emit producer.progress(i);
+        });
+        QTestEventLoop::instance().enterLoop(60);
+        thread.join();
+        QVERIFY(!QTestEventLoop::instance().timeout());
+    }
+}
+
+void EventsBench::socketNotifiers_data()
+{
+    QTest::addColumn<int>("count");
+    for (int count : { 10, 100, 1000, 10000, 100000 })
+        QTest::addRow("%d", count) << count;
+}
+
+void EventsBench::socketNotifiers()
+{
+#ifdef Q_OS_UNIX
+    QFETCH(int, count);
+
+    // each idle notifier needs its own descriptor
+    const rlim_t needed = rlim_t(count) + 64;
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < needed) {
+        limit.rlim_cur = qMin(needed, limit.rlim_max);
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+    if (getrlimit(RLIMIT_NOFILE, &limit) != 0 || limit.rlim_cur < needed)
+        QSKIP("Not enough file descriptors available");
+
+    int idlePipe[2];
+    int activePipe[2];
+    QVERIFY(::pipe(idlePipe) == 0);
+    QVERIFY(::pipe(activePipe) == 0);
+
+    // idle notifiers that never fire, but that the dispatcher has to watch
+    std::vector<std::unique_ptr<QSocketNotifier>> idleNotifiers;
+    idleNotifiers.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        const int fd = ::dup(idlePipe[0]);
+        QVERIFY(fd >= 0);
+        idleNotifiers.push_back(std::make_unique<QSocketNotifier>(fd, QSocketNotifier::Read));
+    }
+
+    int activations = 0;
+    QSocketNotifier activeNotifier(activePipe[0], QSocketNotifier::Read);
+    connect(&activeNotifier, &QSocketNotifier::activated, this, [&] {
+        char c;
+        if (::read(activePipe[0], &c, 1) == 1)
+            ++activations;
+    });
+
+    QBENCHMARK {
+        const char c = 0;
+        QVERIFY(::write(activePipe[1], &c, 1) == 1);
+        QCoreApplication::processEvents();
+    }
+    QVERIFY(activations > 0);
+
+    for (const auto &notifier : idleNotifiers) {
+        const int fd = notifier->socket();
+        notifier->setEnabled(false);
+        ::close(fd);
+    }
+    activeNotifier.setEnabled(false);
+    for (int fd : { idlePipe[0], idlePipe[1], activePipe[0], activePipe[1] })
+        ::close(fd);
+#else
+    QSKIP("This benchmark requires Unix pipes");
+#endif
+}
+
 QTEST_MAIN(EventsBench)
 
 #include "tst_bench_events.moc"
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
 
 #include <qtest.h>
+#include <QtCore/qcoreapplication.h>
 #include <QtCore/qmetatype.h>
 
 class tst_QMetaType : public QObject
@@ -40,6 +41,30 @@ private slots:
     void constructInPlaceCopy();
     void constructInPlaceCopyStaticLess_data();
     void constructInPlaceCopyStaticLess();
+
+    void queuedCallArguments_data();
+    void queuedCallArguments();
+};
+
+class Emitter : public QObject
+{
+    Q_OBJECT
+
+signals:
+    void trivialArguments(int i, double d, qint64 l);
+    void stringArguments(const QString &s1, const QString &s2, const QString &s3);
+};
+
+class Receiver : public QObject
+{
+    Q_OBJECT
+
+public slots:
+    void trivialArguments(int, double, qint64) { ++calls; }
+    void stringArguments(const QString &, const QString &, const QString &) { ++calls; }
+
+public:
+    int calls = 0;
 };
 
 tst_QMetaType::tst_QMetaType()
@@ -295,5 +320,38 @@ void tst_QMetaType::constructInPlaceCopyStaticLess()
     qFreeAligned(storage);
 }
 
+void tst_QMetaType::queuedCallArguments_data()
+{
+    QTest::addColumn<bool>("trivial");
+    QTest::newRow("int, double, qint64") << true;
+    QTest::newRow("QString, QString, QString") << false;
+}
+
+void tst_QMetaType::queuedCallArguments()
+{
+    // the arguments of queued calls are copied using their metatypes
+    QFETCH(bool, trivial);
+    constexpr int Emissions = 10000;
+    const QString str = QStringLiteral("string");
+
+    Emitter emitter;
+    Receiver receiver;
+    connect(&emitter, &Emitter::trivialArguments, &receiver, &Receiver::trivialArguments,
+            Qt::QueuedConnection);
+    connect(&emitter, &Emitter::stringArguments, &receiver, &Receiver::stringArguments,
+            Qt::QueuedConnection);
+
+    QBENCHMARK {
+        for (int i = 0; i < Emissions; ++i) {
+            if (trivial)
+                emit emitter.trivialArguments(i, 0.5, i);
+            else
+                emit emitter.stringArguments(str, str, str);
+        }
+        QCoreApplication::sendPostedEvents(&receiver, QEvent::MetaCall);
+    }
+    QVERIFY(receiver.calls >= Emissions);
+}
+
 QTEST_MAIN(tst_QMetaType)
 #include "tst_bench_qmetatype.moc"
@@ -20,6 +20,8 @@ private slots:
     void signal_slot_benchmark_data();
     void signal_many_receivers();
     void signal_many_receivers_data();
+    void signal_fan_out();
+    void signal_fan_out_data();
     void qproperty_benchmark_data();
     void qproperty_benchmark();
     void dynamic_property_benchmark();
@@ -173,6 +175,39 @@ void tst_QObject::signal_many_receivers()
     }
 }
 
+void tst_QObject::signal_fan_out_data()
+{
+    QTest::addColumn<Qt::ConnectionType>("type");
+    QTest::addColumn<int>("receiverCount");
+    for (int count : { 1, 10, 100, 1000 }) {
+        QTest::addRow("direct--%d", count) << Qt::DirectConnection << count;
+        QTest::addRow("auto--%d", count) << Qt::AutoConnection << count;
+        QTest::addRow("queued--%d", count) << Qt::QueuedConnection << count;
+    }
+}
+
+void tst_QObject::signal_fan_out()
+{
+    QFETCH(Qt::ConnectionType, type);
+    QFETCH(int, receiverCount);
+    Object sender;
+    std::vector<Object> receivers(receiverCount);
+
+    for (Object &receiver : receivers)
+        QObject::connect(&sender, &Object::signal0, &receiver, &Object::slot0, type);
+
+    if (type == Qt::QueuedConnection) {
+        QBENCHMARK {
+            sender.emitSignal0();
+            QCoreApplication::sendPostedEvents();
+        }
+    } else {
+        QBENCHMARK {
+            sender.emitSignal0();
+        }
+    }
+}
+
 void tst_QObject::qproperty_benchmark_data()
 {
     QTest::addColumn<QByteArray>("name");
@@ -60,6 +60,8 @@ private slots:
     void createCoreType();
     void createCoreTypeCopy_data();
     void createCoreTypeCopy();
+    void createTrivialTypeCopy_data();
+    void createTrivialTypeCopy();
 };
 
 struct BigClass
@@ -82,6 +84,13 @@ Q_DECLARE_TYPEINFO(SmallClass, Q_RELOCATABLE_TYPE);
 QT_END_NAMESPACE
 Q_DECLARE_METATYPE(SmallClass);
 
+template <int Size>
+struct TrivialClass
+{
+    char data[Size];
+};
+static_assert(std::is_trivially_copyable_v<TrivialClass<32>>);
+
 void tst_QVariant::testBound()
 {
     qreal d = qreal(.5);
@@ -351,6 +360,30 @@ void tst_QVariant::createCoreTypeCopy()
     }
 }
 
+void tst_QVariant::createTrivialTypeCopy_data()
+{
+    QTest::addColumn<QMetaType>("metaType");
+    QTest::newRow("8 bytes") << QMetaType::fromType<TrivialClass<8>>();
+    QTest::newRow("16 bytes") << QMetaType::fromType<TrivialClass<16>>();
+    QTest::newRow("24 bytes") << QMetaType::fromType<TrivialClass<24>>();
+    QTest::newRow("32 bytes") << QMetaType::fromType<TrivialClass<32>>();
+    QTest::newRow("48 bytes") << QMetaType::fromType<TrivialClass<48>>();
+}
+
+// Tests how fast trivially copyable types of various sizes can be
+// copy-constructed by a QVariant. Types that fit into the internal
+// storage of QVariant need no memory allocation.
+void tst_QVariant::createTrivialTypeCopy()
+{
+    QFETCH(QMetaType, metaType);
+    QVariant other(metaType);
+    const void *copy = other.constData();
+    QBENCHMARK {
+        for (int i = 0; i < ITERATION_COUNT; ++i)
+            QVariant(metaType, copy);
+    }
+}
+
 QTEST_MAIN(tst_QVariant)
 
 #include "tst_bench_qvariant.moc"
@@ -4,8 +4,10 @@
 #include <QByteArray>
 #include <QLatin1StringView>
 #include <QFile>
+#include <QSmallString>
 #include <QTest>
 #include <limits>
+#include <vector>
 
 using namespace Qt::StringLiterals;
 
@@ -55,12 +57,20 @@ private slots:
     void operator_assign_L1SV() { operator_assign<QLatin1StringView>(); }
     void operator_assign_L1SV_data() { operator_assign_data(); }
 
+    // many short strings:
+    void manyShortStrings_QString_data() { manyShortStrings_data(); }
+    void manyShortStrings_QString() { manyShortStrings<QString>(); }
+    void manyShortStrings_QSmallString_data() { manyShortStrings_data(); }
+    void manyShortStrings_QSmallString() { manyShortStrings<QSmallString>(); }
+
 private:
     void section_data_impl(bool includeRegExOnly = true);
     template <typename RX> void section_impl();
     template <typename Integer> void number_impl();
     template <typename T> void operator_assign();
     void operator_assign_data();
+    void manyShortStrings_data();
+    template <typename String> void manyShortStrings();
 };
 
 tst_QString::tst_QString()
@@ -505,6 +515,31 @@ void tst_QString::operator_assign_data()
     QTest::newRow("length: 1'000") << data;
 }
 
+void tst_QString::manyShortStrings_data()
+{
+    QTest::addColumn<int>("length");
+
+    for (int length : { 3, 8, 10, 20 })
+        QTest::addRow("length: %d", length) << length;
+}
+
+template <typename String> void tst_QString::manyShortStrings()
+{
+    QFETCH(int, length);
+    constexpr int Count = 10'000;
+
+    // like the keys and identifiers read from a document
+    const QString source = QString(length + Count, u'k');
+    std::vector<String> strings;
+    strings.reserve(Count);
+
+    QBENCHMARK {
+        strings.clear();
+        for (int i = 0; i < Count; ++i)
+            strings.emplace_back(QStringView(source).sliced(i, length));
+    }
+}
+
 QTEST_APPLESS_MAIN(tst_QString)
 
 #include "tst_bench_qstring.moc"
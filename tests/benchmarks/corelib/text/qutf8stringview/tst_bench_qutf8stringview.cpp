@@ -7,6 +7,8 @@
 #include <qtest.h>
 #include <qutf8stringview.h>
 
+using namespace Qt::StringLiterals;
+
 class tst_QUtf8StringView : public QObject
 {
     Q_OBJECT
@@ -36,7 +38,13 @@ private slots:
     void compareStringsWithErrors_data();
     void compareStringsWithErrors();
 
+    void fromUtf8_data() { conversion_data(); }
+    void fromUtf8();
+    void toUtf8_data() { conversion_data(); }
+    void toUtf8();
+
 private:
+    void conversion_data();
     void equalStrings_data();
     void compareStringsCaseSensitive_data();
     void compareStringsCaseInsensitive_data();
@@ -258,6 +266,46 @@ void tst_QUtf8StringView::compareStringsWithErrors()
     QCOMPARE(-result, rhv.compare(lhv, cs));
 }
 
+void tst_QUtf8StringView::conversion_data()
+{
+    QTest::addColumn<QString>("text");
+
+    // about 64 kB of UTF-16 each
+    auto addRow = [](const char *name, const QString &sample) {
+        QTest::newRow(name) << sample.repeated(32768 / sample.size());
+    };
+    addRow("ascii", u"The quick brown fox jumps over the lazy dog. "_s);
+    addRow("latin1", u"Zwölf Boxkämpfer jagen Viktor quer über den großen Sylter Deich. "_s);
+    addRow("cyrillic", u"Съешь же ещё этих мягких французских булок, да выпей чаю. "_s);
+    addRow("cjk", u"天地玄黄宇宙洪荒日月盈昃辰宿列张寒来暑往秋收冬藏。いろはにほへとちりぬるを。"_s);
+    addRow("mixed", u"Tokyo 東京, Москва, Αθήνα, Zürich and Kraków. "_s);
+    addRow("emoji", u"Smile \U0001F600, cat \U0001F431 and rocket \U0001F680! "_s);
+}
+
+void tst_QUtf8StringView::fromUtf8()
+{
+    QFETCH(QString, text);
+    const QByteArray utf8 = text.toUtf8();
+
+    QString result;
+    QBENCHMARK {
+        result = QString::fromUtf8(utf8);
+    }
+    QCOMPARE(result, text);
+}
+
+void tst_QUtf8StringView::toUtf8()
+{
+    QFETCH(QString, text);
+    const QByteArray expected = text.toUtf8();
+
+    QByteArray result;
+    QBENCHMARK {
+        result = text.toUtf8();
+    }
+    QCOMPARE(result, expected);
+}
+
 QTEST_MAIN(tst_QUtf8StringView)
 
 #include "tst_bench_qutf8stringview.moc"
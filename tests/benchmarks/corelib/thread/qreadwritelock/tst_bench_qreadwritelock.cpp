@@ -82,6 +82,8 @@ private slots:
     void readOnly();
     void writeOnly_data();
     void writeOnly();
+    void readScaling_data();
+    void readScaling();
     // void readWrite();
 };
 
@@ -95,6 +97,16 @@ struct FunctionPtrHolder
 };
 Q_DECLARE_METATYPE(FunctionPtrHolder)
 
+struct ScalingFunctionHolder
+{
+    ScalingFunctionHolder(void (*value)(int) = nullptr)
+        : value(value)
+    {
+    }
+    void (*value)(int);
+};
+Q_DECLARE_METATYPE(ScalingFunctionHolder)
+
 struct FakeLock
 {
     FakeLock(volatile int *i) { *i = 0; }
@@ -294,5 +306,78 @@ void tst_QReadWriteLock::writeOnly()
     holder.value();
 }
 
+// Like readOnly(), for a growing number of threads, and with QReadCopyUpdate
+// as a lock-free alternative: how well do readers scale with the number of cores?
+template <typename Mutex, typename Locker>
+void testReadScaling(int threads)
+{
+    Mutex lock;
+    std::vector<std::unique_ptr<QThread>> readers;
+    QBENCHMARK {
+        readers.clear();
+        for (int i = 0; i < threads; ++i) {
+            readers.emplace_back(QThread::create([&lock] {
+                for (int i = 0; i < Iterations; ++i) {
+                    QString s = QString::number(i); // Do something outside the lock
+                    Locker locker(&lock);
+                    global_hash.contains(s);
+                }
+            }));
+        }
+        for (auto &t : readers)
+            t->start();
+        for (auto &t : readers)
+            t->wait();
+    }
+}
+
+static void testReadScalingReadCopyUpdate(int threads)
+{
+    QReadCopyUpdate<QHash<QString, QString>> rcu(global_hash);
+    std::vector<std::unique_ptr<QThread>> readers;
+    QBENCHMARK {
+        readers.clear();
+        for (int i = 0; i < threads; ++i) {
+            readers.emplace_back(QThread::create([&rcu] {
+                for (int i = 0; i < Iterations; ++i) {
+                    QString s = QString::number(i); // Do something outside the lock
+                    rcu.read()->contains(s);
+                }
+            }));
+        }
+        for (auto &t : readers)
+            t->start();
+        for (auto &t : readers)
+            t->wait();
+    }
+}
+
+void tst_QReadWriteLock::readScaling_data()
+{
+    QTest::addColumn<ScalingFunctionHolder>("holder");
+    QTest::addColumn<int>("threads");
+
+    for (int threads = 1; threads <= 2 * threadCount; threads *= 2) {
+        QTest::addRow("QReadWriteLock, %d threads", threads)
+            << ScalingFunctionHolder(testReadScaling<QReadWriteLock, QReadLocker>) << threads;
+#ifdef __cpp_lib_shared_mutex
+        QTest::addRow("std::shared_mutex, %d threads", threads)
+            << ScalingFunctionHolder(
+                   testReadScaling<std::shared_mutex,
+                                   LockerWrapper<std::shared_lock<std::shared_mutex>>>)
+            << threads;
+#endif
+        QTest::addRow("QReadCopyUpdate, %d threads", threads)
+            << ScalingFunctionHolder(testReadScalingReadCopyUpdate) << threads;
+    }
+}
+
+void tst_QReadWriteLock::readScaling()
+{
+    QFETCH(ScalingFunctionHolder, holder);
+    QFETCH(int, threads);
+    holder.value(threads);
+}
+
 QTEST_MAIN(tst_QReadWriteLock)
 #include "tst_bench_qreadwritelock.moc"
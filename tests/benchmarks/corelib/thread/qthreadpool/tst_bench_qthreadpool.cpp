@@ -15,6 +15,8 @@ public:
 private slots:
     void startRunnables();
     void activeThreadCount();
+    void contention_data();
+    void contention();
 };
 
 tst_QThreadPool::tst_QThreadPool()
@@ -50,6 +52,39 @@ void tst_QThreadPool::activeThreadCount()
     }
 }
 
+void tst_QThreadPool::contention_data()
+{
+    QTest::addColumn<int>("threadCount");
+
+    const int idealThreadCount = QThread::idealThreadCount();
+    for (int threadCount = 1; threadCount < idealThreadCount; threadCount *= 2)
+        QTest::addRow("%d threads", threadCount) << threadCount;
+    QTest::addRow("%d threads", idealThreadCount) << idealThreadCount;
+}
+
+void tst_QThreadPool::contention()
+{
+    QFETCH(int, threadCount);
+    constexpr int TaskCount = 100000;
+
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(threadCount);
+    QSemaphore gate;
+    QSemaphore done;
+
+    QBENCHMARK {
+        // hold the workers back until everything is queued, so that they
+        // all compete for the queue at the same time
+        for (int i = 0; i < threadCount; ++i)
+            threadPool.start([&gate] { gate.acquire(); });
+        for (int i = 0; i < TaskCount; ++i)
+            threadPool.start([&done] { done.release(); });
+        gate.release(threadCount);
+        done.acquire(TaskCount);
+    }
+    QVERIFY(threadPool.waitForDone());
+}
+
 QTEST_MAIN(tst_QThreadPool)
 
 #include "tst_bench_qthreadpool.moc"
@@ -0,0 +1,108 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QConcurrentHash>
+#include <QHash>
+#include <QReadWriteLock>
+#include <QTest>
+#include <QThread>
+
+#include <memory>
+#include <vector>
+
+// A QHash behind a QReadWriteLock, the usual way of sharing a hash between threads.
+template <typename Key, typename T>
+class LockedHash
+{
+public:
+    T value(const Key &key, const T &defaultValue = T()) const
+    {
+        QReadLocker locker(&lock);
+        return hash.value(key, defaultValue);
+    }
+    void insert(const Key &key, const T &value)
+    {
+        QWriteLocker locker(&lock);
+        hash.insert(key, value);
+    }
+
+private:
+    mutable QReadWriteLock lock;
+    QHash<Key, T> hash;
+};
+
+class tst_QConcurrentHash : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void readMostly_data();
+    void readMostly_locked() { readMostly<LockedHash<int, int>>(); }
+    void readMostly_locked_data() { readMostly_data(); }
+    void readMostly_concurrent() { readMostly<QConcurrentHash<int, int>>(); }
+    void readMostly_concurrent_data() { readMostly_data(); }
+
+private:
+    template <typename Hash> void readMostly();
+};
+
+void tst_QConcurrentHash::initTestCase()
+{
+    QHashSeed::setDeterministicGlobalSeed();
+}
+
+void tst_QConcurrentHash::readMostly_data()
+{
+    QTest::addColumn<int>("threadCount");
+    QTest::addColumn<int>("writesPerMille");
+
+    const int maxThreads = qMax(QThread::idealThreadCount(), 2);
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        for (int writes : { 0, 10 }) {
+            QTest::addRow("%d threads, %d%% writes", threads, writes / 10)
+                    << threads << writes;
+        }
+    }
+}
+
+template <typename Hash>
+void tst_QConcurrentHash::readMostly()
+{
+    QFETCH(int, threadCount);
+    QFETCH(int, writesPerMille);
+
+    constexpr int NKeys = 100000;
+    constexpr int OperationsPerThread = 1000000;
+
+    Hash hash;
+    for (int i = 0; i < NKeys; ++i)
+        hash.insert(i, i);
+
+    QBENCHMARK {
+        std::vector<std::unique_ptr<QThread>> threads;
+        for (int t = 0; t < threadCount; ++t) {
+            threads.emplace_back(QThread::create([&hash, t, writesPerMille] {
+                quint32 state = quint32(t) * 7919;
+                int sum = 0;
+                for (int i = 0; i < OperationsPerThread; ++i) {
+                    state = state * 1103515245 + 12345;
+                    const int key = int((state >> 8) % NKeys);
+                    if (int((state >> 16) % 1000) < writesPerMille)
+                        hash.insert(key, i);
+                    else
+                        sum += hash.value(key);
+                }
+                [[maybe_unused]] volatile int result = sum;
+            }));
+        }
+        for (auto &thread : threads)
+            thread->start();
+        for (auto &thread : threads)
+            thread->wait();
+    }
+}
+
+QTEST_MAIN(tst_QConcurrentHash)
+
+#include "tst_bench_qconcurrenthash.moc"
@@ -13,6 +13,9 @@
 #include <QUuid>
 #include <QTest>
 
+#include <algorithm>
+#include <random>
+
 static constexpr quint64 RandomSeed32 = 1045982819;
 static constexpr quint64 RandomSeed64 = QtPrivate::QHashCombine{}(RandomSeed32, RandomSeed32);
 
@@ -49,8 +52,15 @@ private slots:
     void hashing_nonzero_qlatin1string_data() { data(); }
     void hashing_nonzero_qlatin1string() { hashing_nonzero_template<OwningLatin1String>(); }
 
+    void lookup_int_data() { lookup_data(); }
+    void lookup_int() { lookup_template<qint64>(); }
+    void lookup_string_data() { lookup_data(); }
+    void lookup_string() { lookup_template<QString>(); }
+
 private:
     void data();
+    void lookup_data();
+    template <typename Key> void lookup_template();
     template <typename String> void qhash_template();
     template <typename String, size_t Seed = 0> void hashing_template();
     template <typename String> void hashing_nonzero_template()
@@ -176,6 +186,47 @@ template <typename String, size_t Seed> void tst_QHash::hashing_template()
     }
 }
 
+void tst_QHash::lookup_data()
+{
+    QTest::addColumn<qsizetype>("size");
+    QTest::addColumn<bool>("hit");
+
+    for (qsizetype size : { 1000, 1000000, 4000000 }) {
+        QTest::addRow("hit-%lld", qlonglong(size)) << size << true;
+        QTest::addRow("miss-%lld", qlonglong(size)) << size << false;
+    }
+}
+
+template <typename Key> static Key lookupKey(qsizetype i);
+template <> qint64 lookupKey<qint64>(qsizetype i) { return i; }
+template <> QString lookupKey<QString>(qsizetype i) { return QString::number(i); }
+
+template <typename Key> void tst_QHash::lookup_template()
+{
+    // lookups in a table filled up to just below its growth threshold,
+    // with the keys that are looked up either all present or all absent
+    QFETCH(qsizetype, size);
+    QFETCH(bool, hit);
+
+    QHash<Key, qsizetype> hash;
+    hash.reserve(size);
+    QList<Key> keys;
+    keys.reserve(size);
+    for (qsizetype i = 0; i < size; ++i) {
+        hash.insert(lookupKey<Key>(2 * i), i);
+        keys.append(lookupKey<Key>(hit ? 2 * i : 2 * i + 1));
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(RandomSeed32));
+
+    qsizetype found = 0;
+    QBENCHMARK {
+        found = 0;
+        for (const Key &key : std::as_const(keys))
+            found += hash.contains(key);
+    }
+    QCOMPARE(found, hit ? size : 0);
+}
+
 QTEST_MAIN(tst_QHash)
 
 #include "tst_bench_qhash.moc"
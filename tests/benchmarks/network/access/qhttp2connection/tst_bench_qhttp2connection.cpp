@@ -0,0 +1,197 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QTest>
+
+#include <QtCore/qeventloop.h>
+
+#include <QtNetwork/qtcpserver.h>
+#include <QtNetwork/qtcpsocket.h>
+#include <QtNetwork/private/qhttp2connection_p.h>
+
+#include <memory>
+
+using namespace Qt::StringLiterals;
+
+class tst_QHttp2Connection : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void download_data();
+    void download();
+    void upload_data();
+    void upload();
+
+private:
+    struct Connections
+    {
+        std::unique_ptr<QTcpSocket> clientSocket;
+        QTcpSocket *serverSocket = nullptr;
+        QHttp2Connection *client = nullptr;
+        QHttp2Connection *server = nullptr;
+    };
+    bool connectOverLoopback(Connections &connections, const QHttp2Configuration &config);
+    void addRows();
+
+    QTcpServer tcpServer;
+};
+
+static HPack::HttpHeader requestHeaders(const QByteArray &method)
+{
+    return HPack::HttpHeader{
+        { ":authority", "localhost" },
+        { ":method", method },
+        { ":path", "/" },
+        { ":scheme", "http" },
+    };
+}
+
+bool tst_QHttp2Connection::connectOverLoopback(Connections &connections,
+                                               const QHttp2Configuration &config)
+{
+    if (!tcpServer.isListening() && !tcpServer.listen(QHostAddress::LocalHost))
+        return false;
+    connections.clientSocket = std::make_unique<QTcpSocket>();
+    connections.clientSocket->connectToHost(QHostAddress::LocalHost, tcpServer.serverPort());
+    if (!connections.clientSocket->waitForConnected() || !tcpServer.waitForNewConnection(5000))
+        return false;
+    connections.serverSocket = tcpServer.nextPendingConnection();
+    connections.clientSocket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+    connections.serverSocket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+
+    // Both ends use the same configuration, for the windows to apply to either direction:
+    connections.client = QHttp2Connection::createDirectConnection(connections.clientSocket.get(),
+                                                                  config);
+    connections.server = QHttp2Connection::createDirectServerConnection(connections.serverSocket,
+                                                                        config);
+    connect(connections.clientSocket.get(), &QIODevice::readyRead, connections.client,
+            &QHttp2Connection::handleReadyRead);
+    connect(connections.serverSocket, &QIODevice::readyRead, connections.server,
+            &QHttp2Connection::handleReadyRead);
+
+    bool clientSettings = false;
+    bool serverSettings = false;
+    connect(connections.client, &QHttp2Connection::settingsFrameReceived, this,
+            [&clientSettings] { clientSettings = true; });
+    connect(connections.server, &QHttp2Connection::settingsFrameReceived, this,
+            [&serverSettings] { serverSettings = true; });
+    return QTest::qWaitFor([&] { return clientSettings && serverSettings; });
+}
+
+void tst_QHttp2Connection::addRows()
+{
+    QTest::addColumn<int>("streamCount");
+    QTest::addColumn<bool>("adaptiveWindow");
+
+    // 32 MiB per iteration in total:
+    for (int streamCount : { 1, 8, 64 }) {
+        for (bool adaptiveWindow : { false, true }) {
+            QTest::addRow("%d-streams%s", streamCount, adaptiveWindow ? "-adaptive" : "")
+                    << streamCount << adaptiveWindow;
+        }
+    }
+}
+
+static constexpr qsizetype TotalSize = 32 * 1024 * 1024;
+
+void tst_QHttp2Connection::download_data()
+{
+    addRows();
+}
+
+void tst_QHttp2Connection::download()
+{
+    QFETCH(const int, streamCount);
+    QFETCH(const bool, adaptiveWindow);
+
+    QHttp2Configuration config;
+    config.setAdaptiveReceiveWindowEnabled(adaptiveWindow);
+    Connections connections;
+    QVERIFY(connectOverLoopback(connections, config));
+
+    const QByteArray payload(TotalSize / streamCount, 'a');
+    connect(connections.server, &QHttp2Connection::newIncomingStream, this,
+            [&payload](QHttp2Stream *stream) {
+                connect(stream, &QHttp2Stream::headersReceived, stream, [stream, &payload] {
+                    stream->sendHEADERS({ { ":status", "200" } }, false);
+                    stream->sendDATA(payload, true);
+                });
+                connect(stream, &QHttp2Stream::uploadFinished, stream, &QObject::deleteLater);
+            });
+
+    QBENCHMARK {
+        QEventLoop loop;
+        qsizetype received = 0;
+        int finished = 0;
+        for (int i = 0; i < streamCount; ++i) {
+            QHttp2Stream *stream = connections.client->createStream().unwrap();
+            connect(stream, &QHttp2Stream::dataReceived, this,
+                    [&, stream](const QByteArray &data, bool endStream) {
+                        received += data.size();
+                        stream->clearDownloadBuffer();
+                        if (!endStream)
+                            return;
+                        stream->deleteLater();
+                        if (++finished == streamCount)
+                            loop.quit();
+                    });
+            stream->sendHEADERS(requestHeaders("GET"), true);
+        }
+        loop.exec();
+        QCOMPARE(received, payload.size() * streamCount);
+    }
+}
+
+void tst_QHttp2Connection::upload_data()
+{
+    addRows();
+}
+
+void tst_QHttp2Connection::upload()
+{
+    QFETCH(const int, streamCount);
+    QFETCH(const bool, adaptiveWindow);
+
+    QHttp2Configuration config;
+    config.setAdaptiveReceiveWindowEnabled(adaptiveWindow);
+    Connections connections;
+    QVERIFY(connectOverLoopback(connections, config));
+
+    qsizetype received = 0;
+    connect(connections.server, &QHttp2Connection::newIncomingStream, this,
+            [this, &received](QHttp2Stream *stream) {
+                connect(stream, &QHttp2Stream::dataReceived, this,
+                        [stream, &received](const QByteArray &data, bool endStream) {
+                            received += data.size();
+                            stream->clearDownloadBuffer();
+                            if (endStream) {
+                                stream->sendHEADERS({ { ":status", "200" } }, true);
+                                stream->deleteLater();
+                            }
+                        });
+            });
+
+    const QByteArray payload(TotalSize / streamCount, 'a');
+    QBENCHMARK {
+        QEventLoop loop;
+        received = 0;
+        int finished = 0;
+        for (int i = 0; i < streamCount; ++i) {
+            QHttp2Stream *stream = connections.client->createStream().unwrap();
+            connect(stream, &QHttp2Stream::headersReceived, this, [&, stream] {
+                stream->deleteLater();
+                if (++finished == streamCount)
+                    loop.quit();
+            });
+            stream->sendHEADERS(requestHeaders("POST"), false);
+            stream->sendDATA(payload, true);
+        }
+        loop.exec();
+        QCOMPARE(received, payload.size() * streamCount);
+    }
+}
+
+QTEST_MAIN(tst_QHttp2Connection)
+
+#include "tst_bench_qhttp2connection.moc"
@@ -9,7 +9,9 @@
 #include <QSemaphore>
 #include <QTimer>
 #include <QtCore/qrandom.h>
+#include <QtCore/qendian.h>
 #include <QtCore/QElapsedTimer>
+#include <QtNetwork/qhttp2configuration.h>
 #include <QtNetwork/qnetworkreply.h>
 #include <QtNetwork/qnetworkrequest.h>
 #include <QtNetwork/qnetworkaccessmanager.h>
@@ -17,6 +19,12 @@
 #include <QtNetwork/qtcpserver.h>
 #include "../../../../auto/network-settings.h"
 
+#include <algorithm>
+
+#ifdef Q_OS_LINUX
+#include <QtCore/qfile.h>
+#endif
+
 #ifdef QT_BUILD_INTERNAL
 #include <QtNetwork/private/qhostinfo_p.h>
 #endif
@@ -402,6 +410,130 @@ class HttpDownloadPerformanceClient : QObject {
 
 };
 
+// Serves one response body of a given size over cleartext HTTP/2 with prior
+// knowledge. It keeps to the flow control windows the client grants and only
+// writes more once the socket has flushed, so that it does not buffer the
+// body itself.
+class Http2DownloadServer : public QObject
+{
+    enum FrameType : quint8 { Data = 0, Headers = 1, Settings = 4, Ping = 6, WindowUpdate = 8 };
+    enum FrameFlag : quint8 { EndStream = 0x1, Ack = 0x1, EndHeaders = 0x4 };
+    static constexpr qint64 FrameHeaderSize = 9;
+    static constexpr qint64 MaxFrameSize = 16384; // the default SETTINGS_MAX_FRAME_SIZE
+
+    qint64 dataSize;
+    qint64 dataSent = 0;
+    QTcpServer server;
+    QTcpSocket *client = nullptr;
+    QByteArray buffer;
+    bool prefaceReceived = false;
+    quint32 streamId = 0;
+    qint64 initialStreamWindow = 65535;
+    qint64 streamWindow = 0;
+    qint64 sessionWindow = 65535;
+
+public:
+    explicit Http2DownloadServer(qint64 size) : dataSize(size)
+    {
+        server.listen(QHostAddress::LocalHost);
+        connect(&server, &QTcpServer::newConnection, this, [this] {
+            client = server.nextPendingConnection();
+            client->setParent(this);
+            connect(client, &QIODevice::readyRead, this, &Http2DownloadServer::readFrames);
+            connect(client, &QIODevice::bytesWritten, this, &Http2DownloadServer::sendData);
+            writeFrame(Settings, 0, 0, {});
+        });
+    }
+
+    int serverPort() const { return server.serverPort(); }
+
+private:
+    void writeFrame(FrameType type, quint8 flags, quint32 stream, QByteArrayView payload)
+    {
+        char header[FrameHeaderSize];
+        qToBigEndian<quint32>(quint32(payload.size()) << 8 | type, header);
+        header[4] = char(flags);
+        qToBigEndian<quint32>(stream, header + 5);
+        client->write(header, FrameHeaderSize);
+        client->write(payload.data(), payload.size());
+    }
+
+    void readFrames()
+    {
+        buffer += client->readAll();
+        if (!prefaceReceived) {
+            constexpr qsizetype PrefaceSize = 24; // "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n"
+            if (buffer.size() < PrefaceSize)
+                return;
+            buffer.remove(0, PrefaceSize);
+            prefaceReceived = true;
+        }
+
+        while (buffer.size() >= FrameHeaderSize) {
+            const qint64 length = qFromBigEndian<quint32>(buffer.constData()) >> 8;
+            if (buffer.size() < FrameHeaderSize + length)
+                break;
+            const quint8 type = quint8(buffer.at(3));
+            const quint8 flags = quint8(buffer.at(4));
+            const quint32 stream = qFromBigEndian<quint32>(buffer.constData() + 5) & 0x7fffffff;
+            const QByteArray payload = buffer.mid(FrameHeaderSize, length);
+            buffer.remove(0, FrameHeaderSize + length);
+            handleFrame(type, flags, stream, payload);
+        }
+        sendData();
+    }
+
+    void handleFrame(quint8 type, quint8 flags, quint32 stream, const QByteArray &payload)
+    {
+        switch (type) {
+        case Settings:
+            if (flags & Ack)
+                break;
+            for (qsizetype i = 0; i + 6 <= payload.size(); i += 6) {
+                if (qFromBigEndian<quint16>(payload.constData() + i) != 0x4)
+                    continue; // not SETTINGS_INITIAL_WINDOW_SIZE
+                const qint64 window = qFromBigEndian<quint32>(payload.constData() + i + 2);
+                streamWindow += window - initialStreamWindow;
+                initialStreamWindow = window;
+            }
+            writeFrame(Settings, Ack, 0, {});
+            break;
+        case WindowUpdate: {
+            const qint64 increment = qFromBigEndian<quint32>(payload.constData()) & 0x7fffffff;
+            (stream ? streamWindow : sessionWindow) += increment;
+            break;
+        }
+        case Headers:
+            streamId = stream;
+            streamWindow = initialStreamWindow;
+            // ":status: 200", index 8 of the HPACK static table
+            writeFrame(Headers, EndHeaders, streamId, "\x88");
+            break;
+        case Ping:
+            if (!(flags & Ack))
+                writeFrame(Ping, Ack, 0, payload);
+            break;
+        default:
+            break;
+        }
+    }
+
+    void sendData()
+    {
+        while (streamId && dataSent < dataSize && client->bytesToWrite() < 4 * MaxFrameSize) {
+            const qint64 size = std::min({ MaxFrameSize, streamWindow, sessionWindow,
+                                           dataSize - dataSent });
+            if (size <= 0)
+                return;
+            dataSent += size;
+            streamWindow -= size;
+            sessionWindow -= size;
+            writeFrame(Data, dataSent == dataSize ? EndStream : 0, streamId,
+                       QByteArray(size, '@'));
+        }
+    }
+};
+
 
 
 
@@ -434,6 +566,8 @@ private slots:
     void httpDownloadPerformance();
     void httpDownloadPerformanceDownloadBuffer_data();
     void httpDownloadPerformanceDownloadBuffer();
+    void httpDownloadPeakMemory_data();
+    void httpDownloadPeakMemory();
     void httpsRequestChain();
     void httpsUpload();
     void preConnect_data();
@@ -782,6 +916,128 @@ void tst_qnetworkreply::httpDownloadPerformanceDownloadBuffer()
 }
 
 
+#ifdef Q_OS_LINUX
+// Returns a memory size from /proc/self/status, in bytes, or -1.
+static qint64 procStatusSize(QByteArrayView key)
+{
+    QFile status("/proc/self/status");
+    if (!status.open(QIODevice::ReadOnly | QIODevice::Text))
+        return -1;
+    // Files in /proc report a size of 0, so atEnd() cannot be used.
+    const QList<QByteArray> lines = status.readAll().split('\n');
+    for (const QByteArray &line : lines) {
+        if (line.startsWith(key) && line.at(key.size()) == ':')
+            return line.mid(key.size() + 1).trimmed().split(' ').first().toLongLong() * 1024;
+    }
+    return -1;
+}
+
+// Resets the peak resident set size to the current one and returns the
+// latter, in bytes. Returns -1 if the kernel does not support this.
+static qint64 resetPeakResidentSize()
+{
+    QFile clearRefs("/proc/self/clear_refs");
+    if (!clearRefs.open(QIODevice::WriteOnly | QIODevice::Append) || clearRefs.write("5") != 1
+        || !clearRefs.flush()) {
+        return -1;
+    }
+    return procStatusSize("VmRSS");
+}
+
+static qint64 peakResidentSize()
+{
+    return procStatusSize("VmHWM");
+}
+#endif // Q_OS_LINUX
+
+// Reads a fixed amount of data periodically, to simulate a consumer that is
+// slower than the network (e.g. one that writes the data to a slow disk).
+class SlowHttpReader : public QObject
+{
+    Q_OBJECT
+    QNetworkReply *reply;
+    QTimer timer;
+    QByteArray buffer;
+public:
+    qint64 totalBytes = 0;
+
+    SlowHttpReader(QNetworkReply *reply, qint64 bytesPerTick)
+        : reply(reply), buffer(bytesPerTick, Qt::Uninitialized)
+    {
+        connect(&timer, &QTimer::timeout, this, &SlowHttpReader::readSome);
+        timer.start(1ms);
+    }
+
+private slots:
+    void readSome()
+    {
+        const qint64 n = reply->read(buffer.data(), buffer.size());
+        if (n > 0)
+            totalBytes += n;
+        if (reply->isFinished() && !reply->bytesAvailable()) {
+            timer.stop();
+            QTestEventLoop::instance().exitLoop();
+        }
+    }
+};
+
+void tst_qnetworkreply::httpDownloadPeakMemory_data()
+{
+    QTest::addColumn<bool>("http2");
+    QTest::addColumn<qint64>("readBufferSize");
+
+    QTest::newRow("http1-unlimited-read-buffer") << false << qint64(0);
+    QTest::newRow("http1-1MiB-read-buffer") << false << 1 * MiB;
+    QTest::newRow("h2c-unlimited-read-buffer") << true << qint64(0);
+    QTest::newRow("h2c-1MiB-read-buffer") << true << 1 * MiB;
+}
+
+void tst_qnetworkreply::httpDownloadPeakMemory()
+{
+#ifdef Q_OS_LINUX
+    QFETCH(const bool, http2);
+    QFETCH(const qint64, readBufferSize);
+
+    constexpr qint64 DownloadSize = 128 * MiB;
+
+    const qint64 startSize = resetPeakResidentSize();
+    if (startSize < 0)
+        QSKIP("The kernel does not support resetting the peak resident set size");
+
+    HttpDownloadPerformanceServer http1Server(DownloadSize, true, false);
+    Http2DownloadServer http2Server(DownloadSize);
+    const int port = http2 ? http2Server.serverPort() : http1Server.serverPort();
+
+    QNetworkRequest request(QUrl("http://127.0.0.1:" + QString::number(port) + "/?bare=1"));
+    if (http2) {
+        request.setAttribute(QNetworkRequest::Http2DirectAttribute, true);
+        // The default stream window lets the server send almost the whole
+        // body ahead, whatever the reply does with it.
+        QHttp2Configuration config = request.http2Configuration();
+        config.setStreamReceiveWindowSize(1 * MiB);
+        request.setHttp2Configuration(config);
+    }
+    QNetworkAccessManager manager;
+    QNetworkReplyPtr reply(manager.get(request));
+    reply->setReadBufferSize(readBufferSize);
+
+    // 64 KiB per millisecond at best, which is well below loopback speed.
+    SlowHttpReader reader(reply.data(), 64 * 1024);
+    QTestEventLoop::instance().enterLoop(60);
+    QVERIFY(!QTestEventLoop::instance().timeout());
+    QCOMPARE(reply->error(), QNetworkReply::NoError);
+    QCOMPARE(reply->attribute(QNetworkRequest::Http2WasUsedAttribute).toBool(), http2);
+    QCOMPARE(reader.totalBytes, DownloadSize);
+
+    const qint64 peakGrowth = qMax(peakResidentSize() - startSize, 0);
+    qDebug() << "tst_QNetworkReply::httpDownloadPeakMemory peak RSS growth:"
+             << peakGrowth / 1024 << "KiB";
+    QTest::setBenchmarkResult(peakGrowth, QTest::BytesAllocated);
+#else
+    QSKIP("Measuring the peak resident set size is only implemented on Linux");
+#endif
+}
+
 class HttpsRequestChainHelper : public QObject {
     Q_OBJECT
 public:
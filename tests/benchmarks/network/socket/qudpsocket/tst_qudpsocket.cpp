@@ -16,6 +16,8 @@ public:
 private slots:
     void pendingDatagramSize_data();
     void pendingDatagramSize();
+    void sendReceive_data();
+    void sendReceive();
 };
 
 tst_QUdpSocket::tst_QUdpSocket()
@@ -51,5 +53,60 @@ void tst_QUdpSocket::pendingDatagramSize()
     }
 }
 
+void tst_QUdpSocket::sendReceive_data()
+{
+    QTest::addColumn<bool>("batched");
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("size");
+    for (int count : {16, 64}) {
+        for (int size : {64, 1200}) {
+            QTest::addRow("single-%dx%d", count, size) << false << count << size;
+            QTest::addRow("batched-%dx%d", count, size) << true << count << size;
+        }
+    }
+}
+
+void tst_QUdpSocket::sendReceive()
+{
+    QFETCH(bool, batched);
+    QFETCH(int, count);
+    QFETCH(int, size);
+
+    QUdpSocket receiver;
+    QVERIFY(receiver.bind(QHostAddress::LocalHost));
+    receiver.setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, 4 * 1024 * 1024);
+    QUdpSocket sender;
+    QVERIFY(sender.bind(QHostAddress::LocalHost));
+
+    QList<QNetworkDatagram> datagrams;
+    for (int i = 0; i < count; ++i) {
+        datagrams.append(QNetworkDatagram(QByteArray(size, char('a' + i % 26)),
+                                          QHostAddress::LocalHost, receiver.localPort()));
+    }
+
+    QBENCHMARK {
+        if (batched) {
+            QCOMPARE(sender.writeDatagrams(datagrams), count);
+        } else {
+            for (const QNetworkDatagram &datagram : std::as_const(datagrams))
+                QCOMPARE(sender.writeDatagram(datagram), size);
+        }
+
+        int received = 0;
+        while (received < count) {
+            if (!receiver.hasPendingDatagrams()) {
+                QVERIFY(receiver.waitForReadyRead(5000));
+                continue;
+            }
+            if (batched) {
+                received += receiver.receiveDatagrams(count - received, size).size();
+            } else {
+                QVERIFY(receiver.receiveDatagram(size).isValid());
+                ++received;
+            }
+        }
+    }
+}
+
 QTEST_MAIN(tst_QUdpSocket)
 #include "tst_qudpsocket.moc"
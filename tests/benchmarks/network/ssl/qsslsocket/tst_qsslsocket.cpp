@@ -2,10 +2,18 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
 
 #include <QTest>
+#include <QTestEventLoop>
 
 #include <qcoreapplication.h>
+#include <qfile.h>
+#include <qhostaddress.h>
 #include <qsslconfiguration.h>
+#include <qsslkey.h>
+#include <qsslserver.h>
 #include <qsslsocket.h>
+#include <qtemporaryfile.h>
+
+#include <memory>
 
 
 #include "../../../../auto/network-settings.h"
@@ -26,6 +34,8 @@ public slots:
 private slots:
     void rootCertLoading();
     void systemCaCertificates();
+    void loopbackTransfer_data();
+    void loopbackTransfer();
 };
 
 tst_QSslSocket::tst_QSslSocket()
@@ -38,8 +48,6 @@ tst_QSslSocket::~tst_QSslSocket()
 
 void tst_QSslSocket::initTestCase()
 {
-    if (!QtNetworkSettings::verifyTestNetworkSettings())
-        QSKIP("No network test server available");
 }
 
 void tst_QSslSocket::init()
@@ -54,6 +62,9 @@ void tst_QSslSocket::cleanup()
 
 void tst_QSslSocket::rootCertLoading()
 {
+    if (!QtNetworkSettings::verifyTestNetworkSettings())
+        QSKIP("No network test server available");
+
     QBENCHMARK_ONCE {
         QSslSocket socket;
         socket.connectToHostEncrypted(QtNetworkSettings::serverName(), 443);
@@ -71,5 +82,81 @@ void tst_QSslSocket::systemCaCertificates()
   }
 }
 
+void tst_QSslSocket::loopbackTransfer_data()
+{
+    QTest::addColumn<bool>("kernelTls");
+    QTest::addColumn<bool>("useSendFile");
+
+    QTest::newRow("user-space") << false << false;
+    QTest::newRow("user-space, sendFile") << false << true;
+    QTest::newRow("kernel-tls") << true << false;
+    QTest::newRow("kernel-tls, sendFile") << true << true;
+}
+
+void tst_QSslSocket::loopbackTransfer()
+{
+    // Whether the kernel actually encrypts depends on the tls module being
+    // loaded and the negotiated cipher; if it does not, the "kernel-tls" rows
+    // measure OpenSSL writing directly to the socket.
+    QFETCH(bool, kernelTls);
+    QFETCH(bool, useSendFile);
+
+    if (!QSslSocket::supportsSsl())
+        QSKIP("No SSL support");
+
+    constexpr qint64 PayloadSize = 16 * 1024 * 1024;
+
+    QSslConfiguration serverConfiguration = QSslConfiguration::defaultConfiguration();
+    QFile keyFile(QFINDTESTDATA("certs/selfsigned-server.key"));
+    QVERIFY(keyFile.open(QIODevice::ReadOnly));
+    serverConfiguration.setPrivateKey(QSslKey(keyFile.readAll(), QSsl::Rsa));
+    const auto certificates = QSslCertificate::fromPath(QFINDTESTDATA("certs/selfsigned-server.crt"));
+    QVERIFY(!certificates.isEmpty());
+    serverConfiguration.setLocalCertificate(certificates.first());
+    serverConfiguration.setSslOption(QSsl::SslOptionEnableKernelTls, kernelTls);
+
+    QSslServer server;
+    server.setSslConfiguration(serverConfiguration);
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+
+    QSslSocket client;
+    client.setPeerVerifyMode(QSslSocket::VerifyNone);
+    client.connectToHostEncrypted(QHostAddress(QHostAddress::LocalHost).toString(),
+                                  server.serverPort());
+    QTRY_VERIFY(client.isEncrypted());
+    QTRY_VERIFY(server.hasPendingConnections());
+    std::unique_ptr<QSslSocket> sender(qobject_cast<QSslSocket *>(server.nextPendingConnection()));
+    QVERIFY(sender);
+    QVERIFY(sender->isEncrypted());
+
+    QTemporaryFile file;
+    const QByteArray payload(PayloadSize, 'a');
+    if (useSendFile) {
+        QVERIFY(file.open());
+        QCOMPARE(file.write(payload), PayloadSize);
+        QVERIFY(file.flush());
+    }
+
+    qint64 received = 0;
+    QTestEventLoop loop;
+    connect(&client, &QSslSocket::readyRead, this, [&] {
+        received += client.skip(client.bytesAvailable());
+        if (received >= PayloadSize)
+            loop.exitLoop();
+    });
+    connect(&client, &QSslSocket::disconnected, &loop, &QTestEventLoop::exitLoop);
+
+    QBENCHMARK {
+        received = 0;
+        if (useSendFile)
+            QVERIFY(sender->sendFile(&file));
+        else
+            QCOMPARE(sender->write(payload), PayloadSize);
+        loop.enterLoop(60);
+        QVERIFY(!loop.timeout());
+        QCOMPARE(received, PayloadSize);
+    }
+}
+
 QTEST_MAIN(tst_QSslSocket)
 #include "tst_qsslsocket.moc"
@@ -1,6 +1,7 @@
 // Copyright (C) 2016 The Qt Company Ltd.
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
 
+#include <QScopeGuard>
 #include <QTest>
 #include <QtSql/QtSql>
 
@@ -24,10 +25,15 @@ private slots:
     void benchmark();
     void benchmarkSelectPrepared_data() { generic_data(); }
     void benchmarkSelectPrepared();
+    void benchmarkShortLivedPrepared_data() { generic_data(); }
+    void benchmarkShortLivedPrepared() { shortLivedPrepared(false); }
+    void benchmarkShortLivedPreparedCached_data() { generic_data(); }
+    void benchmarkShortLivedPreparedCached() { shortLivedPrepared(true); }
 
 private:
     // returns all database connections
     void generic_data(const QString &engine = QString());
+    void shortLivedPrepared(bool statementCache);
 
     tst_Databases dbs;
 };
@@ -115,4 +121,59 @@ void tst_QSqlQuery::benchmarkSelectPrepared()
     }
 }
 
+void tst_QSqlQuery::shortLivedPrepared(bool statementCache)
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+
+    if (statementCache) {
+        QString option;
+        switch (tst_Databases::getDatabaseType(db)) {
+        case QSqlDriver::SQLite:
+            option = "QSQLITE_STATEMENT_CACHE_SIZE=16";
+            break;
+        case QSqlDriver::PostgreSQL:
+            option = "QPSQL_STATEMENT_CACHE_SIZE=16";
+            break;
+        default:
+            QSKIP("The statement cache is only implemented by QSQLITE and QPSQL");
+        }
+        db = QSqlDatabase::cloneDatabase(db, dbName + "_statementCache");
+        db.setConnectOptions(option);
+        QVERIFY_SQL(db, open());
+    }
+    const auto closeClone = qScopeGuard([&] {
+        if (statementCache) {
+            const QString name = db.connectionName();
+            db = QSqlDatabase();
+            QSqlDatabase::removeDatabase(name);
+        }
+    });
+
+    QSqlQuery q(db);
+    TableScope ts(db, "benchmark", __FILE__);
+    QVERIFY_SQL(q, exec("CREATE TABLE " + ts.tableName() + "(id INT NOT NULL, name VARCHAR(45))"));
+    QVERIFY_SQL(q, exec("INSERT INTO " + ts.tableName() + " VALUES (1, 'one'), (2, 'two')"));
+
+    // the typical pattern of a function that looks something up: a new
+    // QSqlQuery each time, preparing the same SQL text
+    const QString lookup = "SELECT name FROM " + ts.tableName() + " WHERE id = ?";
+    int id = 0;
+    QBENCHMARK {
+        QSqlQuery query(db);
+        QVERIFY_SQL(query, prepare(lookup));
+        query.addBindValue(id % 2 + 1);
+        QVERIFY_SQL(query, exec());
+        QVERIFY_SQL(query, next());
+        ++id;
+    }
+
+    if (statementCache) {
+        const qint64 hits = db.driver()->property("statementCacheHits").toLongLong();
+        const qint64 misses = db.driver()->property("statementCacheMisses").toLongLong();
+        QVERIFY(hits > misses);
+    }
+}
+
 #include "main.moc"